@@ -0,0 +1,200 @@
+/**
+ * @file timestable.h
+ * @brief Embeddable interface to the table generators (libtimestable)
+ *
+ * A handle computes one table and renders it a row at a time into buffers
+ * supplied by the caller, in the layout printed by the timestable program.
+ * Handles share no state, so independent handles may be used on different
+ * threads at once. All memory is allocated by ts_table_open(); reading
+ * rows allocates nothing.
+ */
+
+#ifndef TIMESTABLE_H
+#define TIMESTABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Largest row or column value of a table (its square fits an int)
+ */
+#define TS_MAX_VALUE 46340
+
+/**
+ * @brief Raw value of an undefined cell (such as a division by zero)
+ */
+#define TS_VALUE_UNDEFINED UINT64_MAX
+
+/**
+ * @brief Raw value of a cell too large for 64 bits
+ */
+#define TS_VALUE_OVERFLOW (UINT64_MAX - 1)
+
+/**
+ * @brief Tables a handle can compute, as selected with -t or -e
+ */
+typedef enum
+{
+    TS_TABLE_MULTIPLICATION = 0,     /**< row × column (-t m) */
+    TS_TABLE_DIVISION,               /**< row ÷ column (-t d) */
+    TS_TABLE_POWER,                  /**< row ^ column (-t p) */
+    TS_TABLE_MOD_MULTIPLICATION,     /**< row × column mod m (-t M) */
+    TS_TABLE_MOD_POWER,              /**< row ^ column mod m (-t P) */
+    TS_TABLE_GCD,                    /**< gcd(row, column) (-t g) */
+    TS_TABLE_LCM,                    /**< lcm(row, column) (-t l) */
+    TS_TABLE_REMAINDER,              /**< row mod column (-t r) */
+    TS_TABLE_EXPRESSION              /**< Integer expression in r and c (-e) */
+} ts_table_kind_t;
+
+/**
+ * @brief Number formats of the rendered rows
+ */
+typedef enum
+{
+    TS_FORMAT_DECIMAL = 0,           /**< Decimal text */
+    TS_FORMAT_HEX                    /**< Hexadecimal text (-x) */
+} ts_format_t;
+
+/**
+ * @brief Error codes for the library
+ */
+typedef enum
+{
+    TS_SUCCESS = 0,                  /**< No error */
+    TS_ERROR_INVALID_OPTION,         /**< Unknown option or missing argument */
+    TS_ERROR_INVALID_MIN,            /**< Invalid minimum value */
+    TS_ERROR_INVALID_MAX,            /**< Invalid maximum value */
+    TS_ERROR_MIN_GT_MAX,             /**< Minimum greater than maximum */
+    TS_ERROR_INVALID_TABLE_TYPE,     /**< Unknown table type */
+    TS_ERROR_INVALID_MODULUS,        /**< Missing or invalid modulus */
+    TS_ERROR_INVALID_EXPRESSION,     /**< Expression that does not compile */
+    TS_ERROR_OUT_OF_MEMORY           /**< Allocation failed */
+} ts_error_code_t;
+
+/**
+ * @brief Error code and message
+ */
+typedef struct
+{
+    ts_error_code_t code;            /**< The error code */
+    const char *message;             /**< The corresponding error message */
+} ts_error_t;
+
+/**
+ * @brief Description of a table to open
+ */
+typedef struct
+{
+    int min_value;                   /**< Minimum value for rows and columns */
+    int max_value;                   /**< Maximum value for rows and columns */
+    ts_table_kind_t table;           /**< Table to compute */
+    ts_format_t format;              /**< Number format of the rendered rows */
+    uint64_t modulus;                /**< Modulus of the modular tables (0 = unset) */
+    const char *expression;          /**< Expression of TS_TABLE_EXPRESSION, or NULL */
+} ts_spec_t;
+
+/**
+ * @brief Table opened with ts_table_open()
+ */
+typedef struct ts_table ts_table_t;
+
+/**
+ * @brief Fill a specification with the defaults of the timestable program
+ *
+ * @param spec  Specification to initialize (the 1 to 10 multiplication table)
+ */
+void ts_spec_init(ts_spec_t *spec);
+
+/**
+ * @brief Update a specification from command line style arguments
+ *
+ * Accepts -m N, -M N, -t TYPE, -x, --mod M (or --mod=M) and -e EXPR, with
+ * values attached (-m5) or separate. Nothing outside spec is read or
+ * written, so any thread may parse at any time. The expression is kept by
+ * reference.
+ *
+ * @param spec  Specification to update, usually from ts_spec_init()
+ * @param argc  Number of arguments
+ * @param argv  Arguments, without a program name
+ * @return      ts_error_t Error code and message
+ */
+ts_error_t ts_spec_parse(ts_spec_t *spec, int argc, char *const argv[]);
+
+/**
+ * @brief Open a table
+ *
+ * @param spec   Table to open; it is not kept after the call
+ * @param error  Set to the error code and message
+ * @return       ts_table_t* The table, or NULL on error
+ */
+ts_table_t *ts_table_open(const ts_spec_t *spec, ts_error_t *error);
+
+/**
+ * @brief Title of a table, as printed above it by the timestable program
+ *
+ * @param table  Open table
+ * @return       const char* Title, valid until the table is closed
+ */
+const char *ts_table_title(const ts_table_t *table);
+
+/**
+ * @brief Render the column header and separator lines of a table
+ *
+ * Like snprintf(), the text is written only if it fits with its
+ * terminator, and the length it needs is returned either way.
+ *
+ * @param table   Open table
+ * @param buffer  Destination, or NULL if size is 0
+ * @param size    Size of the destination
+ * @return        size_t Length of the text, without the terminator
+ */
+size_t ts_table_header(const ts_table_t *table, char *buffer, size_t size);
+
+/**
+ * @brief Buffer size that holds any row of a table with its terminator
+ *
+ * @param table  Open table
+ * @return       size_t Size in bytes
+ */
+size_t ts_row_size(const ts_table_t *table);
+
+/**
+ * @brief Render the next row of a table, including its newline
+ *
+ * A row that does not fit with its terminator is not written and stays
+ * the next row, so it can be read again into a larger buffer; its length
+ * is returned as with snprintf(). With a NULL buffer the row is skipped
+ * without being written, which suits callers of ts_get_values() only.
+ *
+ * @param table   Open table
+ * @param buffer  Destination, or NULL to skip the row
+ * @param size    Size of the destination
+ * @return        size_t Length of the row text, or 0 after the last row
+ */
+size_t ts_next_row(ts_table_t *table, char *buffer, size_t size);
+
+/**
+ * @brief Raw values of the row of the last call to ts_next_row()
+ *
+ * The row is computed even if its text did not fit the buffer. Values are
+ * as written by the timestable program with -B: tables of signed values
+ * hold their two's complement, and undefined and overflowed cells hold
+ * TS_VALUE_UNDEFINED and TS_VALUE_OVERFLOW.
+ *
+ * @param table  Open table
+ * @param row    Set to the row value, if not NULL
+ * @param count  Set to the number of values (one per column), if not NULL
+ * @return       const uint64_t* The values, valid until the next call to
+ *               ts_next_row(), or NULL before the first row
+ */
+const uint64_t *ts_get_values(const ts_table_t *table, int *row, int *count);
+
+/**
+ * @brief Close a table and release its memory
+ *
+ * @param table  Table to close, or NULL
+ */
+void ts_table_close(ts_table_t *table);
+
+#endif /* TIMESTABLE_H */
@@ -0,0 +1,147 @@
+/**
+ * @file timestable_aggregate.h
+ * @brief Sums, extremes and histograms of table cells without printing them
+ *
+ * The multiplication, division and power tables are reduced with closed
+ * forms: a rectangle of products sums to the product of two arithmetic
+ * series, a row of powers to a geometric series, and a column of quotients
+ * to a floor sum. Other tables are reduced over their row kernels. No cell
+ * is ever formatted, and values are taken mathematically with 128-bit
+ * accumulators, so a result is either exact or reported as an overflow.
+ */
+
+#ifndef TIMESTABLE_AGGREGATE_H
+#define TIMESTABLE_AGGREGATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "timestable_operations.h"  // row_operation_t
+
+/**
+ * @brief Largest row or column value accepted for aggregates
+ */
+#define AGG_MAX_VALUE 10000
+
+/**
+ * @brief Largest row or column value of --range-sum over tables with a
+ *        closed form (multiplication, division, power), which never scan cells
+ */
+#define AGG_MAX_CLOSED_VALUE 1000000
+
+/**
+ * @brief Most rows (and columns) of a histogram, which holds every cell
+ */
+#define AGG_MAX_HISTOGRAM_SIDE 4096
+
+/**
+ * @brief Characters needed to format any agg_int_t, including the terminator
+ */
+#define AGG_TEXT_SIZE 41
+
+/**
+ * @brief Exact signed 128-bit accumulator
+ */
+__extension__ typedef __int128 agg_int_t;
+
+/**
+ * @brief Reductions of a rectangle of cells
+ */
+typedef enum
+{
+    AGG_SUM,                         /**< Sum of the cells */
+    AGG_MIN,                         /**< Smallest cell */
+    AGG_MAX,                         /**< Largest cell */
+    AGG_HISTOGRAM                    /**< Number of cells holding each value */
+} agg_kind_t;
+
+/**
+ * @brief How the cells of a table are computed
+ */
+typedef enum
+{
+    AGG_TABLE_MULTIPLY,              /**< row × column */
+    AGG_TABLE_DIVIDE,                /**< row ÷ column, truncated; column 0 is undefined */
+    AGG_TABLE_POWER,                 /**< row ^ column, with 0 ^ 0 = 1 */
+    AGG_TABLE_ROWS                   /**< Values of a row operation */
+} agg_source_t;
+
+/**
+ * @brief Table to reduce
+ */
+typedef struct
+{
+    agg_source_t source;                  /**< How the cells are computed */
+    const row_operation_t *row_operation; /**< Operation for AGG_TABLE_ROWS */
+} agg_table_t;
+
+/**
+ * @brief Rectangle of cells
+ */
+typedef struct
+{
+    int first_row;                   /**< First row */
+    int last_row;                    /**< Last row */
+    int first_column;                /**< First column */
+    int last_column;                 /**< Last column */
+} agg_rect_t;
+
+/**
+ * @brief Sum, minimum or maximum of some cells
+ */
+typedef struct
+{
+    agg_int_t value;                 /**< Exact result, unless overflow is set */
+    uint64_t cells;                  /**< Cells with a value (undefined ones are skipped) */
+    bool overflow;                   /**< The result is 2^127 or more */
+} agg_result_t;
+
+/**
+ * @brief Function receiving each value of a histogram, in increasing order
+ *
+ * @param context  Data passed to agg_histogram()
+ * @param value    Cell value
+ * @param count    Number of cells holding value
+ * @return         bool true to continue, false to stop
+ */
+typedef bool (*agg_bucket_t)(void *context, agg_int_t value, uint64_t count);
+
+/**
+ * @brief Reduce a rectangle, optionally by row and by column as well
+ *
+ * @param table    Table to reduce
+ * @param kind     AGG_SUM, AGG_MIN or AGG_MAX
+ * @param rect     Cells to reduce
+ * @param rows     One result per row of rect, or NULL
+ * @param columns  One result per column of rect, or NULL
+ * @param total    Result for the whole rectangle
+ * @return         bool true on success, false if memory ran out
+ */
+bool agg_reduce(const agg_table_t *table, agg_kind_t kind, const agg_rect_t *rect,
+                agg_result_t *rows, agg_result_t *columns, agg_result_t *total);
+
+/**
+ * @brief Count the cells of a rectangle holding each value
+ *
+ * @param table      Table to count
+ * @param rect       Cells to count (at most AGG_MAX_HISTOGRAM_SIDE rows and columns)
+ * @param visit      Function receiving each value and its count
+ * @param context    Data passed to visit
+ * @param undefined  Set to the number of undefined cells
+ * @param overflow   Set to the number of cells of 2^127 or more
+ * @return           bool true if every value was visited, false if visit
+ *                   stopped or memory ran out
+ */
+bool agg_histogram(const agg_table_t *table, const agg_rect_t *rect, agg_bucket_t visit,
+                   void *context, uint64_t *undefined, uint64_t *overflow);
+
+/**
+ * @brief Format a value in decimal
+ *
+ * @param value  Value to format
+ * @param text   Buffer of at least AGG_TEXT_SIZE characters
+ * @return       char* text
+ */
+char *agg_format(agg_int_t value, char *text);
+
+#endif /* TIMESTABLE_AGGREGATE_H */
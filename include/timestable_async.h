@@ -0,0 +1,152 @@
+/**
+ * @file timestable_async.h
+ * @brief Asynchronous multi-buffered writer
+ *
+ * Lets the renderer fill one buffer while earlier buffers are being
+ * written, so table generation does not stall when the output blocks.
+ * Writes are issued through io_uring where the kernel supports it, and
+ * otherwise by a writer thread calling write(). Output order is always
+ * preserved: regular files may have several writes in flight at explicit
+ * offsets, other files (pipes, terminals, devices) one at a time.
+ *
+ * When the output is a pipe, buffers can instead be handed to the kernel
+ * with vmsplice(), which maps the pages into the pipe rather than copying
+ * them. Pages stay referenced until the reader consumes them, so the pool
+ * is used in strict rotation and a buffer is only reused once the pipe
+ * holds fewer unread bytes than were spliced after it. Splicing is only
+ * used when all buffers but one hold at least the pipe's capacity, so a
+ * full pipe blocks the splice rather than the reuse.
+ */
+
+#ifndef TIMESTABLE_ASYNC_H
+#define TIMESTABLE_ASYNC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/**
+ * @brief Buffer limits and defaults
+ */
+#define ASYNC_MIN_BUFFERS         2              /**< Double buffering */
+#define ASYNC_MAX_BUFFERS         64             /**< Upper limit on buffers */
+#define ASYNC_DEFAULT_BUFFERS     4              /**< Default buffer count */
+#define ASYNC_DEFAULT_BUFFER_SIZE (256 * 1024)   /**< Default buffer size in bytes */
+
+/**
+ * @brief Mechanism used to issue the writes
+ */
+typedef enum
+{
+    ASYNC_BACKEND_AUTO = 0,          /**< splice for pipes, else io_uring, else thread */
+    ASYNC_BACKEND_URING,             /**< io_uring submission queue */
+    ASYNC_BACKEND_THREAD,            /**< Writer thread calling write() */
+    ASYNC_BACKEND_SPLICE             /**< vmsplice() of page-aligned buffers (pipes only) */
+} async_backend_t;
+
+/**
+ * @brief Queue statistics collected while writing
+ */
+typedef struct
+{
+    uint64_t writes;                 /**< Buffers submitted */
+    uint64_t bytes;                  /**< Bytes submitted */
+    uint64_t depth_total;            /**< Sum of the in-flight depth after each submit */
+    uint32_t max_depth;              /**< Largest number of buffers in flight */
+    uint64_t stalls;                 /**< Times the renderer waited for a free buffer */
+} async_stats_t;
+
+/**
+ * @brief Backend-specific state (io_uring rings or writer thread)
+ */
+typedef struct async_state async_state_t;
+
+/**
+ * @brief Asynchronous writer with a fixed pool of buffers
+ */
+typedef struct
+{
+    int fd;                          /**< File descriptor written to */
+    async_backend_t backend;         /**< Backend in use (never AUTO once open) */
+    size_t buffer_count;             /**< Number of buffers in the pool */
+    size_t buffer_size;              /**< Size of each buffer in bytes */
+    char *pool;                      /**< buffer_count × buffer_size bytes */
+    size_t max_in_flight;            /**< Writes allowed in flight at once */
+    bool positioned;                 /**< Writes use explicit file offsets */
+    off_t offset;                    /**< Offset of the next positioned write */
+    bool failed;                     /**< A write failed; later calls fail */
+    async_stats_t stats;             /**< Queue statistics */
+    async_state_t *state;            /**< Backend state */
+} async_writer_t;
+
+/**
+ * @brief Open an asynchronous writer on a file descriptor
+ *
+ * @param writer        Writer to initialize
+ * @param fd            File descriptor to write to
+ * @param backend       Requested backend (AUTO picks splice for pipes the
+ *                      pool covers, then io_uring if usable, then the thread)
+ * @param buffer_count  Number of buffers (ASYNC_MIN_BUFFERS to ASYNC_MAX_BUFFERS)
+ * @param buffer_size   Size of each buffer in bytes (rounded up to whole
+ *                      pages for splice)
+ * @return              bool true on success, false if the backend cannot be set up
+ */
+bool async_writer_open(async_writer_t *writer, int fd, async_backend_t backend,
+                       size_t buffer_count, size_t buffer_size);
+
+/**
+ * @brief Get a free buffer to render into, waiting for one if necessary
+ *
+ * With the splice backend only one buffer may be held at a time.
+ *
+ * @param writer Writer to take the buffer from
+ * @return       char* Buffer of buffer_size bytes, or NULL after a write error
+ */
+char *async_writer_acquire(async_writer_t *writer);
+
+/**
+ * @brief Queue a buffer obtained from async_writer_acquire() for writing
+ *
+ * The buffer belongs to the writer again once this returns.
+ *
+ * @param writer  Writer the buffer came from
+ * @param data    Buffer to write
+ * @param length  Number of bytes to write from the buffer
+ * @return        bool true on success, false after a write error
+ */
+bool async_writer_submit(async_writer_t *writer, char *data, size_t length);
+
+/**
+ * @brief Return an acquired buffer without writing it
+ *
+ * @param writer  Writer the buffer came from
+ * @param data    Buffer to return
+ */
+void async_writer_release(async_writer_t *writer, char *data);
+
+/**
+ * @brief Wait until every submitted buffer has been written
+ *
+ * @param writer Writer to drain
+ * @return       bool true if all writes succeeded
+ */
+bool async_writer_drain(async_writer_t *writer);
+
+/**
+ * @brief Drain and close a writer (the file descriptor stays open)
+ *
+ * @param writer Writer to close
+ * @return       bool true if all writes succeeded
+ */
+bool async_writer_close(async_writer_t *writer);
+
+/**
+ * @brief Name of a backend, for reporting
+ *
+ * @param backend Backend
+ * @return        const char* "io_uring", "thread", "splice" or "auto"
+ */
+const char *async_backend_name(async_backend_t backend);
+
+#endif /* TIMESTABLE_ASYNC_H */
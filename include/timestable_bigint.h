@@ -0,0 +1,108 @@
+/**
+ * @file timestable_bigint.h
+ * @brief Arbitrary-precision unsigned integers for the power table
+ *
+ * A minimal non-negative big integer stored as base 2^32 limbs. Only the
+ * operations needed to build power table rows incrementally are provided:
+ * multiplication by a small factor and conversion to decimal or hex text.
+ */
+
+#ifndef TIMESTABLE_BIGINT_H
+#define TIMESTABLE_BIGINT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Non-negative arbitrary-precision integer
+ *
+ * Zero is represented by a single zero limb, so length is never 0 once
+ * the value has been initialized.
+ */
+typedef struct
+{
+    uint32_t *limbs;                 /**< Little-endian base 2^32 limbs */
+    size_t length;                   /**< Number of limbs in use */
+    size_t capacity;                 /**< Number of limbs allocated */
+} bigint_t;
+
+/**
+ * @brief Initialize a big integer to zero
+ *
+ * @param value     Big integer to initialize
+ * @param capacity  Number of limbs to preallocate (at least one is used)
+ * @return          bool true on success, false if allocation failed
+ */
+bool bigint_init(bigint_t *value, size_t capacity);
+
+/**
+ * @brief Release the limbs owned by a big integer
+ *
+ * @param value Big integer to release
+ */
+void bigint_free(bigint_t *value);
+
+/**
+ * @brief Set a big integer to a small value, keeping its allocation
+ *
+ * @param value  Big integer to update
+ * @param small  New value
+ */
+void bigint_set_u32(bigint_t *value, uint32_t small);
+
+/**
+ * @brief Multiply a big integer in place by a small factor
+ *
+ * Grows the limb array when the product needs another limb.
+ *
+ * @param value   Big integer to update
+ * @param factor  Factor to multiply by
+ * @return        bool true on success, false if allocation failed
+ */
+bool bigint_mul_u32(bigint_t *value, uint32_t factor);
+
+/**
+ * @brief Number of significant bits in a big integer
+ *
+ * @param value Big integer to measure
+ * @return      size_t Bit length (0 for zero)
+ */
+size_t bigint_bit_length(const bigint_t *value);
+
+/**
+ * @brief Upper bound on decimal digits for a value of the given bit length
+ *
+ * @param bits Bit length of the value
+ * @return     size_t Maximum number of decimal digits
+ */
+size_t bigint_decimal_digits(size_t bits);
+
+/**
+ * @brief Convert a big integer to decimal text
+ *
+ * Peels off base 10^9 chunks with one 64-by-32 bit division pass per chunk.
+ * The text is not NUL terminated.
+ *
+ * @param value    Big integer to convert
+ * @param scratch  Working copy reused between calls (grown as needed)
+ * @param buffer   Destination, at least bigint_decimal_digits() bytes
+ * @param size     Size of the destination
+ * @return         size_t Number of characters written, 0 on failure
+ */
+size_t bigint_to_decimal(const bigint_t *value, bigint_t *scratch,
+                         char *buffer, size_t size);
+
+/**
+ * @brief Convert a big integer to hexadecimal text with a "0x" prefix
+ *
+ * The text is not NUL terminated.
+ *
+ * @param value   Big integer to convert
+ * @param buffer  Destination, at least 2 + 8 * length bytes
+ * @param size    Size of the destination
+ * @return        size_t Number of characters written, 0 on failure
+ */
+size_t bigint_to_hex(const bigint_t *value, char *buffer, size_t size);
+
+#endif /* TIMESTABLE_BIGINT_H */
@@ -0,0 +1,102 @@
+/**
+ * @file timestable_browser.h
+ * @brief Interactive viewport browser for large tables
+ *
+ * Shows a scrollable window onto a table with frozen row and column
+ * headers. Only the cells that are on screen are computed and formatted,
+ * in fixed-size tiles kept in a small least-recently-used cache, so the
+ * cost of scrolling or jumping does not depend on the size of the table.
+ */
+
+#ifndef TIMESTABLE_BROWSER_H
+#define TIMESTABLE_BROWSER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "timestable_operations.h"
+#include "timestable_formatter.h"
+
+/**
+ * @brief Tile geometry and cache size
+ */
+#define BROWSE_TILE_ROWS    32       /**< Rows per tile */
+#define BROWSE_TILE_COLUMNS 16       /**< Columns per tile */
+#define BROWSE_CACHE_TILES  64       /**< Tiles kept in the cache */
+#define BROWSE_CELL_SIZE    24       /**< Longest cell text (64-bit values) */
+
+/**
+ * @brief Table shown by the browser
+ *
+ * Exactly one of operation and row_operation is used: operation when it is
+ * not NULL, otherwise row_operation.
+ */
+typedef struct
+{
+    int min_value;                          /**< Minimum value for rows and columns */
+    int max_value;                          /**< Maximum value for rows and columns */
+    const char *title;                      /**< Title to display for the table */
+    output_format_t format;                 /**< Output format (decimal, hex) */
+    TableOperation operation;               /**< Per-cell operation, or NULL */
+    const row_operation_t *row_operation;   /**< Row operation if operation is NULL */
+} browse_table_t;
+
+/**
+ * @brief Formatted cells of one tile, unpadded
+ */
+typedef struct
+{
+    int64_t tile_row;                       /**< Tile row index (-1 if unused) */
+    int64_t tile_column;                    /**< Tile column index */
+    uint64_t last_used;                     /**< Cache clock value of last use */
+    uint8_t length[BROWSE_TILE_ROWS][BROWSE_TILE_COLUMNS];
+    char text[BROWSE_TILE_ROWS][BROWSE_TILE_COLUMNS][BROWSE_CELL_SIZE];
+} browse_tile_t;
+
+/**
+ * @brief Least-recently-used cache of rendered tiles
+ */
+typedef struct
+{
+    const browse_table_t *table;            /**< Table the tiles belong to */
+    browse_tile_t *tiles;                   /**< BROWSE_CACHE_TILES tiles */
+    uint64_t clock;                         /**< Incremented on every lookup */
+    uint64_t hits;                          /**< Lookups served from the cache */
+    uint64_t misses;                        /**< Lookups that rendered a tile */
+} browse_cache_t;
+
+/**
+ * @brief Initialize an empty tile cache for a table
+ *
+ * @param cache  Cache to initialize
+ * @param table  Table whose cells are cached
+ * @return       bool true on success, false if allocation failed
+ */
+bool browse_cache_init(browse_cache_t *cache, const browse_table_t *table);
+
+/**
+ * @brief Release a tile cache
+ *
+ * @param cache Cache to release
+ */
+void browse_cache_free(browse_cache_t *cache);
+
+/**
+ * @brief Get the tile holding a cell, rendering it on a miss
+ *
+ * @param cache   Tile cache
+ * @param row     Row value of any cell in the tile
+ * @param column  Column value of any cell in the tile
+ * @return        const browse_tile_t* Tile containing the cell
+ */
+const browse_tile_t *browse_cache_get(browse_cache_t *cache, int64_t row, int64_t column);
+
+/**
+ * @brief Run the interactive browser until the user quits
+ *
+ * @param table Table to browse
+ * @return      bool true on normal exit, false if the terminal or memory
+ *              could not be set up
+ */
+bool browse_table(const browse_table_t *table);
+
+#endif /* TIMESTABLE_BROWSER_H */
@@ -0,0 +1,117 @@
+/**
+ * @file timestable_checkpoint.h
+ * @brief Checkpoints of completed output for resuming interrupted runs
+ *
+ * A checkpoint records a position in the output: the table being written,
+ * the first of its rows not yet known to be on disk, and the byte offset
+ * where that row starts. The output is synced before the record is
+ * written, so a record never points past data that could still be lost.
+ * A resumed run truncates the output to the recorded offset and carries
+ * on from the recorded row.
+ */
+
+#ifndef TIMESTABLE_CHECKPOINT_H
+#define TIMESTABLE_CHECKPOINT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <sys/types.h>
+
+/**
+ * @brief Row value meaning the table's title and header are not written yet
+ */
+#define CHECKPOINT_TABLE_START INT_MIN
+
+/**
+ * @brief Minimum time between checkpoints inside a table, in milliseconds
+ */
+#define CHECKPOINT_INTERVAL_MS 1000
+
+/**
+ * @brief Error codes for checkpoint handling
+ */
+typedef enum
+{
+    CHECKPOINT_SUCCESS = 0,          /**< Checkpoint opened or written */
+    CHECKPOINT_ERROR_OPEN,           /**< Checkpoint file could not be opened */
+    CHECKPOINT_ERROR_OUTPUT,         /**< Output is not a regular file */
+    CHECKPOINT_ERROR_CORRUPT,        /**< Record is damaged or unreadable */
+    CHECKPOINT_ERROR_MISMATCH,       /**< Record belongs to different options */
+    CHECKPOINT_ERROR_WRITE           /**< Syncing the output or record failed */
+} checkpoint_error_code_t;
+
+/**
+ * @brief Structure to hold checkpoint error information
+ */
+typedef struct
+{
+    checkpoint_error_code_t code;    /**< The error code */
+    const char *message;             /**< The corresponding error message */
+} checkpoint_error_t;
+
+/**
+ * @brief Open checkpoint file and the position recorded in it
+ */
+typedef struct
+{
+    int fd;                          /**< Checkpoint file */
+    int output_fd;                   /**< Output the positions refer to */
+    uint64_t signature;              /**< Hash of the options producing the output */
+    uint32_t table;                  /**< Table being written (display order index) */
+    bool resuming;                   /**< Resume position not yet taken up */
+    uint32_t resume_table;           /**< Table to resume */
+    int resume_row;                  /**< Row to resume (or CHECKPOINT_TABLE_START) */
+    uint64_t last_ns;                /**< Time of the last record */
+    uint64_t records;                /**< Records written */
+} checkpoint_t;
+
+/**
+ * @brief Open a checkpoint file, and with resume restore its position
+ *
+ * With resume, the output is truncated to the recorded offset (to nothing
+ * if there is no record yet) and positioned at its end. Without resume,
+ * any old record is replaced by one for the current end of the output.
+ *
+ * @param checkpoint  Checkpoint to initialize
+ * @param path        Path of the checkpoint file
+ * @param output_fd   Output file descriptor (a regular file)
+ * @param signature   Hash of the options producing the output
+ * @param resume      Continue from the recorded position
+ * @return            checkpoint_error_t structure with error code and message
+ */
+checkpoint_error_t checkpoint_open(checkpoint_t *checkpoint, const char *path, int output_fd,
+                                   uint64_t signature, bool resume);
+
+/**
+ * @brief Check whether a row-boundary checkpoint is due
+ *
+ * @param checkpoint Open checkpoint
+ * @return           bool true if CHECKPOINT_INTERVAL_MS have passed since the
+ *                   last record
+ */
+bool checkpoint_due(const checkpoint_t *checkpoint);
+
+/**
+ * @brief Record a position once everything before it is on disk
+ *
+ * The caller must have written all output before offset. The output is
+ * synced first, then the record is written and synced.
+ *
+ * @param checkpoint  Open checkpoint
+ * @param table       Table being written (display order index)
+ * @param next_row    First row not yet written, or CHECKPOINT_TABLE_START
+ * @param offset      Output offset where next_row starts
+ * @return            checkpoint_error_t structure with error code and message
+ */
+checkpoint_error_t checkpoint_commit(checkpoint_t *checkpoint, uint32_t table,
+                                     int next_row, off_t offset);
+
+/**
+ * @brief Close a checkpoint file
+ *
+ * @param checkpoint Checkpoint to close
+ */
+void checkpoint_close(checkpoint_t *checkpoint);
+
+#endif /* TIMESTABLE_CHECKPOINT_H */
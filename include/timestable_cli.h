@@ -10,7 +10,10 @@
 #define TIMESTABLE_CLI_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "timestable_formatter.h"
+#include "timestable_async.h"
+#include "timestable_aggregate.h"
 
 /**
  * @brief Error codes for command line parsing and validation
@@ -22,7 +25,20 @@ typedef enum
     CLI_ERROR_INVALID_MAX,           /**< Invalid maximum value provided */
     CLI_ERROR_MIN_GT_MAX,            /**< Minimum value greater than maximum */
     CLI_ERROR_INVALID_TABLE_TYPE,    /**< Invalid table type specified */
-    CLI_ERROR_INVALID_OPTION         /**< Unknown or invalid option */
+    CLI_ERROR_INVALID_OPTION,        /**< Unknown or invalid option */
+    CLI_ERROR_INVALID_MODULUS,       /**< Missing or invalid modulus */
+    CLI_ERROR_INVALID_PLUGIN,        /**< --plugin given without --op or vice versa */
+    CLI_ERROR_INVALID_EXPRESSION,    /**< Expression failed to compile */
+    CLI_ERROR_INVALID_WRITER,        /**< Unknown -F record format */
+    CLI_ERROR_INVALID_ASYNC,         /**< Invalid asynchronous writer setting */
+    CLI_ERROR_INVALID_JOBS,          /**< Invalid -j worker count */
+    CLI_ERROR_INVALID_CHECKPOINT,    /**< --resume without --checkpoint, or unsupported output */
+    CLI_ERROR_INVALID_SHARD,         /**< Invalid --shard selection or unsupported output */
+    CLI_ERROR_INVALID_FIND,          /**< Invalid --find value or unsupported table */
+    CLI_ERROR_INVALID_AGGREGATE,     /**< Invalid --agg or --range-sum, or unsupported output */
+    CLI_ERROR_INVALID_PRECISION,     /**< Invalid --precision or unsupported output */
+    CLI_ERROR_INVALID_OUTPUT,        /**< Invalid --out sink or unsupported combination */
+    CLI_ERROR_INVALID_COMPACT        /**< --compact with an output it cannot lay out */
 } cli_error_code_t;
 
 /**
@@ -33,6 +49,13 @@ typedef enum
     TABLE_FLAG_MULTIPLICATION = 0x01,     /**< Show multiplication table */
     TABLE_FLAG_DIVISION = 0x02,           /**< Show division table */
     TABLE_FLAG_POWER = 0x04,              /**< Show power table */
+    TABLE_FLAG_MOD_MULTIPLICATION = 0x08, /**< Show modular multiplication table */
+    TABLE_FLAG_MOD_POWER = 0x10,          /**< Show modular power table */
+    TABLE_FLAG_PLUGIN = 0x20,             /**< Show plugin operation table */
+    TABLE_FLAG_EXPRESSION = 0x40,         /**< Show user expression table */
+    TABLE_FLAG_GCD = 0x80,                /**< Show GCD table */
+    TABLE_FLAG_LCM = 0x100,               /**< Show LCM table */
+    TABLE_FLAG_REMAINDER = 0x200,         /**< Show remainder table */
     TABLE_FLAG_ALL = 0x07                 /**< Show all tables */
 } table_flag_t;
 
@@ -45,6 +68,16 @@ typedef struct
     const char *message;             /**< The corresponding error message */
 } cli_error_t;
 
+/**
+ * @brief Output declared with --out
+ */
+typedef struct
+{
+    output_format_t format;          /**< Number format (decimal, hex, binary) */
+    const record_writer_t *writer;   /**< Record writer, or NULL for the padded layout */
+    const char *path;                /**< File to write, or NULL for stdout */
+} output_spec_t;
+
 /**
  * @brief Program options structure
  */
@@ -54,6 +87,39 @@ typedef struct
     int max_value;                   /**< Maximum value for rows and columns */
     output_format_t format;          /**< Output format (decimal, hex) */
     table_flag_t tables;             /**< Tables to display */
+    bool big_power;                  /**< Compute the power table exactly */
+    uint64_t modulus;                /**< Modulus for modular tables (0 = unset) */
+    const char *plugin_path;         /**< Shared object for the plugin table */
+    const char *plugin_op;           /**< Plugin operation name */
+    const char *expression;          /**< Expression over r and c for -e */
+    bool browse;                     /**< Browse the table interactively */
+    bool triangle;                   /**< Print only the upper triangle */
+    const record_writer_t *writer;   /**< Record writer for -F, or NULL */
+    bool async;                      /**< Write output asynchronously */
+    async_backend_t async_backend;   /**< Asynchronous writer backend */
+    int async_buffers;               /**< Number of output buffers */
+    int async_buffer_kib;            /**< Size of each output buffer in KiB */
+    bool async_stats;                /**< Report writer queue statistics */
+    bool no_splice;                  /**< Do not vmsplice() into a piped stdout */
+    bool stats;                      /**< Report pipeline stage waits */
+    int jobs;                        /**< Rendering threads for -j (1 = serial) */
+    const char *checkpoint_path;     /**< Checkpoint file for --checkpoint, or NULL */
+    bool resume;                     /**< Continue from the checkpoint */
+    int shard_index;                 /**< Shard to print for --shard i/N */
+    int shard_count;                 /**< Number of shards (1 = unsharded) */
+    bool shard_offsets;              /**< Print the byte range of every shard */
+    bool find;                       /**< Look up find_value instead of printing */
+    uint64_t find_value;             /**< Value for --find */
+    const char *find_path;           /**< File of values for --find-file, or NULL */
+    bool aggregate;                  /**< Print aggregate_kind instead of the tables */
+    agg_kind_t aggregate_kind;       /**< Reduction for --agg */
+    bool range_sum;                  /**< Print the sum of range instead of the tables */
+    agg_rect_t range;                /**< Cells summed by --range-sum */
+    int precision;                   /**< Division decimals, DECIMAL_SHORTEST, or 0 for integers */
+    output_spec_t outputs[TABLE_MAX_SINKS]; /**< Outputs declared with --out */
+    int output_count;                /**< Number of outputs (0 = the usual single output) */
+    bool compact;                    /**< Size each column to its widest cell */
+    const char *trace_path;          /**< Trace file for --trace, or NULL */
     bool show_help;                  /**< Flag to show help message */
 } program_options_t;
 
@@ -67,6 +133,28 @@ typedef struct
  */
 cli_error_t cli_parse_args(int argc, char *argv[], program_options_t *options);
 
+/**
+ * @brief Parse a string as an integer with error checking
+ *
+ * Keeps no state, so it may be used on any thread.
+ *
+ * @param str       String to parse
+ * @param result    Pointer to store the result
+ * @param min       Minimum allowed value
+ * @param max       Maximum allowed value
+ * @return          bool true if parsing was successful, false otherwise
+ */
+bool cli_parse_integer(const char *str, int *result, int min, int max);
+
+/**
+ * @brief Parse a string as an unsigned 64-bit integer with error checking
+ *
+ * @param str       String to parse
+ * @param result    Pointer to store the result
+ * @return          bool true if parsing was successful, false otherwise
+ */
+bool cli_parse_uint64(const char *str, uint64_t *result);
+
 /**
  * @brief Print usage information for the program
  *
@@ -0,0 +1,62 @@
+/**
+ * @file timestable_decimal.h
+ * @brief Decimal text of fractional quotients without printf()
+ *
+ * Fixed-point quotients are computed by scaled integer division, so every
+ * printed digit is exact. Shortest quotients print the double nearest to
+ * the quotient with the fewest digits that read back as the same double,
+ * found Ryu-style from the exact bounds of its rounding interval.
+ */
+
+#ifndef TIMESTABLE_DECIMAL_H
+#define TIMESTABLE_DECIMAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Most fraction digits of decimal_fixed()
+ */
+#define DECIMAL_MAX_DIGITS 18
+
+/**
+ * @brief Precision selecting decimal_shortest() instead of a digit count
+ */
+#define DECIMAL_SHORTEST (-1)
+
+/**
+ * @brief Most significant digits of decimal_shortest()
+ */
+#define DECIMAL_SHORTEST_DIGITS 17
+
+/**
+ * @brief Characters needed by either function, for any supported value
+ */
+#define DECIMAL_TEXT_SIZE 32
+
+/**
+ * @brief Render numerator ÷ denominator with a fixed number of fraction digits
+ *
+ * The last digit is rounded to nearest, halves up.
+ *
+ * @param numerator    Dividend
+ * @param denominator  Divisor (at least 1)
+ * @param digits       Fraction digits (0 to DECIMAL_MAX_DIGITS)
+ * @param end          One past the last byte of the destination
+ * @return             size_t Number of characters written before end
+ */
+size_t decimal_fixed(uint32_t numerator, uint32_t denominator, int digits, char *end);
+
+/**
+ * @brief Render the shortest decimal that reads back as a double
+ *
+ * Among the shortest candidates the one nearest to value is chosen (ties
+ * to even), as Ryu does. The text is positional, never in exponent form.
+ *
+ * @param value  Value to render (0, or 2^-32 to 2^60)
+ * @param end    One past the last byte of the destination
+ * @return       size_t Number of characters written before end
+ */
+size_t decimal_shortest(double value, char *end);
+
+#endif /* TIMESTABLE_DECIMAL_H */
@@ -0,0 +1,154 @@
+/**
+ * @file timestable_expression.h
+ * @brief User expression operations compiled to register bytecode
+ *
+ * Expressions over the row value r and column value c use C syntax and
+ * precedence for + - * / % & | ^ << >> and unary - ~. They are compiled
+ * once into a register bytecode: constant subexpressions are folded, and
+ * subexpressions that do not depend on c are hoisted into a scalar program
+ * run once per row. The remaining vector program executes each instruction
+ * across a whole run of columns, so dispatch is paid per instruction per
+ * row rather than per cell.
+ *
+ * Arithmetic is 64-bit two's complement with wrap-around. Division and
+ * remainder by zero yield 0, and shift counts are taken modulo 64.
+ */
+
+#ifndef TIMESTABLE_EXPRESSION_H
+#define TIMESTABLE_EXPRESSION_H
+
+#include <stdint.h>
+#include "timestable_operations.h"
+
+/**
+ * @brief Limits of a compiled expression
+ */
+#define EXPR_MAX_NODES      128   /**< Syntax tree nodes after folding */
+#define EXPR_MAX_REGISTERS  8     /**< Vector registers (nesting depth) */
+#define EXPR_MAX_DEPTH      256   /**< Nested parentheses and unary operators */
+
+/**
+ * @brief Bytecode operation codes
+ */
+typedef enum
+{
+    EXPR_OP_ROW = 0,                 /**< dst = r (scalar) */
+    EXPR_OP_CONSTANT,                /**< dst = immediate (scalar) */
+    EXPR_OP_COLUMN,                  /**< dst[i] = c + i (vector) */
+    EXPR_OP_BROADCAST,               /**< dst[i] = scalar a (vector) */
+    EXPR_OP_NEGATE,                  /**< dst = -a */
+    EXPR_OP_NOT,                     /**< dst = ~a */
+    EXPR_OP_ADD,                     /**< dst = a + b */
+    EXPR_OP_SUBTRACT,                /**< dst = a - b */
+    EXPR_OP_MULTIPLY,                /**< dst = a * b */
+    EXPR_OP_DIVIDE,                  /**< dst = a / b (0 when b is 0) */
+    EXPR_OP_REMAINDER,               /**< dst = a % b (0 when b is 0) */
+    EXPR_OP_AND,                     /**< dst = a & b */
+    EXPR_OP_OR,                      /**< dst = a | b */
+    EXPR_OP_XOR,                     /**< dst = a ^ b */
+    EXPR_OP_SHIFT_LEFT,              /**< dst = a << (b mod 64) */
+    EXPR_OP_SHIFT_RIGHT              /**< dst = a >> (b mod 64), arithmetic */
+} expr_opcode_t;
+
+/**
+ * @brief One bytecode instruction
+ *
+ * In the vector program a and b name vector registers unless the matching
+ * *_scalar flag is set, in which case they name slots of the scalar program.
+ */
+typedef struct
+{
+    uint8_t opcode;                  /**< expr_opcode_t */
+    uint8_t dst;                     /**< Destination register or slot */
+    uint8_t a;                       /**< First operand */
+    uint8_t b;                       /**< Second operand */
+    bool a_scalar;                   /**< a is a scalar slot */
+    bool b_scalar;                   /**< b is a scalar slot */
+    int64_t immediate;               /**< Value for EXPR_OP_CONSTANT */
+} expr_instruction_t;
+
+/**
+ * @brief A compiled expression
+ */
+typedef struct
+{
+    expr_instruction_t scalar[EXPR_MAX_NODES];   /**< Run once per row */
+    expr_instruction_t vector[EXPR_MAX_NODES];   /**< Run across each row */
+    int scalar_count;                            /**< Instructions in scalar */
+    int vector_count;                            /**< Instructions in vector */
+    bool has_bound;                              /**< Set by expr_compute_bound() */
+    int bound_min;                               /**< Minimum value of the bound's range */
+    int bound_max;                               /**< Maximum value of the bound's range */
+    uint64_t bound;                              /**< Largest magnitude over that range */
+} expr_program_t;
+
+/**
+ * @brief Error codes for expression compilation
+ */
+typedef enum
+{
+    EXPR_SUCCESS = 0,                /**< Expression compiled successfully */
+    EXPR_ERROR_SYNTAX,               /**< Unexpected or missing token */
+    EXPR_ERROR_NUMBER,               /**< Number literal out of range */
+    EXPR_ERROR_TOO_COMPLEX           /**< Node, register or nesting limit exceeded */
+} expr_error_code_t;
+
+/**
+ * @brief Structure to hold expression compilation error information
+ */
+typedef struct
+{
+    expr_error_code_t code;          /**< The error code */
+    const char *message;             /**< The corresponding error message */
+    int position;                    /**< Offset of the offending character */
+} expr_error_t;
+
+/**
+ * @brief Compile an expression over r and c
+ *
+ * @param text     Expression source
+ * @param program  Pointer to the program to populate
+ * @return         expr_error_t structure with error code, message and position
+ */
+expr_error_t expr_compile(const char *text, expr_program_t *program);
+
+/**
+ * @brief Row kernel evaluating a compiled expression
+ *
+ * Results are 64-bit two's complement values (see row_operation_t.is_signed).
+ *
+ * @param context Pointer to an expr_program_t
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void expr_row(const void *context, int row, int column, int count, uint64_t *values);
+
+/**
+ * @brief Evaluate the largest magnitude of an expression table once
+ *
+ * Expressions have no closed-form bound, so every row of the table is
+ * evaluated and the result stored in the program for expr_value_bound().
+ * Call it after expr_compile() for the range that will be printed.
+ *
+ * @param program Compiled expression
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ */
+void expr_compute_bound(expr_program_t *program, int min_value, int max_value);
+
+/**
+ * @brief Largest magnitude produced by an expression over the table
+ *
+ * Returns the bound stored by expr_compute_bound() for the same range, and
+ * evaluates every row of any other range.
+ *
+ * @param context Pointer to an expr_program_t
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t Largest absolute cell value
+ */
+uint64_t expr_value_bound(const void *context, int min_value, int max_value);
+
+#endif /* TIMESTABLE_EXPRESSION_H */
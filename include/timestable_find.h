@@ -0,0 +1,103 @@
+/**
+ * @file timestable_find.h
+ * @brief Inverse lookup: the cells of a table holding a given value
+ *
+ * Cells are found by arithmetic instead of generating the table: the
+ * divisors of the value for multiplication, one interval of rows per
+ * column for division, and integer roots for powers. Values are taken
+ * mathematically, as 64-bit products and powers, so cells that would
+ * overflow an int in the printed table are found by their true value.
+ */
+
+#ifndef TIMESTABLE_FIND_H
+#define TIMESTABLE_FIND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Largest maximum value accepted for lookups (sieve size)
+ */
+#define FIND_MAX_VALUE 10000000
+
+/**
+ * @brief Operations that can be searched
+ */
+typedef enum
+{
+    FIND_MULTIPLY,                   /**< row × column */
+    FIND_DIVIDE,                     /**< row ÷ column, truncated; column 0 never matches */
+    FIND_POWER                       /**< row ^ column, with 0 ^ 0 = 1 */
+} find_operation_t;
+
+/**
+ * @brief Rectangle of matching cells
+ */
+typedef struct
+{
+    int first_row;                   /**< First matching row */
+    int last_row;                    /**< Last matching row */
+    int first_column;                /**< First matching column */
+    int last_column;                 /**< Last matching column */
+} find_range_t;
+
+/**
+ * @brief Function receiving each group of matching cells
+ *
+ * @param context  Data passed to find_cells()
+ * @param range    Matching cells
+ * @return         bool true to continue, false to stop the search
+ */
+typedef bool (*find_visit_t)(void *context, const find_range_t *range);
+
+/**
+ * @brief Lookup index for one range of rows and columns
+ *
+ * Holds the smallest prime factor of every number up to max_value, so
+ * values up to max_value factor by table lookups alone and larger ones
+ * (up to max_value squared) by trial division with the listed primes.
+ */
+typedef struct
+{
+    int min_value;                   /**< Minimum value for rows and columns */
+    int max_value;                   /**< Maximum value for rows and columns */
+    uint32_t *smallest_factor;       /**< Smallest prime factor of 0..max_value */
+    uint32_t *primes;                /**< Primes up to max_value in order */
+    size_t prime_count;              /**< Number of primes */
+} find_index_t;
+
+/**
+ * @brief Build the lookup index for a table range
+ *
+ * @param index      Index to initialize
+ * @param min_value  Minimum value for rows and columns
+ * @param max_value  Maximum value for rows and columns (at most FIND_MAX_VALUE)
+ * @return           bool true on success, false if allocation failed
+ */
+bool find_index_init(find_index_t *index, int min_value, int max_value);
+
+/**
+ * @brief Release a lookup index
+ *
+ * @param index Index to release
+ */
+void find_index_free(find_index_t *index);
+
+/**
+ * @brief Report every cell of a table holding a value
+ *
+ * Groups of cells sharing a row or a column are reported as one range.
+ *
+ * @param index      Lookup index of the table range
+ * @param operation  Operation of the table
+ * @param value      Value to look for
+ * @param visit      Function receiving each group of matching cells
+ * @param context    Data passed to visit
+ * @return           bool true if the search finished, false if visit
+ *                   stopped it or memory ran out
+ */
+bool find_cells(const find_index_t *index, find_operation_t operation, uint64_t value,
+                find_visit_t visit, void *context);
+
+#endif /* TIMESTABLE_FIND_H */
@@ -8,7 +8,17 @@
 #ifndef TIMESTABLE_FORMATTER_H
 #define TIMESTABLE_FORMATTER_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include "timestable_operations.h"
+#include "timestable_output.h"
+#include "timestable_pipeline.h"
+#include "timestable_scheduler.h"
+
+/**
+ * @brief Smallest table printed with the pipeline by print_table()
+ */
+#define PIPELINE_MIN_ROWS 32
 
 /**
  * @brief Output formats for table values
@@ -16,12 +26,72 @@
 typedef enum
 {
     FORMAT_DECIMAL = 0,     /**< Decimal (base 10) output */
-    FORMAT_HEX              /**< Hexadecimal (base 16) output */
+    FORMAT_HEX,             /**< Hexadecimal (base 16) output */
+    FORMAT_BINARY           /**< Raw native-endian 64-bit cell values */
 } output_format_t;
 
+/**
+ * @brief Rendered text of one field of a record
+ */
+typedef struct
+{
+    const char *text;       /**< Field text (not NUL terminated) */
+    size_t length;          /**< Length of the text */
+    bool is_number;         /**< Text is a bare decimal number */
+} text_span_t;
+
+/**
+ * @brief Writer for unpadded record-oriented output (-F)
+ *
+ * Writers receive whole rows of already rendered fields and append them to
+ * an output buffer, so no per-cell printf() or indirect call is made.
+ */
+typedef struct
+{
+    const char *name;       /**< Name selecting the writer with -F */
+
+    /**
+     * @brief Write what precedes the rows of a table
+     *
+     * @param output   Buffer to append to
+     * @param title    Title of the table
+     * @param columns  Column labels
+     * @param count    Number of columns
+     * @return         bool true on success, false on a write error
+     */
+    bool (*begin)(output_buffer_t *output, const char *title,
+                  const text_span_t *columns, int count);
+
+    /**
+     * @brief Write one row of a table
+     *
+     * @param output   Buffer to append to
+     * @param label    Row label
+     * @param columns  Column labels
+     * @param cells    Cell values
+     * @param count    Number of columns
+     * @return         bool true on success, false on a write error
+     */
+    bool (*row)(output_buffer_t *output, const text_span_t *label,
+                const text_span_t *columns, const text_span_t *cells, int count);
+} record_writer_t;
+
+/**
+ * @brief Look up a record writer by name
+ *
+ * @param name  Writer name (csv, tsv, jsonl or md)
+ * @return      const record_writer_t* The writer, or NULL if unknown
+ */
+const record_writer_t *record_writer_find(const char *name);
+
 /**
  * @brief Print a formatted table using the specified operation
  *
+ * Tables of symmetric operations (see operation_is_symmetric()) compute
+ * and format each off-diagonal cell once and mirror the text. Other tables
+ * of at least PIPELINE_MIN_ROWS rows are printed with
+ * print_table_pipelined().
+ *
  * @param min_value  Minimum value for rows and columns
  * @param max_value  Maximum value for rows and columns
  * @param operation  Function pointer to the operation to perform
@@ -34,4 +104,339 @@ void print_table(int min_value,
                  const char *title,
                  output_format_t format);
 
+/**
+ * @brief Print a formatted table with compute, format and write overlapped
+ *
+ * One thread computes the raw cells of each row and a second renders them
+ * as text, while the calling thread writes the text out. The stages are
+ * linked by lock-free rings of PIPELINE_RING_SLOTS rows, so a slow stage
+ * holds the others back instead of letting rows pile up. Stage waits are
+ * added to the statistics set with pipeline_set_stats(). The output is
+ * the same as that of print_table().
+ *
+ * @param min_value  Minimum value for rows and columns
+ * @param max_value  Maximum value for rows and columns
+ * @param operation  Function pointer to the operation to perform
+ * @param title      Title to display for the table
+ * @param format     Output format to use (decimal, hex)
+ * @return           bool true if the table was printed (or a write error
+ *                   stopped it), false if the pipeline could not be set up
+ *                   and nothing was printed
+ */
+bool print_table_pipelined(int min_value,
+                           int max_value,
+                           TableOperation operation,
+                           const char *title,
+                           output_format_t format);
+
+/**
+ * @brief Calculate the cell width of a table printed with print_big_power_table()
+ *
+ * @param max_value  Maximum value for rows and columns
+ * @param format     Output format to use (decimal, hex)
+ * @return           size_t Width of every cell, including padding, or 0 for
+ *                   binary output or on allocation failure
+ */
+size_t big_power_cell_width(int max_value, output_format_t format);
+
+/**
+ * @brief Print the power table using arbitrary-precision arithmetic
+ *
+ * Rows are computed incrementally (row^c = row^(c-1) * row) into a single
+ * reused big integer and streamed out one row at a time, so values are
+ * exact for any exponent and memory stays bounded by the longest row.
+ *
+ * @param min_value  Minimum value for rows and columns
+ * @param max_value  Maximum value for rows and columns
+ * @param title      Title to display for the table
+ * @param format     Output format to use (decimal, hex)
+ * @return           bool true on success, false on allocation or write failure
+ */
+bool print_big_power_table(int min_value,
+                           int max_value,
+                           const char *title,
+                           output_format_t format);
+
+/**
+ * @brief Calculate the cell width of a table printed with print_fraction_table()
+ *
+ * @param max_value  Maximum value for rows and columns
+ * @param precision  Fraction digits (1 to DECIMAL_MAX_DIGITS) or DECIMAL_SHORTEST
+ * @return           size_t Width of every cell, including padding
+ */
+size_t fraction_cell_width(int max_value, int precision);
+
+/**
+ * @brief Print the division table with fractional quotients
+ *
+ * Cells hold row ÷ column rounded to a fixed number of decimals, or the
+ * shortest decimal of the double quotient. Column 0 stays undefined. The
+ * cell width follows from the precision and the largest row.
+ *
+ * @param min_value  Minimum value for rows and columns
+ * @param max_value  Maximum value for rows and columns
+ * @param title      Title to display for the table
+ * @param precision  Fraction digits (1 to DECIMAL_MAX_DIGITS) or DECIMAL_SHORTEST
+ * @return           bool true on success, false on allocation or write failure
+ */
+bool print_fraction_table(int min_value,
+                          int max_value,
+                          const char *title,
+                          int precision);
+
+/**
+ * @brief Print a formatted table using a row-at-a-time operation
+ *
+ * Cells are computed a row at a time by the operation's batch kernel and
+ * rendered into a large output buffer. Binary output writes each row's
+ * values directly, without title, header or row labels. Symmetric
+ * operations compute and format each off-diagonal cell once.
+ *
+ * @param min_value  Minimum value for rows and columns
+ * @param max_value  Maximum value for rows and columns
+ * @param operation  Row operation computing the cell values
+ * @param title      Title to display for the table
+ * @param format     Output format to use (decimal, hex, binary)
+ * @return           bool true on success, false on allocation or write failure
+ */
+bool print_row_table(int min_value,
+                     int max_value,
+                     const row_operation_t *operation,
+                     const char *title,
+                     output_format_t format);
+
+/**
+ * @brief Print a table with each column only as wide as its widest cell
+ *
+ * A pre-pass finds the width of every column without formatting a cell;
+ * for products and quotients it computes only the last row. The row
+ * labels, header and separator line follow the same widths, and there is
+ * no minimum cell width, so the text is as narrow as the values allow.
+ *
+ * @param min_value      Minimum value for rows and columns
+ * @param max_value      Maximum value for rows and columns
+ * @param operation      Per-cell operation, or NULL
+ * @param row_operation  Row operation if operation is NULL
+ * @param title          Title to display for the table
+ * @param format         Output format to use (decimal, hex)
+ * @return               bool true on success, false on allocation or write failure
+ */
+bool print_compact_table(int min_value,
+                         int max_value,
+                         TableOperation operation,
+                         const row_operation_t *row_operation,
+                         const char *title,
+                         output_format_t format);
+
+/**
+ * @brief Layout of a table rendered row by row into caller buffers
+ *
+ * The layout is that of print_table() and print_row_table(). It holds no
+ * buffers or caches, so any number of layouts may be used on different
+ * threads at once.
+ */
+typedef struct
+{
+    int min_value;                          /**< Minimum value for rows and columns */
+    int max_value;                          /**< Maximum value for rows and columns */
+    TableOperation operation;               /**< Per-cell operation, or NULL */
+    const row_operation_t *row_operation;   /**< Row operation if operation is NULL */
+    output_format_t format;                 /**< Output format (decimal, hex) */
+    size_t cell_width;                      /**< Width of every cell, including padding */
+} table_layout_t;
+
+/**
+ * @brief Find the layout of a table
+ *
+ * @param layout         Layout to initialize
+ * @param min_value      Minimum value for rows and columns
+ * @param max_value      Maximum value for rows and columns
+ * @param operation      Per-cell operation, or NULL
+ * @param row_operation  Row operation if operation is NULL (kept by reference)
+ * @param title          Title of the table, used to recognise the power table
+ * @param format         Output format to use (decimal, hex)
+ */
+void table_layout_init(table_layout_t *layout,
+                       int min_value,
+                       int max_value,
+                       TableOperation operation,
+                       const row_operation_t *row_operation,
+                       const char *title,
+                       output_format_t format);
+
+/**
+ * @brief Render the column header row and the separator line beneath it
+ *
+ * Like snprintf(), the text is written only if it fits with its
+ * terminator, and the length it needs is returned either way.
+ *
+ * @param layout  Layout of the table
+ * @param buffer  Destination, or NULL if size is 0
+ * @param size    Size of the destination
+ * @return        size_t Length of the text, without the terminator
+ */
+size_t table_layout_header(const table_layout_t *layout, char *buffer, size_t size);
+
+/**
+ * @brief Render one row of a table, including its newline
+ *
+ * Like snprintf(), the text is written only if it fits with its
+ * terminator, and the length it needs is returned either way.
+ *
+ * @param layout  Layout of the table
+ * @param row     Row value
+ * @param cells   Cells of the row if the layout has a per-cell operation
+ * @param values  Values of the row if it has a row operation
+ * @param buffer  Destination, or NULL if size is 0
+ * @param size    Size of the destination
+ * @return        size_t Length of the text, without the terminator
+ */
+size_t table_layout_row(const table_layout_t *layout, int row, const cell_value_t *cells,
+                        const uint64_t *values, char *buffer, size_t size);
+
+/**
+ * @brief Print the upper triangle of a symmetric table
+ *
+ * Only the cells on and above the diagonal are computed and written; the
+ * cells below it are left blank so the header and columns stay aligned
+ * with the full layout. Exactly one of operation and row_operation is
+ * used: operation when it is not NULL, otherwise row_operation.
+ *
+ * @param min_value      Minimum value for rows and columns
+ * @param max_value      Maximum value for rows and columns
+ * @param operation      Per-cell operation, or NULL
+ * @param row_operation  Row operation if operation is NULL
+ * @param title          Title to display for the table
+ * @param format         Output format to use (decimal, hex)
+ * @return               bool true on success, false if the operation is not
+ *                       symmetric, the format is binary, or on allocation or
+ *                       write failure
+ */
+bool print_triangle_table(int min_value,
+                          int max_value,
+                          TableOperation operation,
+                          const row_operation_t *row_operation,
+                          const char *title,
+                          output_format_t format);
+
+/**
+ * @brief Write a table as unpadded records
+ *
+ * Exactly one of operation and row_operation is used: operation when it is
+ * not NULL, otherwise row_operation.
+ *
+ * @param min_value      Minimum value for rows and columns
+ * @param max_value      Maximum value for rows and columns
+ * @param operation      Per-cell operation, or NULL
+ * @param row_operation  Row operation if operation is NULL
+ * @param title          Title of the table
+ * @param format         Number format to use (decimal, hex)
+ * @param writer         Record writer producing the output
+ * @return               bool true on success, false if the format is binary,
+ *                       or on allocation or write failure
+ */
+bool print_records(int min_value,
+                   int max_value,
+                   TableOperation operation,
+                   const row_operation_t *row_operation,
+                   const char *title,
+                   output_format_t format,
+                   const record_writer_t *writer);
+
+/**
+ * @brief Most sinks of print_table_sinks()
+ */
+#define TABLE_MAX_SINKS 8
+
+/**
+ * @brief One output of print_table_sinks()
+ */
+typedef struct
+{
+    output_format_t format;                 /**< Number format (decimal, hex, binary) */
+    const record_writer_t *writer;          /**< Record writer, or NULL for the padded layout */
+    FILE *stream;                           /**< Stream to write to */
+} table_sink_t;
+
+/**
+ * @brief Write one table to several sinks, computing each row once
+ *
+ * Each row is computed a single time, with the operation's generator or
+ * batch kernel, and then formatted for every sink into the sink's own
+ * output buffer. A sink gets the bytes print_table() or print_row_table()
+ * (padded layout), print_records() (writer set) or binary output would
+ * write for its format. Exactly one of operation and row_operation is
+ * used: operation when it is not NULL, otherwise row_operation.
+ *
+ * @param min_value      Minimum value for rows and columns
+ * @param max_value      Maximum value for rows and columns
+ * @param operation      Per-cell operation, or NULL
+ * @param row_operation  Row operation if operation is NULL
+ * @param title          Title of the table
+ * @param sinks          Outputs to write, in order
+ * @param count          Number of sinks (at most TABLE_MAX_SINKS)
+ * @return               bool true on success, false on allocation or write failure
+ */
+bool print_table_sinks(int min_value,
+                       int max_value,
+                       TableOperation operation,
+                       const row_operation_t *row_operation,
+                       const char *title,
+                       const table_sink_t *sinks,
+                       size_t count);
+
+/**
+ * @brief Check whether two sinks write the same file through different streams
+ *
+ * Files are compared by device and inode, so a relative and an absolute
+ * path, a symbolic link or /dev/stdout all name the file they reach.
+ * Sinks sharing one stream write in turn and are not an alias.
+ *
+ * @param sinks  Outputs to check
+ * @param count  Number of sinks
+ * @return       bool true if two streams reach the same file
+ */
+bool table_sinks_alias(const table_sink_t *sinks, size_t count);
+
+/**
+ * @brief Rows rendered by one task of print_tables_parallel()
+ */
+#define PARALLEL_BLOCK_ROWS 8
+
+/**
+ * @brief One table printed by print_tables_parallel()
+ *
+ * Exactly one of operation and row_operation is used: operation when it is
+ * not NULL, otherwise row_operation.
+ */
+typedef struct
+{
+    int min_value;                          /**< Minimum value for rows and columns */
+    int max_value;                          /**< Maximum value for rows and columns */
+    const char *title;                      /**< Title to display for the table */
+    output_format_t format;                 /**< Output format (decimal, hex) */
+    TableOperation operation;               /**< Per-cell operation, or NULL */
+    const row_operation_t *row_operation;   /**< Row operation if operation is NULL */
+} table_job_t;
+
+/**
+ * @brief Print several tables with their rows rendered on a pool of threads
+ *
+ * Every table is split into blocks of PARALLEL_BLOCK_ROWS rows, and the
+ * blocks of all tables are rendered as one batch by the work-stealing
+ * scheduler. The rendered blocks are then written in table and row order,
+ * so the output is the same as printing the tables one after another with
+ * print_table() or print_row_table().
+ *
+ * @param tables   Tables to print, in output order
+ * @param count    Number of tables
+ * @param workers  Number of rendering threads, including the caller
+ * @param stats    Scheduler counters to fill in, or NULL
+ * @return         bool true on success, false on allocation or write failure
+ */
+bool print_tables_parallel(const table_job_t *tables,
+                           size_t count,
+                           int workers,
+                           scheduler_stats_t *stats);
+
 #endif /* TIMESTABLE_FORMATTER_H */
\ No newline at end of file
@@ -10,6 +10,7 @@
 #define TIMESTABLE_OPERATIONS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /**
  * @brief String constants for table operation titles
@@ -17,6 +18,18 @@
 #define MULT_TABLE_TITLE   "Multiplication Table (row × column)"
 #define DIV_TABLE_TITLE    "Division Table (row ÷ column)"
 #define POWER_TABLE_TITLE  "Power Table (row ^ column)"
+#define MOD_MULT_TABLE_TITLE  "Modular Multiplication Table (row × column mod m)"
+#define MOD_POWER_TABLE_TITLE "Modular Power Table (row ^ column mod m)"
+#define GCD_TABLE_TITLE    "GCD Table (gcd(row, column))"
+#define LCM_TABLE_TITLE    "LCM Table (lcm(row, column))"
+#define REMAINDER_TABLE_TITLE "Remainder Table (row mod column)"
+
+/**
+ * @brief Row values standing for the UDF and OVF markers of row operations
+ *        with has_markers set
+ */
+#define ROW_VALUE_UNDEFINED UINT64_MAX
+#define ROW_VALUE_OVERFLOW  (UINT64_MAX - 1)
 
 /**
  * @brief Structure to hold cell value (either numeric or string)
@@ -66,4 +79,356 @@ void divide(int row, int column, cell_value_t *result);
  */
 void power(int row, int column, cell_value_t *result);
 
+/**
+ * @brief Check whether a table operation is commutative
+ *
+ * Tables of commutative operations are symmetric about the diagonal, so
+ * only the cells on and above it need to be computed.
+ *
+ * @param operation Operation to check
+ * @return bool true if operation(r, c) == operation(c, r) for all cells
+ */
+bool operation_is_symmetric(TableOperation operation);
+
+/**
+ * @brief Lanes used by gen_fill() for the strided multiplication recurrence
+ */
+#define GEN_LANES 8
+
+/**
+ * @brief Incremental generator for the cells of one table row
+ *
+ * Consecutive cells of a multiplication row differ by a constant step and
+ * those of a power row by a constant factor, so after gen_init() each cell
+ * costs one add or one multiply instead of a full operation call. Values
+ * match the operation exactly: products wrap like int arithmetic, and
+ * powers that do not fit an int yield INT_MIN, as (int)pow() does on
+ * common platforms.
+ */
+typedef struct
+{
+    TableOperation operation;    /**< Operation being generated */
+    uint64_t value;              /**< Value of the next cell */
+    uint64_t step;               /**< Added (multiply) or multiplied (power) per cell */
+} table_generator_t;
+
+/**
+ * @brief Start generating a row of an operation
+ *
+ * @param generator Generator to initialize
+ * @param operation Operation whose row is generated
+ * @param row Row value
+ * @param col_begin First column value (at least 0)
+ * @return bool true if the operation has an incremental form, false if the
+ *         caller must call the operation for each cell
+ */
+bool gen_init(table_generator_t *generator, TableOperation operation, int row, int col_begin);
+
+/**
+ * @brief Produce the next cell of a generated row
+ *
+ * @param generator Generator started with gen_init()
+ * @return int Value of the cell, after which the column advances by one
+ */
+int gen_next(table_generator_t *generator);
+
+/**
+ * @brief Produce the next count cells of a generated row
+ *
+ * Multiplication rows run GEN_LANES independent recurrences, each adding
+ * GEN_LANES × row per step, so the loop has no carried dependency between
+ * neighbouring cells and can be vectorized.
+ *
+ * @param generator Generator started with gen_init()
+ * @param count Number of cells to produce
+ * @param values Array of count entries to store the values in
+ */
+void gen_fill(table_generator_t *generator, int count, int *values);
+
+/**
+ * @brief Bytes per cell of the narrowest unsigned type holding a table
+ *
+ * The all-ones value of each width is reserved for undefined cells.
+ */
+typedef enum
+{
+    VALUE_WIDTH_NONE = 0,        /**< No narrow type fits; use cell_value_t */
+    VALUE_WIDTH_8    = 1,        /**< uint8_t lanes */
+    VALUE_WIDTH_16   = 2,        /**< uint16_t lanes */
+    VALUE_WIDTH_32   = 4         /**< uint32_t lanes */
+} value_width_t;
+
+/**
+ * @brief Lane value of an undefined cell (every bit set)
+ */
+#define LANE_UNDEFINED(type) ((type)~(type)0)
+
+/**
+ * @brief Choose the lane width of a table from the exact bounds of its cells
+ *
+ * @param operation Operation of the table
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return value_width_t Narrowest width whose all-ones value exceeds every
+ *         cell, or VALUE_WIDTH_NONE for negative ranges, cells above
+ *         INT_MAX and operations without a lane kernel
+ */
+value_width_t table_value_width(TableOperation operation, int min_value, int max_value);
+
+/**
+ * @brief Compute a run of cells from one row into lanes of a given width
+ *
+ * Each width has its own loop over its own element type, so narrow tables
+ * are computed on 8- or 16-bit lanes. Undefined cells are
+ * LANE_UNDEFINED() of the lane type.
+ *
+ * @param operation Operation of the table
+ * @param width Width from table_value_width() for the table (not NONE)
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param lanes Array of count lanes of the width to store the values in
+ */
+void table_fill_lanes(TableOperation operation, value_width_t width,
+                      int row, int column, int count, void *lanes);
+
+/**
+ * @brief Batch kernel computing a run of cells from one row
+ *
+ * @param context Operation-specific data (may be NULL)
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+typedef void (*RowOperation)(const void *context, int row, int column,
+                             int count, uint64_t *values);
+
+/**
+ * @brief Function returning the largest value an operation can produce
+ *
+ * @param context Operation-specific data (may be NULL)
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t Upper bound on every cell in the table
+ */
+typedef uint64_t (*RowValueBound)(const void *context, int min_value, int max_value);
+
+/**
+ * @brief Row-at-a-time table operation
+ *
+ * Computes whole rows per call, so the per-cell cost is plain arithmetic
+ * rather than a function call through a TableOperation pointer. Signed
+ * operations store two's complement values, and their bound is the
+ * largest magnitude.
+ */
+typedef struct
+{
+    RowOperation kernel;         /**< Batch kernel filling row values */
+    RowValueBound value_bound;   /**< Bound used for cell width calculation */
+    const void *context;         /**< Data passed to kernel and value_bound */
+    bool is_signed;              /**< Values are two's complement int64_t */
+    bool is_symmetric;           /**< Commutative: op(r, c) == op(c, r) */
+    bool has_markers;            /**< ROW_VALUE_UNDEFINED and ROW_VALUE_OVERFLOW are markers */
+} row_operation_t;
+
+/**
+ * @brief Marker text of a row operation value
+ *
+ * @param operation Row operation that produced the value
+ * @param value Cell value
+ * @return const char* "UDF" or "OVF" for a marker value, otherwise NULL
+ */
+const char *row_value_marker(const row_operation_t *operation, uint64_t value);
+
+/**
+ * @brief Describe a per-cell operation as a row operation on 64-bit values
+ *
+ * The kernels are exact for any int row and column: products need no more
+ * than 62 bits, division by zero is ROW_VALUE_UNDEFINED, and powers of
+ * 2^64 - 2 or more are ROW_VALUE_OVERFLOW instead of wrapping.
+ *
+ * @param operation multiply, divide or power
+ * @param row_operation Filled with the kernel, bound and attributes
+ * @return bool true on success, false if operation has no 64-bit kernel
+ */
+bool table_row_operation(TableOperation operation, row_operation_t *row_operation);
+
+/**
+ * @brief Modulus for the modular tables
+ */
+typedef struct
+{
+    uint64_t modulus;            /**< Modulus m, at least 1 */
+} modulus_t;
+
+/**
+ * @brief Modular multiplication kernel ((row × column) mod m)
+ *
+ * Each row is a running sum: the next cell adds row mod m and subtracts m
+ * at most once, so no per-cell division is needed.
+ *
+ * @param context Pointer to a modulus_t
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void mod_multiply_row(const void *context, int row, int column,
+                      int count, uint64_t *values);
+
+/**
+ * @brief Modular power kernel ((row ^ column) mod m)
+ *
+ * Each row is a running modular product. Multiplication by the fixed row
+ * value uses a per-row precomputed Barrett (Shoup) constant, replacing the
+ * per-cell division with a high multiply and one conditional subtraction.
+ *
+ * @param context Pointer to a modulus_t
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void mod_power_row(const void *context, int row, int column,
+                   int count, uint64_t *values);
+
+/**
+ * @brief Largest value of the modular multiplication table
+ *
+ * @param context Pointer to a modulus_t
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t The smaller of m - 1 and max_value²
+ */
+uint64_t mod_multiply_bound(const void *context, int min_value, int max_value);
+
+/**
+ * @brief Largest value of the modular power table
+ *
+ * @param context Pointer to a modulus_t
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t m - 1
+ */
+uint64_t mod_power_bound(const void *context, int min_value, int max_value);
+
+/**
+ * @brief Side of the memoized GCD tile
+ */
+#define GCD_TILE_SIDE 128
+
+/**
+ * @brief GCDs of all pairs below GCD_TILE_SIDE
+ */
+typedef struct
+{
+    uint8_t gcd[GCD_TILE_SIDE][GCD_TILE_SIDE]; /**< gcd(r, c) at [r][c] */
+} gcd_tile_t;
+
+/**
+ * @brief Fill a GCD tile
+ *
+ * Each entry is looked up from a smaller one with gcd(r, c) = gcd(c, r mod c),
+ * so the tile costs one division per pair.
+ *
+ * @param tile Tile to fill
+ */
+void gcd_tile_init(gcd_tile_t *tile);
+
+/**
+ * @brief GCD kernel (gcd(row, column), with gcd(0, 0) = 0)
+ *
+ * Cells inside the tile are looked up. The others use binary GCD: the
+ * power of two and odd part of the row are split off once per row, and
+ * each cell then subtracts and shifts by the trailing zero count, with no
+ * division.
+ *
+ * @param context Pointer to a gcd_tile_t, or NULL
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void gcd_row(const void *context, int row, int column, int count, uint64_t *values);
+
+/**
+ * @brief LCM kernel (lcm(row, column), with lcm(0, c) = 0)
+ *
+ * Divides the row by the GCDs of gcd_row() and multiplies with an
+ * overflow check; a product of 2^64 - 2 or more is ROW_VALUE_OVERFLOW.
+ *
+ * @param context Pointer to a gcd_tile_t, or NULL
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void lcm_row(const void *context, int row, int column, int count, uint64_t *values);
+
+/**
+ * @brief Columns with a precomputed reciprocal for remainder_row()
+ */
+#define REMAINDER_COLUMNS 4096
+
+/**
+ * @brief Reciprocals of the divisors of the remainder table
+ */
+typedef struct
+{
+    uint64_t reciprocal[REMAINDER_COLUMNS]; /**< floor((2^64 - 1) / c) + 1 at [c] */
+} remainder_divisors_t;
+
+/**
+ * @brief Precompute the reciprocals of the remainder table columns
+ *
+ * @param divisors Reciprocals to fill
+ */
+void remainder_divisors_init(remainder_divisors_t *divisors);
+
+/**
+ * @brief Remainder kernel (row mod column; column 0 is ROW_VALUE_UNDEFINED)
+ *
+ * Below REMAINDER_COLUMNS the remainder takes two multiplications with the
+ * column's reciprocal instead of a division, which is exact for 32-bit
+ * operands (Lemire's fastmod).
+ *
+ * @param context Pointer to a remainder_divisors_t
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void remainder_row(const void *context, int row, int column, int count, uint64_t *values);
+
+/**
+ * @brief Largest value of the GCD table
+ *
+ * @param context Ignored
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t max_value
+ */
+uint64_t gcd_bound(const void *context, int min_value, int max_value);
+
+/**
+ * @brief Largest value of the LCM table
+ *
+ * @param context Ignored
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t max_value²
+ */
+uint64_t lcm_bound(const void *context, int min_value, int max_value);
+
+/**
+ * @brief Largest value of the remainder table
+ *
+ * @param context Ignored
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t max_value
+ */
+uint64_t remainder_bound(const void *context, int min_value, int max_value);
+
 #endif /* TIMESTABLE_OPERATIONS_H */
\ No newline at end of file
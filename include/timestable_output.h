@@ -0,0 +1,161 @@
+/**
+ * @file timestable_output.h
+ * @brief Buffered output for rendered table rows
+ *
+ * Collects rendered bytes in a large caller-owned buffer and hands them to
+ * the underlying stream in bulk, so table bodies are not written one
+ * printf() call per cell.
+ */
+
+#ifndef TIMESTABLE_OUTPUT_H
+#define TIMESTABLE_OUTPUT_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "timestable_async.h"
+#include "timestable_checkpoint.h"
+
+/**
+ * @brief Default capacity of an output buffer in bytes
+ */
+#define OUTPUT_BUFFER_DEFAULT_SIZE (64 * 1024)
+
+/**
+ * @brief Buffer of rendered bytes waiting to be written
+ */
+typedef struct
+{
+    char *data;                      /**< Buffered bytes */
+    size_t length;                   /**< Number of bytes currently buffered */
+    size_t capacity;                 /**< Size of the data allocation */
+    FILE *stream;                    /**< Stream the buffer is flushed to */
+    async_writer_t *async;           /**< Asynchronous writer owning data, or NULL */
+} output_buffer_t;
+
+/**
+ * @brief Route output buffers on a stream through an asynchronous writer
+ *
+ * Buffers initialized on the stream afterwards render into the writer's
+ * buffers, and each full buffer is queued while rendering continues in the
+ * next one. Flushing drains the writer, so output written with stdio
+ * between tables stays in order.
+ *
+ * @param stream  Stream whose buffers use the writer
+ * @param writer  Writer opened on the stream's file descriptor, or NULL to
+ *                go back to synchronous writes
+ */
+void output_set_async_writer(FILE *stream, async_writer_t *writer);
+
+/**
+ * @brief Record checkpoints at row boundaries of output on a stream
+ *
+ * Renderers report each finished row with output_buffer_end_row(), and
+ * ask output_begin_rows() where to start, so a resumed run skips what the
+ * checkpoint says is already written.
+ *
+ * @param stream      Stream the checkpoint positions refer to
+ * @param checkpoint  Open checkpoint, or NULL to stop checkpointing
+ */
+void output_set_checkpoint(FILE *stream, checkpoint_t *checkpoint);
+
+/**
+ * @brief Render only a band of rows of the tables written to a stream
+ *
+ * The title and header belong to the band starting at the first row, so
+ * the outputs of consecutive bands concatenate into the whole table.
+ *
+ * @param stream     Stream whose tables are limited, or NULL for all rows
+ * @param first_row  First row of the band
+ * @param last_row   Last row of the band (first_row - 1 or less if empty)
+ */
+void output_set_row_band(FILE *stream, int first_row, int last_row);
+
+/**
+ * @brief Find which of a table's rows to render
+ *
+ * Narrows the rows to the band set with output_set_row_band() and takes
+ * up a pending checkpoint resume.
+ *
+ * @param stream     Stream the table is written to
+ * @param first_row  First row of the table; replaced by the first row to
+ *                   render
+ * @param last_row   Last row of the table; replaced by the last row to
+ *                   render
+ * @return           bool true if the title and header must be written,
+ *                   false if they are already in the output or belong to
+ *                   another band
+ */
+bool output_begin_rows(FILE *stream, int *first_row, int *last_row);
+
+/**
+ * @brief Record a checkpoint at the current end of a stream's output
+ *
+ * Flushes stdio and any asynchronous writer first. Does nothing unless a
+ * checkpoint is set for the stream.
+ *
+ * @param stream    Stream to checkpoint
+ * @param next_row  First row of the current table not yet written, or
+ *                  CHECKPOINT_TABLE_START
+ * @return          bool true on success, false on a write error
+ */
+bool output_checkpoint(FILE *stream, int next_row);
+
+/**
+ * @brief Initialize an output buffer
+ *
+ * @param buffer    Buffer to initialize
+ * @param stream    Stream to flush the buffered bytes to
+ * @param capacity  Number of bytes to buffer before flushing
+ * @return          bool true on success, false if allocation failed
+ */
+bool output_buffer_init(output_buffer_t *buffer, FILE *stream, size_t capacity);
+
+/**
+ * @brief Flush and release an output buffer
+ *
+ * @param buffer Buffer to release
+ */
+void output_buffer_free(output_buffer_t *buffer);
+
+/**
+ * @brief Write all buffered bytes to the stream
+ *
+ * With an asynchronous writer this waits until all queued buffers have
+ * been written.
+ *
+ * @param buffer Buffer to flush
+ * @return       bool true on success, false on a write error
+ */
+bool output_buffer_flush(output_buffer_t *buffer);
+
+/**
+ * @brief Append bytes to the buffer, flushing as needed
+ *
+ * @param buffer  Buffer to append to
+ * @param data    Bytes to append
+ * @param length  Number of bytes to append
+ * @return        bool true on success, false on a write error
+ */
+bool output_buffer_append(output_buffer_t *buffer, const char *data, size_t length);
+
+/**
+ * @brief Append a run of identical bytes, flushing as needed
+ *
+ * @param buffer  Buffer to append to
+ * @param fill    Byte to repeat
+ * @param count   Number of bytes to append
+ * @return        bool true on success, false on a write error
+ */
+bool output_buffer_fill(output_buffer_t *buffer, char fill, size_t count);
+
+/**
+ * @brief Mark the end of a table row, checkpointing when one is due
+ *
+ * @param buffer  Buffer the row was appended to
+ * @param row     Row that was just completed
+ * @return        bool true on success, false on a write error
+ */
+bool output_buffer_end_row(output_buffer_t *buffer, int row);
+
+#endif /* TIMESTABLE_OUTPUT_H */
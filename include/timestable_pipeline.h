@@ -0,0 +1,158 @@
+/**
+ * @file timestable_pipeline.h
+ * @brief Lock-free rings linking the stages of the table pipeline
+ *
+ * A table body is produced by three stages: one computes the raw cell
+ * values of each row, one renders them as text and one writes the text.
+ * Neighbouring stages are linked by single-producer/single-consumer rings
+ * of preallocated slots. Each side owns one index and only reads the
+ * other's, so no locks are needed, and a full ring makes the producer wait
+ * instead of growing.
+ */
+
+#ifndef TIMESTABLE_PIPELINE_H
+#define TIMESTABLE_PIPELINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Ring geometry
+ */
+#define PIPELINE_RING_SLOTS 16       /**< Row slots per ring (a power of two) */
+#define PIPELINE_CACHE_LINE 64       /**< Keeps the two indices on separate lines */
+
+/**
+ * @brief Single-producer/single-consumer ring of fixed-size slots
+ *
+ * The producer owns tail and the consumer owns head; both only ever grow,
+ * and slot i lives at (i & mask). Slots are handed out in place, so a row
+ * is written once by the producer and read once by the consumer.
+ */
+typedef struct
+{
+    char *slots;                     /**< slot_count × slot_size bytes */
+    size_t *lengths;                 /**< Bytes used in each slot */
+    size_t slot_size;                /**< Size of each slot in bytes */
+    size_t mask;                     /**< slot_count - 1 */
+    bool closed;                     /**< Producer has finished */
+    bool aborted;                    /**< Consumer has given up */
+    char pad_head[PIPELINE_CACHE_LINE];
+    size_t head;                     /**< Next slot to consume (consumer) */
+    char pad_tail[PIPELINE_CACHE_LINE];
+    size_t tail;                     /**< Next slot to produce (producer) */
+    char pad_end[PIPELINE_CACHE_LINE];
+} spsc_ring_t;
+
+/**
+ * @brief Stages of the table pipeline
+ */
+typedef enum
+{
+    PIPELINE_STAGE_COMPUTE = 0,      /**< Computes raw cell values */
+    PIPELINE_STAGE_FORMAT,           /**< Renders values as text */
+    PIPELINE_STAGE_WRITE,            /**< Writes text to the output */
+    PIPELINE_STAGE_COUNT
+} pipeline_stage_t;
+
+/**
+ * @brief Time each stage spent waiting on its neighbours
+ */
+typedef struct
+{
+    uint64_t rows;                              /**< Rows passed through */
+    uint64_t input_ns[PIPELINE_STAGE_COUNT];    /**< Waiting for an input row */
+    uint64_t output_ns[PIPELINE_STAGE_COUNT];   /**< Waiting for a free output slot */
+} pipeline_stats_t;
+
+/**
+ * @brief Initialize an empty ring
+ *
+ * @param ring        Ring to initialize
+ * @param slot_count  Number of slots (a power of two)
+ * @param slot_size   Size of each slot in bytes
+ * @return            bool true on success, false if allocation failed
+ */
+bool spsc_ring_init(spsc_ring_t *ring, size_t slot_count, size_t slot_size);
+
+/**
+ * @brief Release a ring
+ *
+ * @param ring Ring to release
+ */
+void spsc_ring_free(spsc_ring_t *ring);
+
+/**
+ * @brief Get the next free slot to fill (producer)
+ *
+ * @param ring     Ring to produce into
+ * @param wait_ns  Incremented by the time spent waiting for a free slot
+ * @return         void* Slot of slot_size bytes, or NULL if the consumer aborted
+ */
+void *spsc_ring_reserve(spsc_ring_t *ring, uint64_t *wait_ns);
+
+/**
+ * @brief Publish the slot returned by spsc_ring_reserve() (producer)
+ *
+ * @param ring    Ring to produce into
+ * @param length  Bytes used in the slot
+ */
+void spsc_ring_commit(spsc_ring_t *ring, size_t length);
+
+/**
+ * @brief Signal that no more slots will be produced (producer)
+ *
+ * @param ring Ring to close
+ */
+void spsc_ring_close(spsc_ring_t *ring);
+
+/**
+ * @brief Get the oldest published slot (consumer)
+ *
+ * @param ring     Ring to consume from
+ * @param length   Set to the bytes used in the slot
+ * @param wait_ns  Incremented by the time spent waiting for a slot
+ * @return         void* Slot, or NULL once the ring is closed and empty
+ */
+void *spsc_ring_front(spsc_ring_t *ring, size_t *length, uint64_t *wait_ns);
+
+/**
+ * @brief Hand the slot returned by spsc_ring_front() back (consumer)
+ *
+ * @param ring Ring to consume from
+ */
+void spsc_ring_pop(spsc_ring_t *ring);
+
+/**
+ * @brief Stop consuming; later reserves fail so the producer exits (consumer)
+ *
+ * @param ring Ring to abort
+ */
+void spsc_ring_abort(spsc_ring_t *ring);
+
+/**
+ * @brief Collect pipeline statistics for later reporting
+ *
+ * Pipelined tables add their stage waits to the given statistics.
+ *
+ * @param stats Statistics to add to, or NULL to stop collecting
+ */
+void pipeline_set_stats(pipeline_stats_t *stats);
+
+/**
+ * @brief Add one table's statistics to those being collected
+ *
+ * @param stats Statistics of a finished table
+ */
+void pipeline_add_stats(const pipeline_stats_t *stats);
+
+/**
+ * @brief Name of a stage, for reporting
+ *
+ * @param stage Stage
+ * @return      const char* "compute", "format" or "write"
+ */
+const char *pipeline_stage_name(pipeline_stage_t stage);
+
+#endif /* TIMESTABLE_PIPELINE_H */
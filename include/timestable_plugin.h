@@ -0,0 +1,101 @@
+/**
+ * @file timestable_plugin.h
+ * @brief Shared object plugin interface for custom row operations
+ *
+ * A plugin is a shared object exporting a timestable_plugin_t descriptor
+ * named TIMESTABLE_PLUGIN_SYMBOL. Each operation it lists provides a row
+ * batch kernel and a value bound, which are used exactly like the built-in
+ * row operations by print_row_table().
+ */
+
+#ifndef TIMESTABLE_PLUGIN_H
+#define TIMESTABLE_PLUGIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "timestable_operations.h"
+
+/**
+ * @brief Version of the plugin descriptor layout
+ *
+ * Bump whenever timestable_plugin_t, timestable_plugin_op_t, RowOperation
+ * or RowValueBound change in an incompatible way.
+ */
+#define TIMESTABLE_PLUGIN_ABI_VERSION 1
+
+/**
+ * @brief Name of the descriptor symbol exported by every plugin
+ */
+#define TIMESTABLE_PLUGIN_SYMBOL "timestable_plugin"
+
+/**
+ * @brief One operation exported by a plugin
+ */
+typedef struct
+{
+    const char *name;            /**< Name selected with --op */
+    const char *title;           /**< Title to display for the table */
+    RowOperation kernel;         /**< Batch kernel filling row values */
+    RowValueBound value_bound;   /**< Bound used for cell width calculation */
+    const void *context;         /**< Data passed to kernel and value_bound */
+} timestable_plugin_op_t;
+
+/**
+ * @brief Descriptor exported by a plugin as TIMESTABLE_PLUGIN_SYMBOL
+ */
+typedef struct
+{
+    uint32_t abi_version;                  /**< TIMESTABLE_PLUGIN_ABI_VERSION */
+    uint32_t op_count;                     /**< Number of entries in ops */
+    const timestable_plugin_op_t *ops;     /**< Exported operations */
+} timestable_plugin_t;
+
+/**
+ * @brief Error codes for plugin loading
+ */
+typedef enum
+{
+    PLUGIN_SUCCESS = 0,              /**< Plugin loaded successfully */
+    PLUGIN_ERROR_OPEN,               /**< Shared object could not be opened */
+    PLUGIN_ERROR_SYMBOL,             /**< Descriptor symbol not found */
+    PLUGIN_ERROR_VERSION,            /**< Descriptor ABI version mismatch */
+    PLUGIN_ERROR_OPERATION           /**< Requested operation not exported */
+} plugin_error_code_t;
+
+/**
+ * @brief Structure to hold plugin error information
+ */
+typedef struct
+{
+    plugin_error_code_t code;        /**< The error code */
+    const char *message;             /**< The corresponding error message */
+} plugin_error_t;
+
+/**
+ * @brief A loaded plugin operation
+ */
+typedef struct
+{
+    void *handle;                    /**< dlopen() handle */
+    const char *title;               /**< Title to display for the table */
+    row_operation_t operation;       /**< Operation ready for print_row_table() */
+} plugin_t;
+
+/**
+ * @brief Load a plugin and look up one of its operations
+ *
+ * @param path      Path to the shared object
+ * @param op_name   Name of the operation to use
+ * @param plugin    Pointer to the plugin structure to populate
+ * @return          plugin_error_t structure with error code and message
+ */
+plugin_error_t plugin_open(const char *path, const char *op_name, plugin_t *plugin);
+
+/**
+ * @brief Unload a plugin opened with plugin_open()
+ *
+ * @param plugin Plugin to unload
+ */
+void plugin_close(plugin_t *plugin);
+
+#endif /* TIMESTABLE_PLUGIN_H */
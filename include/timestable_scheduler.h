@@ -0,0 +1,58 @@
+/**
+ * @file timestable_scheduler.h
+ * @brief Work-stealing scheduler for independent rendering tasks
+ *
+ * Runs a batch of numbered tasks on a pool of threads. Each worker starts
+ * with its own contiguous share of the tasks in a deque, takes work from
+ * the bottom of that deque, and when it runs dry steals from the top of
+ * another worker's deque. Uneven tasks therefore end up spread over all
+ * workers instead of leaving the owner of the slow share running alone.
+ */
+
+#ifndef TIMESTABLE_SCHEDULER_H
+#define TIMESTABLE_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Upper limit on worker threads
+ */
+#define SCHEDULER_MAX_WORKERS 256
+
+/**
+ * @brief Function running one task
+ *
+ * @param context  Data shared by all tasks of the batch
+ * @param index    Number of the task, from 0 to the task count - 1
+ */
+typedef void (*scheduler_task_t)(void *context, size_t index);
+
+/**
+ * @brief Counters collected while running a batch
+ */
+typedef struct
+{
+    uint64_t executed;               /**< Tasks run */
+    uint64_t stolen;                 /**< Tasks taken from another worker's deque */
+} scheduler_stats_t;
+
+/**
+ * @brief Run every task of a batch and wait for all of them
+ *
+ * The calling thread is one of the workers. Tasks may run in any order and
+ * concurrently, so they must only write to their own results.
+ *
+ * @param task_count  Number of tasks
+ * @param task        Function running one task
+ * @param context     Data passed to every task
+ * @param workers     Number of workers (1 to SCHEDULER_MAX_WORKERS)
+ * @param stats       Counters to fill in, or NULL
+ * @return            bool true on success, false if the pool could not be started
+ *                    (no task has run in that case)
+ */
+bool scheduler_run(size_t task_count, scheduler_task_t task, void *context,
+                   int workers, scheduler_stats_t *stats);
+
+#endif /* TIMESTABLE_SCHEDULER_H */
@@ -0,0 +1,68 @@
+/**
+ * @file timestable_shard.h
+ * @brief Splitting a table into row bands generated by separate processes
+ *
+ * Shard i of N renders one contiguous band of rows, and only shard 0 writes
+ * the title and header, so the outputs of shards 0 to N-1 concatenate into
+ * exactly the output of an unsharded run. Bands hold roughly equal shares
+ * of the estimated cost of the table rather than equal numbers of rows.
+ */
+
+#ifndef TIMESTABLE_SHARD_H
+#define TIMESTABLE_SHARD_H
+
+#include <stdint.h>
+
+/**
+ * @brief Estimated cost of rendering one row
+ *
+ * @param row Row value
+ * @return    uint64_t Relative cost (at least 1)
+ */
+typedef uint64_t (*shard_cost_t)(int row);
+
+/**
+ * @brief Rows of one shard; empty when first_row > last_row
+ */
+typedef struct
+{
+    int first_row;                   /**< First row of the band */
+    int last_row;                    /**< Last row of the band */
+} shard_band_t;
+
+/**
+ * @brief Cost of a row of a table whose rows all take the same work
+ *
+ * @param row Row value
+ * @return    uint64_t 1
+ */
+uint64_t shard_cost_uniform(int row);
+
+/**
+ * @brief Cost of a row of the exact power table
+ *
+ * Cells of row r hold about c * log2(r) bits, and converting them to text
+ * takes time quadratic in their size.
+ *
+ * @param row Row value
+ * @return    uint64_t 1 + bit length of row, squared
+ */
+uint64_t shard_cost_big_power(int row);
+
+/**
+ * @brief Find the band of rows rendered by one shard
+ *
+ * Shard k starts at the first row before which at least k/count of the
+ * total cost lies. Shard 0 always starts at min_value; later shards may be
+ * empty when there are fewer rows than shards.
+ *
+ * @param min_value  First row of the table
+ * @param max_value  Last row of the table
+ * @param cost       Estimated cost of each row
+ * @param index      Shard number, from 0 to count - 1
+ * @param count      Number of shards
+ * @return           shard_band_t Rows of the shard
+ */
+shard_band_t shard_rows(int min_value, int max_value, shard_cost_t cost, int index, int count);
+
+#endif /* TIMESTABLE_SHARD_H */
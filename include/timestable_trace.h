@@ -0,0 +1,96 @@
+/**
+ * @file timestable_trace.h
+ * @brief Timeline of the render phases in Chrome trace-event format
+ *
+ * Spans are recorded into per-thread buffers with no lock or system call
+ * beyond reading the clock, and written out as one JSON file when tracing
+ * stops. While tracing is off, a span costs one predictable branch.
+ *
+ * The same sites carry static probes (provider "timestable") when built
+ * with TIMESTABLE_SDT and <sys/sdt.h>, for perf and bpftrace. Probes are
+ * a no-op instruction until a tracer attaches to them.
+ */
+
+#ifndef TIMESTABLE_TRACE_H
+#define TIMESTABLE_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef TIMESTABLE_SDT
+#include <sys/sdt.h>
+#define TRACE_PROBE1(name, a)       DTRACE_PROBE1(timestable, name, a)
+#define TRACE_PROBE2(name, a, b)    DTRACE_PROBE2(timestable, name, a, b)
+#else
+#define TRACE_PROBE1(name, a)       ((void)0)
+#define TRACE_PROBE2(name, a, b)    ((void)0)
+#endif
+
+/**
+ * @brief Events held by each block of a thread's buffer
+ */
+#define TRACE_CHUNK_EVENTS 4096
+
+/**
+ * @brief Error codes for opening a trace
+ */
+typedef enum
+{
+    TRACE_SUCCESS = 0,               /**< Tracing started */
+    TRACE_ERROR_OPEN,                /**< The trace file cannot be created */
+    TRACE_ERROR_ACTIVE               /**< A trace is already being recorded */
+} trace_error_code_t;
+
+/**
+ * @brief Error code and message
+ */
+typedef struct
+{
+    trace_error_code_t code;         /**< The error code */
+    const char *message;             /**< The corresponding error message */
+} trace_error_t;
+
+/**
+ * @brief Read the clock used for trace timestamps
+ *
+ * @return uint64_t Nanoseconds since an arbitrary point
+ */
+uint64_t trace_clock_ns(void);
+
+/**
+ * @brief Start recording spans
+ *
+ * Must be called before the threads that record spans are started.
+ *
+ * @param path       File to write the trace to when it is closed
+ * @param origin_ns  Time shown as zero, from trace_clock_ns()
+ * @return           trace_error_t Error code and message
+ */
+trace_error_t trace_open(const char *path, uint64_t origin_ns);
+
+/**
+ * @brief Start a span
+ *
+ * @return uint64_t Start time to pass to trace_end(), or 0 if tracing is off
+ */
+uint64_t trace_begin(void);
+
+/**
+ * @brief Record a span of the calling thread that ends now
+ *
+ * @param name   Name of the span (a string literal; it is kept by reference)
+ * @param start  Start time from trace_begin() or trace_clock_ns(); 0 records nothing
+ * @param value  Number shown with the span, such as a row or byte count
+ */
+void trace_end(const char *name, uint64_t start, int64_t value);
+
+/**
+ * @brief Stop recording and write the trace file
+ *
+ * Every thread that recorded spans must have finished recording.
+ *
+ * @return bool true on success (or if tracing was off), false on a write error
+ */
+bool trace_close(void);
+
+#endif /* TIMESTABLE_TRACE_H */
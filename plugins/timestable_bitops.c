@@ -0,0 +1,119 @@
+/**
+ * @file timestable_bitops.c
+ * @brief Example plugin with bitwise and saturating row operations
+ *
+ * Build with "make plugins" and use with, for example:
+ * timestable --plugin bin/plugins/timestable_bitops.so --op xor
+ */
+
+#include <stdint.h>
+#include "timestable_plugin.h"
+
+/**
+ * @brief Ceiling for the saturating add operation
+ */
+#define SATURATE_LIMIT UINT8_MAX
+
+/**
+ * @brief Saturating 8-bit add kernel (min(row + column, 255))
+ */
+static void
+satadd_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    uint64_t value = (uint64_t)row + (uint64_t)column;
+
+    (void)context;
+    for (int i = 0; i < count; i++, value++)
+    {
+        values[i] = (value < SATURATE_LIMIT) ? value : SATURATE_LIMIT;
+    }
+}
+
+/**
+ * @brief Bitwise exclusive-or kernel (row ^ column)
+ */
+static void
+xor_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    (void)context;
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = (uint64_t)(row ^ (column + i));
+    }
+}
+
+/**
+ * @brief Population count of the product kernel (popcount(row × column))
+ */
+static void
+popcount_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    uint64_t product = (uint64_t)row * (uint64_t)column;
+
+    (void)context;
+    for (int i = 0; i < count; i++, product += (uint64_t)row)
+    {
+        values[i] = (uint64_t)__builtin_popcountll(product);
+    }
+}
+
+/**
+ * @brief Bound for the saturating add table
+ */
+static uint64_t
+satadd_bound(const void *context, int min_value, int max_value)
+{
+    uint64_t sum = 2 * (uint64_t)max_value;
+
+    (void)context;
+    (void)min_value;
+    return (sum < SATURATE_LIMIT) ? sum : SATURATE_LIMIT;
+}
+
+/**
+ * @brief Bound for the exclusive-or table (all bits below the top bit of max)
+ */
+static uint64_t
+xor_bound(const void *context, int min_value, int max_value)
+{
+    uint64_t bound = 0;
+
+    (void)context;
+    (void)min_value;
+    while (bound < (uint64_t)max_value)
+    {
+        bound = (bound << 1) | 1;
+    }
+    return bound;
+}
+
+/**
+ * @brief Bound for the popcount table (bits in the largest product)
+ */
+static uint64_t
+popcount_bound(const void *context, int min_value, int max_value)
+{
+    uint64_t product = (uint64_t)max_value * (uint64_t)max_value;
+    uint64_t bits    = 0;
+
+    (void)context;
+    (void)min_value;
+    while (product > 0)
+    {
+        bits++;
+        product >>= 1;
+    }
+    return bits;
+}
+
+static const timestable_plugin_op_t BITOPS_OPS[] = {
+    {"satadd",   "Saturating Add Table (min(row + column, 255))", satadd_row,   satadd_bound,   NULL},
+    {"xor",      "XOR Table (row ^ column)",                      xor_row,      xor_bound,      NULL},
+    {"popcount", "Popcount Table (popcount(row × column))",       popcount_row, popcount_bound, NULL}
+};
+
+const timestable_plugin_t timestable_plugin = {
+    .abi_version = TIMESTABLE_PLUGIN_ABI_VERSION,
+    .op_count    = sizeof(BITOPS_OPS) / sizeof(BITOPS_OPS[0]),
+    .ops         = BITOPS_OPS
+};
@@ -0,0 +1,714 @@
+/**
+ * @file timestable_aggregate.c
+ * @brief Implementation of table aggregates
+ *
+ * A closed form costs O(1) for a rectangle of products, O(columns) for
+ * quotients and O(rows) for powers, where each row is one geometric series.
+ * Tables without one are reduced a row at a time over their batch kernel.
+ */
+
+#include <stdlib.h>                 // malloc(), free(), qsort()
+#include <limits.h>                 // INT_MAX
+
+#include "timestable_aggregate.h"   // agg_table_t, agg_rect_t, agg_result_t
+
+/**
+ * @brief Unsigned 128-bit value, for formatting magnitudes
+ */
+__extension__ typedef unsigned __int128 agg_uint_t;
+
+/**
+ * @brief What a computed cell holds
+ */
+typedef enum
+{
+    CELL_VALUE,                      /**< An exact value */
+    CELL_UNDEFINED,                  /**< No value (division by zero) */
+    CELL_OVERFLOW                    /**< A value of 2^127 or more */
+} cell_state_t;
+
+/**
+ * @brief Fold one partial result into another
+ *
+ * An overflowing minimum is replaced by any exact value, because every
+ * exact value is smaller; an overflowing sum or maximum stays overflowing.
+ *
+ * @param result  Result so far
+ * @param kind    AGG_SUM, AGG_MIN or AGG_MAX
+ * @param part    Result of further cells
+ */
+static void
+merge(agg_result_t *result, agg_kind_t kind, const agg_result_t *part)
+{
+    if (0 == part->cells)
+    {
+        return;
+    }
+
+    if (0 == result->cells)
+    {
+        *result = *part;
+        return;
+    }
+
+    switch (kind)
+    {
+        case AGG_SUM:
+            result->overflow = result->overflow || part->overflow ||
+                               __builtin_add_overflow(result->value, part->value, &result->value);
+        break;
+
+        case AGG_MIN:
+            if (!part->overflow && (result->overflow || part->value < result->value))
+            {
+                result->value    = part->value;
+                result->overflow = false;
+            }
+        break;
+
+        case AGG_MAX:
+            if (!result->overflow && (part->overflow || part->value > result->value))
+            {
+                result->value    = part->value;
+                result->overflow = part->overflow;
+            }
+        break;
+
+        case AGG_HISTOGRAM:
+        break;
+    }
+
+    result->cells += part->cells;
+}
+
+/**
+ * @brief Raise a value to a power exactly
+ *
+ * @param base      Base (0 ^ 0 = 1)
+ * @param exponent  Exponent (at least 0)
+ * @param result    Set to base ^ exponent
+ * @return          bool true if the power is below 2^127
+ */
+static bool
+exact_power(int base, int exponent, agg_int_t *result)
+{
+    agg_int_t power  = 1;
+    agg_int_t square = base;
+
+    /* Square-and-multiply; a square only overflows for |base| >= 2, where
+       any further factor would overflow the power as well */
+    while (exponent > 0)
+    {
+        if ((exponent & 1) && __builtin_mul_overflow(power, square, &power))
+        {
+            return false;
+        }
+
+        exponent >>= 1;
+        if (exponent > 0 && __builtin_mul_overflow(square, square, &square))
+        {
+            return false;
+        }
+    }
+
+    *result = power;
+    return true;
+}
+
+/**
+ * @brief Sum of the integers first..last
+ *
+ * @param first  First integer
+ * @param last   Last integer (at least first)
+ * @return       agg_int_t first + (first + 1) + ... + last
+ */
+static agg_int_t
+series(int first, int last)
+{
+    return ((agg_int_t)first + last) * ((agg_int_t)last - first + 1) / 2;
+}
+
+/**
+ * @brief Sum of row ÷ column over the rows 0..last
+ *
+ * With q = last ÷ column, each quotient below q fills column rows and q
+ * fills the remaining last - q × column + 1.
+ *
+ * @param last    Last row (the sum is 0 below 0)
+ * @param column  Column (at least 1)
+ * @return        agg_int_t Sum of the truncated quotients
+ */
+static agg_int_t
+floor_sum(int last, int column)
+{
+    agg_int_t quotient;
+
+    if (last < 0)
+    {
+        return 0;
+    }
+
+    quotient = last / column;
+    return column * (quotient * (quotient - 1) / 2) + quotient * (last - quotient * column + 1);
+}
+
+/**
+ * @brief Sum of row ÷ column over the columns first..last
+ *
+ * The quotient q holds for the columns up to row ÷ q, so the row is summed
+ * in runs of equal quotients, of which there are at most 2√row.
+ *
+ * @param row    Row (at least 0)
+ * @param first  First column (at least 1)
+ * @param last   Last column
+ * @return       agg_int_t Sum of the truncated quotients
+ */
+static agg_int_t
+quotient_run_sum(int row, int first, int last)
+{
+    agg_int_t sum = 0;
+
+    for (int column = first; column <= last;)
+    {
+        int quotient = row / column;
+        int end;
+
+        if (0 == quotient)
+        {
+            break;
+        }
+
+        end     = (row / quotient < last) ? row / quotient : last;
+        sum    += (agg_int_t)quotient * (end - column + 1);
+        column  = end + 1;
+    }
+
+    return sum;
+}
+
+/**
+ * @brief Reduce a rectangle of the multiplication table
+ *
+ * Products are non-negative and grow with both row and column, so the
+ * extremes are at opposite corners, and the sum factors into two series.
+ *
+ * @param kind    AGG_SUM, AGG_MIN or AGG_MAX
+ * @param rect    Cells to reduce
+ * @param result  Set to the result
+ */
+static void
+multiply_rect(agg_kind_t kind, const agg_rect_t *rect, agg_result_t *result)
+{
+    result->cells    = (uint64_t)(rect->last_row - rect->first_row + 1) *
+                       (uint64_t)(rect->last_column - rect->first_column + 1);
+    result->overflow = false;
+    result->value    = (AGG_MIN == kind) ? (agg_int_t)rect->first_row * rect->first_column
+                     : (AGG_MAX == kind) ? (agg_int_t)rect->last_row * rect->last_column
+                     : series(rect->first_row, rect->last_row) *
+                       series(rect->first_column, rect->last_column);
+}
+
+/**
+ * @brief Reduce a rectangle of the division table
+ *
+ * Column 0 is undefined and skipped. Each other column sums in O(1) as a
+ * difference of two floor sums, and a single row in runs of equal
+ * quotients.
+ *
+ * @param kind    AGG_SUM, AGG_MIN or AGG_MAX
+ * @param rect    Cells to reduce
+ * @param result  Set to the result
+ */
+static void
+divide_rect(agg_kind_t kind, const agg_rect_t *rect, agg_result_t *result)
+{
+    int first_column = (rect->first_column > 1) ? rect->first_column : 1;
+
+    result->cells    = 0;
+    result->overflow = false;
+    result->value    = 0;
+    if (first_column > rect->last_column)
+    {
+        return;
+    }
+
+    result->cells = (uint64_t)(rect->last_row - rect->first_row + 1) *
+                    (uint64_t)(rect->last_column - first_column + 1);
+
+    switch (kind)
+    {
+        case AGG_SUM:
+            if (rect->first_row == rect->last_row)
+            {
+                result->value = quotient_run_sum(rect->first_row, first_column, rect->last_column);
+                break;
+            }
+
+            for (int column = first_column; column <= rect->last_column; column++)
+            {
+                result->value += floor_sum(rect->last_row, column) -
+                                 floor_sum(rect->first_row - 1, column);
+            }
+        break;
+
+        case AGG_MIN:
+            result->value = rect->first_row / rect->last_column;
+        break;
+
+        case AGG_MAX:
+            result->value = rect->last_row / first_column;
+        break;
+
+        case AGG_HISTOGRAM:
+        break;
+    }
+}
+
+/**
+ * @brief Reduce one row of the power table
+ *
+ * The row of base r sums to (r^(last + 1) - r^first) / (r - 1). When the
+ * numerator overflows the sum is added up term by term instead, which ends
+ * after at most 127 terms because every further term overflows too.
+ *
+ * @param kind          AGG_SUM, AGG_MIN or AGG_MAX
+ * @param row           Row (base)
+ * @param first_column  First column (exponent)
+ * @param last_column   Last column (exponent)
+ * @param result        Set to the result
+ */
+static void
+power_row(agg_kind_t kind, int row, int first_column, int last_column, agg_result_t *result)
+{
+    agg_int_t high;
+    agg_int_t term;
+
+    result->cells    = (uint64_t)(last_column - first_column + 1);
+    result->overflow = false;
+    result->value    = 0;
+
+    /* Row 1 is all ones; row 0 is zeros except 0 ^ 0 = 1 */
+    if (row < 2)
+    {
+        bool zero_column = (0 == first_column);
+
+        result->value = (1 == row)       ? ((AGG_SUM == kind) ? (agg_int_t)result->cells : 1)
+                      : (AGG_MIN == kind) ? (last_column < 1)
+                      : zero_column;
+        return;
+    }
+
+    switch (kind)
+    {
+        case AGG_SUM:
+            if (last_column < INT_MAX && exact_power(row, last_column + 1, &high) &&
+                exact_power(row, first_column, &term))
+            {
+                result->value = (high - term) / (row - 1);
+                break;
+            }
+
+            result->overflow = !exact_power(row, first_column, &term);
+            for (int column = first_column; column <= last_column && !result->overflow; column++)
+            {
+                result->overflow = __builtin_add_overflow(result->value, term, &result->value) ||
+                                   (column < last_column &&
+                                    __builtin_mul_overflow(term, row, &term));
+            }
+        break;
+
+        case AGG_MIN:
+            result->overflow = !exact_power(row, first_column, &result->value);
+        break;
+
+        case AGG_MAX:
+            result->overflow = !exact_power(row, last_column, &result->value);
+        break;
+
+        case AGG_HISTOGRAM:
+        break;
+    }
+}
+
+/**
+ * @brief Reduce one column of the power table
+ *
+ * For a fixed exponent the powers never decrease with the base, so the
+ * extremes are the first and last rows and the sum stops at the first
+ * overflowing term.
+ *
+ * @param kind       AGG_SUM, AGG_MIN or AGG_MAX
+ * @param column     Column (exponent)
+ * @param first_row  First row (base)
+ * @param last_row   Last row (base)
+ * @param result     Set to the result
+ */
+static void
+power_column(agg_kind_t kind, int column, int first_row, int last_row, agg_result_t *result)
+{
+    agg_int_t term;
+
+    result->cells    = (uint64_t)(last_row - first_row + 1);
+    result->overflow = false;
+    result->value    = 0;
+
+    switch (kind)
+    {
+        case AGG_SUM:
+            for (int row = first_row; row <= last_row && !result->overflow; row++)
+            {
+                result->overflow = !exact_power(row, column, &term) ||
+                                   __builtin_add_overflow(result->value, term, &result->value);
+            }
+        break;
+
+        case AGG_MIN:
+            result->overflow = !exact_power(first_row, column, &result->value);
+        break;
+
+        case AGG_MAX:
+            result->overflow = !exact_power(last_row, column, &result->value);
+        break;
+
+        case AGG_HISTOGRAM:
+        break;
+    }
+}
+
+/**
+ * @brief Reduce a rectangle of a table with a closed form
+ *
+ * @param table   Table to reduce (not AGG_TABLE_ROWS)
+ * @param kind    AGG_SUM, AGG_MIN or AGG_MAX
+ * @param rect    Cells to reduce
+ * @param result  Set to the result
+ */
+static void
+closed_form(const agg_table_t *table, agg_kind_t kind, const agg_rect_t *rect,
+            agg_result_t *result)
+{
+    switch (table->source)
+    {
+        case AGG_TABLE_MULTIPLY:
+            multiply_rect(kind, rect, result);
+        break;
+
+        case AGG_TABLE_DIVIDE:
+            divide_rect(kind, rect, result);
+        break;
+
+        case AGG_TABLE_POWER:
+            if (rect->first_column == rect->last_column)
+            {
+                power_column(kind, rect->first_column, rect->first_row, rect->last_row, result);
+                break;
+            }
+
+            *result = (agg_result_t){0, 0, false};
+            for (int row = rect->first_row; row <= rect->last_row; row++)
+            {
+                agg_result_t part;
+
+                power_row(kind, row, rect->first_column, rect->last_column, &part);
+                merge(result, kind, &part);
+            }
+        break;
+
+        case AGG_TABLE_ROWS:
+        break;
+    }
+}
+
+/**
+ * @brief Compute a run of cells of one row exactly
+ *
+ * @param table         Table to compute
+ * @param row           Row value
+ * @param first_column  First column value
+ * @param count         Number of consecutive columns
+ * @param buffer        Scratch space of count entries for the row kernel
+ * @param values        Set to the cell values
+ * @param states        Set to what each cell holds
+ */
+static void
+fill_row(const agg_table_t *table, int row, int first_column, int count,
+         uint64_t *buffer, agg_int_t *values, unsigned char *states)
+{
+    agg_int_t term = 0;
+    bool overflow;
+
+    switch (table->source)
+    {
+        case AGG_TABLE_MULTIPLY:
+            for (int i = 0; i < count; i++)
+            {
+                values[i] = (agg_int_t)row * (first_column + i);
+                states[i] = CELL_VALUE;
+            }
+        break;
+
+        case AGG_TABLE_DIVIDE:
+            for (int i = 0; i < count; i++)
+            {
+                int column = first_column + i;
+
+                values[i] = (0 == column) ? 0 : row / column;
+                states[i] = (0 == column) ? CELL_UNDEFINED : CELL_VALUE;
+            }
+        break;
+
+        case AGG_TABLE_POWER:
+            /* A running product; once it overflows every later cell does */
+            overflow = !exact_power(row, first_column, &term);
+            for (int i = 0; i < count; i++)
+            {
+                values[i] = term;
+                states[i] = overflow ? CELL_OVERFLOW : CELL_VALUE;
+                overflow  = overflow || __builtin_mul_overflow(term, row, &term);
+            }
+        break;
+
+        case AGG_TABLE_ROWS:
+            table->row_operation->kernel(table->row_operation->context, row, first_column,
+                                         count, buffer);
+            for (int i = 0; i < count; i++)
+            {
+                const char *marker = row_value_marker(table->row_operation, buffer[i]);
+
+                values[i] = table->row_operation->is_signed ? (agg_int_t)(int64_t)buffer[i]
+                                                            : (agg_int_t)buffer[i];
+                states[i] = (NULL == marker)                   ? CELL_VALUE
+                          : (ROW_VALUE_UNDEFINED == buffer[i]) ? CELL_UNDEFINED
+                          : CELL_OVERFLOW;
+            }
+        break;
+    }
+}
+
+/**
+ * @brief Reduce a rectangle by computing every cell a row at a time
+ *
+ * @param table    Table to reduce
+ * @param kind     AGG_SUM, AGG_MIN or AGG_MAX
+ * @param rect     Cells to reduce
+ * @param rows     One result per row of rect, or NULL
+ * @param columns  One result per column of rect, or NULL
+ * @param total    Result for the whole rectangle
+ * @return         bool true on success, false if memory ran out
+ */
+static bool
+scan(const agg_table_t *table, agg_kind_t kind, const agg_rect_t *rect,
+     agg_result_t *rows, agg_result_t *columns, agg_result_t *total)
+{
+    int count               = rect->last_column - rect->first_column + 1;
+    uint64_t *buffer        = malloc((size_t)count * sizeof(*buffer));
+    agg_int_t *values       = malloc((size_t)count * sizeof(*values));
+    unsigned char *states   = malloc((size_t)count * sizeof(*states));
+    bool success            = (NULL != buffer && NULL != values && NULL != states);
+
+    *total = (agg_result_t){0, 0, false};
+    for (int i = 0; success && NULL != columns && i < count; i++)
+    {
+        columns[i] = *total;
+    }
+
+    for (int row = rect->first_row; success && row <= rect->last_row; row++)
+    {
+        agg_result_t row_result = {0, 0, false};
+
+        fill_row(table, row, rect->first_column, count, buffer, values, states);
+        for (int i = 0; i < count; i++)
+        {
+            agg_result_t cell = {values[i], 1, CELL_OVERFLOW == states[i]};
+
+            if (CELL_UNDEFINED == states[i])
+            {
+                continue;
+            }
+
+            merge(&row_result, kind, &cell);
+            if (NULL != columns)
+            {
+                merge(&columns[i], kind, &cell);
+            }
+        }
+
+        if (NULL != rows)
+        {
+            rows[row - rect->first_row] = row_result;
+        }
+        merge(total, kind, &row_result);
+    }
+
+    free(states);
+    free(values);
+    free(buffer);
+    return success;
+}
+
+/**
+ * @brief Reduce a rectangle, optionally by row and by column as well
+ *
+ * @param table    Table to reduce
+ * @param kind     AGG_SUM, AGG_MIN or AGG_MAX
+ * @param rect     Cells to reduce
+ * @param rows     One result per row of rect, or NULL
+ * @param columns  One result per column of rect, or NULL
+ * @param total    Result for the whole rectangle
+ * @return         bool true on success, false if memory ran out
+ */
+bool
+agg_reduce(const agg_table_t *table, agg_kind_t kind, const agg_rect_t *rect,
+           agg_result_t *rows, agg_result_t *columns, agg_result_t *total)
+{
+    if (AGG_TABLE_ROWS == table->source)
+    {
+        return scan(table, kind, rect, rows, columns, total);
+    }
+
+    for (int row = rect->first_row; NULL != rows && row <= rect->last_row; row++)
+    {
+        agg_rect_t line = {row, row, rect->first_column, rect->last_column};
+
+        closed_form(table, kind, &line, &rows[row - rect->first_row]);
+    }
+
+    for (int column = rect->first_column; NULL != columns && column <= rect->last_column; column++)
+    {
+        agg_rect_t line = {rect->first_row, rect->last_row, column, column};
+
+        closed_form(table, kind, &line, &columns[column - rect->first_column]);
+    }
+
+    closed_form(table, kind, rect, total);
+    return true;
+}
+
+/**
+ * @brief Order 128-bit values for qsort()
+ *
+ * @param left   First value
+ * @param right  Second value
+ * @return       int Negative, zero or positive as left is below, equal to or above right
+ */
+static int
+compare_values(const void *left, const void *right)
+{
+    agg_int_t a = *(const agg_int_t *)left;
+    agg_int_t b = *(const agg_int_t *)right;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Count the cells of a rectangle holding each value
+ *
+ * Every defined, exact value is collected and sorted, then equal values
+ * are counted as runs.
+ *
+ * @param table      Table to count
+ * @param rect       Cells to count (at most AGG_MAX_HISTOGRAM_SIDE rows and columns)
+ * @param visit      Function receiving each value and its count
+ * @param context    Data passed to visit
+ * @param undefined  Set to the number of undefined cells
+ * @param overflow   Set to the number of cells of 2^127 or more
+ * @return           bool true if every value was visited, false if visit
+ *                   stopped or memory ran out
+ */
+bool
+agg_histogram(const agg_table_t *table, const agg_rect_t *rect, agg_bucket_t visit,
+              void *context, uint64_t *undefined, uint64_t *overflow)
+{
+    int count             = rect->last_column - rect->first_column + 1;
+    size_t cells          = (size_t)(rect->last_row - rect->first_row + 1) * (size_t)count;
+    uint64_t *buffer      = malloc((size_t)count * sizeof(*buffer));
+    agg_int_t *values     = malloc(cells * sizeof(*values));
+    unsigned char *states = malloc((size_t)count * sizeof(*states));
+    size_t defined        = 0;
+    bool success          = (NULL != buffer && NULL != values && NULL != states);
+
+    *undefined = 0;
+    *overflow  = 0;
+
+    /* Each row is computed just past the values kept so far and compacted */
+    for (int row = rect->first_row; success && row <= rect->last_row; row++)
+    {
+        agg_int_t *row_values = values + defined;
+
+        fill_row(table, row, rect->first_column, count, buffer, row_values, states);
+        for (int i = 0; i < count; i++)
+        {
+            if (CELL_VALUE == states[i])
+            {
+                values[defined++] = row_values[i];
+            }
+            else if (CELL_UNDEFINED == states[i])
+            {
+                (*undefined)++;
+            }
+            else
+            {
+                (*overflow)++;
+            }
+        }
+    }
+
+    if (success)
+    {
+        qsort(values, defined, sizeof(*values), compare_values);
+    }
+
+    for (size_t first = 0; success && first < defined;)
+    {
+        size_t last = first;
+
+        while (last + 1 < defined && values[last + 1] == values[first])
+        {
+            last++;
+        }
+
+        success = visit(context, values[first], (uint64_t)(last - first + 1));
+        first   = last + 1;
+    }
+
+    free(states);
+    free(values);
+    free(buffer);
+    return success;
+}
+
+/**
+ * @brief Format a value in decimal
+ *
+ * @param value  Value to format
+ * @param text   Buffer of at least AGG_TEXT_SIZE characters
+ * @return       char* text
+ */
+char *
+agg_format(agg_int_t value, char *text)
+{
+    char digits[AGG_TEXT_SIZE];
+    agg_uint_t magnitude = (value < 0) ? -(agg_uint_t)value : (agg_uint_t)value;
+    size_t length        = 0;
+    size_t position      = 0;
+
+    do
+    {
+        digits[length++] = (char)('0' + (int)(magnitude % 10));
+        magnitude       /= 10;
+    }
+    while (magnitude > 0);
+
+    if (value < 0)
+    {
+        text[position++] = '-';
+    }
+
+    while (length > 0)
+    {
+        text[position++] = digits[--length];
+    }
+
+    text[position] = '\0';
+    return text;
+}
@@ -0,0 +1,932 @@
+/**
+ * @file timestable_async.c
+ * @brief Implementation of the asynchronous multi-buffered writer
+ *
+ * The io_uring backend talks to the kernel with raw system calls, so no
+ * liburing is needed. The thread backend is used where io_uring is not
+ * available or not permitted. The splice backend gifts page-aligned
+ * buffers to a pipe with vmsplice().
+ */
+
+#define _GNU_SOURCE                 // vmsplice(), SPLICE_F_GIFT
+
+#include <stdlib.h>                 // malloc(), free()
+#include <string.h>                 // memset()
+#include <errno.h>                  // errno, EINTR
+#include <fcntl.h>                  // fcntl(), O_APPEND
+#include <unistd.h>                 // write(), pwrite(), lseek(), close()
+#include <pthread.h>                // pthread_create(), pthread_mutex_t, pthread_cond_t
+#include <poll.h>                   // poll()
+#include <sys/stat.h>               // fstat(), S_ISREG, S_ISFIFO
+#include <sys/ioctl.h>              // ioctl(), FIONREAD
+#include <sys/mman.h>               // mmap(), munmap()
+#include <sys/uio.h>                // vmsplice(), struct iovec
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define ASYNC_HAVE_URING 1
+#include <sys/syscall.h>            // syscall(), __NR_io_uring_setup, __NR_io_uring_enter
+#include <linux/io_uring.h>         // struct io_uring_params, struct io_uring_sqe
+#endif
+#endif
+
+#include "timestable_async.h"       // async_writer_t, async_backend_t, async_stats_t
+
+/**
+ * @brief Longest sleep between checks of a pipe reader that lags behind
+ */
+#define SPLICE_MAX_DELAY_MS 16
+
+/**
+ * @brief Backend state and buffer bookkeeping
+ */
+struct async_state
+{
+    size_t free_list[ASYNC_MAX_BUFFERS];   /**< Indices of free buffers */
+    size_t free_count;                     /**< Entries in free_list */
+    size_t lengths[ASYNC_MAX_BUFFERS];     /**< Bytes to write per buffer */
+    off_t offsets[ASYNC_MAX_BUFFERS];      /**< File offset per buffer (positioned) */
+    size_t in_flight;                      /**< Buffers submitted but not written */
+    bool resync;                           /**< Re-read the file position on submit */
+
+#ifdef ASYNC_HAVE_URING
+    int ring_fd;                           /**< io_uring instance */
+    void *sq_ring;                         /**< Submission ring mapping */
+    size_t sq_ring_size;                   /**< Size of the submission ring mapping */
+    void *cq_ring;                         /**< Completion ring mapping (may equal sq_ring) */
+    size_t cq_ring_size;                   /**< Size of the completion ring mapping */
+    struct io_uring_sqe *sqes;             /**< Submission queue entries */
+    size_t sqes_size;                      /**< Size of the entries mapping */
+    unsigned *sq_tail;                     /**< Submission ring tail */
+    unsigned *sq_mask;                     /**< Submission ring mask */
+    unsigned *sq_array;                    /**< Submission ring index array */
+    unsigned *cq_head;                     /**< Completion ring head */
+    unsigned *cq_tail;                     /**< Completion ring tail */
+    unsigned *cq_mask;                     /**< Completion ring mask */
+    struct io_uring_cqe *cqes;             /**< Completion queue entries */
+#endif
+
+    uint64_t spliced;                      /**< Bytes spliced so far */
+    uint64_t splice_end[ASYNC_MAX_BUFFERS];/**< Value of spliced after each buffer */
+    size_t splice_next;                    /**< Next buffer in the rotation */
+
+    pthread_t thread;                      /**< Writer thread */
+    pthread_mutex_t lock;                  /**< Protects the fields below and above */
+    pthread_cond_t changed;                /**< Signalled when the queue changes */
+    size_t queue[ASYNC_MAX_BUFFERS];       /**< Buffers waiting for the writer thread */
+    size_t queue_head;                     /**< First queued entry */
+    size_t queue_count;                    /**< Number of queued entries */
+    bool stop;                             /**< Tell the writer thread to exit */
+};
+
+/**
+ * @brief Write a whole block, retrying on short writes and interruptions
+ *
+ * @param fd          File descriptor
+ * @param data        Bytes to write
+ * @param length      Number of bytes
+ * @param positioned  Write at offset instead of the file position
+ * @param offset      Offset for positioned writes
+ * @return            bool true on success, false on a write error
+ */
+static bool
+write_all(int fd, const char *data, size_t length, bool positioned, off_t offset)
+{
+    while (length > 0)
+    {
+        ssize_t written = positioned ? pwrite(fd, data, length, offset)
+                                     : write(fd, data, length);
+
+        if (written < 0)
+        {
+            if (EINTR == errno)
+                continue;
+            return false;
+        }
+
+        data   += written;
+        length -= (size_t)written;
+        offset += written;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Mark a written buffer free and update the failure flag
+ *
+ * @param writer  Writer the buffer belongs to
+ * @param index   Buffer index
+ * @param ok      Whether the write succeeded
+ */
+static void
+complete_buffer(async_writer_t *writer, size_t index, bool ok)
+{
+    async_state_t *state = writer->state;
+
+    if (!ok)
+    {
+        writer->failed = true;
+    }
+
+    state->free_list[state->free_count++] = index;
+    state->in_flight--;
+}
+
+#ifdef ASYNC_HAVE_URING
+
+/**
+ * @brief Set up an io_uring instance with one entry per buffer
+ *
+ * @param writer Writer to set up
+ * @return       bool true on success, false if io_uring is unavailable
+ */
+static bool
+uring_open(async_writer_t *writer)
+{
+    async_state_t *state = writer->state;
+    struct io_uring_params params;
+
+    memset(&params, 0, sizeof(params));
+    state->ring_fd = (int)syscall(__NR_io_uring_setup, (unsigned)writer->buffer_count, &params);
+    if (state->ring_fd < 0)
+    {
+        return false;
+    }
+
+    /* Writes at the file position need kernel support */
+    if (!writer->positioned && !(params.features & IORING_FEAT_RW_CUR_POS))
+    {
+        close(state->ring_fd);
+        return false;
+    }
+
+    state->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    state->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if (state->cq_ring_size > state->sq_ring_size)
+            state->sq_ring_size = state->cq_ring_size;
+        state->cq_ring_size = state->sq_ring_size;
+    }
+
+    state->sq_ring = mmap(NULL, state->sq_ring_size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, state->ring_fd, IORING_OFF_SQ_RING);
+    state->cq_ring = state->sq_ring;
+    if (MAP_FAILED != state->sq_ring && !(params.features & IORING_FEAT_SINGLE_MMAP))
+    {
+        state->cq_ring = mmap(NULL, state->cq_ring_size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, state->ring_fd, IORING_OFF_CQ_RING);
+    }
+
+    state->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    state->sqes      = mmap(NULL, state->sqes_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, state->ring_fd, IORING_OFF_SQES);
+
+    if (MAP_FAILED == state->sq_ring || MAP_FAILED == state->cq_ring || MAP_FAILED == state->sqes)
+    {
+        if (MAP_FAILED != state->sqes)
+            munmap(state->sqes, state->sqes_size);
+        if (MAP_FAILED != state->cq_ring && state->cq_ring != state->sq_ring)
+            munmap(state->cq_ring, state->cq_ring_size);
+        if (MAP_FAILED != state->sq_ring)
+            munmap(state->sq_ring, state->sq_ring_size);
+        close(state->ring_fd);
+        return false;
+    }
+
+    state->sq_tail  = (unsigned *)((char *)state->sq_ring + params.sq_off.tail);
+    state->sq_mask  = (unsigned *)((char *)state->sq_ring + params.sq_off.ring_mask);
+    state->sq_array = (unsigned *)((char *)state->sq_ring + params.sq_off.array);
+    state->cq_head  = (unsigned *)((char *)state->cq_ring + params.cq_off.head);
+    state->cq_tail  = (unsigned *)((char *)state->cq_ring + params.cq_off.tail);
+    state->cq_mask  = (unsigned *)((char *)state->cq_ring + params.cq_off.ring_mask);
+    state->cqes     = (struct io_uring_cqe *)((char *)state->cq_ring + params.cq_off.cqes);
+
+    return true;
+}
+
+/**
+ * @brief Release the io_uring instance
+ *
+ * @param writer Writer to tear down
+ */
+static void
+uring_close(async_writer_t *writer)
+{
+    async_state_t *state = writer->state;
+
+    munmap(state->sqes, state->sqes_size);
+    if (state->cq_ring != state->sq_ring)
+        munmap(state->cq_ring, state->cq_ring_size);
+    munmap(state->sq_ring, state->sq_ring_size);
+    close(state->ring_fd);
+}
+
+/**
+ * @brief Collect completed writes, optionally waiting for at least one
+ *
+ * Short writes are finished synchronously; with positioned writes they
+ * cannot reorder, and otherwise only one write is ever in flight.
+ *
+ * @param writer  Writer whose completions to collect
+ * @param wait    Block until at least one write completes
+ */
+static void
+uring_reap(async_writer_t *writer, bool wait)
+{
+    async_state_t *state = writer->state;
+    bool reaped          = false;
+
+    while (!reaped && state->in_flight > 0)
+    {
+        unsigned head = *state->cq_head;
+        unsigned tail = __atomic_load_n(state->cq_tail, __ATOMIC_ACQUIRE);
+
+        for (; head != tail; head++)
+        {
+            const struct io_uring_cqe *cqe = &state->cqes[head & *state->cq_mask];
+            size_t index                   = (size_t)cqe->user_data;
+            size_t length                  = state->lengths[index];
+            size_t done                    = (cqe->res > 0) ? (size_t)cqe->res : 0;
+            bool ok                        = cqe->res >= 0 || -EINTR == cqe->res ||
+                                             -EAGAIN == cqe->res;
+
+            if (ok && done < length)
+            {
+                ok = write_all(writer->fd, writer->pool + index * writer->buffer_size + done,
+                               length - done, writer->positioned,
+                               state->offsets[index] + (off_t)done);
+            }
+
+            complete_buffer(writer, index, ok);
+            reaped = true;
+        }
+        __atomic_store_n(state->cq_head, head, __ATOMIC_RELEASE);
+
+        if (reaped || !wait)
+        {
+            break;
+        }
+
+        if (syscall(__NR_io_uring_enter, state->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 &&
+            EINTR != errno)
+        {
+            writer->failed = true;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Queue one buffer on the submission ring
+ *
+ * @param writer Writer to submit to
+ * @param index  Buffer index
+ * @return       bool true on success, false if the kernel rejected it
+ */
+static bool
+uring_submit(async_writer_t *writer, size_t index)
+{
+    async_state_t *state     = writer->state;
+    unsigned tail            = *state->sq_tail;
+    unsigned slot            = tail & *state->sq_mask;
+    struct io_uring_sqe *sqe = &state->sqes[slot];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = IORING_OP_WRITE;
+    sqe->fd        = writer->fd;
+    sqe->addr      = (uint64_t)(uintptr_t)(writer->pool + index * writer->buffer_size);
+    sqe->len       = (uint32_t)state->lengths[index];
+    sqe->off       = writer->positioned ? (uint64_t)state->offsets[index] : (uint64_t)-1;
+    sqe->user_data = index;
+
+    state->sq_array[slot] = slot;
+    __atomic_store_n(state->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    while (syscall(__NR_io_uring_enter, state->ring_fd, 1, 0, 0, NULL, 0) < 0)
+    {
+        if (EINTR != errno)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#endif /* ASYNC_HAVE_URING */
+
+/**
+ * @brief Wait until the pipe reader has consumed a buffer's pages
+ *
+ * The pipe holds the most recently spliced bytes, so a buffer is free
+ * once the unread byte count is no larger than what was spliced after it.
+ * The pool covers the pipe (see async_writer_open()), so this only waits
+ * after buffers that were submitted partly filled.
+ *
+ * @param writer  Writer using the splice backend
+ * @param index   Buffer about to be reused
+ * @return        bool true when the buffer may be overwritten
+ */
+static bool
+splice_wait_consumed(async_writer_t *writer, size_t index)
+{
+    async_state_t *state = writer->state;
+    bool stalled         = false;
+    int delay_ms         = 1;
+
+    for (;;)
+    {
+        int unread = 0;
+        struct pollfd pipe_poll = {.fd = writer->fd, .events = 0, .revents = 0};
+
+        if (ioctl(writer->fd, FIONREAD, &unread) < 0)
+        {
+            return false;
+        }
+
+        if ((uint64_t)unread <= state->spliced - state->splice_end[index])
+        {
+            return true;
+        }
+
+        if (!stalled)
+        {
+            writer->stats.stalls++;
+            stalled = true;
+        }
+
+        /* Nothing signals that the reader has consumed a given amount, so
+           sleep between checks, longer each time; only POLLERR (the reader
+           went away) ends the sleep early */
+        if (poll(&pipe_poll, 1, delay_ms) > 0 && (pipe_poll.revents & POLLERR))
+        {
+            /* Nothing reads these pages now, and the next splice fails
+               with SIGPIPE or EPIPE as a plain write would */
+            return true;
+        }
+        delay_ms = (delay_ms < SPLICE_MAX_DELAY_MS) ? 2 * delay_ms : SPLICE_MAX_DELAY_MS;
+    }
+}
+
+/**
+ * @brief Splice a buffer into the pipe
+ *
+ * @param writer  Writer using the splice backend
+ * @param index   Buffer to splice
+ * @param length  Number of bytes to splice
+ * @return        bool true on success, false on an error
+ */
+static bool
+splice_submit(async_writer_t *writer, size_t index, size_t length)
+{
+    async_state_t *state = writer->state;
+    struct iovec iov     = {
+        .iov_base = writer->pool + index * writer->buffer_size,
+        .iov_len  = length
+    };
+
+    while (iov.iov_len > 0)
+    {
+        ssize_t spliced = vmsplice(writer->fd, &iov, 1, SPLICE_F_GIFT);
+
+        if (spliced < 0)
+        {
+            struct pollfd pipe_poll = {.fd = writer->fd, .events = POLLOUT, .revents = 0};
+
+            if (EINTR == errno)
+                continue;
+            if (EAGAIN != errno || poll(&pipe_poll, 1, -1) < 0)
+                return false;
+            continue;
+        }
+
+        iov.iov_base = (char *)iov.iov_base + spliced;
+        iov.iov_len -= (size_t)spliced;
+    }
+
+    state->spliced          += length;
+    state->splice_end[index] = state->spliced;
+    state->splice_next       = (index + 1) % writer->buffer_count;
+
+    return true;
+}
+
+/**
+ * @brief Writer thread: write queued buffers in order until stopped
+ *
+ * @param argument The async_writer_t
+ * @return         void* Always NULL
+ */
+static void *
+thread_main(void *argument)
+{
+    async_writer_t *writer = argument;
+    async_state_t *state   = writer->state;
+
+    pthread_mutex_lock(&state->lock);
+    for (;;)
+    {
+        size_t index;
+        bool ok;
+
+        while (0 == state->queue_count && !state->stop)
+        {
+            pthread_cond_wait(&state->changed, &state->lock);
+        }
+
+        if (0 == state->queue_count)
+        {
+            break;
+        }
+
+        index = state->queue[state->queue_head];
+        pthread_mutex_unlock(&state->lock);
+
+        ok = write_all(writer->fd, writer->pool + index * writer->buffer_size,
+                       state->lengths[index], false, 0);
+
+        pthread_mutex_lock(&state->lock);
+        state->queue_head = (state->queue_head + 1) % ASYNC_MAX_BUFFERS;
+        state->queue_count--;
+        complete_buffer(writer, index, ok);
+        pthread_cond_broadcast(&state->changed);
+    }
+    pthread_mutex_unlock(&state->lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Check that all buffers but one hold at least a full pipe
+ *
+ * @param fd            Pipe
+ * @param buffer_count  Number of buffers
+ * @param buffer_size   Size of each buffer, before rounding to pages
+ * @return              bool true if the pool covers the pipe
+ */
+static bool
+splice_pool_covers_pipe(int fd, size_t buffer_count, size_t buffer_size)
+{
+    size_t page   = (size_t)sysconf(_SC_PAGESIZE);
+    int pipe_size = fcntl(fd, F_GETPIPE_SZ);
+
+    buffer_size = (buffer_size + page - 1) / page * page;
+    return pipe_size > 0 && (buffer_count - 1) * buffer_size >= (size_t)pipe_size;
+}
+
+/**
+ * @brief Open an asynchronous writer on a file descriptor
+ *
+ * @param writer        Writer to initialize
+ * @param fd            File descriptor to write to
+ * @param backend       Requested backend (AUTO picks io_uring if usable)
+ * @param buffer_count  Number of buffers (ASYNC_MIN_BUFFERS to ASYNC_MAX_BUFFERS)
+ * @param buffer_size   Size of each buffer in bytes
+ * @return              bool true on success, false if the backend cannot be set up
+ */
+bool
+async_writer_open(async_writer_t *writer, int fd, async_backend_t backend,
+                  size_t buffer_count, size_t buffer_size)
+{
+    struct stat info;
+    int flags = fcntl(fd, F_GETFL);
+
+    memset(writer, 0, sizeof(*writer));
+    if (buffer_count < ASYNC_MIN_BUFFERS || buffer_count > ASYNC_MAX_BUFFERS ||
+        0 == buffer_size || flags < 0 || fstat(fd, &info) < 0)
+    {
+        return false;
+    }
+
+    writer->fd           = fd;
+    writer->buffer_count = buffer_count;
+    writer->buffer_size  = buffer_size;
+    writer->state        = calloc(1, sizeof(*writer->state));
+    if (NULL == writer->state)
+    {
+        goto fail;
+    }
+
+    /* Pipes take whole pages by reference; the pool is mapped so that pages
+       still in the pipe at close are unmapped rather than handed to malloc.
+       A buffer is reused once the pipe holds only later ones, so the other
+       buffers must fill the pipe, or reuse would wait on every buffer */
+    if (S_ISFIFO(info.st_mode) &&
+        (ASYNC_BACKEND_SPLICE == backend || ASYNC_BACKEND_AUTO == backend) &&
+        splice_pool_covers_pipe(fd, buffer_count, buffer_size))
+    {
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+        writer->buffer_size = (buffer_size + page - 1) / page * page;
+        writer->pool        = mmap(NULL, buffer_count * writer->buffer_size, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == writer->pool)
+        {
+            writer->pool = NULL;
+            goto fail;
+        }
+
+        writer->backend       = ASYNC_BACKEND_SPLICE;
+        writer->max_in_flight = buffer_count;
+        return true;
+    }
+
+    if (ASYNC_BACKEND_SPLICE == backend)
+    {
+        goto fail;
+    }
+
+    writer->pool = malloc(buffer_count * buffer_size);
+    if (NULL == writer->pool)
+    {
+        goto fail;
+    }
+
+    for (size_t i = 0; i < buffer_count; i++)
+    {
+        writer->state->free_list[i] = buffer_count - 1 - i;
+    }
+    writer->state->free_count = buffer_count;
+    writer->state->resync     = true;
+
+#ifdef ASYNC_HAVE_URING
+    if (ASYNC_BACKEND_THREAD != backend)
+    {
+        /* Regular files take several writes at once at explicit offsets;
+           anything else is written in order one buffer at a time */
+        writer->positioned    = S_ISREG(info.st_mode) && !(flags & O_APPEND);
+        writer->max_in_flight = writer->positioned ? buffer_count : 1;
+
+        if (uring_open(writer))
+        {
+            writer->backend = ASYNC_BACKEND_URING;
+            return true;
+        }
+
+        if (ASYNC_BACKEND_URING == backend)
+        {
+            goto fail;
+        }
+    }
+#else
+    if (ASYNC_BACKEND_URING == backend)
+    {
+        goto fail;
+    }
+#endif
+
+    /* The writer thread writes buffers in order at the file position */
+    writer->positioned    = false;
+    writer->max_in_flight = buffer_count;
+    writer->backend       = ASYNC_BACKEND_THREAD;
+
+    if (0 != pthread_mutex_init(&writer->state->lock, NULL))
+    {
+        goto fail;
+    }
+
+    if (0 != pthread_cond_init(&writer->state->changed, NULL))
+    {
+        pthread_mutex_destroy(&writer->state->lock);
+        goto fail;
+    }
+
+    if (0 != pthread_create(&writer->state->thread, NULL, thread_main, writer))
+    {
+        pthread_cond_destroy(&writer->state->changed);
+        pthread_mutex_destroy(&writer->state->lock);
+        goto fail;
+    }
+
+    return true;
+
+fail:
+    free(writer->state);
+    free(writer->pool);
+    writer->state = NULL;
+    writer->pool  = NULL;
+    return false;
+}
+
+/**
+ * @brief Get a free buffer to render into, waiting for one if necessary
+ *
+ * @param writer Writer to take the buffer from
+ * @return       char* Buffer of buffer_size bytes, or NULL after a write error
+ */
+char *
+async_writer_acquire(async_writer_t *writer)
+{
+    async_state_t *state = writer->state;
+    char *buffer         = NULL;
+
+    if (ASYNC_BACKEND_SPLICE == writer->backend)
+    {
+        if (writer->failed || !splice_wait_consumed(writer, state->splice_next))
+        {
+            writer->failed = true;
+            return NULL;
+        }
+        return writer->pool + state->splice_next * writer->buffer_size;
+    }
+
+    if (ASYNC_BACKEND_THREAD == writer->backend)
+    {
+        pthread_mutex_lock(&state->lock);
+    }
+
+    if (0 == state->free_count)
+    {
+        writer->stats.stalls++;
+    }
+
+    while (0 == state->free_count && !writer->failed)
+    {
+#ifdef ASYNC_HAVE_URING
+        if (ASYNC_BACKEND_URING == writer->backend)
+        {
+            uring_reap(writer, true);
+            continue;
+        }
+#endif
+        pthread_cond_wait(&state->changed, &state->lock);
+    }
+
+    if (!writer->failed)
+    {
+        buffer = writer->pool + state->free_list[--state->free_count] * writer->buffer_size;
+    }
+
+    if (ASYNC_BACKEND_THREAD == writer->backend)
+    {
+        pthread_mutex_unlock(&state->lock);
+    }
+
+    return buffer;
+}
+
+/**
+ * @brief Return an acquired buffer without writing it
+ *
+ * @param writer  Writer the buffer came from
+ * @param data    Buffer to return
+ */
+void
+async_writer_release(async_writer_t *writer, char *data)
+{
+    async_state_t *state = writer->state;
+    size_t index         = (size_t)(data - writer->pool) / writer->buffer_size;
+
+    /* The rotation only advances on submit, so there is nothing to return */
+    if (ASYNC_BACKEND_SPLICE == writer->backend)
+    {
+        return;
+    }
+
+    if (ASYNC_BACKEND_THREAD == writer->backend)
+    {
+        pthread_mutex_lock(&state->lock);
+        state->free_list[state->free_count++] = index;
+        pthread_cond_broadcast(&state->changed);
+        pthread_mutex_unlock(&state->lock);
+        return;
+    }
+
+    state->free_list[state->free_count++] = index;
+}
+
+/**
+ * @brief Queue a buffer obtained from async_writer_acquire() for writing
+ *
+ * @param writer  Writer the buffer came from
+ * @param data    Buffer to write
+ * @param length  Number of bytes to write from the buffer
+ * @return        bool true on success, false after a write error
+ */
+bool
+async_writer_submit(async_writer_t *writer, char *data, size_t length)
+{
+    async_state_t *state = writer->state;
+    size_t index         = (size_t)(data - writer->pool) / writer->buffer_size;
+
+    if (0 == length || writer->failed)
+    {
+        async_writer_release(writer, data);
+        return !writer->failed;
+    }
+
+    state->lengths[index] = length;
+
+    if (ASYNC_BACKEND_SPLICE == writer->backend)
+    {
+        int unread = 0;
+        uint32_t depth;
+
+        if (!splice_submit(writer, index, length))
+        {
+            writer->failed = true;
+            return false;
+        }
+
+        /* Buffers whose pages are still (at least partly) in the pipe */
+        ioctl(writer->fd, FIONREAD, &unread);
+        depth = (uint32_t)(((size_t)unread + writer->buffer_size - 1) / writer->buffer_size);
+
+        writer->stats.writes++;
+        writer->stats.bytes       += length;
+        writer->stats.depth_total += depth;
+        if (depth > writer->stats.max_depth)
+            writer->stats.max_depth = depth;
+
+        return true;
+    }
+
+#ifdef ASYNC_HAVE_URING
+    if (ASYNC_BACKEND_URING == writer->backend)
+    {
+        while (state->in_flight >= writer->max_in_flight && !writer->failed)
+        {
+            uring_reap(writer, true);
+        }
+
+        /* Pick up bytes written through the file position since the last drain */
+        if (writer->positioned && state->resync)
+        {
+            writer->offset = lseek(writer->fd, 0, SEEK_CUR);
+            state->resync  = false;
+        }
+        state->offsets[index] = writer->offset;
+        writer->offset       += (off_t)length;
+
+        if (writer->failed || !uring_submit(writer, index))
+        {
+            writer->failed = true;
+            state->free_list[state->free_count++] = index;
+            return false;
+        }
+
+        state->in_flight++;
+        writer->stats.writes++;
+        writer->stats.bytes       += length;
+        writer->stats.depth_total += state->in_flight;
+        if (state->in_flight > writer->stats.max_depth)
+            writer->stats.max_depth = (uint32_t)state->in_flight;
+
+        /* Collect whatever has already finished, without blocking */
+        uring_reap(writer, false);
+        return !writer->failed;
+    }
+#endif
+
+    pthread_mutex_lock(&state->lock);
+    state->queue[(state->queue_head + state->queue_count) % ASYNC_MAX_BUFFERS] = index;
+    state->queue_count++;
+    state->in_flight++;
+    writer->stats.writes++;
+    writer->stats.bytes       += length;
+    writer->stats.depth_total += state->in_flight;
+    if (state->in_flight > writer->stats.max_depth)
+        writer->stats.max_depth = (uint32_t)state->in_flight;
+    pthread_cond_broadcast(&state->changed);
+    pthread_mutex_unlock(&state->lock);
+
+    return !writer->failed;
+}
+
+/**
+ * @brief Wait until every submitted buffer has been written
+ *
+ * @param writer Writer to drain
+ * @return       bool true if all writes succeeded
+ */
+bool
+async_writer_drain(async_writer_t *writer)
+{
+    async_state_t *state = writer->state;
+
+    /* Spliced data is already in the pipe, in order */
+    if (ASYNC_BACKEND_SPLICE == writer->backend)
+    {
+        return !writer->failed;
+    }
+
+#ifdef ASYNC_HAVE_URING
+    if (ASYNC_BACKEND_URING == writer->backend)
+    {
+        while (state->in_flight > 0 && !writer->failed)
+        {
+            uring_reap(writer, true);
+        }
+
+        /* Positioned writes leave the file position alone; move it past them */
+        if (writer->positioned && !state->resync)
+        {
+            if (lseek(writer->fd, writer->offset, SEEK_SET) < 0)
+                writer->failed = true;
+            state->resync = true;
+        }
+
+        return !writer->failed;
+    }
+#endif
+
+    pthread_mutex_lock(&state->lock);
+    while (state->in_flight > 0)
+    {
+        pthread_cond_wait(&state->changed, &state->lock);
+    }
+    pthread_mutex_unlock(&state->lock);
+
+    return !writer->failed;
+}
+
+/**
+ * @brief Drain and close a writer (the file descriptor stays open)
+ *
+ * @param writer Writer to close
+ * @return       bool true if all writes succeeded
+ */
+bool
+async_writer_close(async_writer_t *writer)
+{
+    bool success;
+
+    if (NULL == writer->state)
+    {
+        return false;
+    }
+
+    success = async_writer_drain(writer);
+
+#ifdef ASYNC_HAVE_URING
+    if (ASYNC_BACKEND_URING == writer->backend)
+    {
+        /* A failed writer may still have writes in flight into the pool */
+        while (writer->state->in_flight > 0)
+        {
+            if (syscall(__NR_io_uring_enter, writer->state->ring_fd, 0, 1,
+                        IORING_ENTER_GETEVENTS, NULL, 0) < 0 && EINTR != errno)
+            {
+                break;
+            }
+            uring_reap(writer, false);
+        }
+        uring_close(writer);
+    }
+#endif
+
+    if (ASYNC_BACKEND_THREAD == writer->backend)
+    {
+        pthread_mutex_lock(&writer->state->lock);
+        writer->state->stop = true;
+        pthread_cond_broadcast(&writer->state->changed);
+        pthread_mutex_unlock(&writer->state->lock);
+
+        pthread_join(writer->state->thread, NULL);
+        pthread_cond_destroy(&writer->state->changed);
+        pthread_mutex_destroy(&writer->state->lock);
+    }
+
+    if (ASYNC_BACKEND_SPLICE == writer->backend)
+    {
+        munmap(writer->pool, writer->buffer_count * writer->buffer_size);
+    }
+    else
+    {
+        free(writer->pool);
+    }
+
+    free(writer->state);
+    writer->state = NULL;
+    writer->pool  = NULL;
+
+    return success;
+}
+
+/**
+ * @brief Name of a backend, for reporting
+ *
+ * @param backend Backend
+ * @return        const char* "io_uring", "thread" or "auto"
+ */
+const char *
+async_backend_name(async_backend_t backend)
+{
+    switch (backend)
+    {
+        case ASYNC_BACKEND_URING:
+            return "io_uring";
+
+        case ASYNC_BACKEND_THREAD:
+            return "thread";
+
+        case ASYNC_BACKEND_SPLICE:
+            return "splice";
+
+        case ASYNC_BACKEND_AUTO:
+        default:
+            return "auto";
+    }
+}
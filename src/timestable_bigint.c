@@ -0,0 +1,270 @@
+/**
+ * @file timestable_bigint.c
+ * @brief Implementation of arbitrary-precision unsigned integers
+ *
+ * Limb arithmetic used to compute power table rows exactly.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "timestable_bigint.h"
+
+/**
+ * @brief Largest power of ten that fits in one 32-bit limb
+ */
+#define DECIMAL_CHUNK_BASE   1000000000u
+#define DECIMAL_CHUNK_DIGITS 9
+
+/**
+ * @brief Ensure a big integer can hold the given number of limbs
+ *
+ * @param value     Big integer to grow
+ * @param capacity  Required number of limbs
+ * @return          bool true on success, false if allocation failed
+ */
+static
+bool bigint_reserve(bigint_t *value, size_t capacity)
+{
+    uint32_t *limbs = NULL;
+
+    if (capacity <= value->capacity)
+    {
+        return true;
+    }
+
+    /* Grow geometrically so a row of multiplications reallocates rarely */
+    if (capacity < 2 * value->capacity)
+    {
+        capacity = 2 * value->capacity;
+    }
+
+    limbs = realloc(value->limbs, capacity * sizeof(*limbs));
+    if (NULL == limbs)
+    {
+        return false;
+    }
+
+    value->limbs    = limbs;
+    value->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Initialize a big integer to zero
+ *
+ * @param value     Big integer to initialize
+ * @param capacity  Number of limbs to preallocate (at least one is used)
+ * @return          bool true on success, false if allocation failed
+ */
+bool
+bigint_init(bigint_t *value, size_t capacity)
+{
+    value->limbs    = NULL;
+    value->length   = 0;
+    value->capacity = 0;
+
+    if (!bigint_reserve(value, (0 == capacity) ? 1 : capacity))
+    {
+        return false;
+    }
+
+    bigint_set_u32(value, 0);
+    return true;
+}
+
+/**
+ * @brief Release the limbs owned by a big integer
+ *
+ * @param value Big integer to release
+ */
+void
+bigint_free(bigint_t *value)
+{
+    free(value->limbs);
+    value->limbs    = NULL;
+    value->length   = 0;
+    value->capacity = 0;
+}
+
+/**
+ * @brief Set a big integer to a small value, keeping its allocation
+ *
+ * @param value  Big integer to update
+ * @param small  New value
+ */
+void
+bigint_set_u32(bigint_t *value, uint32_t small)
+{
+    value->limbs[0] = small;
+    value->length   = 1;
+}
+
+/**
+ * @brief Multiply a big integer in place by a small factor
+ *
+ * @param value   Big integer to update
+ * @param factor  Factor to multiply by
+ * @return        bool true on success, false if allocation failed
+ */
+bool
+bigint_mul_u32(bigint_t *value, uint32_t factor)
+{
+    uint64_t carry = 0;
+
+    if (0 == factor)
+    {
+        bigint_set_u32(value, 0);
+        return true;
+    }
+
+    for (size_t i = 0; i < value->length; i++)
+    {
+        uint64_t product = (uint64_t)value->limbs[i] * factor + carry;
+        value->limbs[i]  = (uint32_t)product;
+        carry            = product >> 32;
+    }
+
+    if (0 != carry)
+    {
+        if (!bigint_reserve(value, value->length + 1))
+        {
+            return false;
+        }
+        value->limbs[value->length++] = (uint32_t)carry;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Number of significant bits in a big integer
+ *
+ * @param value Big integer to measure
+ * @return      size_t Bit length (0 for zero)
+ */
+size_t
+bigint_bit_length(const bigint_t *value)
+{
+    uint32_t top  = value->limbs[value->length - 1];
+    size_t   bits = (value->length - 1) * 32;
+
+    while (top > 0)
+    {
+        bits++;
+        top >>= 1;
+    }
+
+    return bits;
+}
+
+/**
+ * @brief Upper bound on decimal digits for a value of the given bit length
+ *
+ * A value below 2^bits has at most floor(bits * log10(2)) + 1 digits; the
+ * rational 30103/100000 is slightly above log10(2), keeping this a bound.
+ *
+ * @param bits Bit length of the value
+ * @return     size_t Maximum number of decimal digits
+ */
+size_t
+bigint_decimal_digits(size_t bits)
+{
+    return (bits * 30103u) / 100000u + 1;
+}
+
+/**
+ * @brief Convert a big integer to decimal text
+ *
+ * @param value    Big integer to convert
+ * @param scratch  Working copy reused between calls (grown as needed)
+ * @param buffer   Destination, at least bigint_decimal_digits() bytes
+ * @param size     Size of the destination
+ * @return         size_t Number of characters written, 0 on failure
+ */
+size_t
+bigint_to_decimal(const bigint_t *value, bigint_t *scratch,
+                  char *buffer, size_t size)
+{
+    char *cursor = buffer + size;
+
+    if (!bigint_reserve(scratch, value->length))
+    {
+        return 0;
+    }
+    memcpy(scratch->limbs, value->limbs, value->length * sizeof(*value->limbs));
+    scratch->length = value->length;
+
+    /* Digits are produced least significant chunk first, from the end */
+    do
+    {
+        uint64_t remainder = 0;
+
+        for (size_t i = scratch->length; i-- > 0;)
+        {
+            uint64_t current  = (remainder << 32) | scratch->limbs[i];
+            scratch->limbs[i] = (uint32_t)(current / DECIMAL_CHUNK_BASE);
+            remainder         = current % DECIMAL_CHUNK_BASE;
+        }
+
+        while (scratch->length > 1 && 0 == scratch->limbs[scratch->length - 1])
+        {
+            scratch->length--;
+        }
+
+        bool last_chunk = (1 == scratch->length && 0 == scratch->limbs[0]);
+        int  digits     = 0;
+
+        do
+        {
+            if (cursor == buffer)
+            {
+                return 0;
+            }
+            *--cursor = (char)('0' + remainder % 10);
+            remainder /= 10;
+            digits++;
+        } while ((last_chunk) ? (remainder > 0) : (digits < DECIMAL_CHUNK_DIGITS));
+
+        if (last_chunk)
+        {
+            break;
+        }
+    } while (true);
+
+    size_t length = (size_t)(buffer + size - cursor);
+    memmove(buffer, cursor, length);
+    return length;
+}
+
+/**
+ * @brief Convert a big integer to hexadecimal text with a "0x" prefix
+ *
+ * @param value   Big integer to convert
+ * @param buffer  Destination, at least 2 + 8 * length bytes
+ * @param size    Size of the destination
+ * @return        size_t Number of characters written, 0 on failure
+ */
+size_t
+bigint_to_hex(const bigint_t *value, char *buffer, size_t size)
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    size_t bits   = bigint_bit_length(value);
+    size_t digits = (0 == bits) ? 1 : (bits + 3) / 4;
+
+    if (size < digits + 2)
+    {
+        return 0;
+    }
+
+    buffer[0] = '0';
+    buffer[1] = 'x';
+
+    for (size_t i = 0; i < digits; i++)
+    {
+        size_t   nibble = digits - 1 - i;
+        uint32_t limb   = value->limbs[nibble / 8];
+        buffer[2 + i]   = HEX_DIGITS[(limb >> (4 * (nibble % 8))) & 0xfu];
+    }
+
+    return digits + 2;
+}
@@ -0,0 +1,526 @@
+/**
+ * @file timestable_browser.c
+ * @brief Implementation of the interactive viewport browser
+ *
+ * Renders visible tiles on demand into an LRU cache and draws them with
+ * ncurses around frozen row and column headers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ncurses.h>
+#include "timestable_browser.h"
+
+#define BROWSE_MIN_CELL_WIDTH 4
+#define BROWSE_CELL_PADDING 1
+#define BROWSE_HEADER_LINES 3        /* Title, column header, separator */
+#define BROWSE_FOOTER_LINES 1        /* Status line */
+#define BROWSE_PROMPT_SIZE 64
+#define BROWSE_STATUS_SIZE 512
+
+/**
+ * @brief Viewport position and geometry
+ */
+typedef struct
+{
+    int64_t top_row;                 /**< Row value shown on the first body line */
+    int64_t left_column;             /**< Column value shown in the first cell */
+    int body_rows;                   /**< Number of table rows on screen */
+    int visible_columns;             /**< Number of table columns on screen */
+    int label_width;                 /**< Width of the frozen row labels */
+    int cell_width;                  /**< Width of every cell, with padding */
+} browse_view_t;
+
+/**
+ * @brief Format a row or column label
+ *
+ * @param value   Label value
+ * @param format  Output format
+ * @param buffer  Destination of BROWSE_CELL_SIZE bytes
+ * @return        int Length of the label
+ */
+static int
+format_label(int64_t value, output_format_t format, char *buffer)
+{
+    if (FORMAT_HEX == format)
+    {
+        return snprintf(buffer, BROWSE_CELL_SIZE, "0x%llx", (unsigned long long)value);
+    }
+
+    return snprintf(buffer, BROWSE_CELL_SIZE, "%lld", (long long)value);
+}
+
+/**
+ * @brief Compute and format every cell of one tile
+ *
+ * Built-in operations are computed on 64-bit values, so the far cells of
+ * an unlimited table are exact or read OVF rather than wrapping as int.
+ *
+ * @param table  Table to compute
+ * @param tile   Tile to fill; tile_row and tile_column select the cells
+ */
+static void
+render_tile(const browse_table_t *table, browse_tile_t *tile)
+{
+    int64_t first_row                    = table->min_value + tile->tile_row * BROWSE_TILE_ROWS;
+    int64_t first_column                 = table->min_value + tile->tile_column * BROWSE_TILE_COLUMNS;
+    int columns                          = BROWSE_TILE_COLUMNS;
+    const row_operation_t *row_operation = table->row_operation;
+    row_operation_t wide_operation;
+    uint64_t values[BROWSE_TILE_COLUMNS];
+
+    if (NULL != table->operation && table_row_operation(table->operation, &wide_operation))
+    {
+        row_operation = &wide_operation;
+    }
+
+    if (first_column + columns - 1 > table->max_value)
+    {
+        columns = (int)(table->max_value - first_column + 1);
+    }
+
+    memset(tile->length, 0, sizeof(tile->length));
+
+    for (int i = 0; i < BROWSE_TILE_ROWS && first_row + i <= table->max_value; i++)
+    {
+        int row = (int)(first_row + i);
+
+        if (NULL != row_operation)
+        {
+            row_operation->kernel(row_operation->context, row, (int)first_column, columns, values);
+        }
+
+        for (int j = 0; j < columns; j++)
+        {
+            char *text = tile->text[i][j];
+            int length = 0;
+
+            if (NULL == row_operation)
+            {
+                cell_value_t cell;
+
+                table->operation(row, (int)first_column + j, &cell);
+
+                if (!cell.is_numeric)
+                    length = snprintf(text, BROWSE_CELL_SIZE, "%s", cell.str_value);
+                else if (FORMAT_HEX == table->format)
+                    length = snprintf(text, BROWSE_CELL_SIZE, "0x%x", cell.num_value);
+                else
+                    length = snprintf(text, BROWSE_CELL_SIZE, "%d", cell.num_value);
+            }
+            else
+            {
+                const char *marker = row_value_marker(row_operation, values[j]);
+                bool negative      = row_operation->is_signed && (values[j] >> 63);
+                uint64_t value     = negative ? 0 - values[j] : values[j];
+                const char *sign   = negative ? "-" : "";
+
+                if (NULL != marker)
+                    length = snprintf(text, BROWSE_CELL_SIZE, "%s", marker);
+                else if (FORMAT_HEX == table->format)
+                    length = snprintf(text, BROWSE_CELL_SIZE, "%s0x%llx", sign, (unsigned long long)value);
+                else
+                    length = snprintf(text, BROWSE_CELL_SIZE, "%s%llu", sign, (unsigned long long)value);
+            }
+
+            tile->length[i][j] = (uint8_t)length;
+        }
+    }
+}
+
+/**
+ * @brief Initialize an empty tile cache for a table
+ *
+ * @param cache  Cache to initialize
+ * @param table  Table whose cells are cached
+ * @return       bool true on success, false if allocation failed
+ */
+bool
+browse_cache_init(browse_cache_t *cache, const browse_table_t *table)
+{
+    cache->table  = table;
+    cache->tiles  = malloc(BROWSE_CACHE_TILES * sizeof(*cache->tiles));
+    cache->clock  = 0;
+    cache->hits   = 0;
+    cache->misses = 0;
+
+    if (NULL == cache->tiles)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < BROWSE_CACHE_TILES; i++)
+    {
+        cache->tiles[i].tile_row  = -1;
+        cache->tiles[i].last_used = 0;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Release a tile cache
+ *
+ * @param cache Cache to release
+ */
+void
+browse_cache_free(browse_cache_t *cache)
+{
+    free(cache->tiles);
+    cache->tiles = NULL;
+}
+
+/**
+ * @brief Get the tile holding a cell, rendering it on a miss
+ *
+ * @param cache   Tile cache
+ * @param row     Row value of any cell in the tile
+ * @param column  Column value of any cell in the tile
+ * @return        const browse_tile_t* Tile containing the cell
+ */
+const browse_tile_t *
+browse_cache_get(browse_cache_t *cache, int64_t row, int64_t column)
+{
+    int64_t tile_row    = (row - cache->table->min_value) / BROWSE_TILE_ROWS;
+    int64_t tile_column = (column - cache->table->min_value) / BROWSE_TILE_COLUMNS;
+    browse_tile_t *lru  = &cache->tiles[0];
+
+    cache->clock++;
+
+    for (int i = 0; i < BROWSE_CACHE_TILES; i++)
+    {
+        browse_tile_t *tile = &cache->tiles[i];
+
+        if (tile->tile_row == tile_row && tile->tile_column == tile_column)
+        {
+            tile->last_used = cache->clock;
+            cache->hits++;
+            return tile;
+        }
+
+        if (tile->last_used < lru->last_used)
+        {
+            lru = tile;
+        }
+    }
+
+    /* Miss: evict the least recently used tile and render into it */
+    lru->tile_row    = tile_row;
+    lru->tile_column = tile_column;
+    lru->last_used   = cache->clock;
+    render_tile(cache->table, lru);
+    cache->misses++;
+
+    return lru;
+}
+
+/**
+ * @brief Get the text of one cell through the cache
+ *
+ * @param cache   Tile cache
+ * @param row     Row value
+ * @param column  Column value
+ * @param length  Pointer to store the text length
+ * @return        const char* Cell text (not NUL terminated)
+ */
+static const char *
+cell_text(browse_cache_t *cache, int64_t row, int64_t column, int *length)
+{
+    const browse_tile_t *tile = browse_cache_get(cache, row, column);
+    int i = (int)((row - cache->table->min_value) % BROWSE_TILE_ROWS);
+    int j = (int)((column - cache->table->min_value) % BROWSE_TILE_COLUMNS);
+
+    *length = tile->length[i][j];
+    return tile->text[i][j];
+}
+
+/**
+ * @brief Clamp a viewport origin so the view stays inside the table
+ *
+ * @param value    Requested origin
+ * @param visible  Number of rows or columns on screen
+ * @param table    Table being browsed
+ * @return         int64_t Clamped origin
+ */
+static int64_t
+clamp_origin(int64_t value, int visible, const browse_table_t *table)
+{
+    int64_t last = (int64_t)table->max_value - visible + 1;
+
+    if (value > last)
+        value = last;
+    if (value < table->min_value)
+        value = table->min_value;
+
+    return value;
+}
+
+/**
+ * @brief Fit the cell width to the widest cell currently on screen
+ *
+ * The number of visible columns depends on the width and vice versa, so
+ * the fit is repeated until it is stable (at most a couple of passes).
+ *
+ * @param cache  Tile cache
+ * @param view   Viewport to update
+ * @param width  Screen width in characters
+ */
+static void
+fit_columns(browse_cache_t *cache, browse_view_t *view, int width)
+{
+    const browse_table_t *table = cache->table;
+    char label[BROWSE_CELL_SIZE];
+
+    int64_t columns = (int64_t)table->max_value - table->min_value + 1;
+    int space       = 0;
+
+    view->label_width = format_label(table->max_value, table->format, label) + BROWSE_CELL_PADDING;
+    space             = width - view->label_width - 2;
+
+    for (int pass = 0; pass < 3; pass++)
+    {
+        int widest = BROWSE_MIN_CELL_WIDTH;
+
+        view->visible_columns = space / view->cell_width;
+        if (view->visible_columns < 1)
+            view->visible_columns = 1;
+        if (view->visible_columns > columns)
+            view->visible_columns = (int)columns;
+
+        view->left_column = clamp_origin(view->left_column, view->visible_columns, table);
+
+        for (int j = 0; j < view->visible_columns; j++)
+        {
+            int64_t column = view->left_column + j;
+            int length     = format_label(column, table->format, label);
+
+            widest = (length > widest) ? length : widest;
+
+            for (int i = 0; i < view->body_rows && view->top_row + i <= table->max_value; i++)
+            {
+                cell_text(cache, view->top_row + i, column, &length);
+                widest = (length > widest) ? length : widest;
+            }
+        }
+
+        widest += BROWSE_CELL_PADDING;
+        if (widest == view->cell_width)
+        {
+            return;
+        }
+
+        /* Never shrink on the last pass, so every visible cell still fits */
+        view->cell_width = (pass < 2 || widest > view->cell_width) ? widest : view->cell_width;
+    }
+
+    view->visible_columns = space / view->cell_width;
+    if (view->visible_columns < 1)
+        view->visible_columns = 1;
+    if (view->visible_columns > columns)
+        view->visible_columns = (int)columns;
+}
+
+/**
+ * @brief Draw right-aligned text in a cell
+ *
+ * @param y       Screen line
+ * @param x       Screen column of the cell
+ * @param text    Cell text
+ * @param length  Length of the text
+ * @param width   Width of the cell
+ */
+static void
+draw_cell(int y, int x, const char *text, int length, int width)
+{
+    mvaddnstr(y, x + width - length, text, length);
+}
+
+/**
+ * @brief Redraw the whole screen for the current viewport
+ *
+ * @param cache  Tile cache
+ * @param view   Viewport to draw (origin and geometry are updated)
+ */
+static void
+draw_view(browse_cache_t *cache, browse_view_t *view)
+{
+    const browse_table_t *table = cache->table;
+    char label[BROWSE_CELL_SIZE];
+    char status[BROWSE_STATUS_SIZE];
+    int lines  = 0;
+    int width  = 0;
+    int length = 0;
+    int x      = 0;
+
+    getmaxyx(stdscr, lines, width);
+    view->body_rows = lines - BROWSE_HEADER_LINES - BROWSE_FOOTER_LINES;
+    if (view->body_rows < 1)
+        view->body_rows = 1;
+
+    view->top_row = clamp_origin(view->top_row, view->body_rows, table);
+    fit_columns(cache, view, width);
+
+    erase();
+
+    attron(A_BOLD);
+    mvaddnstr(0, 0, table->title, width);
+    attroff(A_BOLD);
+
+    /* Frozen column header and separator */
+    mvaddstr(1, view->label_width, " |");
+    mvhline(2, 0, '-', view->label_width + 1);
+    mvaddch(2, view->label_width + 1, '+');
+    x = view->label_width + 2;
+    for (int j = 0; j < view->visible_columns; j++, x += view->cell_width)
+    {
+        length = format_label(view->left_column + j, table->format, label);
+        draw_cell(1, x, label, length, view->cell_width);
+    }
+    mvhline(2, view->label_width + 2, '-', x - view->label_width - 2);
+
+    /* Frozen row labels and body */
+    for (int i = 0; i < view->body_rows && view->top_row + i <= table->max_value; i++)
+    {
+        int y       = BROWSE_HEADER_LINES + i;
+        int64_t row = view->top_row + i;
+
+        length = format_label(row, table->format, label);
+        draw_cell(y, 0, label, length, view->label_width);
+        mvaddstr(y, view->label_width, " |");
+
+        x = view->label_width + 2;
+        for (int j = 0; j < view->visible_columns; j++, x += view->cell_width)
+        {
+            const char *text = cell_text(cache, row, view->left_column + j, &length);
+            draw_cell(y, x, text, length, view->cell_width);
+        }
+    }
+
+    snprintf(status, sizeof(status),
+             " r %lld c %lld | arrows/hjkl scroll  PgUp/PgDn  [ ] page columns  Home/End  g go to  q quit",
+             (long long)view->top_row, (long long)view->left_column);
+    attron(A_REVERSE);
+    mvhline(lines - 1, 0, ' ', width);
+    mvaddnstr(lines - 1, 0, status, width);
+    attroff(A_REVERSE);
+
+    refresh();
+}
+
+/**
+ * @brief Ask for a "row,column" position and jump to it
+ *
+ * @param view   Viewport to move
+ */
+static void
+prompt_goto(browse_view_t *view)
+{
+    char input[BROWSE_PROMPT_SIZE] = "";
+    long long row                  = 0;
+    long long column               = 0;
+    int lines                      = getmaxy(stdscr);
+
+    attron(A_REVERSE);
+    mvhline(lines - 1, 0, ' ', COLS);
+    mvaddstr(lines - 1, 0, " Go to row,column: ");
+    attroff(A_REVERSE);
+
+    echo();
+    curs_set(1);
+    getnstr(input, BROWSE_PROMPT_SIZE - 1);
+    curs_set(0);
+    noecho();
+
+    switch (sscanf(input, "%lld%*[ ,]%lld", &row, &column))
+    {
+        case 2:
+            view->top_row     = row;
+            view->left_column = column;
+        break;
+
+        case 1:
+            view->top_row = row;
+        break;
+
+        default:
+        break;
+    }
+}
+
+/**
+ * @brief Run the interactive browser until the user quits
+ *
+ * @param table Table to browse
+ * @return      bool true on normal exit, false if the terminal or memory
+ *              could not be set up
+ */
+bool
+browse_table(const browse_table_t *table)
+{
+    browse_cache_t cache;
+    browse_view_t view = {
+        .top_row     = table->min_value,
+        .left_column = table->min_value,
+        .cell_width  = BROWSE_MIN_CELL_WIDTH + BROWSE_CELL_PADDING
+    };
+    bool running       = true;
+
+    if (!browse_cache_init(&cache, table))
+    {
+        return false;
+    }
+
+    if (NULL == initscr())
+    {
+        browse_cache_free(&cache);
+        return false;
+    }
+    cbreak();
+    noecho();
+    curs_set(0);
+    keypad(stdscr, TRUE);
+
+    while (running)
+    {
+        draw_view(&cache, &view);
+
+        switch (getch())
+        {
+            case KEY_UP:    case 'k':   view.top_row--;                             break;
+            case KEY_DOWN:  case 'j':   view.top_row++;                             break;
+            case KEY_LEFT:  case 'h':   view.left_column--;                         break;
+            case KEY_RIGHT: case 'l':   view.left_column++;                         break;
+            case KEY_PPAGE:             view.top_row -= view.body_rows;             break;
+            case KEY_NPAGE: case ' ':   view.top_row += view.body_rows;             break;
+            case '[':                   view.left_column -= view.visible_columns;   break;
+            case ']':                   view.left_column += view.visible_columns;   break;
+
+            case KEY_HOME:
+                view.top_row     = table->min_value;
+                view.left_column = table->min_value;
+            break;
+
+            case KEY_END:
+                view.top_row     = table->max_value;
+                view.left_column = table->max_value;
+            break;
+
+            case 'g':
+                prompt_goto(&view);
+            break;
+
+            case 'q':
+            case 'Q':
+                running = false;
+            break;
+
+            default:
+            break;
+        }
+    }
+
+    endwin();
+    browse_cache_free(&cache);
+    return true;
+}
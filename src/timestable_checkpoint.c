@@ -0,0 +1,291 @@
+/**
+ * @file timestable_checkpoint.c
+ * @brief Implementation of output checkpoints
+ *
+ * The record is one fixed-size line of text rewritten in place, ending in
+ * a checksum of the rest, so a torn or foreign record is detected rather
+ * than trusted.
+ */
+
+#include <stdio.h>                  // snprintf(), sscanf()
+#include <string.h>                 // memset(), memcpy()
+#include <errno.h>                  // errno, EINTR
+#include <fcntl.h>                  // open(), O_RDWR, O_CREAT
+#include <unistd.h>                 // pread(), pwrite(), ftruncate(), fdatasync(), lseek(), close()
+#include <time.h>                   // clock_gettime(), CLOCK_MONOTONIC
+#include <sys/stat.h>               // fstat(), S_ISREG
+
+#include "timestable_checkpoint.h"  // checkpoint_t, checkpoint_error_t
+
+/**
+ * @brief Size of the record, including the trailing newline
+ */
+#define RECORD_SIZE 128
+
+/**
+ * @brief Characters of the record covered by its checksum
+ */
+#define RECORD_BODY 110
+
+static const checkpoint_error_t CHECKPOINT_ERRORS[] = {
+    {CHECKPOINT_SUCCESS,            "Success"},
+    {CHECKPOINT_ERROR_OPEN,         "Cannot open checkpoint file"},
+    {CHECKPOINT_ERROR_OUTPUT,       "Checkpointed output must be redirected to a regular file"},
+    {CHECKPOINT_ERROR_CORRUPT,      "Checkpoint file is damaged"},
+    {CHECKPOINT_ERROR_MISMATCH,     "Checkpoint was written with different table options"},
+    {CHECKPOINT_ERROR_WRITE,        "Cannot write checkpoint"}
+};
+
+static const size_t CHECKPOINT_ERRORS_COUNT = sizeof(CHECKPOINT_ERRORS) / sizeof(CHECKPOINT_ERRORS[0]);
+
+/**
+ * @brief Look up the error structure for a checkpoint error code
+ *
+ * @param code  Error code
+ * @return      checkpoint_error_t structure with error code and message
+ */
+static checkpoint_error_t
+checkpoint_error(checkpoint_error_code_t code)
+{
+    for (size_t i = 0; i < CHECKPOINT_ERRORS_COUNT; i++)
+    {
+        if (code == CHECKPOINT_ERRORS[i].code)
+        {
+            return CHECKPOINT_ERRORS[i];
+        }
+    }
+
+    return (checkpoint_error_t){.code = code, .message = "Unknown error"};
+}
+
+/**
+ * @brief Read the monotonic clock
+ *
+ * @return uint64_t Nanoseconds since an arbitrary point
+ */
+static uint64_t
+now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief FNV-1a hash of the record body
+ *
+ * @param record Record text
+ * @return       uint32_t Checksum of the first RECORD_BODY characters
+ */
+static uint32_t
+record_checksum(const char *record)
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < RECORD_BODY; i++)
+    {
+        hash = (hash ^ (unsigned char)record[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Read and check the record of a checkpoint file
+ *
+ * @param checkpoint  Checkpoint being opened (signature set)
+ * @param offset      Set to the recorded output offset
+ * @return            checkpoint_error_code_t CHECKPOINT_SUCCESS with the
+ *                    position filled in, or why the record cannot be used
+ */
+static checkpoint_error_code_t
+read_record(checkpoint_t *checkpoint, off_t *offset)
+{
+    char record[RECORD_SIZE + 1];
+    unsigned long long signature;
+    unsigned table;
+    int row;
+    long long position;
+    unsigned checksum;
+    ssize_t length = pread(checkpoint->fd, record, RECORD_SIZE, 0);
+
+    /* No record yet: the previous run never got as far as a checkpoint */
+    if (0 == length)
+    {
+        checkpoint->resume_table = 0;
+        checkpoint->resume_row   = CHECKPOINT_TABLE_START;
+        *offset                  = 0;
+        return CHECKPOINT_SUCCESS;
+    }
+
+    record[(length < 0) ? 0 : length] = '\0';
+    if (RECORD_SIZE != length ||
+        4 != sscanf(record, "timestable-checkpoint 1 %llx %u %d %lld",
+                    &signature, &table, &row, &position) ||
+        1 != sscanf(record + RECORD_BODY, "%x", &checksum) ||
+        checksum != record_checksum(record) || position < 0)
+    {
+        return CHECKPOINT_ERROR_CORRUPT;
+    }
+
+    if (signature != checkpoint->signature)
+    {
+        return CHECKPOINT_ERROR_MISMATCH;
+    }
+
+    checkpoint->resume_table = table;
+    checkpoint->resume_row   = row;
+    *offset                  = (off_t)position;
+    return CHECKPOINT_SUCCESS;
+}
+
+/**
+ * @brief Open a checkpoint file, and with resume restore its position
+ *
+ * @param checkpoint  Checkpoint to initialize
+ * @param path        Path of the checkpoint file
+ * @param output_fd   Output file descriptor (a regular file)
+ * @param signature   Hash of the options producing the output
+ * @param resume      Continue from the recorded position
+ * @return            checkpoint_error_t structure with error code and message
+ */
+checkpoint_error_t
+checkpoint_open(checkpoint_t *checkpoint, const char *path, int output_fd,
+                uint64_t signature, bool resume)
+{
+    checkpoint_error_code_t error_code = CHECKPOINT_SUCCESS;
+    struct stat info;
+    off_t offset                       = 0;
+
+    memset(checkpoint, 0, sizeof(*checkpoint));
+    checkpoint->output_fd = output_fd;
+    checkpoint->signature = signature;
+    checkpoint->last_ns   = now_ns();
+
+    checkpoint->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (checkpoint->fd < 0)
+    {
+        error_code = CHECKPOINT_ERROR_OPEN;
+        goto exit_function;
+    }
+
+    if (0 != fstat(output_fd, &info) || !S_ISREG(info.st_mode))
+    {
+        error_code = CHECKPOINT_ERROR_OUTPUT;
+        goto exit_function;
+    }
+
+    /* A fresh run starts where the output currently ends (appending) or
+       at its file position, before anything is written */
+    if (!resume)
+    {
+        offset = (fcntl(output_fd, F_GETFL) & O_APPEND) ? info.st_size
+                                                         : lseek(output_fd, 0, SEEK_CUR);
+        if (0 != ftruncate(checkpoint->fd, 0) || offset < 0 ||
+            CHECKPOINT_SUCCESS != checkpoint_commit(checkpoint, 0, CHECKPOINT_TABLE_START,
+                                                    offset).code)
+        {
+            error_code = CHECKPOINT_ERROR_WRITE;
+        }
+        goto exit_function;
+    }
+
+    error_code = read_record(checkpoint, &offset);
+    if (CHECKPOINT_SUCCESS != error_code)
+    {
+        goto exit_function;
+    }
+
+    /* Drop whatever was written after the record, then continue from there */
+    if (0 != ftruncate(output_fd, offset) || lseek(output_fd, offset, SEEK_SET) < 0)
+    {
+        error_code = CHECKPOINT_ERROR_OUTPUT;
+        goto exit_function;
+    }
+
+    checkpoint->resuming = true;
+
+exit_function:
+    if (CHECKPOINT_SUCCESS != error_code)
+    {
+        checkpoint_close(checkpoint);
+    }
+
+    return checkpoint_error(error_code);
+}
+
+/**
+ * @brief Check whether a row-boundary checkpoint is due
+ *
+ * @param checkpoint Open checkpoint
+ * @return           bool true if CHECKPOINT_INTERVAL_MS have passed since the
+ *                   last record
+ */
+bool
+checkpoint_due(const checkpoint_t *checkpoint)
+{
+    return now_ns() - checkpoint->last_ns >= (uint64_t)CHECKPOINT_INTERVAL_MS * 1000000u;
+}
+
+/**
+ * @brief Record a position once everything before it is on disk
+ *
+ * @param checkpoint  Open checkpoint
+ * @param table       Table being written (display order index)
+ * @param next_row    First row not yet written, or CHECKPOINT_TABLE_START
+ * @param offset      Output offset where next_row starts
+ * @return            checkpoint_error_t structure with error code and message
+ */
+checkpoint_error_t
+checkpoint_commit(checkpoint_t *checkpoint, uint32_t table, int next_row, off_t offset)
+{
+    char record[RECORD_SIZE + 1];
+    ssize_t written;
+
+    /* The data must be durable before a record may point past it */
+    if (0 != fdatasync(checkpoint->output_fd))
+    {
+        return checkpoint_error(CHECKPOINT_ERROR_WRITE);
+    }
+
+    memset(record, ' ', RECORD_SIZE);
+    snprintf(record, RECORD_BODY, "timestable-checkpoint 1 %016llx %u %d %lld",
+             (unsigned long long)checkpoint->signature, (unsigned)table, next_row,
+             (long long)offset);
+    memset(record + strlen(record), ' ', RECORD_BODY - strlen(record));
+    snprintf(record + RECORD_BODY, RECORD_SIZE + 1 - RECORD_BODY, "%08x", record_checksum(record));
+    memset(record + RECORD_BODY + 8, ' ', RECORD_SIZE - RECORD_BODY - 8);
+    record[RECORD_SIZE - 1] = '\n';
+
+    do
+    {
+        written = pwrite(checkpoint->fd, record, RECORD_SIZE, 0);
+    }
+    while (written < 0 && EINTR == errno);
+
+    if (RECORD_SIZE != written || 0 != fdatasync(checkpoint->fd))
+    {
+        return checkpoint_error(CHECKPOINT_ERROR_WRITE);
+    }
+
+    checkpoint->last_ns = now_ns();
+    checkpoint->records++;
+    return checkpoint_error(CHECKPOINT_SUCCESS);
+}
+
+/**
+ * @brief Close a checkpoint file
+ *
+ * @param checkpoint Checkpoint to close
+ */
+void
+checkpoint_close(checkpoint_t *checkpoint)
+{
+    if (checkpoint->fd >= 0)
+    {
+        close(checkpoint->fd);
+    }
+
+    checkpoint->fd = -1;
+}
@@ -16,20 +16,98 @@
 
 #include "colors.h"                 // RED, GRN, YLW, BLU, MAG, CYN, CLR
 #include "timestable_cli.h"         // cli_error_t, program_options_t, cli_parse_args(), cli_print_usage()
+#include "timestable_scheduler.h"   // SCHEDULER_MAX_WORKERS
+#include "timestable_find.h"        // FIND_MAX_VALUE
+#include "timestable_aggregate.h"   // AGG_MAX_VALUE, AGG_MAX_CLOSED_VALUE, AGG_MAX_HISTOGRAM_SIDE
+#include "timestable_decimal.h"     // DECIMAL_MAX_DIGITS, DECIMAL_SHORTEST
 
 #define MAX_TABLE_SIZE 100
+#define MAX_BIG_TABLE_SIZE 1000
+#define MAX_LONG_TABLE_SIZE 46340
+#define MIN_ASYNC_BUFFER_KIB 4
+#define MAX_ASYNC_BUFFER_KIB 65536
 
 static const cli_error_t CLI_ERRORS[] = {
     {CLI_SUCCESS,                   "Success"},
     {CLI_ERROR_INVALID_MIN,         "Invalid minimum value"},
-    {CLI_ERROR_INVALID_MAX,         "Invalid maximum value (must be between 0 and 100)"},
+    {CLI_ERROR_INVALID_MAX,         "Invalid maximum value (must be between 0 and 100, 1000 with -b, 46340 with --checkpoint, --shard or --compact, any with --browse)"},
     {CLI_ERROR_MIN_GT_MAX,          "Minimum value cannot be greater than maximum value"},
-    {CLI_ERROR_INVALID_TABLE_TYPE,  "Invalid table type (use m, d, p, or a)"},
-    {CLI_ERROR_INVALID_OPTION,      "Unknown or invalid option"}
+    {CLI_ERROR_INVALID_TABLE_TYPE,  "Invalid table type (use m, d, p, M, P, g, l, r, or a)"},
+    {CLI_ERROR_INVALID_OPTION,      "Unknown or invalid option"},
+    {CLI_ERROR_INVALID_MODULUS,     "Invalid modulus (-t M and -t P need --mod with 1 <= m < 2^64)"},
+    {CLI_ERROR_INVALID_PLUGIN,      "Plugin tables need both --plugin and --op"},
+    {CLI_ERROR_INVALID_EXPRESSION,  "Invalid expression"},
+    {CLI_ERROR_INVALID_WRITER,      "Invalid record format (use csv, tsv, jsonl or md)"},
+    {CLI_ERROR_INVALID_ASYNC,       "Invalid asynchronous output (--async[=uring|thread|splice], --buffers 2-64, --buffer-size 4-65536 KiB)"},
+    {CLI_ERROR_INVALID_JOBS,        "Invalid job count (-j 1-256, not with -B, -F, -b, --browse or --triangle)"},
+    {CLI_ERROR_INVALID_CHECKPOINT,  "Invalid checkpoint (--resume needs --checkpoint; not with -B, -F, -j or --browse)"},
+    {CLI_ERROR_INVALID_SHARD,       "Invalid shard (--shard i/N with 0 <= i < N and one table; not with -B, -F, -j, --browse or --checkpoint)"},
+    {CLI_ERROR_INVALID_FIND,        "Invalid lookup (--find VALUE or --find-file FILE for -t m, d, p or a; -M up to 10000000)"},
+    {CLI_ERROR_INVALID_AGGREGATE,   "Invalid aggregate (--agg sum|min|max|hist or --range-sum r0:r1,c0:c1 up to 10000, or 1000000 over m, d and p; hist up to 4096 rows)"},
+    {CLI_ERROR_INVALID_PRECISION,   "Invalid precision (--precision 1-18 or shortest for -t d or a; decimal text only, not with -F, -j or --browse)"},
+    {CLI_ERROR_INVALID_OUTPUT,      "Invalid output (--out dec|hex|bin|csv|tsv|jsonl|md:FILE or :stdout, up to 8; not with -x, -B, -F, -b, -j, --browse, --triangle, --precision, --checkpoint or --shard)"},
+    {CLI_ERROR_INVALID_COMPACT,     "Invalid compact layout (--compact is decimal or hex text only; not with -B, -F, -b, -j, --browse, --triangle, --precision, --shard or --out)"}
 };
 
 static const size_t CLI_ERRORS_COUNT = sizeof(CLI_ERRORS) / sizeof(CLI_ERRORS[0]);
 
+/**
+ * @brief Identifiers for options that only have a long form
+ */
+enum
+{
+    OPTION_MODULUS = 256,
+    OPTION_PLUGIN,
+    OPTION_PLUGIN_OP,
+    OPTION_BROWSE,
+    OPTION_TRIANGLE,
+    OPTION_ASYNC,
+    OPTION_ASYNC_BUFFERS,
+    OPTION_ASYNC_SIZE,
+    OPTION_ASYNC_STATS,
+    OPTION_NO_SPLICE,
+    OPTION_STATS,
+    OPTION_CHECKPOINT,
+    OPTION_RESUME,
+    OPTION_SHARD,
+    OPTION_SHARD_OFFSETS,
+    OPTION_FIND,
+    OPTION_FIND_FILE,
+    OPTION_AGGREGATE,
+    OPTION_RANGE_SUM,
+    OPTION_PRECISION,
+    OPTION_OUTPUT,
+    OPTION_COMPACT,
+    OPTION_TRACE
+};
+
+static const struct option CLI_LONG_OPTIONS[] = {
+    {"mod",                 required_argument, NULL, OPTION_MODULUS},
+    {"plugin",              required_argument, NULL, OPTION_PLUGIN},
+    {"op",                  required_argument, NULL, OPTION_PLUGIN_OP},
+    {"browse",              no_argument,       NULL, OPTION_BROWSE},
+    {"triangle",            no_argument,       NULL, OPTION_TRIANGLE},
+    {"async",               optional_argument, NULL, OPTION_ASYNC},
+    {"buffers",             required_argument, NULL, OPTION_ASYNC_BUFFERS},
+    {"buffer-size",         required_argument, NULL, OPTION_ASYNC_SIZE},
+    {"async-stats",         no_argument,       NULL, OPTION_ASYNC_STATS},
+    {"no-splice",           no_argument,       NULL, OPTION_NO_SPLICE},
+    {"stats",               no_argument,       NULL, OPTION_STATS},
+    {"checkpoint",          required_argument, NULL, OPTION_CHECKPOINT},
+    {"resume",              no_argument,       NULL, OPTION_RESUME},
+    {"shard",               required_argument, NULL, OPTION_SHARD},
+    {"print-shard-offsets", no_argument,       NULL, OPTION_SHARD_OFFSETS},
+    {"find",                required_argument, NULL, OPTION_FIND},
+    {"find-file",           required_argument, NULL, OPTION_FIND_FILE},
+    {"agg",                 required_argument, NULL, OPTION_AGGREGATE},
+    {"range-sum",           required_argument, NULL, OPTION_RANGE_SUM},
+    {"precision",           required_argument, NULL, OPTION_PRECISION},
+    {"out",                 required_argument, NULL, OPTION_OUTPUT},
+    {"compact",             no_argument,       NULL, OPTION_COMPACT},
+    {"trace",               required_argument, NULL, OPTION_TRACE},
+    {NULL,                  0,                 NULL, 0}
+};
+
 /**
  * @brief Parse a string as an integer with error checking
  *
@@ -39,8 +117,8 @@ static const size_t CLI_ERRORS_COUNT = sizeof(CLI_ERRORS) / sizeof(CLI_ERRORS[0]
  * @param max_val   Maximum allowed value
  * @return          bool true if parsing was successful, false otherwise
  */
-static
-bool parse_integer(const char *str, int *result, int min, int max)
+bool
+cli_parse_integer(const char *str, int *result, int min, int max)
 {
     /* Initialize variables */
     char *endptr = NULL;
@@ -69,6 +147,232 @@ bool parse_integer(const char *str, int *result, int min, int max)
     return true;
 }
 
+/**
+ * @brief Parse a string as an unsigned 64-bit integer with error checking
+ *
+ * @param str       String to parse
+ * @param result    Pointer to store the result
+ * @return          bool true if parsing was successful, false otherwise
+ */
+bool
+cli_parse_uint64(const char *str, uint64_t *result)
+{
+    char *endptr             = NULL;
+    unsigned long long value = 0;
+    errno                    = 0;
+
+    /* strtoull() silently negates a leading minus sign, so reject it */
+    if (NULL != strchr(str, '-'))
+    {
+        return false;
+    }
+
+    value = strtoull(str, &endptr, 10);
+
+    if (ERANGE == errno || endptr == str || *endptr != '\0')
+    {
+        return false;
+    }
+
+    *result = (uint64_t)value;
+    return true;
+}
+
+/**
+ * @brief Parse a shard selection of the form i/N
+ *
+ * @param str       String to parse
+ * @param index     Pointer to store the shard number i
+ * @param count     Pointer to store the number of shards N
+ * @return          bool true if parsing was successful and 0 <= i < N
+ */
+static
+bool parse_shard(const char *str, int *index, int *count)
+{
+    char text[32];
+    char *slash = NULL;
+
+    if (strlen(str) >= sizeof(text))
+    {
+        return false;
+    }
+
+    strcpy(text, str);
+    slash = strchr(text, '/');
+    if (NULL == slash)
+    {
+        return false;
+    }
+
+    *slash = '\0';
+    return cli_parse_integer(slash + 1, count, 1, INT_MAX) &&
+           cli_parse_integer(text, index, 0, *count - 1);
+}
+
+/**
+ * @brief Parse an aggregate name
+ *
+ * @param str       String to parse (sum, min, max or hist)
+ * @param kind      Pointer to store the reduction
+ * @return          bool true if parsing was successful
+ */
+static
+bool parse_aggregate(const char *str, agg_kind_t *kind)
+{
+    static const struct
+    {
+        const char *name;
+        agg_kind_t kind;
+    } AGGREGATES[] = {
+        {"sum",  AGG_SUM},
+        {"min",  AGG_MIN},
+        {"max",  AGG_MAX},
+        {"hist", AGG_HISTOGRAM}
+    };
+
+    for (size_t i = 0; i < sizeof(AGGREGATES) / sizeof(AGGREGATES[0]); i++)
+    {
+        if (0 == strcmp(str, AGGREGATES[i].name))
+        {
+            *kind = AGGREGATES[i].kind;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Parse an interval of the form first:last
+ *
+ * @param str       String to parse (modified)
+ * @param first     Pointer to store the first value
+ * @param last      Pointer to store the last value
+ * @return          bool true if parsing was successful and
+ *                  0 <= first <= last <= AGG_MAX_CLOSED_VALUE
+ */
+static
+bool parse_interval(char *str, int *first, int *last)
+{
+    char *colon = strchr(str, ':');
+
+    if (NULL == colon)
+    {
+        return false;
+    }
+
+    *colon = '\0';
+    return cli_parse_integer(str, first, 0, AGG_MAX_CLOSED_VALUE) &&
+           cli_parse_integer(colon + 1, last, *first, AGG_MAX_CLOSED_VALUE);
+}
+
+/**
+ * @brief Parse a rectangle of the form r0:r1,c0:c1
+ *
+ * @param str       String to parse
+ * @param rect      Pointer to store the rows and columns
+ * @return          bool true if parsing was successful
+ */
+static
+bool parse_rectangle(const char *str, agg_rect_t *rect)
+{
+    char text[64];
+    char *comma = NULL;
+
+    if (strlen(str) >= sizeof(text))
+    {
+        return false;
+    }
+
+    strcpy(text, str);
+    comma = strchr(text, ',');
+    if (NULL == comma)
+    {
+        return false;
+    }
+
+    *comma = '\0';
+    return parse_interval(text, &rect->first_row, &rect->last_row) &&
+           parse_interval(comma + 1, &rect->first_column, &rect->last_column);
+}
+
+/**
+ * @brief Parse an output of the form format:path
+ *
+ * @param str       String to parse (format dec, hex, bin or a record writer
+ *                  name; path stdout or - for standard output)
+ * @param spec      Pointer to store the output
+ * @return          bool true if parsing was successful
+ */
+static
+bool parse_output(const char *str, output_spec_t *spec)
+{
+    static const struct
+    {
+        const char *name;
+        output_format_t format;
+    } FORMATS[] = {
+        {"dec", FORMAT_DECIMAL},
+        {"hex", FORMAT_HEX},
+        {"bin", FORMAT_BINARY}
+    };
+    const char *colon = strchr(str, ':');
+    char name[8];
+
+    if (NULL == colon || '\0' == colon[1] || (size_t)(colon - str) >= sizeof(name))
+    {
+        return false;
+    }
+
+    memcpy(name, str, (size_t)(colon - str));
+    name[colon - str] = '\0';
+
+    spec->format = FORMAT_DECIMAL;
+    spec->writer = NULL;
+    spec->path   = (0 == strcmp(colon + 1, "stdout") || 0 == strcmp(colon + 1, "-"))
+                   ? NULL : colon + 1;
+
+    for (size_t i = 0; i < sizeof(FORMATS) / sizeof(FORMATS[0]); i++)
+    {
+        if (0 == strcmp(name, FORMATS[i].name))
+        {
+            spec->format = FORMATS[i].format;
+            return true;
+        }
+    }
+
+    /* Records carry decimal numbers */
+    spec->writer = record_writer_find(name);
+    return NULL != spec->writer;
+}
+
+/**
+ * @brief Find the largest maximum value allowed for the selected output
+ *
+ * Exact big-integer power tables and tables written for long-running
+ * output may exceed the default size. The latter stop where a product of
+ * two values no longer fits an int.
+ *
+ * @param options   Parsed options
+ * @return          int Largest maximum value
+ */
+static
+int table_size_limit(const program_options_t *options)
+{
+    if (options->big_power)
+    {
+        return MAX_BIG_TABLE_SIZE;
+    }
+
+    if (NULL != options->checkpoint_path || options->shard_count > 1 || options->shard_offsets ||
+        options->compact)
+    {
+        return MAX_LONG_TABLE_SIZE;
+    }
+
+    return MAX_TABLE_SIZE;
+}
+
 /**
  * @brief Parse command line arguments into program options
  *
@@ -80,12 +384,12 @@ bool parse_integer(const char *str, int *result, int min, int max)
 cli_error_t
 cli_parse_args(int argc, char *argv[], program_options_t *options)
 {
-    char option                 = '\0';
+    int option                  = 0;
     int temp_value              = 0;
     cli_error_code_t error_code = CLI_SUCCESS;
 
     /* Parse command line options */
-    while ((option = getopt(argc, argv, "xm:M:t:h")) != -1)
+    while ((option = getopt_long(argc, argv, "xBF:bm:M:t:e:j:h", CLI_LONG_OPTIONS, NULL)) != -1)
     {
         switch (option)
         {
@@ -93,8 +397,180 @@ cli_parse_args(int argc, char *argv[], program_options_t *options)
                 options->format = FORMAT_HEX;
             break;
 
+            case 'B':
+                options->format = FORMAT_BINARY;
+            break;
+
+            case 'F':
+                options->writer = record_writer_find(optarg);
+                if (NULL == options->writer)
+                {
+                    error_code = CLI_ERROR_INVALID_WRITER;
+                    goto exit_function;
+                }
+            break;
+
+            case 'b':
+                options->big_power = true;
+            break;
+
+            case OPTION_MODULUS:
+                if (!cli_parse_uint64(optarg, &options->modulus) || 0 == options->modulus)
+                {
+                    error_code = CLI_ERROR_INVALID_MODULUS;
+                    goto exit_function;
+                }
+            break;
+
+            case OPTION_PLUGIN:
+                options->plugin_path = optarg;
+            break;
+
+            case OPTION_PLUGIN_OP:
+                /* Like -t, selecting an operation replaces the table choice */
+                options->plugin_op = optarg;
+                options->tables    = TABLE_FLAG_PLUGIN;
+            break;
+
+            case OPTION_BROWSE:
+                options->browse = true;
+            break;
+
+            case OPTION_TRIANGLE:
+                options->triangle = true;
+            break;
+
+            case OPTION_ASYNC:
+                options->async = true;
+                if (NULL == optarg)
+                    options->async_backend = ASYNC_BACKEND_AUTO;
+                else if (0 == strcmp(optarg, "uring"))
+                    options->async_backend = ASYNC_BACKEND_URING;
+                else if (0 == strcmp(optarg, "thread"))
+                    options->async_backend = ASYNC_BACKEND_THREAD;
+                else if (0 == strcmp(optarg, "splice"))
+                    options->async_backend = ASYNC_BACKEND_SPLICE;
+                else
+                {
+                    error_code = CLI_ERROR_INVALID_ASYNC;
+                    goto exit_function;
+                }
+            break;
+
+            case OPTION_ASYNC_BUFFERS:
+                if (!cli_parse_integer(optarg, &options->async_buffers, ASYNC_MIN_BUFFERS, ASYNC_MAX_BUFFERS))
+                {
+                    error_code = CLI_ERROR_INVALID_ASYNC;
+                    goto exit_function;
+                }
+                options->async = true;
+            break;
+
+            case OPTION_ASYNC_SIZE:
+                if (!cli_parse_integer(optarg, &options->async_buffer_kib, MIN_ASYNC_BUFFER_KIB, MAX_ASYNC_BUFFER_KIB))
+                {
+                    error_code = CLI_ERROR_INVALID_ASYNC;
+                    goto exit_function;
+                }
+                options->async = true;
+            break;
+
+            case OPTION_ASYNC_STATS:
+                options->async       = true;
+                options->async_stats = true;
+            break;
+
+            case OPTION_NO_SPLICE:
+                options->no_splice = true;
+            break;
+
+            case OPTION_STATS:
+                options->stats = true;
+            break;
+
+            case OPTION_CHECKPOINT:
+                options->checkpoint_path = optarg;
+            break;
+
+            case OPTION_RESUME:
+                options->resume = true;
+            break;
+
+            case OPTION_SHARD:
+                if (!parse_shard(optarg, &options->shard_index, &options->shard_count))
+                {
+                    error_code = CLI_ERROR_INVALID_SHARD;
+                    goto exit_function;
+                }
+            break;
+
+            case OPTION_SHARD_OFFSETS:
+                options->shard_offsets = true;
+            break;
+
+            case OPTION_FIND:
+                if (!cli_parse_uint64(optarg, &options->find_value))
+                {
+                    error_code = CLI_ERROR_INVALID_FIND;
+                    goto exit_function;
+                }
+                options->find = true;
+            break;
+
+            case OPTION_FIND_FILE:
+                options->find_path = optarg;
+            break;
+
+            case OPTION_AGGREGATE:
+                if (!parse_aggregate(optarg, &options->aggregate_kind))
+                {
+                    error_code = CLI_ERROR_INVALID_AGGREGATE;
+                    goto exit_function;
+                }
+                options->aggregate = true;
+            break;
+
+            case OPTION_RANGE_SUM:
+                if (!parse_rectangle(optarg, &options->range))
+                {
+                    error_code = CLI_ERROR_INVALID_AGGREGATE;
+                    goto exit_function;
+                }
+                options->range_sum = true;
+            break;
+
+            case OPTION_PRECISION:
+                if (0 == strcmp(optarg, "shortest"))
+                {
+                    options->precision = DECIMAL_SHORTEST;
+                }
+                else if (!cli_parse_integer(optarg, &options->precision, 1, DECIMAL_MAX_DIGITS))
+                {
+                    error_code = CLI_ERROR_INVALID_PRECISION;
+                    goto exit_function;
+                }
+            break;
+
+            case OPTION_COMPACT:
+                options->compact = true;
+            break;
+
+            case OPTION_TRACE:
+                options->trace_path = optarg;
+            break;
+
+            case OPTION_OUTPUT:
+                if (options->output_count >= TABLE_MAX_SINKS ||
+                    !parse_output(optarg, &options->outputs[options->output_count]))
+                {
+                    error_code = CLI_ERROR_INVALID_OUTPUT;
+                    goto exit_function;
+                }
+                options->output_count++;
+            break;
+
             case 'm':
-                if (!parse_integer(optarg, &temp_value, 0, INT_MAX))
+                if (!cli_parse_integer(optarg, &temp_value, 0, INT_MAX))
                 {
                     error_code = CLI_ERROR_INVALID_MIN;
                     goto exit_function;
@@ -103,7 +579,7 @@ cli_parse_args(int argc, char *argv[], program_options_t *options)
             break;
 
             case 'M':
-                if (!parse_integer(optarg, &temp_value, 0, MAX_TABLE_SIZE))
+                if (!cli_parse_integer(optarg, &temp_value, 0, INT_MAX))
                 {
                     error_code = CLI_ERROR_INVALID_MAX;
                     goto exit_function;
@@ -133,6 +609,26 @@ cli_parse_args(int argc, char *argv[], program_options_t *options)
                         options->tables = TABLE_FLAG_POWER;
                     break;
 
+                    case 'M':
+                        options->tables = TABLE_FLAG_MOD_MULTIPLICATION;
+                    break;
+
+                    case 'P':
+                        options->tables = TABLE_FLAG_MOD_POWER;
+                    break;
+
+                    case 'g':
+                        options->tables = TABLE_FLAG_GCD;
+                    break;
+
+                    case 'l':
+                        options->tables = TABLE_FLAG_LCM;
+                    break;
+
+                    case 'r':
+                        options->tables = TABLE_FLAG_REMAINDER;
+                    break;
+
                     case 'a':
                         options->tables = TABLE_FLAG_ALL;
                     break;
@@ -143,6 +639,20 @@ cli_parse_args(int argc, char *argv[], program_options_t *options)
                 }
             break;
 
+            case 'j':
+                if (!cli_parse_integer(optarg, &options->jobs, 1, SCHEDULER_MAX_WORKERS))
+                {
+                    error_code = CLI_ERROR_INVALID_JOBS;
+                    goto exit_function;
+                }
+            break;
+
+            case 'e':
+                /* Like -t, an expression replaces the table choice */
+                options->expression = optarg;
+                options->tables     = TABLE_FLAG_EXPRESSION;
+            break;
+
             case 'h':
                 options->show_help = true;
                 goto exit_function;
@@ -153,6 +663,168 @@ cli_parse_args(int argc, char *argv[], program_options_t *options)
         }
     }
 
+    /* Fractional quotients are decimal text cells of the division table */
+    if (0 != options->precision &&
+        (!(options->tables & TABLE_FLAG_DIVISION) ||
+         FORMAT_DECIMAL != options->format || NULL != options->writer ||
+         options->browse || options->jobs > 1 || options->find ||
+         NULL != options->find_path || options->aggregate || options->range_sum))
+    {
+        error_code = CLI_ERROR_INVALID_PRECISION;
+        goto exit_function;
+    }
+
+    /* Outputs declare their own formats and write whole tables in order */
+    if (options->output_count > 0 &&
+        (FORMAT_DECIMAL != options->format || NULL != options->writer ||
+         options->big_power || options->browse || options->triangle || options->jobs > 1 ||
+         0 != options->precision || NULL != options->checkpoint_path ||
+         options->shard_count > 1 || options->shard_offsets || options->find ||
+         NULL != options->find_path || options->aggregate || options->range_sum))
+    {
+        error_code = CLI_ERROR_INVALID_OUTPUT;
+        goto exit_function;
+    }
+
+    /* Column widths are known only once the whole table is computed, so
+       the layout cannot be split into fixed-size shards or worker rows */
+    if (options->compact &&
+        (FORMAT_BINARY == options->format || NULL != options->writer ||
+         options->big_power || options->browse || options->triangle || options->jobs > 1 ||
+         0 != options->precision || options->shard_count > 1 || options->shard_offsets ||
+         options->output_count > 0 || options->find || NULL != options->find_path ||
+         options->aggregate || options->range_sum))
+    {
+        error_code = CLI_ERROR_INVALID_COMPACT;
+        goto exit_function;
+    }
+
+    /* Lookups never generate the table; their limit is the factor sieve */
+    if (options->find || NULL != options->find_path)
+    {
+        if (options->max_value > FIND_MAX_VALUE ||
+            0 != (options->tables & ~(unsigned)TABLE_FLAG_ALL) ||
+            NULL != options->writer || FORMAT_BINARY == options->format ||
+            options->browse || options->triangle || options->jobs > 1 ||
+            NULL != options->checkpoint_path || options->shard_count > 1 ||
+            options->shard_offsets)
+        {
+            error_code = CLI_ERROR_INVALID_FIND;
+        }
+        else if (options->min_value > options->max_value)
+        {
+            error_code = CLI_ERROR_MIN_GT_MAX;
+        }
+        goto exit_function;
+    }
+
+    /* Aggregates never format a cell; their limit is the time a scan takes
+       and, for histograms, holding every cell. --range-sum has its own rows
+       and columns and ignores -m and -M; only tables without a closed form
+       scan its cells */
+    if (options->aggregate || options->range_sum)
+    {
+        if ((options->aggregate && options->range_sum) ||
+            (options->aggregate && options->max_value > AGG_MAX_VALUE) ||
+            (options->range_sum && (options->tables & ~TABLE_FLAG_ALL) &&
+             (options->range.last_row > AGG_MAX_VALUE ||
+              options->range.last_column > AGG_MAX_VALUE)) ||
+            (options->aggregate && AGG_HISTOGRAM == options->aggregate_kind &&
+             options->max_value - options->min_value >= AGG_MAX_HISTOGRAM_SIDE) ||
+            FORMAT_DECIMAL != options->format || NULL != options->writer ||
+            options->browse || options->triangle || options->jobs > 1 ||
+            NULL != options->checkpoint_path || options->shard_count > 1 ||
+            options->shard_offsets)
+        {
+            error_code = CLI_ERROR_INVALID_AGGREGATE;
+            goto exit_function;
+        }
+    }
+    /* Only the browser, which computes just the visible cells, is unlimited */
+    else if (!options->browse && options->max_value > table_size_limit(options))
+    {
+        error_code = CLI_ERROR_INVALID_MAX;
+        goto exit_function;
+    }
+
+    /* The browser shows fixed-size text cells, and triangles need a text layout */
+    if ((options->browse && (options->big_power || FORMAT_BINARY == options->format)) ||
+        (options->triangle && (options->browse || FORMAT_BINARY == options->format)))
+    {
+        error_code = CLI_ERROR_INVALID_OPTION;
+        goto exit_function;
+    }
+
+    /* Modular tables need a modulus */
+    if ((options->tables & (TABLE_FLAG_MOD_MULTIPLICATION | TABLE_FLAG_MOD_POWER)) &&
+        0 == options->modulus)
+    {
+        error_code = CLI_ERROR_INVALID_MODULUS;
+        goto exit_function;
+    }
+
+    /* Plugin tables need both the shared object and the operation name, and
+       a shared object alone must not quietly print the default table */
+    if (((options->tables & TABLE_FLAG_PLUGIN) && NULL == options->plugin_path) ||
+        (NULL != options->plugin_path && NULL == options->plugin_op))
+    {
+        error_code = CLI_ERROR_INVALID_PLUGIN;
+        goto exit_function;
+    }
+
+    /* The browser draws with ncurses, not through output buffers */
+    if ((options->async && options->browse) ||
+        (options->no_splice && ASYNC_BACKEND_SPLICE == options->async_backend))
+    {
+        error_code = CLI_ERROR_INVALID_OPTION;
+        goto exit_function;
+    }
+
+    /* Parallel rendering covers the padded text tables only */
+    if (options->jobs > 1 &&
+        (FORMAT_BINARY == options->format || NULL != options->writer || options->big_power ||
+         options->browse || options->triangle))
+    {
+        error_code = CLI_ERROR_INVALID_JOBS;
+        goto exit_function;
+    }
+
+    /* Checkpoints mark row boundaries of the padded tables written in order */
+    if ((options->resume && NULL == options->checkpoint_path) ||
+        (NULL != options->checkpoint_path &&
+         (FORMAT_BINARY == options->format || NULL != options->writer ||
+          options->jobs > 1 || options->browse)))
+    {
+        error_code = CLI_ERROR_INVALID_CHECKPOINT;
+        goto exit_function;
+    }
+
+    /* Shards split the padded rows of a single table written in order */
+    if ((options->shard_count > 1 || options->shard_offsets) &&
+        (0 != (options->tables & (options->tables - 1)) ||
+         FORMAT_BINARY == options->format || NULL != options->writer ||
+         options->jobs > 1 || options->browse || NULL != options->checkpoint_path))
+    {
+        error_code = CLI_ERROR_INVALID_SHARD;
+        goto exit_function;
+    }
+
+    /* Records are text, one per computed row */
+    if (NULL != options->writer &&
+        (FORMAT_BINARY == options->format || options->big_power ||
+         options->browse || options->triangle))
+    {
+        error_code = CLI_ERROR_INVALID_OPTION;
+        goto exit_function;
+    }
+
+    /* Exact power values do not fit fixed-size binary cells */
+    if (options->big_power && FORMAT_BINARY == options->format)
+    {
+        error_code = CLI_ERROR_INVALID_OPTION;
+        goto exit_function;
+    }
+
     /* Validate min/max values */
     if (options->min_value > options->max_value)
     {
@@ -184,9 +856,74 @@ cli_print_usage(const char *program_name)
     printf(GRN "Usage: %s [options]\n", program_name);
     printf(YLW "Options:\n");
     printf(YLW "  -x           Display output in hexadecimal format\n");
+    printf(YLW "  -B           Write raw 64-bit binary cell values (no headers)\n");
+    printf(YLW "  -F <fmt>     Write unpadded records: csv, tsv, jsonl (one object per row)\n");
+    printf(YLW "               or md (Markdown table)\n");
+    printf(YLW "  --out <fmt>:<file>\n");
+    printf(YLW "               Also write each table as dec, hex, bin or a -F format to a\n");
+    printf(YLW "               file (or stdout); repeat for up to %d outputs of one pass,\n",
+           TABLE_MAX_SINKS);
+    printf(YLW "               each to a different file\n");
     printf(YLW "  -m <min>     Minimum value (default: 1, cannot be less than 0)\n");
-    printf(YLW "  -M <max>     Maximum value (default: 10, cannot exceed %d)\n", MAX_TABLE_SIZE);
-    printf(YLW "  -t <type>    Table type (m=multiplication, d=division, p=power, a=all)\n");
+    printf(YLW "  -M <max>     Maximum value (default: 10, cannot exceed %d, or %d with -b,\n",
+           MAX_TABLE_SIZE, MAX_BIG_TABLE_SIZE);
+    printf(YLW "               %d with --checkpoint, --shard or --compact; unlimited with\n",
+           MAX_LONG_TABLE_SIZE);
+    printf(YLW "               --browse)\n");
+    printf(YLW "  -t <type>    Table type (m=multiplication, d=division, p=power, a=all,\n");
+    printf(YLW "               M=modular multiplication, P=modular power, g=gcd, l=lcm,\n");
+    printf(YLW "               r=remainder)\n");
+    printf(YLW "  --mod <m>    Modulus for -t M and -t P (1 <= m < 2^64)\n");
+    printf(YLW "  -e <expr>    Show the table of an expression over r and c, e.g. \"r*c + r\"\n");
+    printf(YLW "               (C operators + - * / %% & | ^ << >> ~, 64-bit, x/0 = 0)\n");
+    printf(YLW "  --plugin <path.so> --op <name>\n");
+    printf(YLW "               Show the table of an operation loaded from a plugin\n");
+    printf(YLW "  -b           Compute the power table with exact arbitrary-precision values\n");
+    printf(YLW "  --precision <n|shortest>\n");
+    printf(YLW "               Show division quotients rounded to n decimals (1-%d), or as\n",
+           DECIMAL_MAX_DIGITS);
+    printf(YLW "               the shortest decimal of the double quotient\n");
+    printf(YLW "  --browse     Browse the first selected table interactively\n");
+    printf(YLW "  --triangle   Print only the upper triangle of symmetric tables (m, M)\n");
+    printf(YLW "  --compact    Make each column only as wide as its widest value\n");
+    printf(YLW "  --async[=uring|thread|splice]\n");
+    printf(YLW "               Overlap table generation with writing (default: vmsplice for\n");
+    printf(YLW "               pipes no larger than the other buffers, else io_uring if\n");
+    printf(YLW "               available, else a writer thread)\n");
+    printf(YLW "  --buffers <n>, --buffer-size <KiB>\n");
+    printf(YLW "               Asynchronous output buffers (default: %d × %d KiB)\n",
+           ASYNC_DEFAULT_BUFFERS, ASYNC_DEFAULT_BUFFER_SIZE / 1024);
+    printf(YLW "  --async-stats\n");
+    printf(YLW "               Report writer queue-depth statistics on stderr\n");
+    printf(YLW "  --no-splice  Copy output into a pipe with write() instead of vmsplice\n");
+    printf(YLW "  --stats      Report time each pipeline stage spent waiting on stderr\n");
+    printf(YLW "  --trace <file>\n");
+    printf(YLW "               Write a timeline of the render phases of each thread to file\n");
+    printf(YLW "               (Chrome trace-event JSON, for chrome://tracing or Perfetto)\n");
+    printf(YLW "  -j <n>       Render the rows of all selected tables on n threads (1-%d)\n",
+           SCHEDULER_MAX_WORKERS);
+    printf(YLW "  --checkpoint <file>\n");
+    printf(YLW "               Record how far the output (a regular file) has safely got\n");
+    printf(YLW "  --resume     Continue the output recorded in --checkpoint, e.g.\n");
+    printf(YLW "               %s -t a --checkpoint ck --resume >> out\n", program_name);
+    printf(YLW "  --shard <i/N>\n");
+    printf(YLW "               Print only shard i of N row bands of one table (the header is\n");
+    printf(YLW "               in shard 0); shards 0..N-1 concatenate into the whole table\n");
+    printf(YLW "  --print-shard-offsets\n");
+    printf(YLW "               Print the rows and byte range of every shard of --shard i/N\n");
+    printf(YLW "  --find <value>\n");
+    printf(YLW "               List the cells of the selected tables (m, d, p) holding value,\n");
+    printf(YLW "               computed directly; -M may be up to %d\n", FIND_MAX_VALUE);
+    printf(YLW "  --find-file <file>\n");
+    printf(YLW "               Look up every value in file (one per line, - for stdin)\n");
+    printf(YLW "  --agg <sum|min|max|hist>\n");
+    printf(YLW "               Print the exact sum, minimum or maximum of every row, every\n");
+    printf(YLW "               column and the whole of each selected table, or the number\n");
+    printf(YLW "               of cells holding each value; -M may be up to %d\n", AGG_MAX_VALUE);
+    printf(YLW "  --range-sum <r0:r1,c0:c1>\n");
+    printf(YLW "               Print the exact sum of rows r0..r1 and columns c0..c1, each\n");
+    printf(YLW "               up to %d (%d when only m, d and p are selected)\n",
+           AGG_MAX_VALUE, AGG_MAX_CLOSED_VALUE);
     printf(YLW "  -h           Display this help message\n");
     printf(CLR);
 }
\ No newline at end of file
@@ -0,0 +1,271 @@
+/**
+ * @file timestable_decimal.c
+ * @brief Implementation of quotient formatting
+ *
+ * Ryu computes the rounding interval of a double scaled by a power of ten
+ * with precomputed multipliers. Quotients of table values lie between
+ * 2^-32 and 2^60, where 64-bit mantissas times a power of five fit in 128
+ * bits, so the interval is computed exactly instead, without tables.
+ */
+
+#include <stdbool.h>
+#include <string.h>                 // memcpy()
+
+#include "timestable_decimal.h"     // decimal_fixed(), decimal_shortest()
+
+/**
+ * @brief Unsigned 128-bit value for the exact interval bounds
+ */
+__extension__ typedef unsigned __int128 decimal_u128_t;
+
+/**
+ * @brief Powers of ten up to 10^9, the largest scale step of decimal_fixed()
+ */
+static const uint64_t POW10[] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+/**
+ * @brief Powers of five up to 5^27, enough for exponents down to 2^-86
+ */
+static const uint64_t POW5[] = {
+    1ull, 5ull, 25ull, 125ull, 625ull, 3125ull, 15625ull, 78125ull, 390625ull,
+    1953125ull, 9765625ull, 48828125ull, 244140625ull, 1220703125ull, 6103515625ull,
+    30517578125ull, 152587890625ull, 762939453125ull, 3814697265625ull,
+    19073486328125ull, 95367431640625ull, 476837158203125ull, 2384185791015625ull,
+    11920928955078125ull, 59604644775390625ull, 298023223876953125ull,
+    1490116119384765625ull, 7450580596923828125ull
+};
+
+/**
+ * @brief Render the decimal digits of a value ending at the given position
+ *
+ * @param value  Value to render
+ * @param count  Least number of digits, padded with leading zeros
+ * @param end    One past the last byte of the destination
+ * @return       size_t Number of characters written before end
+ */
+static size_t
+put_digits(uint64_t value, int count, char *end)
+{
+    char *cursor = end;
+
+    do
+    {
+        *--cursor = (char)('0' + (int)(value % 10));
+        value    /= 10;
+        count--;
+    }
+    while (value > 0 || count > 0);
+
+    return (size_t)(end - cursor);
+}
+
+/**
+ * @brief Render numerator ÷ denominator with a fixed number of fraction digits
+ *
+ * The remainder is scaled at most nine digits at a time, which keeps it
+ * below 2^62 for any 32-bit divisor.
+ *
+ * @param numerator    Dividend
+ * @param denominator  Divisor (at least 1)
+ * @param digits       Fraction digits (0 to DECIMAL_MAX_DIGITS)
+ * @param end          One past the last byte of the destination
+ * @return             size_t Number of characters written before end
+ */
+size_t
+decimal_fixed(uint32_t numerator, uint32_t denominator, int digits, char *end)
+{
+    uint64_t whole     = numerator / denominator;
+    uint64_t remainder = numerator % denominator;
+    uint64_t fraction  = 0;
+    uint64_t scale     = 1;
+    char *cursor       = end;
+
+    for (int left = digits; left > 0; left -= 9)
+    {
+        uint64_t step = POW10[(left < 9) ? left : 9];
+
+        remainder *= step;
+        fraction   = fraction * step + remainder / denominator;
+        remainder %= denominator;
+        scale     *= step;
+    }
+
+    /* Round half up; a carry out of the fraction goes to the whole part */
+    if (2 * remainder >= denominator && ++fraction == scale)
+    {
+        fraction = 0;
+        whole++;
+    }
+
+    if (digits > 0)
+    {
+        cursor   -= put_digits(fraction, digits, cursor);
+        *--cursor = '.';
+    }
+    cursor -= put_digits(whole, 1, cursor);
+
+    return (size_t)(end - cursor);
+}
+
+/**
+ * @brief Scale an interval bound to the decimal grid, rounding down
+ *
+ * @param mantissa  Bound in units of 2^-shift, before multiplying by five
+ * @param five      Power of five of the decimal scale
+ * @param shift     Power of two to divide by (multiply by, if negative)
+ * @param exact     Set to whether no nonzero bits were dropped
+ * @return          uint64_t floor(mantissa × five / 2^shift)
+ */
+static uint64_t
+scale_bound(uint64_t mantissa, uint64_t five, int shift, bool *exact)
+{
+    decimal_u128_t product = (decimal_u128_t)mantissa * five;
+
+    if (shift < 0)
+    {
+        *exact = true;
+        return (uint64_t)(product << -shift);
+    }
+
+    *exact = 0 == (product & ((((decimal_u128_t)1) << shift) - 1));
+    return (uint64_t)(product >> shift);
+}
+
+/**
+ * @brief Render the shortest decimal that reads back as a double
+ *
+ * The double m × 2^e is read back from any decimal strictly inside the
+ * interval halfway to its neighbours (or on its ends, for even m). The
+ * three points are scaled by 10^j with 10^j ≥ 10 × 2^-e, which puts at
+ * least 30 grid steps inside the interval, so at least one digit is
+ * removed and the last one decides the rounding. Digits are removed while
+ * the shortened bounds still differ, as in Ryu's general case.
+ *
+ * @param value  Value to render (0, or 2^-32 to 2^60)
+ * @param end    One past the last byte of the destination
+ * @return       size_t Number of characters written before end
+ */
+size_t
+decimal_shortest(double value, char *end)
+{
+    uint64_t bits;
+    uint64_t ieee_mantissa;
+    int ieee_exponent;
+    uint64_t mv;
+    uint64_t vr;
+    uint64_t vp;
+    uint64_t vm;
+    uint64_t output;
+    int exponent2;
+    int exponent10;
+    bool accept_bounds;
+    bool vr_trailing_zeros      = true;
+    bool vm_trailing_zeros      = true;
+    bool vp_exact               = true;
+    int last_removed_digit      = 0;
+    char *cursor                = end;
+
+    memcpy(&bits, &value, sizeof(bits));
+    ieee_mantissa = bits & ((UINT64_C(1) << 52) - 1);
+    ieee_exponent = (int)((bits >> 52) & 0x7ff);
+    if (0 == ieee_exponent && 0 == ieee_mantissa)
+    {
+        *--cursor = '0';
+        return 1;
+    }
+
+    /* Interval in units of a quarter ulp; a power of two has a closer lower
+       neighbour */
+    mv            = 4 * (ieee_mantissa | (UINT64_C(1) << 52));
+    exponent2     = ieee_exponent - 1075 - 2;
+    accept_bounds = 0 == (mv & 4);
+
+    if (exponent2 >= 0)
+    {
+        vr         = mv << exponent2;
+        vp         = (mv + 2) << exponent2;
+        vm         = (mv - 1 - (0 != ieee_mantissa)) << exponent2;
+        exponent10 = 0;
+    }
+    else
+    {
+        /* floor(k log10 2) + 2 digits: 10^j ≥ 10 × 2^k, and 5^j × 4m < 2^128 */
+        int k     = -exponent2;
+        int j     = (int)(((uint32_t)k * 78913u) >> 18) + 2;
+        bool exact;
+
+        vr                = scale_bound(mv, POW5[j], k - j, &vr_trailing_zeros);
+        vp                = scale_bound(mv + 2, POW5[j], k - j, &vp_exact);
+        vm                = scale_bound(mv - 1 - (0 != ieee_mantissa), POW5[j], k - j, &exact);
+        vm_trailing_zeros = exact;
+        exponent10        = -j;
+    }
+
+    /* Bounds are only part of the interval for even mantissas */
+    vm_trailing_zeros = vm_trailing_zeros && accept_bounds;
+    if (vp_exact && !accept_bounds)
+    {
+        vp--;
+    }
+
+    while (vp / 10 > vm / 10)
+    {
+        vm_trailing_zeros  = vm_trailing_zeros && 0 == vm % 10;
+        vr_trailing_zeros  = vr_trailing_zeros && 0 == last_removed_digit;
+        last_removed_digit = (int)(vr % 10);
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        exponent10++;
+    }
+
+    /* An exact lower bound may still end in removable zeros */
+    while (vm_trailing_zeros && 0 == vm % 10 && vm > 0)
+    {
+        vr_trailing_zeros  = vr_trailing_zeros && 0 == last_removed_digit;
+        last_removed_digit = (int)(vr % 10);
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        exponent10++;
+    }
+
+    /* Exactly halfway rounds to even */
+    if (vr_trailing_zeros && 5 == last_removed_digit && 0 == vr % 2)
+    {
+        last_removed_digit = 4;
+    }
+
+    output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) ||
+                   last_removed_digit >= 5);
+
+    /* Rounding up can leave a trailing zero */
+    while (exponent10 < 0 && 0 == output % 10)
+    {
+        output /= 10;
+        exponent10++;
+    }
+
+    if (exponent10 >= 0)
+    {
+        while (exponent10-- > 0)
+        {
+            *--cursor = '0';
+        }
+        cursor -= put_digits(output, 1, cursor);
+    }
+    else
+    {
+        for (int i = 0; i < -exponent10; i++)
+        {
+            *--cursor = (char)('0' + (int)(output % 10));
+            output   /= 10;
+        }
+        *--cursor = '.';
+        cursor   -= put_digits(output, 1, cursor);
+    }
+
+    return (size_t)(end - cursor);
+}
@@ -0,0 +1,848 @@
+/**
+ * @file timestable_expression.c
+ * @brief Implementation of compiled user expression operations
+ *
+ * A recursive descent parser builds a constant-folded syntax tree, which is
+ * then split into a per-row scalar program (subtrees not depending on c)
+ * and a vector program evaluated across runs of columns.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include "timestable_expression.h"
+
+/**
+ * @brief Number of columns evaluated per pass of the vector program
+ */
+#define EXPR_CHUNK 256
+
+/**
+ * @brief Number of binary operator precedence levels (| ^ & shifts + *)
+ */
+#define EXPR_PRECEDENCE_LEVELS 6
+
+/**
+ * @brief Syntax tree node
+ */
+typedef struct
+{
+    expr_opcode_t opcode;            /**< Leaf kind or operation */
+    int left;                        /**< First child node (-1 if none) */
+    int right;                       /**< Second child node (-1 if none) */
+    int64_t value;                   /**< Value of EXPR_OP_CONSTANT leaves */
+    bool varies;                     /**< Depends on the column value */
+} expr_node_t;
+
+/**
+ * @brief Parser and code generator state
+ */
+typedef struct
+{
+    const char *text;                /**< Expression source */
+    int position;                    /**< Offset of the next character */
+    expr_node_t nodes[EXPR_MAX_NODES];
+    int node_count;                  /**< Nodes allocated so far */
+    int depth;                       /**< Unary terms being parsed */
+    expr_error_code_t error;         /**< First error encountered */
+    int error_position;              /**< Offset of the first error */
+    expr_program_t *program;         /**< Program being generated */
+} expr_parser_t;
+
+/**
+ * @brief Binary operators and their precedence levels (0 binds loosest)
+ */
+static const struct
+{
+    const char *token;
+    int level;
+    expr_opcode_t opcode;
+} EXPR_BINARY_OPERATORS[] = {
+    {"|",  0, EXPR_OP_OR},
+    {"^",  1, EXPR_OP_XOR},
+    {"&",  2, EXPR_OP_AND},
+    {"<<", 3, EXPR_OP_SHIFT_LEFT},
+    {">>", 3, EXPR_OP_SHIFT_RIGHT},
+    {"+",  4, EXPR_OP_ADD},
+    {"-",  4, EXPR_OP_SUBTRACT},
+    {"*",  5, EXPR_OP_MULTIPLY},
+    {"/",  5, EXPR_OP_DIVIDE},
+    {"%",  5, EXPR_OP_REMAINDER}
+};
+
+static const size_t EXPR_BINARY_OPERATORS_COUNT =
+    sizeof(EXPR_BINARY_OPERATORS) / sizeof(EXPR_BINARY_OPERATORS[0]);
+
+static const expr_error_t EXPR_ERRORS[] = {
+    {EXPR_SUCCESS,              "Success", 0},
+    {EXPR_ERROR_SYNTAX,         "Invalid expression syntax", 0},
+    {EXPR_ERROR_NUMBER,         "Number does not fit in 64 bits", 0},
+    {EXPR_ERROR_TOO_COMPLEX,    "Expression is too complex", 0}
+};
+
+static const size_t EXPR_ERRORS_COUNT = sizeof(EXPR_ERRORS) / sizeof(EXPR_ERRORS[0]);
+
+/**
+ * @brief Signed division with the expression language's edge cases
+ *
+ * @param a Dividend
+ * @param b Divisor
+ * @return uint64_t a / b, or 0 when b is 0
+ */
+static inline uint64_t
+expr_divide(uint64_t a, uint64_t b)
+{
+    if (0 == b)
+    {
+        return 0;
+    }
+
+    /* INT64_MIN / -1 traps; negation gives the wrapped result */
+    if (UINT64_MAX == b)
+    {
+        return 0 - a;
+    }
+
+    return (uint64_t)((int64_t)a / (int64_t)b);
+}
+
+/**
+ * @brief Signed remainder with the expression language's edge cases
+ *
+ * @param a Dividend
+ * @param b Divisor
+ * @return uint64_t a % b, or 0 when b is 0 or -1
+ */
+static inline uint64_t
+expr_remainder(uint64_t a, uint64_t b)
+{
+    if (0 == b || UINT64_MAX == b)
+    {
+        return 0;
+    }
+
+    return (uint64_t)((int64_t)a % (int64_t)b);
+}
+
+/**
+ * @brief Arithmetic shift right with the count taken modulo 64
+ *
+ * @param a Value to shift
+ * @param b Shift count
+ * @return uint64_t a >> (b mod 64), sign-extending
+ */
+static inline uint64_t
+expr_shift_right(uint64_t a, uint64_t b)
+{
+    return (uint64_t)((int64_t)a >> (b & 63u));
+}
+
+/**
+ * @brief Apply a unary or binary operation to scalar operands
+ *
+ * Used for constant folding and for the per-row scalar program.
+ *
+ * @param opcode Operation to apply
+ * @param a First operand
+ * @param b Second operand (ignored by unary operations)
+ * @return uint64_t Result
+ */
+static uint64_t
+expr_apply(expr_opcode_t opcode, uint64_t a, uint64_t b)
+{
+    switch (opcode)
+    {
+        case EXPR_OP_NEGATE:        return 0 - a;
+        case EXPR_OP_NOT:           return ~a;
+        case EXPR_OP_ADD:           return a + b;
+        case EXPR_OP_SUBTRACT:      return a - b;
+        case EXPR_OP_MULTIPLY:      return a * b;
+        case EXPR_OP_DIVIDE:        return expr_divide(a, b);
+        case EXPR_OP_REMAINDER:     return expr_remainder(a, b);
+        case EXPR_OP_AND:           return a & b;
+        case EXPR_OP_OR:            return a | b;
+        case EXPR_OP_XOR:           return a ^ b;
+        case EXPR_OP_SHIFT_LEFT:    return a << (b & 63u);
+        case EXPR_OP_SHIFT_RIGHT:   return expr_shift_right(a, b);
+        default:                    return a;
+    }
+}
+
+/**
+ * @brief Record the first error and its position
+ *
+ * @param parser Parser state
+ * @param error Error code
+ */
+static void
+expr_fail(expr_parser_t *parser, expr_error_code_t error)
+{
+    if (EXPR_SUCCESS == parser->error)
+    {
+        parser->error          = error;
+        parser->error_position = parser->position;
+    }
+}
+
+/**
+ * @brief Allocate a syntax tree node
+ *
+ * @param parser Parser state
+ * @param opcode Leaf kind or operation
+ * @param left First child (-1 if none)
+ * @param right Second child (-1 if none)
+ * @return int Node index, or -1 on error
+ */
+static int
+expr_node(expr_parser_t *parser, expr_opcode_t opcode, int left, int right)
+{
+    expr_node_t *node = NULL;
+
+    if (EXPR_SUCCESS != parser->error)
+    {
+        return -1;
+    }
+
+    if (parser->node_count >= EXPR_MAX_NODES)
+    {
+        expr_fail(parser, EXPR_ERROR_TOO_COMPLEX);
+        return -1;
+    }
+
+    node          = &parser->nodes[parser->node_count];
+    node->opcode  = opcode;
+    node->left    = left;
+    node->right   = right;
+    node->value   = 0;
+    node->varies  = (EXPR_OP_COLUMN == opcode) ||
+                    (left >= 0 && parser->nodes[left].varies) ||
+                    (right >= 0 && parser->nodes[right].varies);
+
+    return parser->node_count++;
+}
+
+/**
+ * @brief Create an operation node, folding it if all operands are constant
+ *
+ * @param parser Parser state
+ * @param opcode Operation
+ * @param left First operand node
+ * @param right Second operand node (-1 for unary operations)
+ * @return int Node index, or -1 on error
+ */
+static int
+expr_operation(expr_parser_t *parser, expr_opcode_t opcode, int left, int right)
+{
+    if (left < 0 || (right < 0 && EXPR_OP_NEGATE != opcode && EXPR_OP_NOT != opcode))
+    {
+        return -1;
+    }
+
+    if (EXPR_OP_CONSTANT == parser->nodes[left].opcode &&
+        (right < 0 || EXPR_OP_CONSTANT == parser->nodes[right].opcode))
+    {
+        uint64_t a = (uint64_t)parser->nodes[left].value;
+        uint64_t b = (right < 0) ? 0 : (uint64_t)parser->nodes[right].value;
+
+        /* Reuse the left operand's node for the folded constant */
+        parser->nodes[left].value = (int64_t)expr_apply(opcode, a, b);
+        return left;
+    }
+
+    return expr_node(parser, opcode, left, right);
+}
+
+/**
+ * @brief Skip whitespace before the next token
+ *
+ * @param parser Parser state
+ */
+static void
+expr_skip_space(expr_parser_t *parser)
+{
+    while (isspace((unsigned char)parser->text[parser->position]))
+    {
+        parser->position++;
+    }
+}
+
+static int expr_parse_binary(expr_parser_t *parser, int level);
+static int expr_parse_unary(expr_parser_t *parser);
+
+/**
+ * @brief Parse a number literal (decimal or 0x hexadecimal)
+ *
+ * @param parser Parser state
+ * @return int Node index, or -1 on error
+ */
+static int
+expr_parse_number(expr_parser_t *parser)
+{
+    const char *start        = parser->text + parser->position;
+    char *end                = NULL;
+    int base                 = 10;
+    unsigned long long value = 0;
+    int node                 = -1;
+
+    if ('0' == start[0] && ('x' == start[1] || 'X' == start[1]))
+    {
+        base = 16;
+    }
+
+    errno = 0;
+    value = strtoull(start, &end, base);
+    if (ERANGE == errno)
+    {
+        expr_fail(parser, EXPR_ERROR_NUMBER);
+        return -1;
+    }
+
+    node = expr_node(parser, EXPR_OP_CONSTANT, -1, -1);
+    if (node >= 0)
+    {
+        parser->nodes[node].value = (int64_t)(uint64_t)value;
+    }
+
+    parser->position += (int)(end - start);
+    return node;
+}
+
+/**
+ * @brief Parse a unary expression or primary term, without the depth limit
+ *
+ * @param parser Parser state
+ * @return int Node index, or -1 on error
+ */
+static int
+expr_parse_term(expr_parser_t *parser)
+{
+    char next = '\0';
+    int node  = -1;
+
+    expr_skip_space(parser);
+    next = parser->text[parser->position];
+
+    switch (next)
+    {
+        case '-':
+            parser->position++;
+            return expr_operation(parser, EXPR_OP_NEGATE, expr_parse_unary(parser), -1);
+
+        case '~':
+            parser->position++;
+            return expr_operation(parser, EXPR_OP_NOT, expr_parse_unary(parser), -1);
+
+        case '+':
+            parser->position++;
+            return expr_parse_unary(parser);
+
+        case '(':
+            parser->position++;
+            node = expr_parse_binary(parser, 0);
+            expr_skip_space(parser);
+            if (')' != parser->text[parser->position])
+            {
+                expr_fail(parser, EXPR_ERROR_SYNTAX);
+                return -1;
+            }
+            parser->position++;
+            return node;
+
+        case 'r':
+        case 'c':
+            parser->position++;
+            if (isalnum((unsigned char)parser->text[parser->position]) ||
+                '_' == parser->text[parser->position])
+            {
+                expr_fail(parser, EXPR_ERROR_SYNTAX);
+                return -1;
+            }
+            return expr_node(parser, ('r' == next) ? EXPR_OP_ROW : EXPR_OP_COLUMN, -1, -1);
+
+        default:
+            if (isdigit((unsigned char)next))
+            {
+                return expr_parse_number(parser);
+            }
+            expr_fail(parser, EXPR_ERROR_SYNTAX);
+            return -1;
+    }
+}
+
+/**
+ * @brief Parse a unary expression or primary term
+ *
+ * Parentheses and unary operators recurse before any node is allocated,
+ * so their nesting is limited here rather than by the node count.
+ *
+ * @param parser Parser state
+ * @return int Node index, or -1 on error
+ */
+static int
+expr_parse_unary(expr_parser_t *parser)
+{
+    int node = -1;
+
+    if (parser->depth >= EXPR_MAX_DEPTH)
+    {
+        expr_fail(parser, EXPR_ERROR_TOO_COMPLEX);
+        return -1;
+    }
+
+    parser->depth++;
+    node = expr_parse_term(parser);
+    parser->depth--;
+
+    return node;
+}
+
+/**
+ * @brief Parse a chain of binary operators at one precedence level
+ *
+ * @param parser Parser state
+ * @param level Precedence level (0 binds loosest)
+ * @return int Node index, or -1 on error
+ */
+static int
+expr_parse_binary(expr_parser_t *parser, int level)
+{
+    int left = -1;
+
+    if (EXPR_PRECEDENCE_LEVELS == level)
+    {
+        return expr_parse_unary(parser);
+    }
+
+    left = expr_parse_binary(parser, level + 1);
+
+    while (left >= 0)
+    {
+        const char *cursor = NULL;
+        size_t matched     = EXPR_BINARY_OPERATORS_COUNT;
+
+        expr_skip_space(parser);
+        cursor = parser->text + parser->position;
+
+        for (size_t i = 0; i < EXPR_BINARY_OPERATORS_COUNT; i++)
+        {
+            const char *token = EXPR_BINARY_OPERATORS[i].token;
+
+            if (level == EXPR_BINARY_OPERATORS[i].level &&
+                0 == strncmp(cursor, token, strlen(token)))
+            {
+                matched = i;
+                break;
+            }
+        }
+
+        if (EXPR_BINARY_OPERATORS_COUNT == matched)
+        {
+            break;
+        }
+
+        parser->position += (int)strlen(EXPR_BINARY_OPERATORS[matched].token);
+        left = expr_operation(parser, EXPR_BINARY_OPERATORS[matched].opcode,
+                              left, expr_parse_binary(parser, level + 1));
+    }
+
+    return left;
+}
+
+/**
+ * @brief Append an instruction to the scalar or vector program
+ *
+ * @param parser Parser state
+ * @param vector true for the vector program, false for the scalar one
+ * @param instruction Instruction to append
+ * @return int Index of the instruction, or -1 on error
+ */
+static int
+expr_emit(expr_parser_t *parser, bool vector, expr_instruction_t instruction)
+{
+    expr_instruction_t *code = vector ? parser->program->vector : parser->program->scalar;
+    int *count               = vector ? &parser->program->vector_count
+                                      : &parser->program->scalar_count;
+
+    if (*count >= EXPR_MAX_NODES)
+    {
+        expr_fail(parser, EXPR_ERROR_TOO_COMPLEX);
+        return -1;
+    }
+
+    code[*count] = instruction;
+    return (*count)++;
+}
+
+/**
+ * @brief Generate scalar code for a subtree that does not depend on c
+ *
+ * Every scalar instruction writes its own slot, numbered by its index.
+ *
+ * @param parser Parser state
+ * @param node Subtree root
+ * @return int Slot holding the subtree's value, or -1 on error
+ */
+static int
+expr_generate_scalar(expr_parser_t *parser, int node)
+{
+    const expr_node_t *n           = &parser->nodes[node];
+    expr_instruction_t instruction = { .opcode = (uint8_t)n->opcode, .immediate = n->value };
+    int slot                       = -1;
+
+    if (n->left >= 0)
+    {
+        slot = expr_generate_scalar(parser, n->left);
+        instruction.a = (uint8_t)slot;
+    }
+
+    if (n->right >= 0)
+    {
+        slot = expr_generate_scalar(parser, n->right);
+        instruction.b = (uint8_t)slot;
+    }
+
+    if (EXPR_SUCCESS != parser->error)
+    {
+        return -1;
+    }
+
+    instruction.dst = (uint8_t)parser->program->scalar_count;
+    return expr_emit(parser, false, instruction);
+}
+
+/**
+ * @brief Generate vector code leaving a subtree's values in a register
+ *
+ * Registers are allocated in stack order: the subtree's result goes to
+ * register, and register + 1 and above are free for temporaries.
+ * Operands that do not depend on c are referenced as scalar slots.
+ *
+ * @param parser Parser state
+ * @param node Subtree root
+ * @param reg Destination register
+ */
+static void
+expr_generate_vector(expr_parser_t *parser, int node, int reg)
+{
+    const expr_node_t *n           = &parser->nodes[node];
+    expr_instruction_t instruction = { .opcode = (uint8_t)n->opcode, .dst = (uint8_t)reg };
+
+    if (reg >= EXPR_MAX_REGISTERS)
+    {
+        expr_fail(parser, EXPR_ERROR_TOO_COMPLEX);
+        return;
+    }
+
+    if (!n->varies)
+    {
+        /* Whole expression is constant across the row */
+        instruction.opcode   = EXPR_OP_BROADCAST;
+        instruction.a        = (uint8_t)expr_generate_scalar(parser, node);
+        instruction.a_scalar = true;
+    }
+    else if (n->left < 0)
+    {
+        /* The column leaf */
+    }
+    else if (n->right < 0)
+    {
+        expr_generate_vector(parser, n->left, reg);
+        instruction.a = (uint8_t)reg;
+    }
+    else if (parser->nodes[n->left].varies && parser->nodes[n->right].varies)
+    {
+        expr_generate_vector(parser, n->left, reg);
+        expr_generate_vector(parser, n->right, reg + 1);
+        instruction.a = (uint8_t)reg;
+        instruction.b = (uint8_t)(reg + 1);
+    }
+    else if (parser->nodes[n->left].varies)
+    {
+        instruction.b        = (uint8_t)expr_generate_scalar(parser, n->right);
+        instruction.b_scalar = true;
+        expr_generate_vector(parser, n->left, reg);
+        instruction.a        = (uint8_t)reg;
+    }
+    else
+    {
+        instruction.a        = (uint8_t)expr_generate_scalar(parser, n->left);
+        instruction.a_scalar = true;
+        expr_generate_vector(parser, n->right, reg);
+        instruction.b        = (uint8_t)reg;
+    }
+
+    if (EXPR_SUCCESS == parser->error)
+    {
+        expr_emit(parser, true, instruction);
+    }
+}
+
+/**
+ * @brief Compile an expression over r and c
+ *
+ * @param text     Expression source
+ * @param program  Pointer to the program to populate
+ * @return         expr_error_t structure with error code, message and position
+ */
+expr_error_t
+expr_compile(const char *text, expr_program_t *program)
+{
+    expr_parser_t *parser = calloc(1, sizeof(*parser));
+    expr_error_t result   = EXPR_ERRORS[EXPR_ERROR_TOO_COMPLEX];
+    int root              = -1;
+
+    if (NULL == parser)
+    {
+        return result;
+    }
+
+    parser->text           = text;
+    parser->program        = program;
+    program->scalar_count  = 0;
+    program->vector_count  = 0;
+    program->has_bound     = false;
+
+    root = expr_parse_binary(parser, 0);
+
+    expr_skip_space(parser);
+    if (root >= 0 && '\0' != text[parser->position])
+    {
+        expr_fail(parser, EXPR_ERROR_SYNTAX);
+    }
+
+    if (EXPR_SUCCESS == parser->error)
+    {
+        expr_generate_vector(parser, root, 0);
+    }
+
+    for (size_t i = 0; i < EXPR_ERRORS_COUNT; i++)
+    {
+        if (parser->error == EXPR_ERRORS[i].code)
+        {
+            result          = EXPR_ERRORS[i];
+            result.position = parser->error_position;
+        }
+    }
+
+    free(parser);
+    return result;
+}
+
+/**
+ * @brief Apply a vector instruction's operation to every lane
+ *
+ * Expands to three loops covering vector-vector, vector-scalar and
+ * scalar-vector operands; x and y name the operands in OPERATION.
+ */
+#define EXPR_VECTOR_LOOP(OPERATION)                                         \
+    do                                                                      \
+    {                                                                       \
+        if (in->a_scalar)                                                   \
+        {                                                                   \
+            const uint64_t x = scalars[in->a];                              \
+            const uint64_t *b = registers[in->b];                           \
+            for (int i = 0; i < lanes; i++)                                 \
+            {                                                               \
+                const uint64_t y = b[i];                                    \
+                dst[i] = (OPERATION);                                       \
+            }                                                               \
+        }                                                                   \
+        else if (in->b_scalar)                                              \
+        {                                                                   \
+            const uint64_t *a = registers[in->a];                           \
+            const uint64_t y = scalars[in->b];                              \
+            for (int i = 0; i < lanes; i++)                                 \
+            {                                                               \
+                const uint64_t x = a[i];                                    \
+                dst[i] = (OPERATION);                                       \
+            }                                                               \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+            const uint64_t *a = registers[in->a];                           \
+            const uint64_t *b = registers[in->b];                           \
+            for (int i = 0; i < lanes; i++)                                 \
+            {                                                               \
+                const uint64_t x = a[i];                                    \
+                const uint64_t y = b[i];                                    \
+                dst[i] = (OPERATION);                                       \
+            }                                                               \
+        }                                                                   \
+    } while (0)
+
+/**
+ * @brief Row kernel evaluating a compiled expression
+ *
+ * @param context Pointer to an expr_program_t
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void
+expr_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    const expr_program_t *program = context;
+    uint64_t scalars[EXPR_MAX_NODES];
+    uint64_t storage[EXPR_MAX_REGISTERS - 1][EXPR_CHUNK];
+    uint64_t *registers[EXPR_MAX_REGISTERS];
+
+    /* Loop-invariant part: once per row */
+    for (int pc = 0; pc < program->scalar_count; pc++)
+    {
+        const expr_instruction_t *in = &program->scalar[pc];
+
+        switch (in->opcode)
+        {
+            case EXPR_OP_ROW:
+                scalars[in->dst] = (uint64_t)(int64_t)row;
+            break;
+
+            case EXPR_OP_CONSTANT:
+                scalars[in->dst] = (uint64_t)in->immediate;
+            break;
+
+            default:
+                scalars[in->dst] = expr_apply((expr_opcode_t)in->opcode,
+                                              scalars[in->a], scalars[in->b]);
+            break;
+        }
+    }
+
+    for (int i = 1; i < EXPR_MAX_REGISTERS; i++)
+    {
+        registers[i] = storage[i - 1];
+    }
+
+    /* Varying part: each instruction runs across a chunk of columns */
+    for (int start = 0; start < count; start += EXPR_CHUNK)
+    {
+        int lanes    = (count - start < EXPR_CHUNK) ? count - start : EXPR_CHUNK;
+        registers[0] = values + start;
+
+        for (int pc = 0; pc < program->vector_count; pc++)
+        {
+            const expr_instruction_t *in = &program->vector[pc];
+            uint64_t *dst                = registers[in->dst];
+
+            switch (in->opcode)
+            {
+                case EXPR_OP_COLUMN:
+                    for (int i = 0; i < lanes; i++)
+                    {
+                        dst[i] = (uint64_t)(int64_t)(column + start + i);
+                    }
+                break;
+
+                case EXPR_OP_BROADCAST:
+                    for (int i = 0; i < lanes; i++)
+                    {
+                        dst[i] = scalars[in->a];
+                    }
+                break;
+
+                case EXPR_OP_NEGATE:
+                    for (int i = 0; i < lanes; i++)
+                    {
+                        dst[i] = 0 - registers[in->a][i];
+                    }
+                break;
+
+                case EXPR_OP_NOT:
+                    for (int i = 0; i < lanes; i++)
+                    {
+                        dst[i] = ~registers[in->a][i];
+                    }
+                break;
+
+                case EXPR_OP_ADD:         EXPR_VECTOR_LOOP(x + y);                      break;
+                case EXPR_OP_SUBTRACT:    EXPR_VECTOR_LOOP(x - y);                      break;
+                case EXPR_OP_MULTIPLY:    EXPR_VECTOR_LOOP(x * y);                      break;
+                case EXPR_OP_DIVIDE:      EXPR_VECTOR_LOOP(expr_divide(x, y));          break;
+                case EXPR_OP_REMAINDER:   EXPR_VECTOR_LOOP(expr_remainder(x, y));       break;
+                case EXPR_OP_AND:         EXPR_VECTOR_LOOP(x & y);                      break;
+                case EXPR_OP_OR:          EXPR_VECTOR_LOOP(x | y);                      break;
+                case EXPR_OP_XOR:         EXPR_VECTOR_LOOP(x ^ y);                      break;
+                case EXPR_OP_SHIFT_LEFT:  EXPR_VECTOR_LOOP(x << (y & 63u));             break;
+                case EXPR_OP_SHIFT_RIGHT: EXPR_VECTOR_LOOP(expr_shift_right(x, y));     break;
+
+                default:
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Evaluate every row of an expression for its largest magnitude
+ *
+ * @param program Compiled expression
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t Largest absolute cell value
+ */
+static uint64_t
+expr_scan_bound(const expr_program_t *program, int min_value, int max_value)
+{
+    int count        = max_value - min_value + 1;
+    uint64_t *values = malloc((size_t)count * sizeof(*values));
+    uint64_t largest = 0;
+
+    if (NULL == values)
+    {
+        /* Fall back to the widest possible cell */
+        return UINT64_MAX;
+    }
+
+    for (int row = min_value; row <= max_value; row++)
+    {
+        expr_row(program, row, min_value, count, values);
+
+        for (int i = 0; i < count; i++)
+        {
+            uint64_t magnitude = (values[i] >> 63) ? 0 - values[i] : values[i];
+            largest            = (magnitude > largest) ? magnitude : largest;
+        }
+    }
+
+    free(values);
+    return largest;
+}
+
+/**
+ * @brief Evaluate the largest magnitude of an expression table once
+ *
+ * @param program Compiled expression
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ */
+void
+expr_compute_bound(expr_program_t *program, int min_value, int max_value)
+{
+    program->bound     = expr_scan_bound(program, min_value, max_value);
+    program->bound_min = min_value;
+    program->bound_max = max_value;
+    program->has_bound = true;
+}
+
+/**
+ * @brief Largest magnitude produced by an expression over the table
+ *
+ * @param context Pointer to an expr_program_t
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t Largest absolute cell value
+ */
+uint64_t
+expr_value_bound(const void *context, int min_value, int max_value)
+{
+    const expr_program_t *program = context;
+
+    if (program->has_bound && min_value == program->bound_min && max_value == program->bound_max)
+    {
+        return program->bound;
+    }
+
+    return expr_scan_bound(program, min_value, max_value);
+}
@@ -0,0 +1,441 @@
+/**
+ * @file timestable_find.c
+ * @brief Implementation of the inverse table lookup
+ *
+ * Every search costs about the number of matches plus, for products, the
+ * factorization of the value; nothing is proportional to the table size.
+ */
+
+#include <stdlib.h>                 // malloc(), free(), qsort()
+#include <math.h>                   // pow(), llround()
+
+#include "timestable_find.h"        // find_index_t, find_range_t, find_cells()
+
+/**
+ * @brief Most distinct prime factors of a value below 2^64
+ */
+#define MAX_PRIME_FACTORS 16
+
+/**
+ * @brief Highest exponent with a power of 2 or more below 2^64
+ */
+#define MAX_ROOT_EXPONENT 63
+
+/**
+ * @brief Build the lookup index for a table range
+ *
+ * @param index      Index to initialize
+ * @param min_value  Minimum value for rows and columns
+ * @param max_value  Maximum value for rows and columns (at most FIND_MAX_VALUE)
+ * @return           bool true on success, false if allocation failed
+ */
+bool
+find_index_init(find_index_t *index, int min_value, int max_value)
+{
+    size_t size = (size_t)max_value + 1;
+
+    index->min_value       = min_value;
+    index->max_value       = max_value;
+    index->prime_count     = 0;
+    index->smallest_factor = calloc(size, sizeof(*index->smallest_factor));
+    index->primes          = malloc(size * sizeof(*index->primes));
+
+    if (NULL == index->smallest_factor || NULL == index->primes)
+    {
+        find_index_free(index);
+        return false;
+    }
+
+    /* Linear sieve: each composite is struck once, by its smallest prime */
+    for (uint32_t n = 2; n < size; n++)
+    {
+        if (0 == index->smallest_factor[n])
+        {
+            index->smallest_factor[n]           = n;
+            index->primes[index->prime_count++] = n;
+        }
+
+        for (size_t i = 0; i < index->prime_count; i++)
+        {
+            uint32_t prime = index->primes[i];
+
+            if (prime > index->smallest_factor[n] || (uint64_t)prime * n >= size)
+            {
+                break;
+            }
+            index->smallest_factor[prime * n] = prime;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Release a lookup index
+ *
+ * @param index Index to release
+ */
+void
+find_index_free(find_index_t *index)
+{
+    free(index->smallest_factor);
+    free(index->primes);
+    index->smallest_factor = NULL;
+    index->primes          = NULL;
+    index->prime_count     = 0;
+}
+
+/**
+ * @brief Factor a value of at most max_value squared
+ *
+ * Values above max_value are trial-divided by the sieved primes until the
+ * rest can be looked up. A rest still above max_value is prime: two
+ * factors above max_value would make the value exceed max_value squared.
+ *
+ * @param index      Lookup index
+ * @param value      Value to factor (at least 1)
+ * @param primes     Set to the distinct prime factors
+ * @param exponents  Set to the exponent of each prime factor
+ * @return           size_t Number of distinct prime factors
+ */
+static size_t
+factorize(const find_index_t *index, uint64_t value, uint64_t *primes, int *exponents)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < index->prime_count && value > (uint64_t)index->max_value; i++)
+    {
+        uint64_t prime = index->primes[i];
+
+        if (prime * prime > value)
+        {
+            break;
+        }
+
+        if (0 == value % prime)
+        {
+            primes[count]    = prime;
+            exponents[count] = 0;
+            while (0 == value % prime)
+            {
+                value /= prime;
+                exponents[count]++;
+            }
+            count++;
+        }
+    }
+
+    if (value > (uint64_t)index->max_value)
+    {
+        primes[count]      = value;
+        exponents[count++] = 1;
+        return count;
+    }
+
+    while (value > 1)
+    {
+        uint64_t prime = index->smallest_factor[value];
+
+        primes[count]    = prime;
+        exponents[count] = 0;
+        while (0 == value % prime)
+        {
+            value /= prime;
+            exponents[count]++;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Order 64-bit values for qsort()
+ *
+ * @param left   First value
+ * @param right  Second value
+ * @return       int Negative, zero or positive as left is below, equal to or above right
+ */
+static int
+compare_u64(const void *left, const void *right)
+{
+    uint64_t a = *(const uint64_t *)left;
+    uint64_t b = *(const uint64_t *)right;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Report one matching cell or range
+ *
+ * @param visit         Function receiving the range
+ * @param context       Data passed to visit
+ * @param first_row     First matching row
+ * @param last_row      Last matching row
+ * @param first_column  First matching column
+ * @param last_column   Last matching column
+ * @return              bool Result of visit
+ */
+static bool
+report(find_visit_t visit, void *context, uint64_t first_row, uint64_t last_row,
+       uint64_t first_column, uint64_t last_column)
+{
+    find_range_t range = {
+        .first_row    = (int)first_row,
+        .last_row     = (int)last_row,
+        .first_column = (int)first_column,
+        .last_column  = (int)last_column
+    };
+
+    return visit(context, &range);
+}
+
+/**
+ * @brief Find the cells with row × column = value
+ *
+ * @param index    Lookup index
+ * @param value    Value to look for
+ * @param visit    Function receiving each match
+ * @param context  Data passed to visit
+ * @return         bool true if the search finished
+ */
+static bool
+find_products(const find_index_t *index, uint64_t value, find_visit_t visit, void *context)
+{
+    uint64_t min = (uint64_t)index->min_value;
+    uint64_t max = (uint64_t)index->max_value;
+    uint64_t primes[MAX_PRIME_FACTORS];
+    int exponents[MAX_PRIME_FACTORS];
+    uint64_t *divisors;
+    size_t divisor_count = 1;
+    size_t factor_count;
+    bool success = true;
+
+    /* Zero fills row 0 and column 0 */
+    if (0 == value)
+    {
+        if (0 != min)
+        {
+            return true;
+        }
+
+        return report(visit, context, 0, 0, 0, max) &&
+               (max < 1 || report(visit, context, 1, max, 0, 0));
+    }
+
+    if (0 == max || value / max > max)
+    {
+        return true;
+    }
+
+    factor_count = factorize(index, value, primes, exponents);
+    for (size_t i = 0; i < factor_count; i++)
+    {
+        divisor_count *= (size_t)exponents[i] + 1;
+    }
+
+    divisors = malloc(divisor_count * sizeof(*divisors));
+    if (NULL == divisors)
+    {
+        return false;
+    }
+
+    /* Multiply the divisors found so far by each power of the next prime */
+    divisors[0]   = 1;
+    divisor_count = 1;
+    for (size_t i = 0; i < factor_count; i++)
+    {
+        size_t previous = divisor_count;
+        uint64_t power  = 1;
+
+        for (int e = 1; e <= exponents[i]; e++)
+        {
+            power *= primes[i];
+            for (size_t j = 0; j < previous; j++)
+            {
+                divisors[divisor_count++] = divisors[j] * power;
+            }
+        }
+    }
+
+    qsort(divisors, divisor_count, sizeof(*divisors), compare_u64);
+
+    for (size_t i = 0; i < divisor_count && success; i++)
+    {
+        uint64_t row    = divisors[i];
+        uint64_t column = value / row;
+
+        if (row >= min && row <= max && column >= min && column <= max)
+        {
+            success = report(visit, context, row, row, column, column);
+        }
+    }
+
+    free(divisors);
+    return success;
+}
+
+/**
+ * @brief Find the cells with row ÷ column = value (truncated)
+ *
+ * Column c holds value in the rows value × c to value × c + c - 1.
+ *
+ * @param index    Lookup index
+ * @param value    Value to look for
+ * @param visit    Function receiving each match
+ * @param context  Data passed to visit
+ * @return         bool true if the search finished
+ */
+static bool
+find_quotients(const find_index_t *index, uint64_t value, find_visit_t visit, void *context)
+{
+    uint64_t min = (uint64_t)index->min_value;
+    uint64_t max = (uint64_t)index->max_value;
+
+    if (value > max)
+    {
+        return true;
+    }
+
+    /* Column 0 is undefined; beyond max / value the interval starts past max */
+    for (uint64_t column = (min > 1) ? min : 1;
+         column <= max && value * column <= max; column++)
+    {
+        uint64_t first = value * column;
+        uint64_t last  = first + column - 1;
+
+        if (first < min)
+            first = min;
+        if (last > max)
+            last = max;
+
+        if (first <= last && !report(visit, context, first, last, column, column))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check whether base ^ exponent equals a value, without overflow
+ *
+ * @param base      Base (at least 2)
+ * @param exponent  Exponent
+ * @param value     Value to compare with
+ * @return          bool true if base ^ exponent == value
+ */
+static bool
+power_equals(uint64_t base, int exponent, uint64_t value)
+{
+    uint64_t result = 1;
+
+    for (int i = 0; i < exponent; i++)
+    {
+        if (result > value / base)
+        {
+            return false;
+        }
+        result *= base;
+    }
+
+    return result == value;
+}
+
+/**
+ * @brief Find the cells with row ^ column = value
+ *
+ * Bases 0 and 1 and exponent 0 give whole rows or columns; every other
+ * match is value itself to the power 1 or its exact integer root for one
+ * higher exponent.
+ *
+ * @param index    Lookup index
+ * @param value    Value to look for
+ * @param visit    Function receiving each match
+ * @param context  Data passed to visit
+ * @return         bool true if the search finished
+ */
+static bool
+find_powers(const find_index_t *index, uint64_t value, find_visit_t visit, void *context)
+{
+    uint64_t min          = (uint64_t)index->min_value;
+    uint64_t max          = (uint64_t)index->max_value;
+    uint64_t first_column = (min > 1) ? min : 1;
+
+    if (1 == value && 0 == min && !report(visit, context, min, max, 0, 0))
+    {
+        return false;
+    }
+
+    if (0 == value && 0 == min && max >= 1 && !report(visit, context, 0, 0, first_column, max))
+    {
+        return false;
+    }
+
+    if (1 == value && min <= 1 && max >= 1 && !report(visit, context, 1, 1, first_column, max))
+    {
+        return false;
+    }
+
+    if (value < 2)
+    {
+        return true;
+    }
+
+    if (1 == first_column && value <= max && !report(visit, context, value, value, 1, 1))
+    {
+        return false;
+    }
+
+    for (uint64_t column = (first_column > 2) ? first_column : 2;
+         column <= max && column <= MAX_ROOT_EXPONENT; column++)
+    {
+        /* The floating-point root is within one of the exact one */
+        uint64_t estimate = (uint64_t)llround(pow((double)value, 1.0 / (double)column));
+
+        for (uint64_t row = (estimate > 2) ? estimate - 1 : 2; row <= estimate + 1; row++)
+        {
+            if (row >= min && row <= max && power_equals(row, (int)column, value))
+            {
+                if (!report(visit, context, row, row, column, column))
+                {
+                    return false;
+                }
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Report every cell of a table holding a value
+ *
+ * @param index      Lookup index of the table range
+ * @param operation  Operation of the table
+ * @param value      Value to look for
+ * @param visit      Function receiving each group of matching cells
+ * @param context    Data passed to visit
+ * @return           bool true if the search finished, false if visit
+ *                   stopped it or memory ran out
+ */
+bool
+find_cells(const find_index_t *index, find_operation_t operation, uint64_t value,
+           find_visit_t visit, void *context)
+{
+    switch (operation)
+    {
+        case FIND_MULTIPLY:
+            return find_products(index, value, visit, context);
+
+        case FIND_DIVIDE:
+            return find_quotients(index, value, visit, context);
+
+        case FIND_POWER:
+            return find_powers(index, value, visit, context);
+    }
+
+    return false;
+}
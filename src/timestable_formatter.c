@@ -7,14 +7,60 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
+#include <sys/stat.h>
 #include "timestable_formatter.h"
+#include "timestable_bigint.h"
+#include "timestable_output.h"
+#include "timestable_decimal.h"
+#include "timestable_trace.h"
 
 #define HEX_ZERO_WIDTH 3
 #define DECIMAL_ZERO_WIDTH 1
 #define MIN_CELL_WIDTH 4
 #define CELL_PADDING 1
+#define U64_TEXT_SIZE 24
+#define MIRROR_TILE 16
+
+/**
+ * @brief Value written in binary output for non-numeric cells
+ */
+#define BINARY_UNDEFINED UINT64_MAX
+
+/**
+ * @brief Values 0 to CELL_CACHE_VALUES - 1 may be held by a cell cache
+ */
+#define CELL_CACHE_VALUES 65536
+
+/**
+ * @brief Most bytes of padded text held by one cell cache
+ */
+#define CELL_CACHE_BUDGET (1u << 20)
+
+/**
+ * @brief Most bytes of text in the mirrored grid of a symmetric table
+ *
+ * Larger tables are printed row by row instead.
+ */
+#define MIRROR_GRID_BUDGET ((size_t)256 << 20)
+
+/**
+ * @brief Padded text of small cell values for one cell width and format
+ *
+ * Cells are rendered on first use, so a cache costs only the pages of the
+ * values actually printed. Table cells and row labels are padded to the
+ * same width, so each hit is one copy of width bytes.
+ */
+typedef struct
+{
+    char *cells;                     /**< count cells of width bytes; NUL-led until rendered */
+    size_t count;                    /**< Values held (0 if allocation failed) */
+    size_t width;                    /**< Width of every cell, including padding */
+    output_format_t format;          /**< Format of the text (decimal, hex) */
+} cell_cache_t;
 
 /**
  * @brief Calculate the required cell width for a value based on format
@@ -24,7 +70,7 @@
  * @return int    The required width in characters
  */
 static
-int calculate_numeric_width(int value, output_format_t format)
+int calculate_numeric_width(uint64_t value, output_format_t format)
 {
     int width = 0;
 
@@ -43,11 +89,72 @@ int calculate_numeric_width(int value, output_format_t format)
                 value /= 16;
             } while (value > 0 || 2 == width); //Handle zero case within the loop.
             break;
+
+        case FORMAT_BINARY:
+            width = (int)sizeof(uint64_t);
+            break;
     }
 
     return width;
 }
 
+/**
+ * @brief Render an unsigned value as text ending at the given position
+ *
+ * Decimal digits are produced two at a time from a lookup table, so no
+ * printf() family call is made per cell.
+ *
+ * @param value   Value to render
+ * @param format  Output format (decimal, hex)
+ * @param end     One past the last byte of the destination
+ * @return size_t Number of characters written before end
+ */
+static size_t
+format_u64(uint64_t value, output_format_t format, char *end)
+{
+    static const char DIGIT_PAIRS[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    char *cursor = end;
+
+    switch (format)
+    {
+        case FORMAT_DECIMAL:
+        case FORMAT_BINARY:
+            while (value >= 100)
+            {
+                unsigned pair = (unsigned)(value % 100) * 2;
+                value /= 100;
+                *--cursor = DIGIT_PAIRS[pair + 1];
+                *--cursor = DIGIT_PAIRS[pair];
+            }
+            if (value >= 10)
+            {
+                *--cursor = DIGIT_PAIRS[value * 2 + 1];
+                *--cursor = DIGIT_PAIRS[value * 2];
+            }
+            else
+            {
+                *--cursor = (char)('0' + value);
+            }
+        break;
+
+        case FORMAT_HEX:
+            do
+            {
+                *--cursor = HEX_DIGITS[value & 0xfu];
+                value >>= 4;
+            } while (value > 0);
+            *--cursor = 'x';
+            *--cursor = '0';
+        break;
+    }
+
+    return (size_t)(end - cursor);
+}
+
 /**
  * @brief Format and print a cell value according to the specified format
  *
@@ -73,8 +180,20 @@ print_cell(cell_value_t cell_value, int width, output_format_t format)
                 snprintf(buffer, sizeof(buffer), "0x%x", cell_value.num_value);
                 printf("%*s", width, buffer);
             break;
+
+            case FORMAT_BINARY:
+            {
+                uint64_t raw = (uint64_t)(int64_t)cell_value.num_value;
+                fwrite(&raw, sizeof(raw), 1, stdout);
+            }
+            break;
         }
     }
+    else if (FORMAT_BINARY == format)
+    {
+        uint64_t raw = BINARY_UNDEFINED;
+        fwrite(&raw, sizeof(raw), 1, stdout);
+    }
     else
     {
         printf("%*s", width, cell_value.str_value);
@@ -82,26 +201,135 @@ print_cell(cell_value_t cell_value, int width, output_format_t format)
 }
 
 /**
- * @brief Print a formatted table using the specified operation
+ * @brief Print the column header row and the separator line beneath it
  *
- * @param min_value Minimum value for rows and columns
- * @param max_value Maximum value for rows and columns
- * @param operation Function pointer to the operation to perform
- * @param title Title to display for the table
- * @param format Output format to use (decimal, hex)
+ * @param min_value Minimum column value
+ * @param max_value Maximum column value
+ * @param max_width Width of every cell
+ * @param format Output format to use
  */
-void
-print_table(int min_value,
-            int max_value,
-            TableOperation operation,
-            const char *title,
-            output_format_t format)
+static void
+print_header(int min_value, int max_value, int max_width, output_format_t format)
 {
     int row;
     int column;
-    int max_width;
 
-    printf("\n%s\n", title);
+    /* Print header row */
+    printf("%*s |", max_width, "");
+    for (column = min_value; column <= max_value; column++)
+    {
+        cell_value_t header;
+        header.is_numeric = true;
+        header.num_value = column;
+        print_cell(header, max_width, format);
+    }
+    printf("\n");
+
+    /* Print separator line */
+    for (column = 0; column < max_width; column++)
+    {
+        printf("-");
+    }
+    printf("-+");
+
+    for (column = min_value; column <= max_value; column++)
+    {
+        for (row = 0; row < max_width; row++)
+        {
+            printf("-");
+        }
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Append text to an output buffer right-aligned in a cell
+ *
+ * @param output Buffer to append to
+ * @param text Cell text
+ * @param length Length of the cell text
+ * @param width Width of the cell
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_cell(output_buffer_t *output, const char *text, size_t length, size_t width)
+{
+    if (length < width && !output_buffer_fill(output, ' ', width - length))
+    {
+        return false;
+    }
+
+    return output_buffer_append(output, text, length);
+}
+
+/**
+ * @brief Generate a row of cell values incrementally when possible
+ *
+ * @param generator Generator state to use
+ * @param operation Operation of the table
+ * @param row Row value
+ * @param min_value First column value
+ * @param max_value Last column value
+ * @param numbers Array for the row's values, or NULL if none was allocated
+ * @return const int* numbers filled with the row, or NULL if the operation
+ *         must be called for each cell
+ */
+static const int *
+generate_row(table_generator_t *generator,
+             TableOperation operation,
+             int row,
+             int min_value,
+             int max_value,
+             int *numbers)
+{
+    if (NULL == numbers || !gen_init(generator, operation, row, min_value))
+    {
+        return NULL;
+    }
+
+    gen_fill(generator, max_value - min_value + 1, numbers);
+    return numbers;
+}
+
+/**
+ * @brief Get one cell of a row, from generated values or the operation
+ *
+ * @param operation Operation of the table
+ * @param generated Row values from generate_row(), or NULL
+ * @param row Row value
+ * @param column Column value
+ * @param min_value First column value of the row
+ * @return cell_value_t The cell
+ */
+static cell_value_t
+row_cell(TableOperation operation, const int *generated, int row, int column, int min_value)
+{
+    cell_value_t value;
+
+    if (NULL == generated)
+    {
+        operation(row, column, &value);
+        return value;
+    }
+
+    value.is_numeric   = true;
+    value.num_value    = generated[column - min_value];
+    value.str_value[0] = '\0';
+    return value;
+}
+
+/**
+ * @brief Calculate the cell width of a table printed with print_table()
+ *
+ * @param max_value Maximum value for rows and columns
+ * @param title Title of the table, used to recognise the power table
+ * @param format Output format to use
+ * @return int Width of every cell, including padding
+ */
+static int
+table_cell_width(int max_value, const char *title, output_format_t format)
+{
+    int max_width;
 
     /* Calculate maximum width needed based on largest possible value */
     int largest_possible = max_value * max_value; /* Largest value from multiplication */
@@ -115,59 +343,3297 @@ print_table(int min_value,
         largest_possible = (int)pow(max_value, max_exponent);
     }
 
-    max_width = calculate_numeric_width(largest_possible, format);
+    max_width = calculate_numeric_width((largest_possible < 0) ? 0 : (uint64_t)largest_possible,
+                                        format);
 
     /* Ensure we meet minimum width requirement */
     if (max_width < MIN_CELL_WIDTH)
         max_width = MIN_CELL_WIDTH;
 
     /* Add padding */
-    max_width += CELL_PADDING;
+    return max_width + CELL_PADDING;
+}
 
-    /* Print header row */
-    printf("%*s |", max_width, "");
-    for (column = min_value; column <= max_value; column++)
+/**
+ * @brief Calculate the cell width of a table printed with print_row_table()
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Row operation computing the cell values
+ * @param format Output format to use
+ * @return size_t Width of every cell, including padding
+ */
+static size_t
+row_cell_width(int min_value, int max_value, const row_operation_t *operation,
+               output_format_t format)
+{
+    uint64_t largest = operation->value_bound(operation->context, min_value, max_value);
+    size_t max_width = (size_t)calculate_numeric_width(largest, format);
+
+    if (operation->is_signed)
+        max_width++;
+    if (max_width < (size_t)calculate_numeric_width((uint64_t)max_value, format))
+        max_width = (size_t)calculate_numeric_width((uint64_t)max_value, format);
+
+    if (max_width < MIN_CELL_WIDTH)
+        max_width = MIN_CELL_WIDTH;
+
+    return max_width + CELL_PADDING;
+}
+
+/**
+ * @brief Render a cell value as text ending at the given position
+ *
+ * Matches print_cell(): decimal values are signed, hexadecimal values are
+ * the 32-bit two's complement pattern.
+ *
+ * @param cell_value Cell value to render
+ * @param format Output format (decimal, hex)
+ * @param end One past the last byte of the destination
+ * @return size_t Number of characters written before end
+ */
+static size_t
+format_cell_value(const cell_value_t *cell_value, output_format_t format, char *end)
+{
+    size_t length;
+
+    if (!cell_value->is_numeric)
     {
-        cell_value_t header;
-        header.is_numeric = true;
-        header.num_value = column;
-        print_cell(header, max_width, format);
+        length = strlen(cell_value->str_value);
+        memcpy(end - length, cell_value->str_value, length);
+    }
+    else if (FORMAT_HEX == format)
+    {
+        length = format_u64((uint32_t)cell_value->num_value, format, end);
+    }
+    else if (cell_value->num_value < 0)
+    {
+        length = format_u64(0 - (uint64_t)(int64_t)cell_value->num_value, format, end);
+        *(end - ++length) = '-';
+    }
+    else
+    {
+        length = format_u64((uint64_t)cell_value->num_value, format, end);
     }
-    printf("\n");
 
-    /* Print separator line */
-    for (column = 0; column < max_width; column++)
+    return length;
+}
+
+/**
+ * @brief Render a row operation value as text ending at the given position
+ *
+ * @param value Cell value
+ * @param operation Row operation that produced the value
+ * @param format Output format (decimal, hex)
+ * @param end One past the last byte of the destination
+ * @return size_t Number of characters written before end
+ */
+static size_t
+format_row_value(uint64_t value, const row_operation_t *operation, output_format_t format, char *end)
+{
+    const char *marker = row_value_marker(operation, value);
+    size_t length;
+
+    if (NULL != marker)
     {
-        printf("-");
+        length = strlen(marker);
+        memcpy(end - length, marker, length);
+    }
+    else if (operation->is_signed && (value >> 63))
+    {
+        length = format_u64(0 - value, format, end);
+        *(end - ++length) = '-';
+    }
+    else
+    {
+        length = format_u64(value, format, end);
     }
-    printf("-+");
 
-    for (column = min_value; column <= max_value; column++)
+    return length;
+}
+
+/**
+ * @brief Cells interned by the printers that format on one thread at a time
+ *
+ * It is kept from table to table, so tables of the same width and format
+ * (such as those of -t a) reuse the cells already rendered.
+ */
+static cell_cache_t interned_cells;
+
+/**
+ * @brief Number of values a cache holds for the values up to largest
+ *
+ * A cache holds no more than CELL_CACHE_VALUES values or
+ * CELL_CACHE_BUDGET bytes, and only values whose text fits the width.
+ *
+ * @param width Width of every cell, including padding
+ * @param format Format of the text (decimal, hex)
+ * @param largest Largest value worth caching
+ * @return size_t Number of values, from 0 up
+ */
+static size_t
+cell_cache_capacity(size_t width, output_format_t format, uint64_t largest)
+{
+    size_t count = CELL_CACHE_VALUES;
+
+    if (largest < count)
     {
-        for (row = 0; row < max_width; row++)
-        {
-            printf("-");
-        }
+        count = (size_t)largest + 1;
+    }
+    if (count > CELL_CACHE_BUDGET / width)
+    {
+        count = CELL_CACHE_BUDGET / width;
     }
-    printf("\n");
 
-    /* Print table body */
-    for (row = min_value; row <= max_value; row++)
+    while (count > 0 && (size_t)calculate_numeric_width(count - 1, format) > width)
     {
-        /* Print row label */
-        cell_value_t label;
-        label.is_numeric = true;
-        label.num_value = row;
-        print_cell(label, max_width, format);
-        printf(" |");
+        count /= 2;
+    }
 
-        /* Print row data */
-        for (column = min_value; column <= max_value; column++)
-        {
-            cell_value_t value;
-            operation(row, column, &value);
-            print_cell(value, max_width, format);
-        }
-        printf("\n");
+    return count;
+}
+
+/**
+ * @brief Set up a cache of padded cells for the values up to largest
+ *
+ * @param cache Cache to set up
+ * @param width Width of every cell, including padding
+ * @param format Format of the text (decimal, hex)
+ * @param largest Largest value worth caching
+ */
+static void
+cell_cache_init(cell_cache_t *cache, size_t width, output_format_t format, uint64_t largest)
+{
+    size_t count = cell_cache_capacity(width, format, largest);
+
+    cache->width  = width;
+    cache->format = format;
+    cache->cells  = (count > 0) ? calloc(count, width) : NULL;
+    cache->count  = (NULL != cache->cells) ? count : 0;
+}
+
+/**
+ * @brief Release a cell cache
+ *
+ * @param cache Cache to release
+ */
+static void
+cell_cache_free(cell_cache_t *cache)
+{
+    free(cache->cells);
+    cache->cells = NULL;
+    cache->count = 0;
+}
+
+/**
+ * @brief Get the interned cache for a cell width and format
+ *
+ * The cache is kept if it already holds the values up to largest, and set
+ * up again otherwise. Only one thread may use it at a time.
+ *
+ * @param width Width of every cell, including padding
+ * @param format Format of the text (decimal, hex)
+ * @param largest Largest value worth caching
+ * @return cell_cache_t* The interned cache
+ */
+static cell_cache_t *
+cell_cache_acquire(size_t width, output_format_t format, uint64_t largest)
+{
+    if (width != interned_cells.width || format != interned_cells.format ||
+        interned_cells.count < cell_cache_capacity(width, format, largest))
+    {
+        cell_cache_free(&interned_cells);
+        cell_cache_init(&interned_cells, width, format, largest);
+    }
+
+    return &interned_cells;
+}
+
+/**
+ * @brief Get the padded text of a value, rendering it on first use
+ *
+ * @param cache Cache to look in
+ * @param value Value to look up
+ * @return const char* cache->width bytes of text, or NULL if value is not cached
+ */
+static const char *
+cell_cache_lookup(cell_cache_t *cache, uint64_t value)
+{
+    char *cell;
+
+    if (value >= cache->count)
+    {
+        return NULL;
+    }
+
+    /* Padded text never starts with NUL, so NUL marks a cell not yet rendered */
+    cell = cache->cells + value * cache->width;
+    if ('\0' == cell[0])
+    {
+        char text[U64_TEXT_SIZE];
+        size_t length = format_u64(value, cache->format, text + sizeof(text));
+
+        memset(cell, ' ', cache->width - length);
+        memcpy(cell + cache->width - length, text + sizeof(text) - length, length);
+    }
+
+    return cell;
+}
+
+/**
+ * @brief Render every cell of a cache, so threads may share it read-only
+ *
+ * @param cache Cache to fill
+ */
+static void
+cell_cache_fill(cell_cache_t *cache)
+{
+    for (size_t value = 0; value < cache->count; value++)
+    {
+        cell_cache_lookup(cache, value);
+    }
+}
+
+/**
+ * @brief Largest cell value worth caching for a table
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @return uint64_t Bound on the cells and row labels; just the row labels
+ *         when the operation has no cheap bound
+ */
+static uint64_t
+cell_cache_bound(int min_value, int max_value, TableOperation operation,
+                 const row_operation_t *row_operation)
+{
+    uint64_t bound = 0;
+
+    if (multiply == operation)
+    {
+        bound = (uint64_t)max_value * (uint64_t)max_value;
+    }
+    else if (divide == operation)
+    {
+        bound = (uint64_t)max_value;
     }
-}
\ No newline at end of file
+    else if (NULL == operation)
+    {
+        bound = row_operation->value_bound(row_operation->context, min_value, max_value);
+    }
+
+    /* Row labels go through the cache too */
+    return (bound > (uint64_t)max_value) ? bound : (uint64_t)max_value;
+}
+
+/**
+ * @brief Append a row label and the " |" after it
+ *
+ * @param output Buffer to append to
+ * @param cache Cache of padded cells
+ * @param row Row value
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_row_label(output_buffer_t *output, cell_cache_t *cache, int row)
+{
+    const char *cell = cell_cache_lookup(cache, (uint64_t)row);
+    char text[U64_TEXT_SIZE];
+    size_t length;
+
+    if (NULL != cell)
+    {
+        return output_buffer_append(output, cell, cache->width) &&
+               output_buffer_append(output, " |", 2);
+    }
+
+    length = format_u64((uint64_t)row, cache->format, text + sizeof(text));
+    return append_cell(output, text + sizeof(text) - length, length, cache->width) &&
+           output_buffer_append(output, " |", 2);
+}
+
+/**
+ * @brief Append a cell value right-aligned in a cell
+ *
+ * @param output Buffer to append to
+ * @param cache Cache of padded cells
+ * @param value Cell value
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_cell_value(output_buffer_t *output, cell_cache_t *cache, const cell_value_t *value)
+{
+    const char *cell = NULL;
+    char text[U64_TEXT_SIZE];
+    size_t length;
+
+    if (value->is_numeric && value->num_value >= 0)
+    {
+        cell = cell_cache_lookup(cache, (uint64_t)value->num_value);
+    }
+
+    if (NULL != cell)
+    {
+        return output_buffer_append(output, cell, cache->width);
+    }
+
+    length = format_cell_value(value, cache->format, text + sizeof(text));
+    return append_cell(output, text + sizeof(text) - length, length, cache->width);
+}
+
+/**
+ * @brief Append a row operation value right-aligned in a cell
+ *
+ * @param output Buffer to append to
+ * @param cache Cache of padded cells
+ * @param value Cell value
+ * @param operation Row operation that produced the value
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_row_value(output_buffer_t *output, cell_cache_t *cache, uint64_t value,
+                 const row_operation_t *operation)
+{
+    const char *cell = cell_cache_lookup(cache, value);
+    char text[U64_TEXT_SIZE];
+    size_t length;
+
+    /* Markers and negative values lie far above any cached value */
+    if (NULL != cell)
+    {
+        return output_buffer_append(output, cell, cache->width);
+    }
+
+    length = format_row_value(value, operation, cache->format, text + sizeof(text));
+    return append_cell(output, text + sizeof(text) - length, length, cache->width);
+}
+
+/**
+ * @brief Find the rows to render and write the title and header if needed
+ *
+ * The title and header are left out when a resumed run already wrote them
+ * or they belong to another shard.
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param title Title to display for the table
+ * @param max_width Width of every cell, including padding
+ * @param format Output format to use (decimal, hex)
+ * @param first_row Set to the first row to render
+ * @param last_row Set to the last row to render
+ */
+static void
+begin_table_rows(int min_value, int max_value, const char *title, int max_width,
+                 output_format_t format, int *first_row, int *last_row)
+{
+    *first_row = min_value;
+    *last_row  = max_value;
+
+    if (output_begin_rows(stdout, first_row, last_row))
+    {
+        printf("\n%s\n", title);
+        print_header(min_value, max_value, max_width, format);
+    }
+}
+
+/**
+ * @brief Write a value right-aligned in a fixed-width cell, truncated to fit
+ *
+ * @param cache Cache of padded cells
+ * @param value Cell value
+ * @param max_width Width of the cell
+ * @param cell Destination of max_width bytes
+ */
+static inline void
+put_fixed_cell(cell_cache_t *cache, uint64_t value, size_t max_width, char *cell)
+{
+    const char *cached = cell_cache_lookup(cache, value);
+    char text[U64_TEXT_SIZE];
+    size_t length;
+
+    if (NULL != cached)
+    {
+        memcpy(cell, cached, max_width);
+        return;
+    }
+
+    length = format_u64(value, cache->format, text + sizeof(text));
+    if (length > max_width)
+    {
+        length = max_width;
+    }
+
+    memset(cell, ' ', max_width - length);
+    memcpy(cell + max_width - length, text + sizeof(text) - length, length);
+}
+
+/**
+ * @brief Define the formatting loop of one lane width for fixed-width cells
+ *
+ * Lanes are read as numbers; the caller handles tables with undefined cells.
+ */
+#define FIXED_CELLS_FROM_LANES(name, type)                                  \
+    static void                                                             \
+    name(cell_cache_t *cache, const void *lanes, size_t count,              \
+         size_t max_width, char *cell)                                      \
+    {                                                                       \
+        const type *values = lanes;                                         \
+                                                                            \
+        for (size_t i = 0; i < count; i++, cell += max_width)               \
+        {                                                                   \
+            put_fixed_cell(cache, values[i], max_width, cell);              \
+        }                                                                   \
+    }
+
+FIXED_CELLS_FROM_LANES(fixed_cells_from_lanes_8, uint8_t)
+FIXED_CELLS_FROM_LANES(fixed_cells_from_lanes_16, uint16_t)
+FIXED_CELLS_FROM_LANES(fixed_cells_from_lanes_32, uint32_t)
+
+/**
+ * @brief Format lanes into consecutive fixed-width cells
+ *
+ * @param width Width of the lanes
+ * @param cache Cache of padded cells
+ * @param lanes Array of count lanes
+ * @param count Number of cells
+ * @param max_width Width of every cell
+ * @param cell Destination of count × max_width bytes
+ */
+static void
+fixed_cells_from_lanes(value_width_t width, cell_cache_t *cache, const void *lanes,
+                       size_t count, size_t max_width, char *cell)
+{
+    switch (width)
+    {
+        case VALUE_WIDTH_8:
+            fixed_cells_from_lanes_8(cache, lanes, count, max_width, cell);
+            break;
+
+        case VALUE_WIDTH_16:
+            fixed_cells_from_lanes_16(cache, lanes, count, max_width, cell);
+            break;
+
+        case VALUE_WIDTH_32:
+            fixed_cells_from_lanes_32(cache, lanes, count, max_width, cell);
+            break;
+
+        case VALUE_WIDTH_NONE:
+            break;
+    }
+}
+
+/**
+ * @brief Print the table of a symmetric (commutative) operation
+ *
+ * Only the cells on and above the diagonal are computed and formatted,
+ * into a grid of fixed-width cells. For the full table the formatted bytes
+ * are then copied to their mirrored positions one MIRROR_TILE square at a
+ * time, so the rows read and the columns written both stay in cache. The
+ * triangle layout blanks the cells below the diagonal instead.
+ *
+ * Exactly one of operation and row_operation is used: operation when it is
+ * not NULL, otherwise row_operation. An operation whose cells fit a narrow
+ * type is computed a row at a time into lanes of that width.
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param title Title to display for the table
+ * @param max_width Width of every cell, including padding
+ * @param format Output format to use (decimal, hex)
+ * @param triangle Print only the upper triangle
+ * @param printed Set to false if only some rows are printed, the grid is over
+ *                MIRROR_GRID_BUDGET or could not be allocated, or a cell is
+ *                wider than max_width, and nothing was printed, so the caller
+ *                can print row by row
+ * @return bool true on success, false on allocation or write failure, or if
+ *         a cell is wider than max_width
+ */
+static bool
+print_symmetric_table(int min_value,
+                      int max_value,
+                      TableOperation operation,
+                      const row_operation_t *row_operation,
+                      const char *title,
+                      size_t max_width,
+                      output_format_t format,
+                      bool triangle,
+                      bool *printed)
+{
+    output_buffer_t output;
+    size_t count     = (size_t)(max_value - min_value + 1);
+    size_t row_size  = count * max_width;
+    char *grid       = NULL;
+    uint64_t *values = malloc(count * sizeof(*values));
+    char text[U64_TEXT_SIZE];
+    char *end        = text + sizeof(text);
+    bool success     = false;
+    int first_row    = min_value;
+    int last_row     = max_value;
+    table_generator_t generator;
+    cell_cache_t *cache;
+    value_width_t width = (NULL != operation) ? table_value_width(operation, min_value, max_value)
+                                              : VALUE_WIDTH_NONE;
+
+    /* Some of the rows (a shard or a resumed table) cost less row by row
+       than the whole grid; a triangle has no row-by-row layout */
+    output_begin_rows(stdout, &first_row, &last_row);
+    if ((triangle || (first_row == min_value && last_row == max_value)) &&
+        row_size <= MIRROR_GRID_BUDGET / count)
+    {
+        grid = malloc(count * row_size);
+    }
+
+    *printed = false;
+    if (NULL == grid || NULL == values ||
+        !output_buffer_init(&output, stdout, OUTPUT_BUFFER_DEFAULT_SIZE))
+    {
+        free(grid);
+        free(values);
+        return false;
+    }
+    *printed = true;
+
+    cache = cell_cache_acquire(max_width, format,
+                               cell_cache_bound(min_value, max_value, operation, row_operation));
+
+    /* Compute and format the upper triangle, diagonal included */
+    for (size_t i = 0; i < count; i++)
+    {
+        int row        = min_value + (int)i;
+        char *cell     = grid + i * row_size + i * max_width;
+        bool generated = false;
+
+        if (NULL == operation)
+        {
+            row_operation->kernel(row_operation->context, row, row, (int)(count - i), values);
+        }
+        else if (VALUE_WIDTH_NONE != width)
+        {
+            /* Multiplication has no undefined cell, so every lane is a number */
+            table_fill_lanes(operation, width, row, row, (int)(count - i), values);
+            fixed_cells_from_lanes(width, cache, values, count - i, max_width, cell);
+            continue;
+        }
+        else
+        {
+            generated = gen_init(&generator, operation, row, row);
+        }
+
+        for (size_t j = i; j < count; j++, cell += max_width)
+        {
+            const char *cached = NULL;
+            size_t length      = 0;
+
+            if (NULL != operation)
+            {
+                cell_value_t value;
+
+                if (generated)
+                {
+                    value.is_numeric = true;
+                    value.num_value  = gen_next(&generator);
+                }
+                else
+                {
+                    operation(row, min_value + (int)j, &value);
+                }
+
+                if (value.is_numeric && value.num_value >= 0)
+                {
+                    cached = cell_cache_lookup(cache, (uint64_t)value.num_value);
+                }
+                if (NULL == cached)
+                {
+                    length = format_cell_value(&value, format, end);
+                }
+            }
+            else if (NULL == (cached = cell_cache_lookup(cache, values[j - i])))
+            {
+                length = format_row_value(values[j - i], row_operation, format, end);
+            }
+
+            if (NULL != cached)
+            {
+                memcpy(cell, cached, max_width);
+                continue;
+            }
+
+            /* A cell wider than the bound would misalign the grid; nothing
+               has been written yet, so the caller prints row by row */
+            if (length > max_width)
+            {
+                *printed = false;
+                goto cleanup;
+            }
+
+            memset(cell, ' ', max_width - length);
+            memcpy(cell + max_width - length, end - length, length);
+        }
+    }
+
+    /* Mirror the upper triangle onto the lower one, tile by tile */
+    if (!triangle)
+    {
+        for (size_t tile_row = 0; tile_row < count; tile_row += MIRROR_TILE)
+        {
+            for (size_t tile_column = tile_row; tile_column < count; tile_column += MIRROR_TILE)
+            {
+                size_t row_end    = (tile_row + MIRROR_TILE < count) ? tile_row + MIRROR_TILE : count;
+                size_t column_end = (tile_column + MIRROR_TILE < count) ? tile_column + MIRROR_TILE : count;
+
+                for (size_t i = tile_row; i < row_end; i++)
+                {
+                    for (size_t j = (tile_column > i) ? tile_column : i + 1; j < column_end; j++)
+                    {
+                        memcpy(grid + j * row_size + i * max_width,
+                               grid + i * row_size + j * max_width, max_width);
+                    }
+                }
+            }
+        }
+    }
+
+    begin_table_rows(min_value, max_value, title, (int)max_width, format, &first_row, &last_row);
+
+    for (int row = first_row; row <= last_row; row++)
+    {
+        size_t i      = (size_t)(row - min_value);
+        size_t skip   = triangle ? i * max_width : 0;
+
+        if (!append_row_label(&output, cache, row) ||
+            !output_buffer_fill(&output, ' ', skip) ||
+            !output_buffer_append(&output, grid + i * row_size + skip, row_size - skip) ||
+            !output_buffer_append(&output, "\n", 1) ||
+            !output_buffer_end_row(&output, row))
+        {
+            goto cleanup;
+        }
+    }
+
+    success = true;
+
+cleanup:
+    success = output_buffer_flush(&output) && success;
+    output_buffer_free(&output);
+    free(values);
+    free(grid);
+    return success;
+}
+
+/**
+ * @brief Print a formatted table using the specified operation, untraced
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Function pointer to the operation to perform
+ * @param title Title to display for the table
+ * @param format Output format to use (decimal, hex)
+ */
+static void
+print_table_body(int min_value,
+                 int max_value,
+                 TableOperation operation,
+                 const char *title,
+                 output_format_t format)
+{
+    int row;
+    int column;
+    int max_width;
+    int first_row;
+    int last_row;
+    int *numbers = NULL;
+    table_generator_t generator;
+    output_buffer_t output;
+    cell_cache_t *cache;
+
+    /* Binary output is the bare cell values, row by row */
+    if (FORMAT_BINARY == format)
+    {
+        numbers = malloc((size_t)(max_value - min_value + 1) * sizeof(*numbers));
+
+        for (row = min_value; row <= max_value; row++)
+        {
+            const int *generated = generate_row(&generator, operation, row, min_value,
+                                                max_value, numbers);
+
+            for (column = min_value; column <= max_value; column++)
+            {
+                print_cell(row_cell(operation, generated, row, column, min_value), 0, format);
+            }
+        }
+
+        free(numbers);
+        return;
+    }
+
+    max_width = table_cell_width(max_value, title, format);
+
+    /* Without memory for the mirrored grid, fall back to printing row by row */
+    if (operation_is_symmetric(operation))
+    {
+        bool printed;
+
+        print_symmetric_table(min_value, max_value, operation, NULL, title,
+                              (size_t)max_width, format, false, &printed);
+        if (printed)
+        {
+            return;
+        }
+    }
+
+    if (max_value - min_value + 1 >= PIPELINE_MIN_ROWS &&
+        print_table_pipelined(min_value, max_value, operation, title, format))
+    {
+        return;
+    }
+
+    if (!output_buffer_init(&output, stdout, OUTPUT_BUFFER_DEFAULT_SIZE))
+    {
+        return;
+    }
+
+    numbers = malloc((size_t)(max_value - min_value + 1) * sizeof(*numbers));
+    cache   = cell_cache_acquire((size_t)max_width, format,
+                                 cell_cache_bound(min_value, max_value, operation, NULL));
+
+    begin_table_rows(min_value, max_value, title, max_width, format, &first_row, &last_row);
+
+    /* Render the table body into the output buffer */
+    for (row = first_row; row <= last_row; row++)
+    {
+        const int *generated = generate_row(&generator, operation, row, min_value,
+                                            max_value, numbers);
+
+        /* Row label */
+        if (!append_row_label(&output, cache, row))
+        {
+            break;
+        }
+
+        /* Row data */
+        for (column = min_value; column <= max_value; column++)
+        {
+            cell_value_t value = row_cell(operation, generated, row, column, min_value);
+
+            if (!append_cell_value(&output, cache, &value))
+            {
+                break;
+            }
+        }
+
+        if (column <= max_value || !output_buffer_append(&output, "\n", 1) ||
+            !output_buffer_end_row(&output, row))
+        {
+            break;
+        }
+    }
+
+    output_buffer_free(&output);
+    free(numbers);
+}
+
+/**
+ * @brief Print a formatted table using the specified operation
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Function pointer to the operation to perform
+ * @param title Title to display for the table
+ * @param format Output format to use (decimal, hex)
+ */
+void
+print_table(int min_value,
+            int max_value,
+            TableOperation operation,
+            const char *title,
+            output_format_t format)
+{
+    uint64_t span = trace_begin();
+
+    TRACE_PROBE2(print_table_begin, min_value, max_value);
+    print_table_body(min_value, max_value, operation, title, format);
+    TRACE_PROBE2(print_table_end, min_value, max_value);
+    trace_end("print_table", span, max_value - min_value + 1);
+}
+
+/**
+ * @brief State shared by the stages of a pipelined table
+ */
+typedef struct
+{
+    int min_value;                   /**< Minimum value for rows and columns */
+    int max_value;                   /**< Maximum value for rows and columns */
+    int first_row;                   /**< First row to render */
+    int last_row;                    /**< Last row to render */
+    TableOperation operation;        /**< Operation computing the cells */
+    output_format_t format;          /**< Output format (decimal, hex) */
+    size_t max_width;                /**< Width of every cell, including padding */
+    value_width_t value_width;       /**< Lane width of the values, or NONE for cell_value_t */
+    cell_cache_t *cache;             /**< Interned cells, used by the format stage only */
+    spsc_ring_t values;              /**< Compute -> format: rows of lanes or cell_value_t */
+    spsc_ring_t lines;               /**< Format -> write: rendered lines */
+    pipeline_stats_t stats;          /**< Stage waits */
+} table_pipeline_t;
+
+/**
+ * @brief Compute stage: fill a slot of lanes or cell_value_t per row
+ *
+ * @param argument table_pipeline_t of the table
+ * @return void* NULL
+ */
+static void *
+compute_stage(void *argument)
+{
+    table_pipeline_t *pipeline = argument;
+    uint64_t *wait             = &pipeline->stats.output_ns[PIPELINE_STAGE_COMPUTE];
+    size_t count               = (size_t)(pipeline->max_value - pipeline->min_value + 1);
+    uint64_t span              = trace_begin();
+    int row;
+    table_generator_t generator;
+
+    for (row = pipeline->first_row; row <= pipeline->last_row; row++)
+    {
+        cell_value_t *cells = spsc_ring_reserve(&pipeline->values, wait);
+        bool generated;
+
+        if (NULL == cells)
+        {
+            break;
+        }
+
+        if (VALUE_WIDTH_NONE != pipeline->value_width)
+        {
+            table_fill_lanes(pipeline->operation, pipeline->value_width, row,
+                             pipeline->min_value, (int)count, cells);
+            spsc_ring_commit(&pipeline->values, count * pipeline->value_width);
+            continue;
+        }
+
+        generated = gen_init(&generator, pipeline->operation, row, pipeline->min_value);
+        for (size_t i = 0; i < count; i++)
+        {
+            if (generated)
+            {
+                cells[i].is_numeric = true;
+                cells[i].num_value  = gen_next(&generator);
+            }
+            else
+            {
+                pipeline->operation(row, pipeline->min_value + (int)i, &cells[i]);
+            }
+        }
+
+        spsc_ring_commit(&pipeline->values, count * sizeof(*cells));
+    }
+
+    spsc_ring_close(&pipeline->values);
+    trace_end("pipeline_compute", span, row - pipeline->first_row);
+    return NULL;
+}
+
+/**
+ * @brief Append text right-aligned in a pipeline cell, never truncated
+ *
+ * @param pipeline Pipeline of the table
+ * @param text Text of the cell
+ * @param length Length of text
+ * @param next Where to write
+ * @return char* End of the written cell
+ */
+static inline char *
+pipeline_append_text(const table_pipeline_t *pipeline, const char *text, size_t length, char *next)
+{
+    if (length < pipeline->max_width)
+    {
+        memset(next, ' ', pipeline->max_width - length);
+        next += pipeline->max_width - length;
+    }
+    memcpy(next, text, length);
+    return next + length;
+}
+
+/**
+ * @brief Append a number as a pipeline cell, from the cache if it holds it
+ *
+ * @param pipeline Pipeline of the table
+ * @param value Cell value
+ * @param next Where to write
+ * @return char* End of the written cell
+ */
+static inline char *
+pipeline_append_value(const table_pipeline_t *pipeline, uint64_t value, char *next)
+{
+    const char *cell = cell_cache_lookup(pipeline->cache, value);
+    char text[U64_TEXT_SIZE];
+    size_t length;
+
+    if (NULL != cell)
+    {
+        memcpy(next, cell, pipeline->max_width);
+        return next + pipeline->max_width;
+    }
+
+    length = format_u64(value, pipeline->format, text + sizeof(text));
+    return pipeline_append_text(pipeline, text + sizeof(text) - length, length, next);
+}
+
+/**
+ * @brief Append a cell_value_t as a pipeline cell
+ *
+ * @param pipeline Pipeline of the table
+ * @param value Cell value
+ * @param next Where to write
+ * @return char* End of the written cell
+ */
+static char *
+pipeline_append_cell(const table_pipeline_t *pipeline, const cell_value_t *value, char *next)
+{
+    char text[U64_TEXT_SIZE];
+    size_t length;
+
+    if (value->is_numeric && value->num_value >= 0)
+    {
+        return pipeline_append_value(pipeline, (uint64_t)value->num_value, next);
+    }
+
+    length = format_cell_value(value, pipeline->format, text + sizeof(text));
+    return pipeline_append_text(pipeline, text + sizeof(text) - length, length, next);
+}
+
+/**
+ * @brief Define the formatting loop of one lane width for the format stage
+ *
+ * Undefined lanes are recomputed with the operation for their text.
+ */
+#define PIPELINE_CELLS_FROM_LANES(name, type)                               \
+    static char *                                                           \
+    name(const table_pipeline_t *pipeline, const void *lanes, size_t count, \
+         int row, char *next)                                               \
+    {                                                                       \
+        const type *values = lanes;                                         \
+                                                                            \
+        for (size_t i = 0; i < count; i++)                                  \
+        {                                                                   \
+            if (LANE_UNDEFINED(type) != values[i])                          \
+            {                                                               \
+                next = pipeline_append_value(pipeline, values[i], next);    \
+            }                                                               \
+            else                                                            \
+            {                                                               \
+                cell_value_t cell;                                          \
+                                                                            \
+                int column = pipeline->min_value + (int)i;                  \
+                                                                            \
+                pipeline->operation(row, column, &cell);                    \
+                next = pipeline_append_cell(pipeline, &cell, next);         \
+            }                                                               \
+        }                                                                   \
+        return next;                                                        \
+    }
+
+PIPELINE_CELLS_FROM_LANES(pipeline_cells_from_lanes_8, uint8_t)
+PIPELINE_CELLS_FROM_LANES(pipeline_cells_from_lanes_16, uint16_t)
+PIPELINE_CELLS_FROM_LANES(pipeline_cells_from_lanes_32, uint32_t)
+
+/**
+ * @brief Format stage: render each row of cells as one line of text
+ *
+ * @param argument table_pipeline_t of the table
+ * @return void* NULL
+ */
+static void *
+format_stage(void *argument)
+{
+    table_pipeline_t *pipeline = argument;
+    pipeline_stats_t *stats    = &pipeline->stats;
+    int row                    = pipeline->first_row;
+    uint64_t span              = trace_begin();
+    const void *values;
+    size_t size;
+
+    while (NULL != (values = spsc_ring_front(&pipeline->values, &size,
+                                             &stats->input_ns[PIPELINE_STAGE_FORMAT])))
+    {
+        char *line = spsc_ring_reserve(&pipeline->lines, &stats->output_ns[PIPELINE_STAGE_FORMAT]);
+        char *next = line;
+
+        if (NULL == line)
+        {
+            spsc_ring_abort(&pipeline->values);
+            break;
+        }
+
+        /* Same layout as append_cell(): right-aligned, never truncated */
+        next = pipeline_append_value(pipeline, (uint64_t)row, next);
+        memcpy(next, " |", 2);
+        next += 2;
+
+        switch (pipeline->value_width)
+        {
+            case VALUE_WIDTH_8:
+                next = pipeline_cells_from_lanes_8(pipeline, values, size, row, next);
+                break;
+
+            case VALUE_WIDTH_16:
+                next = pipeline_cells_from_lanes_16(pipeline, values, size / 2, row, next);
+                break;
+
+            case VALUE_WIDTH_32:
+                next = pipeline_cells_from_lanes_32(pipeline, values, size / 4, row, next);
+                break;
+
+            case VALUE_WIDTH_NONE:
+                for (size_t i = 0; i < size / sizeof(cell_value_t); i++)
+                {
+                    next = pipeline_append_cell(pipeline, (const cell_value_t *)values + i, next);
+                }
+                break;
+        }
+        *next++ = '\n';
+
+        spsc_ring_commit(&pipeline->lines, (size_t)(next - line));
+        spsc_ring_pop(&pipeline->values);
+        row++;
+    }
+
+    spsc_ring_close(&pipeline->lines);
+    trace_end("pipeline_format", span, row - pipeline->first_row);
+    return NULL;
+}
+
+/**
+ * @brief Print a formatted table with compute, format and write overlapped
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Function pointer to the operation to perform
+ * @param title Title to display for the table
+ * @param format Output format to use (decimal, hex)
+ * @return bool true if the table was printed (or a write error stopped it),
+ *         false if the pipeline could not be set up and nothing was printed
+ */
+bool
+print_table_pipelined(int min_value,
+                      int max_value,
+                      TableOperation operation,
+                      const char *title,
+                      output_format_t format)
+{
+    table_pipeline_t pipeline;
+    output_buffer_t output;
+    pthread_t compute_thread;
+    pthread_t format_thread;
+    size_t count     = (size_t)(max_value - min_value + 1);
+    size_t cell_size = (size_t)table_cell_width(max_value, title, format);
+    size_t value_size;
+    const char *line;
+    size_t length;
+    bool write_title;
+
+    pipeline.min_value = min_value;
+    pipeline.max_value = max_value;
+    pipeline.first_row = min_value;
+    pipeline.last_row  = max_value;
+    pipeline.operation = operation;
+    pipeline.format    = format;
+    pipeline.max_width = cell_size;
+    memset(&pipeline.stats, 0, sizeof(pipeline.stats));
+
+    pipeline.value_width = table_value_width(operation, min_value, max_value);
+
+    /* The stages need their rows before they start */
+    write_title = output_begin_rows(stdout, &pipeline.first_row, &pipeline.last_row);
+
+    /* Cells wider than max_width are written in full, so size for the longest */
+    if (cell_size < U64_TEXT_SIZE)
+        cell_size = U64_TEXT_SIZE;
+
+    /* Narrow lanes shrink the values ring to 1 to 4 bytes a cell, from 16 */
+    value_size = (VALUE_WIDTH_NONE != pipeline.value_width) ? (size_t)pipeline.value_width
+                                                            : sizeof(cell_value_t);
+    if (!spsc_ring_init(&pipeline.values, PIPELINE_RING_SLOTS, count * value_size))
+    {
+        return false;
+    }
+
+    if (!spsc_ring_init(&pipeline.lines, PIPELINE_RING_SLOTS, (count + 1) * cell_size + 3))
+    {
+        spsc_ring_free(&pipeline.values);
+        return false;
+    }
+
+    if (!output_buffer_init(&output, stdout, OUTPUT_BUFFER_DEFAULT_SIZE))
+    {
+        spsc_ring_free(&pipeline.lines);
+        spsc_ring_free(&pipeline.values);
+        return false;
+    }
+
+    pipeline.cache = cell_cache_acquire(pipeline.max_width, format,
+                                        cell_cache_bound(min_value, max_value, operation, NULL));
+
+    if (0 != pthread_create(&compute_thread, NULL, compute_stage, &pipeline))
+    {
+        output_buffer_free(&output);
+        spsc_ring_free(&pipeline.lines);
+        spsc_ring_free(&pipeline.values);
+        return false;
+    }
+
+    if (0 != pthread_create(&format_thread, NULL, format_stage, &pipeline))
+    {
+        spsc_ring_abort(&pipeline.values);
+        pthread_join(compute_thread, NULL);
+        output_buffer_free(&output);
+        spsc_ring_free(&pipeline.lines);
+        spsc_ring_free(&pipeline.values);
+        return false;
+    }
+
+    if (write_title)
+    {
+        printf("\n%s\n", title);
+        print_header(min_value, max_value, (int)pipeline.max_width, format);
+    }
+
+    /* Write stage: hand each rendered line to the output buffer */
+    while (NULL != (line = spsc_ring_front(&pipeline.lines, &length,
+                                           &pipeline.stats.input_ns[PIPELINE_STAGE_WRITE])))
+    {
+        if (!output_buffer_append(&output, line, length) ||
+            !output_buffer_end_row(&output, pipeline.first_row + (int)pipeline.stats.rows))
+        {
+            spsc_ring_abort(&pipeline.lines);
+            break;
+        }
+
+        spsc_ring_pop(&pipeline.lines);
+        pipeline.stats.rows++;
+    }
+
+    pthread_join(format_thread, NULL);
+    pthread_join(compute_thread, NULL);
+
+    output_buffer_free(&output);
+    spsc_ring_free(&pipeline.lines);
+    spsc_ring_free(&pipeline.values);
+    pipeline_add_stats(&pipeline.stats);
+    return true;
+}
+
+/**
+ * @brief Calculate the cell width of a table printed with print_big_power_table()
+ *
+ * @param max_value Maximum value for rows and columns
+ * @param format Output format to use (decimal, hex)
+ * @return size_t Width of every cell, including padding, or 0 for binary
+ *         output or on allocation failure
+ */
+size_t
+big_power_cell_width(int max_value, output_format_t format)
+{
+    bigint_t largest;
+    size_t max_width = 0;
+    size_t bits;
+
+    /* Exact values do not fit a fixed-size binary cell */
+    if (FORMAT_BINARY == format || !bigint_init(&largest, 1))
+    {
+        return 0;
+    }
+
+    /* The largest cell is max_value^max_value; measure its exact bit length */
+    bigint_set_u32(&largest, 1);
+    for (int exponent = 0; exponent < max_value; exponent++)
+    {
+        if (!bigint_mul_u32(&largest, (uint32_t)max_value))
+        {
+            bigint_free(&largest);
+            return 0;
+        }
+    }
+    bits = bigint_bit_length(&largest);
+    bigint_free(&largest);
+
+    max_width = (FORMAT_HEX == format) ? 2 + ((0 == bits) ? 1 : (bits + 3) / 4)
+                                       : bigint_decimal_digits(bits);
+
+    if (max_width < (size_t)calculate_numeric_width((uint64_t)max_value, format))
+        max_width = (size_t)calculate_numeric_width((uint64_t)max_value, format);
+
+    if (max_width < MIN_CELL_WIDTH)
+        max_width = MIN_CELL_WIDTH;
+
+    return max_width + CELL_PADDING;
+}
+
+/**
+ * @brief Print the power table using arbitrary-precision arithmetic
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param title Title to display for the table
+ * @param format Output format to use (decimal, hex)
+ * @return bool true on success, false on allocation or write failure
+ */
+bool
+print_big_power_table(int min_value,
+                      int max_value,
+                      const char *title,
+                      output_format_t format)
+{
+    bigint_t accumulator;
+    bigint_t scratch;
+    output_buffer_t output;
+    char *text       = NULL;
+    size_t max_width = big_power_cell_width(max_value, format);
+    int first_row;
+    int last_row;
+    bool success     = false;
+
+    if (0 == max_width || !bigint_init(&accumulator, 1))
+    {
+        return false;
+    }
+    if (!bigint_init(&scratch, 1))
+    {
+        bigint_free(&accumulator);
+        return false;
+    }
+
+    text = malloc(max_width);
+    if (NULL == text || !output_buffer_init(&output, stdout, OUTPUT_BUFFER_DEFAULT_SIZE))
+    {
+        goto cleanup;
+    }
+
+    begin_table_rows(min_value, max_value, title, (int)max_width, format, &first_row, &last_row);
+
+    /* Each row is built incrementally: row^c = row^(c-1) * row */
+    for (int row = first_row; row <= last_row; row++)
+    {
+        int label_length = 0;
+
+        switch (format)
+        {
+            case FORMAT_DECIMAL:
+                label_length = snprintf(text, max_width, "%d", row);
+            break;
+
+            case FORMAT_HEX:
+            case FORMAT_BINARY:
+                label_length = snprintf(text, max_width, "0x%x", row);
+            break;
+        }
+
+        if (!append_cell(&output, text, (size_t)label_length, max_width) ||
+            !output_buffer_append(&output, " |", 2))
+        {
+            goto flush;
+        }
+
+        bigint_set_u32(&accumulator, 1);
+        for (int exponent = 0; exponent < min_value; exponent++)
+        {
+            if (!bigint_mul_u32(&accumulator, (uint32_t)row))
+            {
+                goto flush;
+            }
+        }
+
+        for (int column = min_value; column <= max_value; column++)
+        {
+            size_t length = 0;
+
+            switch (format)
+            {
+                case FORMAT_DECIMAL:
+                    length = bigint_to_decimal(&accumulator, &scratch, text, max_width);
+                break;
+
+                case FORMAT_HEX:
+                case FORMAT_BINARY:
+                    length = bigint_to_hex(&accumulator, text, max_width);
+                break;
+            }
+
+            if (0 == length || !append_cell(&output, text, length, max_width))
+            {
+                goto flush;
+            }
+
+            if (column < max_value && !bigint_mul_u32(&accumulator, (uint32_t)row))
+            {
+                goto flush;
+            }
+        }
+
+        if (!output_buffer_append(&output, "\n", 1) || !output_buffer_end_row(&output, row))
+        {
+            goto flush;
+        }
+    }
+
+    success = true;
+
+flush:
+    success = output_buffer_flush(&output) && success;
+    output_buffer_free(&output);
+
+cleanup:
+    free(text);
+    bigint_free(&scratch);
+    bigint_free(&accumulator);
+    return success;
+}
+
+/**
+ * @brief Calculate the cell width of a table printed with print_fraction_table()
+ *
+ * @param max_value Maximum value for rows and columns
+ * @param precision Fraction digits (1 to DECIMAL_MAX_DIGITS) or DECIMAL_SHORTEST
+ * @return size_t Width of every cell, including padding
+ */
+size_t
+fraction_cell_width(int max_value, int precision)
+{
+    size_t digits    = (size_t)calculate_numeric_width((uint64_t)max_value, FORMAT_DECIMAL);
+    size_t max_width = (DECIMAL_SHORTEST == precision) ? digits + 1 + DECIMAL_SHORTEST_DIGITS
+                                                       : digits + 1 + (size_t)precision;
+
+    if (max_width < MIN_CELL_WIDTH)
+        max_width = MIN_CELL_WIDTH;
+
+    return max_width + CELL_PADDING;
+}
+
+/**
+ * @brief Print the division table with fractional quotients
+ *
+ * A fixed-point cell has the digits of the largest row, the point and the
+ * fraction digits. A shortest cell is at most "0.", the leading zeros of
+ * 1 ÷ max_value and DECIMAL_SHORTEST_DIGITS significant digits.
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param title Title to display for the table
+ * @param precision Fraction digits (1 to DECIMAL_MAX_DIGITS) or DECIMAL_SHORTEST
+ * @return bool true on success, false on allocation or write failure
+ */
+bool
+print_fraction_table(int min_value,
+                     int max_value,
+                     const char *title,
+                     int precision)
+{
+    output_buffer_t output;
+    char text[DECIMAL_TEXT_SIZE];
+    char *end        = text + sizeof(text);
+    size_t max_width = fraction_cell_width(max_value, precision);
+    cell_value_t undefined;
+    int first_row;
+    int last_row;
+    bool success     = false;
+
+    if (!output_buffer_init(&output, stdout, OUTPUT_BUFFER_DEFAULT_SIZE))
+    {
+        return false;
+    }
+
+    /* The undefined marker is the one divide() uses */
+    divide(0, 0, &undefined);
+
+    begin_table_rows(min_value, max_value, title, (int)max_width, FORMAT_DECIMAL,
+                     &first_row, &last_row);
+
+    for (int row = first_row; row <= last_row; row++)
+    {
+        size_t length = format_u64((uint64_t)row, FORMAT_DECIMAL, end);
+
+        if (!append_cell(&output, end - length, length, max_width) ||
+            !output_buffer_append(&output, " |", 2))
+        {
+            goto cleanup;
+        }
+
+        for (int column = min_value; column <= max_value; column++)
+        {
+            if (0 == column)
+            {
+                length = strlen(undefined.str_value);
+                if (!append_cell(&output, undefined.str_value, length, max_width))
+                {
+                    goto cleanup;
+                }
+                continue;
+            }
+
+            length = (DECIMAL_SHORTEST == precision)
+                   ? decimal_shortest((double)row / (double)column, end)
+                   : decimal_fixed((uint32_t)row, (uint32_t)column, precision, end);
+
+            if (!append_cell(&output, end - length, length, max_width))
+            {
+                goto cleanup;
+            }
+        }
+
+        if (!output_buffer_append(&output, "\n", 1) || !output_buffer_end_row(&output, row))
+        {
+            goto cleanup;
+        }
+    }
+
+    success = true;
+
+cleanup:
+    success = output_buffer_flush(&output) && success;
+    output_buffer_free(&output);
+    return success;
+}
+
+/**
+ * @brief Print a formatted table using a row-at-a-time operation, untraced
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Row operation computing the cell values
+ * @param title Title to display for the table
+ * @param format Output format to use (decimal, hex, binary)
+ * @return bool true on success, false on allocation or write failure
+ */
+static bool
+print_row_table_body(int min_value,
+                     int max_value,
+                     const row_operation_t *operation,
+                     const char *title,
+                     output_format_t format)
+{
+    output_buffer_t output;
+    cell_cache_t *cache = NULL;
+    int count        = max_value - min_value + 1;
+    uint64_t *values = malloc((size_t)count * sizeof(*values));
+    size_t max_width = 0;
+    int first_row    = min_value;
+    int last_row     = max_value;
+    bool success     = false;
+
+    if (NULL == values || !output_buffer_init(&output, stdout, OUTPUT_BUFFER_DEFAULT_SIZE))
+    {
+        free(values);
+        return false;
+    }
+
+    if (FORMAT_BINARY != format)
+    {
+        max_width = row_cell_width(min_value, max_value, operation, format);
+
+        /* Without memory for the mirrored grid, fall back to printing row by row */
+        if (operation->is_symmetric)
+        {
+            bool printed;
+
+            success = print_symmetric_table(min_value, max_value, NULL, operation, title,
+                                            max_width, format, false, &printed);
+            if (printed)
+            {
+                free(values);
+                output_buffer_free(&output);
+                return success;
+            }
+        }
+
+        cache = cell_cache_acquire(max_width, format,
+                                   cell_cache_bound(min_value, max_value, NULL, operation));
+        begin_table_rows(min_value, max_value, title, (int)max_width, format,
+                         &first_row, &last_row);
+    }
+
+    for (int row = first_row; row <= last_row; row++)
+    {
+        operation->kernel(operation->context, row, min_value, count, values);
+
+        if (FORMAT_BINARY == format)
+        {
+            if (!output_buffer_append(&output, (const char *)values,
+                                      (size_t)count * sizeof(*values)))
+            {
+                goto cleanup;
+            }
+            continue;
+        }
+
+        if (!append_row_label(&output, cache, row))
+        {
+            goto cleanup;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            if (!append_row_value(&output, cache, values[i], operation))
+            {
+                goto cleanup;
+            }
+        }
+
+        if (!output_buffer_append(&output, "\n", 1) || !output_buffer_end_row(&output, row))
+        {
+            goto cleanup;
+        }
+    }
+
+    success = true;
+
+cleanup:
+    success = output_buffer_flush(&output) && success;
+    output_buffer_free(&output);
+    free(values);
+    return success;
+}
+
+/**
+ * @brief Print a formatted table using a row-at-a-time operation
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Row operation computing the cell values
+ * @param title Title to display for the table
+ * @param format Output format to use (decimal, hex, binary)
+ * @return bool true on success, false on allocation or write failure
+ */
+bool
+print_row_table(int min_value,
+                int max_value,
+                const row_operation_t *operation,
+                const char *title,
+                output_format_t format)
+{
+    uint64_t span = trace_begin();
+    bool success;
+
+    TRACE_PROBE2(print_table_begin, min_value, max_value);
+    success = print_row_table_body(min_value, max_value, operation, title, format);
+    TRACE_PROBE2(print_table_end, min_value, max_value);
+    trace_end("print_row_table", span, max_value - min_value + 1);
+    return success;
+}
+
+/**
+ * @brief Text width of a cell value, as format_cell_value() renders it
+ *
+ * @param cell_value Cell value
+ * @param format Output format (decimal, hex)
+ * @return size_t Number of characters of the text
+ */
+static size_t
+cell_text_width(const cell_value_t *cell_value, output_format_t format)
+{
+    if (!cell_value->is_numeric)
+        return strlen(cell_value->str_value);
+    if (FORMAT_HEX == format)
+        return (size_t)calculate_numeric_width((uint32_t)cell_value->num_value, format);
+    if (cell_value->num_value < 0)
+        return 1 + (size_t)calculate_numeric_width(0 - (uint64_t)(int64_t)cell_value->num_value,
+                                                   format);
+
+    return (size_t)calculate_numeric_width((uint64_t)cell_value->num_value, format);
+}
+
+/**
+ * @brief Text width of a row operation value, as format_row_value() renders it
+ *
+ * @param value Cell value
+ * @param operation Row operation that produced the value
+ * @param format Output format (decimal, hex)
+ * @return size_t Number of characters of the text
+ */
+static size_t
+row_value_text_width(uint64_t value, const row_operation_t *operation, output_format_t format)
+{
+    const char *marker = row_value_marker(operation, value);
+
+    if (NULL != marker)
+        return strlen(marker);
+    if (operation->is_signed && (value >> 63))
+        return 1 + (size_t)calculate_numeric_width(0 - value, format);
+
+    return (size_t)calculate_numeric_width(value, format);
+}
+
+/**
+ * @brief Find the text width of every column of a compact table
+ *
+ * Products and quotients grow with the row, so the last row holds the
+ * widest cell of each column and is the only one computed. Other tables
+ * are computed once in full, without formatting any cell.
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param format Output format (decimal, hex)
+ * @param widths Set to the widest text of each column, header included
+ * @return bool true on success, false if allocation failed
+ */
+static bool
+compact_column_widths(int min_value,
+                      int max_value,
+                      TableOperation operation,
+                      const row_operation_t *row_operation,
+                      output_format_t format,
+                      size_t *widths)
+{
+    int count        = max_value - min_value + 1;
+    int first_row    = min_value;
+    int *numbers     = NULL;
+    uint64_t *values = NULL;
+    table_generator_t generator;
+
+    for (int i = 0; i < count; i++)
+    {
+        widths[i] = (size_t)calculate_numeric_width((uint64_t)(min_value + i), format);
+    }
+
+    if (multiply == operation || divide == operation)
+    {
+        first_row = max_value;
+    }
+
+    if (NULL != operation)
+    {
+        numbers = malloc((size_t)count * sizeof(*numbers));
+
+        for (int row = first_row; row <= max_value; row++)
+        {
+            const int *generated = generate_row(&generator, operation, row, min_value,
+                                                max_value, numbers);
+
+            for (int i = 0; i < count; i++)
+            {
+                cell_value_t value = row_cell(operation, generated, row, min_value + i, min_value);
+                size_t width       = cell_text_width(&value, format);
+
+                if (width > widths[i])
+                    widths[i] = width;
+            }
+        }
+
+        free(numbers);
+        return true;
+    }
+
+    values = malloc((size_t)count * sizeof(*values));
+    if (NULL == values)
+    {
+        return false;
+    }
+
+    for (int row = min_value; row <= max_value; row++)
+    {
+        row_operation->kernel(row_operation->context, row, min_value, count, values);
+
+        for (int i = 0; i < count; i++)
+        {
+            size_t width = row_value_text_width(values[i], row_operation, format);
+
+            if (width > widths[i])
+                widths[i] = width;
+        }
+    }
+
+    free(values);
+    return true;
+}
+
+/**
+ * @brief Print the column header row and separator line of a compact table
+ *
+ * @param min_value Minimum column value
+ * @param max_value Maximum column value
+ * @param label_width Width of the row label column
+ * @param widths Width of each column, including padding
+ * @param format Output format to use
+ */
+static void
+print_compact_header(int min_value, int max_value, size_t label_width, const size_t *widths,
+                     output_format_t format)
+{
+    size_t total = 0;
+
+    printf("%*s |", (int)label_width, "");
+    for (int column = min_value; column <= max_value; column++)
+    {
+        cell_value_t header;
+        header.is_numeric = true;
+        header.num_value  = column;
+        print_cell(header, (int)widths[column - min_value], format);
+        total += widths[column - min_value];
+    }
+    printf("\n");
+
+    for (size_t i = 0; i < label_width; i++)
+    {
+        putchar('-');
+    }
+    printf("-+");
+
+    for (size_t i = 0; i < total; i++)
+    {
+        putchar('-');
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Print a table with each column only as wide as its widest cell, untraced
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param title Title to display for the table
+ * @param format Output format to use (decimal, hex)
+ * @return bool true on success, false on allocation or write failure
+ */
+static bool
+print_compact_table_body(int min_value,
+                         int max_value,
+                         TableOperation operation,
+                         const row_operation_t *row_operation,
+                         const char *title,
+                         output_format_t format)
+{
+    output_buffer_t output;
+    table_generator_t generator;
+    int count          = max_value - min_value + 1;
+    size_t *widths     = malloc((size_t)count * sizeof(*widths));
+    int *numbers       = NULL;
+    uint64_t *values   = NULL;
+    size_t label_width = (size_t)calculate_numeric_width((uint64_t)max_value, format);
+    char text[U64_TEXT_SIZE];
+    char *end          = text + sizeof(text);
+    int first_row      = min_value;
+    int last_row       = max_value;
+    bool success       = false;
+
+    if (NULL == widths ||
+        !compact_column_widths(min_value, max_value, operation, row_operation, format, widths))
+    {
+        free(widths);
+        return false;
+    }
+
+    if (NULL != operation)
+    {
+        numbers = malloc((size_t)count * sizeof(*numbers));
+    }
+    else if (NULL == (values = malloc((size_t)count * sizeof(*values))))
+    {
+        free(widths);
+        return false;
+    }
+
+    if (!output_buffer_init(&output, stdout, OUTPUT_BUFFER_DEFAULT_SIZE))
+    {
+        free(widths);
+        free(numbers);
+        free(values);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        widths[i] += CELL_PADDING;
+    }
+
+    if (output_begin_rows(stdout, &first_row, &last_row))
+    {
+        printf("\n%s\n", title);
+        print_compact_header(min_value, max_value, label_width, widths, format);
+    }
+
+    for (int row = first_row; row <= last_row; row++)
+    {
+        const int *generated = NULL;
+        size_t length        = format_u64((uint64_t)row, format, end);
+
+        if (!append_cell(&output, end - length, length, label_width) ||
+            !output_buffer_append(&output, " |", 2))
+        {
+            goto cleanup;
+        }
+
+        if (NULL != operation)
+        {
+            generated = generate_row(&generator, operation, row, min_value, max_value, numbers);
+        }
+        else
+        {
+            row_operation->kernel(row_operation->context, row, min_value, count, values);
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            if (NULL != operation)
+            {
+                cell_value_t value = row_cell(operation, generated, row, min_value + i, min_value);
+
+                length = format_cell_value(&value, format, end);
+            }
+            else
+            {
+                length = format_row_value(values[i], row_operation, format, end);
+            }
+
+            if (!append_cell(&output, end - length, length, widths[i]))
+            {
+                goto cleanup;
+            }
+        }
+
+        if (!output_buffer_append(&output, "\n", 1) || !output_buffer_end_row(&output, row))
+        {
+            goto cleanup;
+        }
+    }
+
+    success = true;
+
+cleanup:
+    success = output_buffer_flush(&output) && success;
+    output_buffer_free(&output);
+    free(widths);
+    free(numbers);
+    free(values);
+    return success;
+}
+
+/**
+ * @brief Print a table with each column only as wide as its widest cell
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param title Title to display for the table
+ * @param format Output format to use (decimal, hex)
+ * @return bool true on success, false on allocation or write failure
+ */
+bool
+print_compact_table(int min_value,
+                    int max_value,
+                    TableOperation operation,
+                    const row_operation_t *row_operation,
+                    const char *title,
+                    output_format_t format)
+{
+    uint64_t span = trace_begin();
+    bool success;
+
+    TRACE_PROBE2(print_table_begin, min_value, max_value);
+    success = print_compact_table_body(min_value, max_value, operation, row_operation, title,
+                                       format);
+    TRACE_PROBE2(print_table_end, min_value, max_value);
+    trace_end("print_compact_table", span, max_value - min_value + 1);
+    return success;
+}
+
+/**
+ * @brief Text appended to a caller buffer without overrunning it
+ *
+ * Once a piece does not fit, nothing more is written but the length keeps
+ * counting, as with snprintf().
+ */
+typedef struct
+{
+    char *buffer;                    /**< Destination */
+    size_t size;                     /**< Size of the destination */
+    size_t length;                   /**< Length of the whole text so far */
+} bounded_text_t;
+
+/**
+ * @brief Append text right-aligned in a cell of a bounded text
+ *
+ * @param text Bounded text to append to
+ * @param data Text to append
+ * @param length Length of the text to append
+ * @param width Width of the cell (0 for no padding)
+ */
+static void
+bounded_append(bounded_text_t *text, const char *data, size_t length, size_t width)
+{
+    size_t padding = (length < width) ? width - length : 0;
+
+    if (text->length < text->size && text->size - text->length > padding + length)
+    {
+        memset(text->buffer + text->length, ' ', padding);
+        memcpy(text->buffer + text->length + padding, data, length);
+    }
+    else
+    {
+        text->size = 0;
+    }
+
+    text->length += padding + length;
+}
+
+/**
+ * @brief Append copies of a character to a bounded text
+ *
+ * @param text Bounded text to append to
+ * @param character Character to append
+ * @param count Number of copies
+ */
+static void
+bounded_fill(bounded_text_t *text, char character, size_t count)
+{
+    if (text->length < text->size && text->size - text->length > count)
+    {
+        memset(text->buffer + text->length, character, count);
+    }
+    else
+    {
+        text->size = 0;
+    }
+
+    text->length += count;
+}
+
+/**
+ * @brief Terminate a bounded text if the whole of it fit
+ *
+ * @param text Bounded text to finish
+ * @return size_t Length of the whole text
+ */
+static size_t
+bounded_finish(bounded_text_t *text)
+{
+    if (text->length < text->size)
+    {
+        text->buffer[text->length] = '\0';
+    }
+
+    return text->length;
+}
+
+/**
+ * @brief Find the layout of a table
+ *
+ * @param layout Layout to initialize
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL (kept by reference)
+ * @param title Title of the table, used to recognise the power table
+ * @param format Output format to use (decimal, hex)
+ */
+void
+table_layout_init(table_layout_t *layout,
+                  int min_value,
+                  int max_value,
+                  TableOperation operation,
+                  const row_operation_t *row_operation,
+                  const char *title,
+                  output_format_t format)
+{
+    layout->min_value     = min_value;
+    layout->max_value     = max_value;
+    layout->operation     = operation;
+    layout->row_operation = row_operation;
+    layout->format        = format;
+    layout->cell_width    = (NULL != operation)
+                          ? (size_t)table_cell_width(max_value, title, format)
+                          : row_cell_width(min_value, max_value, row_operation, format);
+}
+
+/**
+ * @brief Render the column header row and the separator line beneath it
+ *
+ * @param layout Layout of the table
+ * @param buffer Destination, or NULL if size is 0
+ * @param size Size of the destination
+ * @return size_t Length of the text, without the terminator
+ */
+size_t
+table_layout_header(const table_layout_t *layout, char *buffer, size_t size)
+{
+    bounded_text_t text = {buffer, size, 0};
+    size_t count        = (size_t)(layout->max_value - layout->min_value + 1);
+    char label[U64_TEXT_SIZE];
+
+    bounded_fill(&text, ' ', layout->cell_width);
+    bounded_append(&text, " |", 2, 0);
+    for (int column = layout->min_value; column <= layout->max_value; column++)
+    {
+        size_t length = format_u64((uint64_t)column, layout->format, label + sizeof(label));
+
+        bounded_append(&text, label + sizeof(label) - length, length, layout->cell_width);
+    }
+    bounded_append(&text, "\n", 1, 0);
+
+    bounded_fill(&text, '-', layout->cell_width);
+    bounded_append(&text, "-+", 2, 0);
+    bounded_fill(&text, '-', count * layout->cell_width);
+    bounded_append(&text, "\n", 1, 0);
+
+    return bounded_finish(&text);
+}
+
+/**
+ * @brief Render one row of a table, including its newline
+ *
+ * @param layout Layout of the table
+ * @param row Row value
+ * @param cells Cells of the row if the layout has a per-cell operation
+ * @param values Values of the row if it has a row operation
+ * @param buffer Destination, or NULL if size is 0
+ * @param size Size of the destination
+ * @return size_t Length of the text, without the terminator
+ */
+size_t
+table_layout_row(const table_layout_t *layout, int row, const cell_value_t *cells,
+                 const uint64_t *values, char *buffer, size_t size)
+{
+    bounded_text_t text = {buffer, size, 0};
+    int count           = layout->max_value - layout->min_value + 1;
+    char cell[U64_TEXT_SIZE];
+    size_t length;
+
+    length = format_u64((uint64_t)row, layout->format, cell + sizeof(cell));
+    bounded_append(&text, cell + sizeof(cell) - length, length, layout->cell_width);
+    bounded_append(&text, " |", 2, 0);
+
+    for (int i = 0; i < count; i++)
+    {
+        length = (NULL != layout->operation)
+               ? format_cell_value(&cells[i], layout->format, cell + sizeof(cell))
+               : format_row_value(values[i], layout->row_operation, layout->format,
+                                  cell + sizeof(cell));
+        bounded_append(&text, cell + sizeof(cell) - length, length, layout->cell_width);
+    }
+    bounded_append(&text, "\n", 1, 0);
+
+    return bounded_finish(&text);
+}
+
+/**
+ * @brief Print the upper triangle of a symmetric table, untraced
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param title Title to display for the table
+ * @param format Output format to use (decimal, hex)
+ * @return bool true on success, false if the operation is not symmetric,
+ *         the format is binary, or on allocation or write failure
+ */
+static bool
+print_triangle_table_body(int min_value,
+                          int max_value,
+                          TableOperation operation,
+                          const row_operation_t *row_operation,
+                          const char *title,
+                          output_format_t format)
+{
+    size_t max_width;
+    bool printed;
+
+    if (FORMAT_BINARY == format)
+    {
+        return false;
+    }
+
+    if (NULL != operation)
+    {
+        if (!operation_is_symmetric(operation))
+            return false;
+        max_width = (size_t)table_cell_width(max_value, title, format);
+    }
+    else
+    {
+        if (!row_operation->is_symmetric)
+            return false;
+        max_width = row_cell_width(min_value, max_value, row_operation, format);
+    }
+
+    return print_symmetric_table(min_value, max_value, operation, row_operation, title,
+                                 max_width, format, true, &printed);
+}
+
+/**
+ * @brief Print the upper triangle of a symmetric table
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param title Title to display for the table
+ * @param format Output format to use (decimal, hex)
+ * @return bool true on success, false if the operation is not symmetric,
+ *         the format is binary, or on allocation or write failure
+ */
+bool
+print_triangle_table(int min_value,
+                     int max_value,
+                     TableOperation operation,
+                     const row_operation_t *row_operation,
+                     const char *title,
+                     output_format_t format)
+{
+    uint64_t span = trace_begin();
+    bool success;
+
+    TRACE_PROBE2(print_table_begin, min_value, max_value);
+    success = print_triangle_table_body(min_value, max_value, operation, row_operation, title,
+                                        format);
+    TRACE_PROBE2(print_table_end, min_value, max_value);
+    trace_end("print_triangle_table", span, max_value - min_value + 1);
+    return success;
+}
+
+/**
+ * @brief Append a field, quoting it if it contains a special character
+ *
+ * @param output Buffer to append to
+ * @param field Field to append
+ * @param separator Field separator (',' for CSV, '\t' for TSV)
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_delimited_field(output_buffer_t *output, const text_span_t *field, char separator)
+{
+    size_t start = 0;
+
+    if (NULL == memchr(field->text, separator, field->length) &&
+        NULL == memchr(field->text, '"', field->length) &&
+        NULL == memchr(field->text, '\n', field->length))
+    {
+        return output_buffer_append(output, field->text, field->length);
+    }
+
+    /* Quote the field and double embedded quotes (RFC 4180) */
+    if (!output_buffer_append(output, "\"", 1))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < field->length; i++)
+    {
+        if ('"' == field->text[i])
+        {
+            if (!output_buffer_append(output, field->text + start, i + 1 - start))
+            {
+                return false;
+            }
+            start = i;
+        }
+    }
+
+    return output_buffer_append(output, field->text + start, field->length - start) &&
+           output_buffer_append(output, "\"", 1);
+}
+
+/**
+ * @brief Append a delimited record of a label followed by fields
+ *
+ * @param output Buffer to append to
+ * @param label First field of the record
+ * @param fields Remaining fields
+ * @param count Number of remaining fields
+ * @param separator Field separator
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_delimited_record(output_buffer_t *output, const text_span_t *label,
+                        const text_span_t *fields, int count, char separator)
+{
+    if (!append_delimited_field(output, label, separator))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (!output_buffer_append(output, &separator, 1) ||
+            !append_delimited_field(output, &fields[i], separator))
+        {
+            return false;
+        }
+    }
+
+    return output_buffer_append(output, "\n", 1);
+}
+
+/**
+ * @brief Header field naming the row label column
+ */
+static const text_span_t ROW_KEY = {"row", 3, false};
+
+/**
+ * @brief CSV: header record of "row" and the column labels
+ */
+static bool
+csv_begin(output_buffer_t *output, const char *title, const text_span_t *columns, int count)
+{
+    (void)title;
+    return append_delimited_record(output, &ROW_KEY, columns, count, ',');
+}
+
+/**
+ * @brief CSV: one record per row, label first
+ */
+static bool
+csv_row(output_buffer_t *output, const text_span_t *label,
+        const text_span_t *columns, const text_span_t *cells, int count)
+{
+    (void)columns;
+    return append_delimited_record(output, label, cells, count, ',');
+}
+
+/**
+ * @brief TSV: header record of "row" and the column labels
+ */
+static bool
+tsv_begin(output_buffer_t *output, const char *title, const text_span_t *columns, int count)
+{
+    (void)title;
+    return append_delimited_record(output, &ROW_KEY, columns, count, '\t');
+}
+
+/**
+ * @brief TSV: one record per row, label first
+ */
+static bool
+tsv_row(output_buffer_t *output, const text_span_t *label,
+        const text_span_t *columns, const text_span_t *cells, int count)
+{
+    (void)columns;
+    return append_delimited_record(output, label, cells, count, '\t');
+}
+
+/**
+ * @brief Append a field as a JSON value, quoting and escaping non-numbers
+ *
+ * @param output Buffer to append to
+ * @param field Field to append
+ * @param as_key Always quote the field, for use as an object key
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_json_value(output_buffer_t *output, const text_span_t *field, bool as_key)
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    size_t start = 0;
+
+    if (field->is_number && !as_key)
+    {
+        return output_buffer_append(output, field->text, field->length);
+    }
+
+    if (!output_buffer_append(output, "\"", 1))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < field->length; i++)
+    {
+        unsigned char c = (unsigned char)field->text[i];
+        char escape[6]  = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0xfu]};
+
+        if (c >= 0x20 && '"' != c && '\\' != c)
+        {
+            continue;
+        }
+
+        if (!output_buffer_append(output, field->text + start, i - start))
+        {
+            return false;
+        }
+
+        if ('"' == c || '\\' == c)
+        {
+            escape[1] = (char)c;
+            if (!output_buffer_append(output, escape, 2))
+                return false;
+        }
+        else if (!output_buffer_append(output, escape, sizeof(escape)))
+        {
+            return false;
+        }
+        start = i + 1;
+    }
+
+    return output_buffer_append(output, field->text + start, field->length - start) &&
+           output_buffer_append(output, "\"", 1);
+}
+
+/**
+ * @brief JSON Lines: nothing precedes the row objects
+ */
+static bool
+jsonl_begin(output_buffer_t *output, const char *title, const text_span_t *columns, int count)
+{
+    (void)output;
+    (void)title;
+    (void)columns;
+    (void)count;
+    return true;
+}
+
+/**
+ * @brief JSON Lines: one object per row, keyed by "row" and column labels
+ */
+static bool
+jsonl_row(output_buffer_t *output, const text_span_t *label,
+          const text_span_t *columns, const text_span_t *cells, int count)
+{
+    if (!output_buffer_append(output, "{\"row\":", 7) ||
+        !append_json_value(output, label, false))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (!output_buffer_append(output, ",", 1) ||
+            !append_json_value(output, &columns[i], true) ||
+            !output_buffer_append(output, ":", 1) ||
+            !append_json_value(output, &cells[i], false))
+        {
+            return false;
+        }
+    }
+
+    return output_buffer_append(output, "}\n", 2);
+}
+
+/**
+ * @brief Append a Markdown table row of a label followed by fields
+ *
+ * @param output Buffer to append to
+ * @param label First cell of the row
+ * @param fields Remaining cells
+ * @param count Number of remaining cells
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_markdown_row(output_buffer_t *output, const text_span_t *label,
+                    const text_span_t *fields, int count)
+{
+    for (int i = -1; i < count; i++)
+    {
+        const text_span_t *field = (i < 0) ? label : &fields[i];
+        size_t start = 0;
+
+        if (!output_buffer_append(output, "| ", 2))
+        {
+            return false;
+        }
+
+        /* Escape pipes so they do not split the cell */
+        for (size_t j = 0; j < field->length; j++)
+        {
+            if ('|' == field->text[j])
+            {
+                if (!output_buffer_append(output, field->text + start, j - start) ||
+                    !output_buffer_append(output, "\\", 1))
+                {
+                    return false;
+                }
+                start = j;
+            }
+        }
+
+        if (!output_buffer_append(output, field->text + start, field->length - start) ||
+            !output_buffer_append(output, " ", 1))
+        {
+            return false;
+        }
+    }
+
+    return output_buffer_append(output, "|\n", 2);
+}
+
+/**
+ * @brief Markdown: title heading, header row and right-aligned separator
+ */
+static bool
+md_begin(output_buffer_t *output, const char *title, const text_span_t *columns, int count)
+{
+    if (!output_buffer_append(output, "\n### ", 5) ||
+        !output_buffer_append(output, title, strlen(title)) ||
+        !output_buffer_append(output, "\n\n", 2) ||
+        !append_markdown_row(output, &ROW_KEY, columns, count))
+    {
+        return false;
+    }
+
+    /* Right-align every column, like the text layout */
+    for (int i = -1; i < count; i++)
+    {
+        if (!output_buffer_append(output, "|---:", 5))
+        {
+            return false;
+        }
+    }
+
+    return output_buffer_append(output, "|\n", 2);
+}
+
+/**
+ * @brief Markdown: one table row per row
+ */
+static bool
+md_row(output_buffer_t *output, const text_span_t *label,
+       const text_span_t *columns, const text_span_t *cells, int count)
+{
+    (void)columns;
+    return append_markdown_row(output, label, cells, count);
+}
+
+static const record_writer_t RECORD_WRITERS[] = {
+    {"csv",   csv_begin,   csv_row},
+    {"tsv",   tsv_begin,   tsv_row},
+    {"jsonl", jsonl_begin, jsonl_row},
+    {"md",    md_begin,    md_row}
+};
+
+static const size_t RECORD_WRITERS_COUNT = sizeof(RECORD_WRITERS) / sizeof(RECORD_WRITERS[0]);
+
+/**
+ * @brief Look up a record writer by name
+ *
+ * @param name Writer name (csv, tsv, jsonl or md)
+ * @return const record_writer_t* The writer, or NULL if unknown
+ */
+const record_writer_t *
+record_writer_find(const char *name)
+{
+    for (size_t i = 0; i < RECORD_WRITERS_COUNT; i++)
+    {
+        if (0 == strcmp(name, RECORD_WRITERS[i].name))
+        {
+            return &RECORD_WRITERS[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Write a table as unpadded records, untraced
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param title Title of the table
+ * @param format Number format to use (decimal, hex)
+ * @param writer Record writer producing the output
+ * @return bool true on success, false if the format is binary, or on
+ *         allocation or write failure
+ */
+static bool
+print_records_body(int min_value,
+                   int max_value,
+                   TableOperation operation,
+                   const row_operation_t *row_operation,
+                   const char *title,
+                   output_format_t format,
+                   const record_writer_t *writer)
+{
+    output_buffer_t output;
+    table_generator_t generator;
+    int count           = max_value - min_value + 1;
+    char *arena         = malloc((size_t)(2 * count + 1) * U64_TEXT_SIZE);
+    text_span_t *spans  = malloc((size_t)(2 * count + 1) * sizeof(*spans));
+    uint64_t *values    = malloc((size_t)count * sizeof(*values));
+    int *numbers        = malloc((size_t)count * sizeof(*numbers));
+    bool decimal        = (FORMAT_DECIMAL == format);
+    bool success        = false;
+
+    if (FORMAT_BINARY == format || NULL == arena || NULL == spans || NULL == values ||
+        NULL == numbers || !output_buffer_init(&output, stdout, OUTPUT_BUFFER_DEFAULT_SIZE))
+    {
+        free(numbers);
+        free(values);
+        free(spans);
+        free(arena);
+        return false;
+    }
+
+    /* Column labels, then the cells of the current row, then its label;
+       each field is rendered backwards into its own U64_TEXT_SIZE slot */
+    text_span_t *columns = spans;
+    text_span_t *cells   = spans + count;
+    text_span_t *label   = spans + 2 * count;
+
+    for (int i = 0; i <= 2 * count; i++)
+    {
+        spans[i].text      = arena + (size_t)(i + 1) * U64_TEXT_SIZE;
+        spans[i].is_number = decimal;
+    }
+
+    for (int j = 0; j < count; j++)
+    {
+        columns[j].length = format_u64((uint64_t)(min_value + j), format, (char *)columns[j].text);
+        columns[j].text  -= columns[j].length;
+    }
+
+    if (!writer->begin(&output, title, columns, count))
+    {
+        goto cleanup;
+    }
+
+    for (int row = min_value; row <= max_value; row++)
+    {
+        const int *generated = NULL;
+        char *end            = arena + (size_t)(2 * count + 1) * U64_TEXT_SIZE;
+
+        label->length = format_u64((uint64_t)row, format, end);
+        label->text   = end - label->length;
+
+        if (NULL != operation)
+        {
+            generated = generate_row(&generator, operation, row, min_value, max_value, numbers);
+        }
+        else
+        {
+            row_operation->kernel(row_operation->context, row, min_value, count, values);
+        }
+
+        for (int j = 0; j < count; j++)
+        {
+            end = arena + (size_t)(count + j + 1) * U64_TEXT_SIZE;
+
+            if (NULL != operation)
+            {
+                cell_value_t value = row_cell(operation, generated, row, min_value + j, min_value);
+
+                cells[j].length    = format_cell_value(&value, format, end);
+                cells[j].is_number = decimal && value.is_numeric;
+            }
+            else
+            {
+                cells[j].length    = format_row_value(values[j], row_operation, format, end);
+                cells[j].is_number = decimal && NULL == row_value_marker(row_operation, values[j]);
+            }
+            cells[j].text = end - cells[j].length;
+        }
+
+        if (!writer->row(&output, label, columns, cells, count))
+        {
+            goto cleanup;
+        }
+    }
+
+    success = true;
+
+cleanup:
+    success = output_buffer_flush(&output) && success;
+    output_buffer_free(&output);
+    free(numbers);
+    free(values);
+    free(spans);
+    free(arena);
+    return success;
+}
+
+/**
+ * @brief Write a table as unpadded records
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param title Title of the table
+ * @param format Number format to use (decimal, hex)
+ * @param writer Record writer producing the output
+ * @return bool true on success, false if the format is binary, or on
+ *         allocation or write failure
+ */
+bool
+print_records(int min_value,
+              int max_value,
+              TableOperation operation,
+              const row_operation_t *row_operation,
+              const char *title,
+              output_format_t format,
+              const record_writer_t *writer)
+{
+    uint64_t span = trace_begin();
+    bool success;
+
+    TRACE_PROBE2(print_table_begin, min_value, max_value);
+    success = print_records_body(min_value, max_value, operation, row_operation, title, format,
+                                 writer);
+    TRACE_PROBE2(print_table_end, min_value, max_value);
+    trace_end("print_records", span, max_value - min_value + 1);
+    return success;
+}
+
+/**
+ * @brief Append the column header row and the separator line beneath it
+ *
+ * Produces the same bytes as print_header(), into a buffer.
+ *
+ * @param output Buffer to append to
+ * @param min_value Minimum column value
+ * @param max_value Maximum column value
+ * @param max_width Width of every cell
+ * @param format Output format to use (decimal, hex)
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_header(output_buffer_t *output, int min_value, int max_value, size_t max_width,
+              output_format_t format)
+{
+    char text[U64_TEXT_SIZE];
+    char *end    = text + sizeof(text);
+    bool success = output_buffer_fill(output, ' ', max_width) &&
+                   output_buffer_append(output, " |", 2);
+
+    for (int column = min_value; success && column <= max_value; column++)
+    {
+        size_t length = format_u64((uint64_t)column, format, end);
+
+        success = append_cell(output, end - length, length, max_width);
+    }
+
+    return success && output_buffer_append(output, "\n", 1) &&
+           output_buffer_fill(output, '-', max_width + 1) &&
+           output_buffer_append(output, "+", 1) &&
+           output_buffer_fill(output, '-', (size_t)(max_value - min_value + 1) * max_width) &&
+           output_buffer_append(output, "\n", 1);
+}
+
+/**
+ * @brief One computed row shared by all sinks of print_table_sinks()
+ */
+typedef struct
+{
+    const row_operation_t *row_operation; /**< Row operation if cells is NULL */
+    const cell_value_t *cells;            /**< Cells of a per-cell operation, or NULL */
+    const uint64_t *values;               /**< Cells of the row operation */
+} sink_row_t;
+
+/**
+ * @brief Output state of one sink of print_table_sinks()
+ */
+typedef struct
+{
+    const table_sink_t *sink;        /**< Sink description */
+    output_buffer_t output;          /**< Buffer on the sink's stream */
+    size_t width;                    /**< Cell width of the padded layout */
+    text_span_t *columns;            /**< Column labels of the record layout */
+    char *arena;                     /**< Text of the column labels */
+} sink_state_t;
+
+/**
+ * @brief Render one cell of a computed row as text ending at the given position
+ *
+ * @param row Computed row
+ * @param index Column index within the row
+ * @param format Output format (decimal, hex)
+ * @param end One past the last byte of the destination
+ * @param is_number Set to whether the text is a bare number
+ * @return size_t Number of characters written before end
+ */
+static size_t
+format_sink_cell(const sink_row_t *row, int index, output_format_t format, char *end,
+                 bool *is_number)
+{
+    if (NULL != row->cells)
+    {
+        *is_number = row->cells[index].is_numeric;
+        return format_cell_value(&row->cells[index], format, end);
+    }
+
+    *is_number = NULL == row_value_marker(row->row_operation, row->values[index]);
+    return format_row_value(row->values[index], row->row_operation, format, end);
+}
+
+/**
+ * @brief Append one computed row to a sink in the sink's layout
+ *
+ * @param state Sink to append to
+ * @param computed Cells of the row
+ * @param row Row value
+ * @param count Number of columns
+ * @param spans Scratch spans for count cells and the label
+ * @param arena Scratch text of (count + 1) * U64_TEXT_SIZE bytes
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_sink_row(sink_state_t *state, const sink_row_t *computed, int row, int count,
+                text_span_t *spans, char *arena)
+{
+    output_format_t format = state->sink->format;
+    char *end              = arena + U64_TEXT_SIZE;
+    bool is_number;
+    size_t length;
+
+    if (FORMAT_BINARY == format)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            uint64_t raw = (NULL == computed->cells) ? computed->values[i]
+                         : computed->cells[i].is_numeric
+                           ? (uint64_t)(int64_t)computed->cells[i].num_value
+                           : BINARY_UNDEFINED;
+
+            if (!output_buffer_append(&state->output, (const char *)&raw, sizeof(raw)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (NULL != state->sink->writer)
+    {
+        text_span_t *label = spans + count;
+
+        for (int i = 0; i < count; i++)
+        {
+            end                = arena + (size_t)(i + 1) * U64_TEXT_SIZE;
+            spans[i].length    = format_sink_cell(computed, i, format, end, &is_number);
+            spans[i].text      = end - spans[i].length;
+            spans[i].is_number = (FORMAT_DECIMAL == format) && is_number;
+        }
+
+        end              = arena + (size_t)(count + 1) * U64_TEXT_SIZE;
+        label->length    = format_u64((uint64_t)row, format, end);
+        label->text      = end - label->length;
+        label->is_number = (FORMAT_DECIMAL == format);
+        return state->sink->writer->row(&state->output, label, state->columns, spans, count);
+    }
+
+    length = format_u64((uint64_t)row, format, end);
+    if (!append_cell(&state->output, end - length, length, state->width) ||
+        !output_buffer_append(&state->output, " |", 2))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        length = format_sink_cell(computed, i, format, end, &is_number);
+        if (!append_cell(&state->output, end - length, length, state->width))
+        {
+            return false;
+        }
+    }
+
+    return output_buffer_append(&state->output, "\n", 1);
+}
+
+/**
+ * @brief Set up one sink and write what precedes the rows
+ *
+ * @param state Sink state to initialize, with its output buffer set up
+ * @param sink Sink description
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param title Title of the table
+ * @return bool true on success, false on allocation or write failure
+ */
+static bool
+begin_sink(sink_state_t *state, const table_sink_t *sink, int min_value, int max_value,
+           TableOperation operation, const row_operation_t *row_operation, const char *title)
+{
+    int count = max_value - min_value + 1;
+
+    state->sink    = sink;
+    state->columns = NULL;
+    state->arena   = NULL;
+    state->width   = 0;
+
+    if (FORMAT_BINARY == sink->format)
+    {
+        return true;
+    }
+
+    if (NULL != sink->writer)
+    {
+        state->columns = malloc((size_t)count * sizeof(*state->columns));
+        state->arena   = malloc((size_t)count * U64_TEXT_SIZE);
+        if (NULL == state->columns || NULL == state->arena)
+        {
+            return false;
+        }
+
+        for (int j = 0; j < count; j++)
+        {
+            char *end = state->arena + (size_t)(j + 1) * U64_TEXT_SIZE;
+
+            state->columns[j].length    = format_u64((uint64_t)(min_value + j), sink->format, end);
+            state->columns[j].text      = end - state->columns[j].length;
+            state->columns[j].is_number = (FORMAT_DECIMAL == sink->format);
+        }
+
+        return sink->writer->begin(&state->output, title, state->columns, count);
+    }
+
+    state->width = (NULL != operation)
+                   ? (size_t)table_cell_width(max_value, title, sink->format)
+                   : row_cell_width(min_value, max_value, row_operation, sink->format);
+
+    return output_buffer_append(&state->output, "\n", 1) &&
+           output_buffer_append(&state->output, title, strlen(title)) &&
+           output_buffer_append(&state->output, "\n", 1) &&
+           append_header(&state->output, min_value, max_value, state->width, sink->format);
+}
+
+/**
+ * @brief Check whether two sinks write the same file through different streams
+ *
+ * @param sinks Outputs to check
+ * @param count Number of sinks
+ * @return bool true if two streams reach the same file
+ */
+bool
+table_sinks_alias(const table_sink_t *sinks, size_t count)
+{
+    struct stat files[TABLE_MAX_SINKS];
+    bool known[TABLE_MAX_SINKS];
+
+    for (size_t i = 0; i < count && i < TABLE_MAX_SINKS; i++)
+    {
+        known[i] = 0 == fstat(fileno(sinks[i].stream), &files[i]);
+        if (!known[i])
+        {
+            continue;
+        }
+
+        for (size_t j = 0; j < i; j++)
+        {
+            if (known[j] && sinks[j].stream != sinks[i].stream &&
+                files[j].st_dev == files[i].st_dev && files[j].st_ino == files[i].st_ino)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Write one table to several sinks, computing each row once, untraced
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param title Title of the table
+ * @param sinks Outputs to write, in order
+ * @param count Number of sinks (at most TABLE_MAX_SINKS)
+ * @return bool true on success, false on allocation or write failure
+ */
+static bool
+print_table_sinks_body(int min_value,
+                       int max_value,
+                       TableOperation operation,
+                       const row_operation_t *row_operation,
+                       const char *title,
+                       const table_sink_t *sinks,
+                       size_t count)
+{
+    sink_state_t states[TABLE_MAX_SINKS];
+    table_generator_t generator;
+    int columns          = max_value - min_value + 1;
+    cell_value_t *cells  = malloc((size_t)columns * sizeof(*cells));
+    uint64_t *values     = malloc((size_t)columns * sizeof(*values));
+    int *numbers         = malloc((size_t)columns * sizeof(*numbers));
+    text_span_t *spans   = malloc((size_t)(columns + 1) * sizeof(*spans));
+    char *arena          = malloc((size_t)(columns + 1) * U64_TEXT_SIZE);
+    sink_row_t computed  = {row_operation, (NULL != operation) ? cells : NULL, values};
+    size_t started       = 0;
+    bool success         = (count <= TABLE_MAX_SINKS && NULL != cells && NULL != values &&
+                            NULL != numbers && NULL != spans && NULL != arena);
+
+    /* A sink whose header fails is still counted, so it is released below */
+    for (; success && started < count; started++)
+    {
+        if (!output_buffer_init(&states[started].output, sinks[started].stream,
+                                OUTPUT_BUFFER_DEFAULT_SIZE))
+        {
+            success = false;
+            break;
+        }
+
+        success = begin_sink(&states[started], &sinks[started], min_value, max_value,
+                             operation, row_operation, title);
+    }
+
+    for (int row = min_value; success && row <= max_value; row++)
+    {
+        /* Compute the row once, then format it for every sink */
+        if (NULL != operation)
+        {
+            const int *generated = generate_row(&generator, operation, row, min_value,
+                                                max_value, numbers);
+
+            for (int j = 0; j < columns; j++)
+            {
+                cells[j] = row_cell(operation, generated, row, min_value + j, min_value);
+            }
+        }
+        else
+        {
+            row_operation->kernel(row_operation->context, row, min_value, columns, values);
+        }
+
+        for (size_t s = 0; success && s < count; s++)
+        {
+            success = append_sink_row(&states[s], &computed, row, columns, spans, arena);
+        }
+    }
+
+    for (size_t s = 0; s < started; s++)
+    {
+        success = output_buffer_flush(&states[s].output) && success;
+        output_buffer_free(&states[s].output);
+        free(states[s].columns);
+        free(states[s].arena);
+    }
+
+    free(arena);
+    free(spans);
+    free(numbers);
+    free(values);
+    free(cells);
+    return success;
+}
+
+/**
+ * @brief Write one table to several sinks, computing each row once
+ *
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @param operation Per-cell operation, or NULL
+ * @param row_operation Row operation if operation is NULL
+ * @param title Title of the table
+ * @param sinks Outputs to write, in order
+ * @param count Number of sinks (at most TABLE_MAX_SINKS)
+ * @return bool true on success, false on allocation or write failure
+ */
+bool
+print_table_sinks(int min_value,
+                  int max_value,
+                  TableOperation operation,
+                  const row_operation_t *row_operation,
+                  const char *title,
+                  const table_sink_t *sinks,
+                  size_t count)
+{
+    uint64_t span = trace_begin();
+    bool success;
+
+    TRACE_PROBE2(print_table_begin, min_value, max_value);
+    success = print_table_sinks_body(min_value, max_value, operation, row_operation, title, sinks,
+                                     count);
+    TRACE_PROBE2(print_table_end, min_value, max_value);
+    trace_end("print_table_sinks", span, max_value - min_value + 1);
+    return success;
+}
+
+/**
+ * @brief Rendered text of one block of rows
+ */
+typedef struct
+{
+    char *text;                      /**< Rendered rows (from open_memstream()) */
+    size_t length;                   /**< Length of the text */
+    bool success;                    /**< Rendering succeeded */
+} rendered_block_t;
+
+/**
+ * @brief Batch of blocks rendered by print_tables_parallel()
+ */
+typedef struct
+{
+    const table_job_t *tables;       /**< Tables being printed */
+    size_t count;                    /**< Number of tables */
+    size_t *first_block;             /**< First block of each table, then the total */
+    cell_cache_t *caches;            /**< Cell width and filled cell cache of each table */
+    rendered_block_t *blocks;        /**< One entry per block */
+} parallel_batch_t;
+
+/**
+ * @brief Append one table row (label, cells and newline) to an output buffer
+ *
+ * @param output Buffer to append to
+ * @param table Table the row belongs to
+ * @param cache Filled cache of padded cells of the table
+ * @param row Row value
+ * @param generator Scratch generator state
+ * @param numbers Scratch array of one row of int values
+ * @param values Scratch array of one row of uint64_t values
+ * @return bool true on success, false on a write error
+ */
+static bool
+append_table_row(output_buffer_t *output,
+                 const table_job_t *table,
+                 cell_cache_t *cache,
+                 int row,
+                 table_generator_t *generator,
+                 int *numbers,
+                 uint64_t *values)
+{
+    int count            = table->max_value - table->min_value + 1;
+    const int *generated = NULL;
+
+    if (NULL != table->operation)
+    {
+        generated = generate_row(generator, table->operation, row, table->min_value,
+                                 table->max_value, numbers);
+    }
+    else
+    {
+        table->row_operation->kernel(table->row_operation->context, row,
+                                     table->min_value, count, values);
+    }
+
+    if (!append_row_label(output, cache, row))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        bool appended;
+
+        if (NULL != table->operation)
+        {
+            cell_value_t value = row_cell(table->operation, generated, row,
+                                          table->min_value + i, table->min_value);
+
+            appended = append_cell_value(output, cache, &value);
+        }
+        else
+        {
+            appended = append_row_value(output, cache, values[i], table->row_operation);
+        }
+
+        if (!appended)
+        {
+            return false;
+        }
+    }
+
+    return output_buffer_append(output, "\n", 1);
+}
+
+/**
+ * @brief Scheduler task: render one block of rows into memory
+ *
+ * @param context parallel_batch_t of the batch
+ * @param index Block number across all tables
+ */
+static void
+render_block(void *context, size_t index)
+{
+    parallel_batch_t *batch   = context;
+    rendered_block_t *block   = &batch->blocks[index];
+    size_t table_index        = 0;
+    const table_job_t *table;
+    int count;
+    int first_row;
+    int last_row;
+    int *numbers;
+    uint64_t *values;
+    FILE *stream;
+    output_buffer_t output;
+    table_generator_t generator;
+    uint64_t span = trace_begin();
+
+    while (index >= batch->first_block[table_index + 1])
+    {
+        table_index++;
+    }
+
+    table     = &batch->tables[table_index];
+    count     = table->max_value - table->min_value + 1;
+    first_row = table->min_value +
+                (int)(index - batch->first_block[table_index]) * PARALLEL_BLOCK_ROWS;
+    last_row  = (table->max_value - first_row < PARALLEL_BLOCK_ROWS)
+                ? table->max_value : first_row + PARALLEL_BLOCK_ROWS - 1;
+
+    TRACE_PROBE2(row_block_begin, first_row, last_row);
+    block->success = false;
+    numbers        = malloc((size_t)count * sizeof(*numbers));
+    values         = malloc((size_t)count * sizeof(*values));
+    stream         = open_memstream(&block->text, &block->length);
+
+    if (NULL != stream && NULL != numbers && NULL != values &&
+        output_buffer_init(&output, stream, OUTPUT_BUFFER_DEFAULT_SIZE))
+    {
+        block->success = true;
+        for (int row = first_row; row <= last_row && block->success; row++)
+        {
+            block->success = append_table_row(&output, table, &batch->caches[table_index],
+                                              row, &generator, numbers, values);
+        }
+
+        block->success = output_buffer_flush(&output) && block->success;
+        output_buffer_free(&output);
+    }
+
+    if (NULL != stream && 0 != fclose(stream))
+    {
+        block->success = false;
+    }
+
+    free(values);
+    free(numbers);
+    TRACE_PROBE2(row_block_end, first_row, last_row);
+    trace_end("row_block", span, first_row);
+}
+
+/**
+ * @brief Print several tables with their rows rendered on a pool of threads, untraced
+ *
+ * @param tables Tables to print, in output order
+ * @param count Number of tables
+ * @param workers Number of rendering threads, including the caller
+ * @param stats Scheduler counters to fill in, or NULL
+ * @return bool true on success, false on allocation or write failure
+ */
+static bool
+print_tables_parallel_body(const table_job_t *tables,
+                           size_t count,
+                           int workers,
+                           scheduler_stats_t *stats)
+{
+    parallel_batch_t batch;
+    output_buffer_t output;
+    size_t total = 0;
+    bool success = false;
+
+    batch.tables      = tables;
+    batch.count       = count;
+    batch.first_block = malloc((count + 1) * sizeof(*batch.first_block));
+    batch.caches      = calloc(count + 1, sizeof(*batch.caches));
+    batch.blocks      = NULL;
+    if (NULL == batch.first_block || NULL == batch.caches)
+    {
+        goto cleanup;
+    }
+
+    /* Workers share the caches, so every cell is rendered before they start */
+    for (size_t t = 0; t < count; t++)
+    {
+        const table_job_t *table = &tables[t];
+        size_t rows              = (size_t)(table->max_value - table->min_value + 1);
+        size_t width             = (NULL != table->operation)
+                                   ? (size_t)table_cell_width(table->max_value, table->title, table->format)
+                                   : row_cell_width(table->min_value, table->max_value,
+                                                    table->row_operation, table->format);
+
+        batch.first_block[t] = total;
+        cell_cache_init(&batch.caches[t], width, table->format,
+                        cell_cache_bound(table->min_value, table->max_value,
+                                         table->operation, table->row_operation));
+        cell_cache_fill(&batch.caches[t]);
+        total += (rows + PARALLEL_BLOCK_ROWS - 1) / PARALLEL_BLOCK_ROWS;
+    }
+    batch.first_block[count] = total;
+
+    batch.blocks = calloc(total + 1, sizeof(*batch.blocks));
+    if (NULL == batch.blocks)
+    {
+        goto cleanup;
+    }
+
+    /* Without a pool the caller renders every block itself */
+    if (!scheduler_run(total, render_block, &batch, workers, stats) &&
+        !scheduler_run(total, render_block, &batch, 1, stats))
+    {
+        goto cleanup;
+    }
+
+    /* Stitch the blocks together in table and row order */
+    for (size_t t = 0; t < count; t++)
+    {
+        if (!output_buffer_init(&output, stdout, OUTPUT_BUFFER_DEFAULT_SIZE))
+        {
+            goto cleanup;
+        }
+
+        printf("\n%s\n", tables[t].title);
+        print_header(tables[t].min_value, tables[t].max_value, (int)batch.caches[t].width,
+                     tables[t].format);
+
+        for (size_t b = batch.first_block[t]; b < batch.first_block[t + 1]; b++)
+        {
+            if (!batch.blocks[b].success ||
+                !output_buffer_append(&output, batch.blocks[b].text, batch.blocks[b].length))
+            {
+                output_buffer_free(&output);
+                goto cleanup;
+            }
+        }
+
+        if (!output_buffer_flush(&output))
+        {
+            output_buffer_free(&output);
+            goto cleanup;
+        }
+        output_buffer_free(&output);
+    }
+
+    success = true;
+
+cleanup:
+    if (NULL != batch.blocks)
+    {
+        for (size_t b = 0; b < total; b++)
+        {
+            free(batch.blocks[b].text);
+        }
+    }
+    free(batch.blocks);
+    if (NULL != batch.caches)
+    {
+        for (size_t t = 0; t < count; t++)
+        {
+            cell_cache_free(&batch.caches[t]);
+        }
+    }
+    free(batch.caches);
+    free(batch.first_block);
+    return success;
+}
+
+/**
+ * @brief Print several tables with their rows rendered on a pool of threads
+ *
+ * @param tables Tables to print, in output order
+ * @param count Number of tables
+ * @param workers Number of rendering threads, including the caller
+ * @param stats Scheduler counters to fill in, or NULL
+ * @return bool true on success, false on allocation or write failure
+ */
+bool
+print_tables_parallel(const table_job_t *tables,
+                      size_t count,
+                      int workers,
+                      scheduler_stats_t *stats)
+{
+    uint64_t span = trace_begin();
+    bool success;
+
+    TRACE_PROBE2(print_tables_begin, count, workers);
+    success = print_tables_parallel_body(tables, count, workers, stats);
+    TRACE_PROBE2(print_tables_end, count, workers);
+    trace_end("print_tables_parallel", span, (int64_t)count);
+    return success;
+}
@@ -0,0 +1,588 @@
+/**
+ * @file timestable_lib.c
+ * @brief Implementation of the embeddable table interface
+ *
+ * Each handle owns the row buffers and operation context of its table, so
+ * the kernels it calls touch no shared state. Rows are computed into the
+ * buffers and rendered by the reentrant layout functions of the formatter.
+ */
+
+#include <stdlib.h>                 // calloc(), free()
+#include <string.h>                 // strcmp(), strncmp(), strlen()
+#include <stdio.h>                  // snprintf()
+
+#include "timestable.h"             // ts_spec_t, ts_table_t, ts_next_row()
+#include "timestable_cli.h"         // cli_parse_integer(), cli_parse_uint64()
+#include "timestable_expression.h"  // expr_program_t, expr_compile(), expr_row(), expr_compute_bound()
+#include "timestable_formatter.h"   // table_layout_t, table_layout_row()
+#include "timestable_operations.h"  // *_TITLE, row kernels, table_generator_t
+
+#define TS_TITLE_SIZE 256
+
+/**
+ * @brief Longest text of one cell value (a signed 64-bit value)
+ */
+#define TS_CELL_TEXT_MAX 21
+
+static const ts_error_t TS_ERRORS[] = {
+    {TS_SUCCESS,                   "Success"},
+    {TS_ERROR_INVALID_OPTION,      "Unknown option or missing argument"},
+    {TS_ERROR_INVALID_MIN,         "Invalid minimum value"},
+    {TS_ERROR_INVALID_MAX,         "Invalid maximum value (must be between 0 and 46340)"},
+    {TS_ERROR_MIN_GT_MAX,          "Minimum value cannot be greater than maximum value"},
+    {TS_ERROR_INVALID_TABLE_TYPE,  "Invalid table type (use m, d, p, M, P, g, l or r)"},
+    {TS_ERROR_INVALID_MODULUS,     "Invalid modulus (-t M and -t P need --mod with 1 <= m < 2^64)"},
+    {TS_ERROR_INVALID_EXPRESSION,  "Invalid expression"},
+    {TS_ERROR_OUT_OF_MEMORY,       "Out of memory"}
+};
+
+static const size_t TS_ERRORS_COUNT = sizeof(TS_ERRORS) / sizeof(TS_ERRORS[0]);
+
+/**
+ * @brief Table kinds selected by the letters of -t
+ */
+static const struct
+{
+    char letter;                     /**< Letter given to -t */
+    ts_table_kind_t table;           /**< Table it selects */
+} TS_TABLE_LETTERS[] = {
+    {'m', TS_TABLE_MULTIPLICATION},
+    {'d', TS_TABLE_DIVISION},
+    {'p', TS_TABLE_POWER},
+    {'M', TS_TABLE_MOD_MULTIPLICATION},
+    {'P', TS_TABLE_MOD_POWER},
+    {'g', TS_TABLE_GCD},
+    {'l', TS_TABLE_LCM},
+    {'r', TS_TABLE_REMAINDER}
+};
+
+static const size_t TS_TABLE_LETTERS_COUNT = sizeof(TS_TABLE_LETTERS) / sizeof(TS_TABLE_LETTERS[0]);
+
+/**
+ * @brief Open table
+ */
+struct ts_table
+{
+    table_layout_t layout;           /**< Layout of the rendered rows */
+    row_operation_t row_operation;   /**< Row operation if layout.operation is NULL */
+    union
+    {
+        modulus_t modulus;                     /**< Context of the modular tables */
+        gcd_tile_t gcd_tile;                   /**< Context of the GCD and LCM tables */
+        remainder_divisors_t divisors;         /**< Context of the remainder table */
+        expr_program_t program;                /**< Context of the expression table */
+    } context;                       /**< Context of row_operation */
+    cell_value_t *cells;             /**< Cells of the current row (per-cell operations) */
+    uint64_t *values;                /**< Raw values of the current row */
+    int next_row;                    /**< Row returned by the next ts_next_row() */
+    int computed_row;                /**< Row held by cells and values */
+    char title[TS_TITLE_SIZE];       /**< Title of the table */
+};
+
+/**
+ * @brief Look up the error structure of an error code
+ *
+ * @param code  Error code
+ * @return      ts_error_t Error code and message
+ */
+static ts_error_t
+ts_error(ts_error_code_t code)
+{
+    for (size_t i = 0; i < TS_ERRORS_COUNT; i++)
+    {
+        if (code == TS_ERRORS[i].code)
+        {
+            return TS_ERRORS[i];
+        }
+    }
+
+    return (ts_error_t){.code = code, .message = "Unknown error"};
+}
+
+/**
+ * @brief Fill a specification with the defaults of the timestable program
+ *
+ * @param spec  Specification to initialize
+ */
+void
+ts_spec_init(ts_spec_t *spec)
+{
+    spec->min_value  = 1;
+    spec->max_value  = 10;
+    spec->table      = TS_TABLE_MULTIPLICATION;
+    spec->format     = TS_FORMAT_DECIMAL;
+    spec->modulus    = 0;
+    spec->expression = NULL;
+}
+
+/**
+ * @brief Get the value of an option, attached or in the next argument
+ *
+ * @param argc    Number of arguments
+ * @param argv    Arguments
+ * @param index   Index of the option, advanced past a separate value
+ * @param prefix  Length of the option name, after which an attached value starts
+ * @return        const char* The value, or NULL if it is missing
+ */
+static const char *
+option_value(int argc, char *const argv[], int *index, size_t prefix)
+{
+    const char *argument = argv[*index];
+
+    if ('\0' != argument[prefix])
+    {
+        return argument + prefix;
+    }
+
+    if (*index + 1 >= argc)
+    {
+        return NULL;
+    }
+
+    return argv[++*index];
+}
+
+/**
+ * @brief Update a specification from command line style arguments
+ *
+ * @param spec  Specification to update
+ * @param argc  Number of arguments
+ * @param argv  Arguments, without a program name
+ * @return      ts_error_t Error code and message
+ */
+ts_error_t
+ts_spec_parse(ts_spec_t *spec, int argc, char *const argv[])
+{
+    ts_error_code_t error_code = TS_SUCCESS;
+
+    for (int i = 0; i < argc; i++)
+    {
+        const char *argument = argv[i];
+        const char *value;
+
+        if (0 == strcmp(argument, "-x"))
+        {
+            spec->format = TS_FORMAT_HEX;
+            continue;
+        }
+
+        if (0 == strcmp(argument, "--mod") || 0 == strncmp(argument, "--mod=", 6))
+        {
+            value = option_value(argc, argv, &i, ('=' == argument[5]) ? 6 : 5);
+            if (NULL == value || !cli_parse_uint64(value, &spec->modulus) || 0 == spec->modulus)
+            {
+                error_code = TS_ERROR_INVALID_MODULUS;
+                goto exit_function;
+            }
+            continue;
+        }
+
+        if ('-' != argument[0] || NULL == strchr("mMte", argument[1]) || '\0' == argument[1])
+        {
+            error_code = TS_ERROR_INVALID_OPTION;
+            goto exit_function;
+        }
+
+        value = option_value(argc, argv, &i, 2);
+        if (NULL == value)
+        {
+            error_code = TS_ERROR_INVALID_OPTION;
+            goto exit_function;
+        }
+
+        switch (argument[1])
+        {
+            case 'm':
+                if (!cli_parse_integer(value, &spec->min_value, 0, TS_MAX_VALUE))
+                {
+                    error_code = TS_ERROR_INVALID_MIN;
+                    goto exit_function;
+                }
+            break;
+
+            case 'M':
+                if (!cli_parse_integer(value, &spec->max_value, 0, TS_MAX_VALUE))
+                {
+                    error_code = TS_ERROR_INVALID_MAX;
+                    goto exit_function;
+                }
+            break;
+
+            case 't':
+            {
+                size_t letter = 0;
+
+                while (letter < TS_TABLE_LETTERS_COUNT &&
+                       !(TS_TABLE_LETTERS[letter].letter == value[0] && '\0' == value[1]))
+                {
+                    letter++;
+                }
+
+                if (letter == TS_TABLE_LETTERS_COUNT)
+                {
+                    error_code = TS_ERROR_INVALID_TABLE_TYPE;
+                    goto exit_function;
+                }
+                spec->table = TS_TABLE_LETTERS[letter].table;
+            }
+            break;
+
+            case 'e':
+                /* Like -t, an expression replaces the table choice */
+                spec->expression = value;
+                spec->table      = TS_TABLE_EXPRESSION;
+            break;
+        }
+    }
+
+exit_function:
+    return ts_error(error_code);
+}
+
+/**
+ * @brief Set up the operation of a table
+ *
+ * @param table  Table being opened
+ * @param spec   Table to open
+ * @return       ts_error_code_t TS_SUCCESS, or the reason the table is invalid
+ */
+static ts_error_code_t
+setup_operation(ts_table_t *table, const ts_spec_t *spec)
+{
+    const char *title              = NULL;
+    TableOperation operation       = NULL;
+    row_operation_t *row_operation = &table->row_operation;
+
+    switch (spec->table)
+    {
+        case TS_TABLE_MULTIPLICATION:
+            title     = MULT_TABLE_TITLE;
+            operation = multiply;
+        break;
+
+        case TS_TABLE_DIVISION:
+            title     = DIV_TABLE_TITLE;
+            operation = divide;
+        break;
+
+        case TS_TABLE_POWER:
+            title     = POWER_TABLE_TITLE;
+            operation = power;
+        break;
+
+        case TS_TABLE_MOD_MULTIPLICATION:
+        case TS_TABLE_MOD_POWER:
+            if (0 == spec->modulus)
+            {
+                return TS_ERROR_INVALID_MODULUS;
+            }
+            table->context.modulus.modulus = spec->modulus;
+            if (TS_TABLE_MOD_MULTIPLICATION == spec->table)
+            {
+                title                       = MOD_MULT_TABLE_TITLE;
+                row_operation->kernel       = mod_multiply_row;
+                row_operation->value_bound  = mod_multiply_bound;
+                row_operation->is_symmetric = true;
+            }
+            else
+            {
+                title                      = MOD_POWER_TABLE_TITLE;
+                row_operation->kernel      = mod_power_row;
+                row_operation->value_bound = mod_power_bound;
+            }
+            row_operation->context = &table->context.modulus;
+        break;
+
+        case TS_TABLE_GCD:
+        case TS_TABLE_LCM:
+            gcd_tile_init(&table->context.gcd_tile);
+            title                       = (TS_TABLE_GCD == spec->table) ? GCD_TABLE_TITLE : LCM_TABLE_TITLE;
+            row_operation->kernel       = (TS_TABLE_GCD == spec->table) ? gcd_row : lcm_row;
+            row_operation->value_bound  = (TS_TABLE_GCD == spec->table) ? gcd_bound : lcm_bound;
+            row_operation->context      = &table->context.gcd_tile;
+            row_operation->is_symmetric = true;
+            row_operation->has_markers  = true;
+        break;
+
+        case TS_TABLE_REMAINDER:
+            remainder_divisors_init(&table->context.divisors);
+            title                      = REMAINDER_TABLE_TITLE;
+            row_operation->kernel      = remainder_row;
+            row_operation->value_bound = remainder_bound;
+            row_operation->context     = &table->context.divisors;
+            row_operation->has_markers = true;
+        break;
+
+        case TS_TABLE_EXPRESSION:
+            if (NULL == spec->expression ||
+                EXPR_SUCCESS != expr_compile(spec->expression, &table->context.program).code)
+            {
+                return TS_ERROR_INVALID_EXPRESSION;
+            }
+            expr_compute_bound(&table->context.program, spec->min_value, spec->max_value);
+            snprintf(table->title, sizeof(table->title), "Expression Table (%s)", spec->expression);
+            row_operation->kernel      = expr_row;
+            row_operation->value_bound = expr_value_bound;
+            row_operation->context     = &table->context.program;
+            row_operation->is_signed   = true;
+        break;
+
+        default:
+            return TS_ERROR_INVALID_TABLE_TYPE;
+    }
+
+    if (NULL != title)
+    {
+        snprintf(table->title, sizeof(table->title), "%s", title);
+    }
+
+    table_layout_init(&table->layout, spec->min_value, spec->max_value, operation,
+                      row_operation, table->title,
+                      (TS_FORMAT_HEX == spec->format) ? FORMAT_HEX : FORMAT_DECIMAL);
+    return TS_SUCCESS;
+}
+
+/**
+ * @brief Open a table
+ *
+ * @param spec   Table to open
+ * @param error  Set to the error code and message
+ * @return       ts_table_t* The table, or NULL on error
+ */
+ts_table_t *
+ts_table_open(const ts_spec_t *spec, ts_error_t *error)
+{
+    ts_error_code_t error_code = TS_SUCCESS;
+    ts_table_t *table          = NULL;
+    size_t count;
+
+    if (spec->min_value < 0)
+    {
+        error_code = TS_ERROR_INVALID_MIN;
+        goto exit_function;
+    }
+
+    if (spec->max_value < 0 || spec->max_value > TS_MAX_VALUE)
+    {
+        error_code = TS_ERROR_INVALID_MAX;
+        goto exit_function;
+    }
+
+    if (spec->min_value > spec->max_value)
+    {
+        error_code = TS_ERROR_MIN_GT_MAX;
+        goto exit_function;
+    }
+
+    count = (size_t)(spec->max_value - spec->min_value + 1);
+    table = calloc(1, sizeof(*table));
+    if (NULL == table ||
+        NULL == (table->cells = malloc(count * sizeof(*table->cells))) ||
+        NULL == (table->values = malloc(count * sizeof(*table->values))))
+    {
+        error_code = TS_ERROR_OUT_OF_MEMORY;
+        goto exit_function;
+    }
+
+    error_code = setup_operation(table, spec);
+    if (TS_SUCCESS != error_code)
+    {
+        goto exit_function;
+    }
+
+    table->next_row     = spec->min_value;
+    table->computed_row = spec->min_value - 1;
+
+exit_function:
+    if (TS_SUCCESS != error_code)
+    {
+        ts_table_close(table);
+        table = NULL;
+    }
+
+    if (NULL != error)
+    {
+        *error = ts_error(error_code);
+    }
+    return table;
+}
+
+/**
+ * @brief Title of a table, as printed above it by the timestable program
+ *
+ * @param table  Open table
+ * @return       const char* Title, valid until the table is closed
+ */
+const char *
+ts_table_title(const ts_table_t *table)
+{
+    return table->title;
+}
+
+/**
+ * @brief Render the column header and separator lines of a table
+ *
+ * @param table   Open table
+ * @param buffer  Destination, or NULL if size is 0
+ * @param size    Size of the destination
+ * @return        size_t Length of the text, without the terminator
+ */
+size_t
+ts_table_header(const ts_table_t *table, char *buffer, size_t size)
+{
+    return table_layout_header(&table->layout, buffer, size);
+}
+
+/**
+ * @brief Buffer size that holds any row of a table with its terminator
+ *
+ * Every cell, the label included, is as wide as the layout or as its text,
+ * followed by " |", the newline and the terminator.
+ *
+ * @param table  Open table
+ * @return       size_t Size in bytes
+ */
+size_t
+ts_row_size(const ts_table_t *table)
+{
+    size_t count = (size_t)(table->layout.max_value - table->layout.min_value + 1);
+    size_t width = (table->layout.cell_width > TS_CELL_TEXT_MAX)
+                 ? table->layout.cell_width : TS_CELL_TEXT_MAX;
+
+    return (count + 1) * width + 4;
+}
+
+/**
+ * @brief Compute the cells and raw values of one row
+ *
+ * @param table  Open table
+ * @param row    Row value
+ */
+static void
+compute_row(ts_table_t *table, int row)
+{
+    const table_layout_t *layout = &table->layout;
+    int count                    = layout->max_value - layout->min_value + 1;
+    table_generator_t generator;
+
+    if (NULL == layout->operation)
+    {
+        table->row_operation.kernel(table->row_operation.context, row, layout->min_value,
+                                    count, table->values);
+        return;
+    }
+
+    if (gen_init(&generator, layout->operation, row, layout->min_value))
+    {
+        for (int i = 0; i < count; i++)
+        {
+            table->cells[i].is_numeric   = true;
+            table->cells[i].num_value    = gen_next(&generator);
+            table->cells[i].str_value[0] = '\0';
+        }
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+        {
+            layout->operation(row, layout->min_value + i, &table->cells[i]);
+        }
+    }
+
+    /* As written with -B */
+    for (int i = 0; i < count; i++)
+    {
+        table->values[i] = table->cells[i].is_numeric
+                         ? (uint64_t)(int64_t)table->cells[i].num_value
+                         : TS_VALUE_UNDEFINED;
+    }
+}
+
+/**
+ * @brief Render the next row of a table, including its newline
+ *
+ * @param table   Open table
+ * @param buffer  Destination, or NULL to skip the row
+ * @param size    Size of the destination
+ * @return        size_t Length of the row text, or 0 after the last row
+ */
+size_t
+ts_next_row(ts_table_t *table, char *buffer, size_t size)
+{
+    int row = table->next_row;
+    size_t length;
+
+    if (row > table->layout.max_value)
+    {
+        if (NULL != buffer && size > 0)
+        {
+            buffer[0] = '\0';
+        }
+        return 0;
+    }
+
+    /* A row retried into a larger buffer is not computed again */
+    if (row != table->computed_row)
+    {
+        compute_row(table, row);
+        table->computed_row = row;
+    }
+
+    if (NULL == buffer)
+    {
+        table->next_row++;
+        return table_layout_row(&table->layout, row, table->cells, table->values, NULL, 0);
+    }
+
+    length = table_layout_row(&table->layout, row, table->cells, table->values, buffer, size);
+    if (length < size)
+    {
+        table->next_row++;
+    }
+    return length;
+}
+
+/**
+ * @brief Raw values of the row of the last call to ts_next_row()
+ *
+ * @param table  Open table
+ * @param row    Set to the row value, if not NULL
+ * @param count  Set to the number of values, if not NULL
+ * @return       const uint64_t* The values, or NULL before the first row
+ */
+const uint64_t *
+ts_get_values(const ts_table_t *table, int *row, int *count)
+{
+    if (table->computed_row < table->layout.min_value)
+    {
+        return NULL;
+    }
+
+    if (NULL != row)
+    {
+        *row = table->computed_row;
+    }
+    if (NULL != count)
+    {
+        *count = table->layout.max_value - table->layout.min_value + 1;
+    }
+    return table->values;
+}
+
+/**
+ * @brief Close a table and release its memory
+ *
+ * @param table  Table to close, or NULL
+ */
+void
+ts_table_close(ts_table_t *table)
+{
+    if (NULL == table)
+    {
+        return;
+    }
+
+    free(table->cells);
+    free(table->values);
+    free(table);
+}
@@ -8,15 +8,1024 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
+#include <errno.h>                  // errno
+#include <unistd.h>                 // ftruncate()
+#include <sys/stat.h>               // fstat(), S_ISFIFO, S_ISREG
 
 #include "timestable_operations.h"  //*_TITLE, multiply, divide, power
 #include "timestable_formatter.h"   // print_table
+#include "timestable_plugin.h"     // plugin_t, plugin_open, plugin_close
+#include "timestable_expression.h" // expr_program_t, expr_compile, expr_row, expr_compute_bound
+#include "timestable_browser.h"    // browse_table_t, browse_table
+#include "timestable_async.h"      // async_writer_t, async_writer_open, async_writer_close
+#include "timestable_output.h"     // output_set_async_writer, output_set_checkpoint
+#include "timestable_checkpoint.h" // checkpoint_t, checkpoint_open, checkpoint_close
+#include "timestable_shard.h"      // shard_band_t, shard_rows
+#include "timestable_find.h"       // find_index_t, find_cells
+#include "timestable_aggregate.h"  // agg_table_t, agg_reduce, agg_histogram
+#include "timestable_pipeline.h"   // pipeline_stats_t, pipeline_set_stats
+#include "timestable_scheduler.h"  // scheduler_stats_t
+#include "timestable_trace.h"      // trace_open, trace_end, trace_close
 #include "timestable_cli.h"         // cli_error_code_t, program_options_t, cli_parse_args, cli_get_error_message, cli_print_usage
 #include "colors.h"                 // RED, GRN, YLW, BLU, MAG, CYN, CLR
 
 #define DEFAULT_MIN_VALUE 1
 #define DEFAULT_MAX_VALUE 10
+#define MAX_TITLE_LENGTH 256
+
+/**
+ * @brief Order in which selected tables are displayed
+ */
+static const table_flag_t TABLE_ORDER[] = {
+    TABLE_FLAG_MULTIPLICATION,
+    TABLE_FLAG_DIVISION,
+    TABLE_FLAG_POWER,
+    TABLE_FLAG_MOD_MULTIPLICATION,
+    TABLE_FLAG_MOD_POWER,
+    TABLE_FLAG_GCD,
+    TABLE_FLAG_LCM,
+    TABLE_FLAG_REMAINDER,
+    TABLE_FLAG_PLUGIN,
+    TABLE_FLAG_EXPRESSION
+};
+
+static const size_t TABLE_ORDER_COUNT = sizeof(TABLE_ORDER) / sizeof(TABLE_ORDER[0]);
+
+/**
+ * @brief Operation and resources needed to display one table
+ */
+typedef struct
+{
+    const char *title;                   /**< Title to display for the table */
+    TableOperation operation;            /**< Per-cell operation, or NULL */
+    row_operation_t row_operation;       /**< Row operation if operation is NULL */
+    modulus_t modulus;                   /**< Context of the modular tables */
+    plugin_t plugin;                     /**< Loaded plugin (handle NULL if unused) */
+    char title_buffer[MAX_TITLE_LENGTH]; /**< Storage for generated titles */
+} table_setup_t;
+
+/* Compiled -e expression, too large for the stack */
+static expr_program_t expression_program;
+
+/* Streams of the --out outputs, opened by open_outputs() */
+static table_sink_t output_sinks[TABLE_MAX_SINKS];
+
+/* Lookup tables of the GCD, LCM and remainder tables, filled by setup_table() */
+static gcd_tile_t gcd_tile;
+static remainder_divisors_t remainder_divisors;
+
+/**
+ * @brief Prepare the operation for one table
+ *
+ * @param options  Program options
+ * @param table    Table to prepare
+ * @param setup    Pointer to the setup structure to populate
+ * @return         bool true on success, false after reporting an error
+ */
+static bool
+setup_table(const program_options_t *options, table_flag_t table, table_setup_t *setup)
+{
+    plugin_error_t plugin_error;
+    expr_error_t expr_error;
+
+    memset(setup, 0, sizeof(*setup));
+    setup->modulus.modulus = options->modulus;
+
+    switch (table)
+    {
+        case TABLE_FLAG_MULTIPLICATION:
+            setup->title     = MULT_TABLE_TITLE;
+            setup->operation = multiply;
+        break;
+
+        case TABLE_FLAG_DIVISION:
+            setup->title     = DIV_TABLE_TITLE;
+            setup->operation = divide;
+        break;
+
+        case TABLE_FLAG_POWER:
+            setup->title     = POWER_TABLE_TITLE;
+            setup->operation = power;
+        break;
+
+        case TABLE_FLAG_MOD_MULTIPLICATION:
+            setup->title                      = MOD_MULT_TABLE_TITLE;
+            setup->row_operation.kernel       = mod_multiply_row;
+            setup->row_operation.value_bound  = mod_multiply_bound;
+            setup->row_operation.context      = &setup->modulus;
+            setup->row_operation.is_symmetric = true;
+        break;
+
+        case TABLE_FLAG_MOD_POWER:
+            setup->title                     = MOD_POWER_TABLE_TITLE;
+            setup->row_operation.kernel      = mod_power_row;
+            setup->row_operation.value_bound = mod_power_bound;
+            setup->row_operation.context     = &setup->modulus;
+        break;
+
+        case TABLE_FLAG_GCD:
+        case TABLE_FLAG_LCM:
+            gcd_tile_init(&gcd_tile);
+            setup->title                      = (TABLE_FLAG_GCD == table) ? GCD_TABLE_TITLE : LCM_TABLE_TITLE;
+            setup->row_operation.kernel       = (TABLE_FLAG_GCD == table) ? gcd_row : lcm_row;
+            setup->row_operation.value_bound  = (TABLE_FLAG_GCD == table) ? gcd_bound : lcm_bound;
+            setup->row_operation.context      = &gcd_tile;
+            setup->row_operation.is_symmetric = true;
+            setup->row_operation.has_markers  = true;
+        break;
+
+        case TABLE_FLAG_REMAINDER:
+            remainder_divisors_init(&remainder_divisors);
+            setup->title                     = REMAINDER_TABLE_TITLE;
+            setup->row_operation.kernel      = remainder_row;
+            setup->row_operation.value_bound = remainder_bound;
+            setup->row_operation.context     = &remainder_divisors;
+            setup->row_operation.has_markers = true;
+        break;
+
+        case TABLE_FLAG_PLUGIN:
+            plugin_error = plugin_open(options->plugin_path, options->plugin_op, &setup->plugin);
+            if (plugin_error.code != PLUGIN_SUCCESS)
+            {
+                fprintf(stderr, RED "Error: %s: %s\n" CLR, plugin_error.message, options->plugin_path);
+                return false;
+            }
+            setup->title         = setup->plugin.title;
+            setup->row_operation = setup->plugin.operation;
+        break;
+
+        case TABLE_FLAG_EXPRESSION:
+            expr_error = expr_compile(options->expression, &expression_program);
+            if (expr_error.code != EXPR_SUCCESS)
+            {
+                fprintf(stderr, RED "Error: %s at offset %d: %s\n" CLR,
+                        expr_error.message, expr_error.position, options->expression);
+                return false;
+            }
+            /* Only printed tables need the bound; the browser and aggregates
+               never format a whole table */
+            if (!options->browse && !options->aggregate && !options->range_sum)
+            {
+                expr_compute_bound(&expression_program, options->min_value, options->max_value);
+            }
+            snprintf(setup->title_buffer, sizeof(setup->title_buffer),
+                     "Expression Table (%s)", options->expression);
+            setup->title                     = setup->title_buffer;
+            setup->row_operation.kernel      = expr_row;
+            setup->row_operation.value_bound = expr_value_bound;
+            setup->row_operation.context     = &expression_program;
+            setup->row_operation.is_signed   = true;
+        break;
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Display one table by printing or browsing it
+ *
+ * @param options  Program options
+ * @param table    Table to display
+ * @return         bool true on success, false after reporting an error
+ */
+static bool
+show_table(const program_options_t *options, table_flag_t table)
+{
+    table_setup_t setup;
+    bool success = true;
+
+    if (!setup_table(options, table, &setup))
+    {
+        plugin_close(&setup.plugin);
+        return false;
+    }
+
+    if (options->triangle &&
+        !(NULL != setup.operation ? operation_is_symmetric(setup.operation)
+                                  : setup.row_operation.is_symmetric))
+    {
+        fprintf(stderr, RED "Error: --triangle needs a symmetric table: %s\n" CLR, setup.title);
+        plugin_close(&setup.plugin);
+        return false;
+    }
+
+    if (options->browse)
+    {
+        browse_table_t browse = {
+            .min_value     = options->min_value,
+            .max_value     = options->max_value,
+            .title         = setup.title,
+            .format        = options->format,
+            .operation     = setup.operation,
+            .row_operation = &setup.row_operation
+        };
+
+        success = browse_table(&browse);
+    }
+    else if (TABLE_FLAG_POWER == table && options->big_power)
+    {
+        success = print_big_power_table(options->min_value, options->max_value,
+                                        setup.title, options->format);
+    }
+    else if (TABLE_FLAG_DIVISION == table && 0 != options->precision)
+    {
+        success = print_fraction_table(options->min_value, options->max_value,
+                                       setup.title, options->precision);
+    }
+    else if (options->output_count > 0)
+    {
+        success = print_table_sinks(options->min_value, options->max_value,
+                                    setup.operation, &setup.row_operation, setup.title,
+                                    output_sinks, (size_t)options->output_count);
+    }
+    else if (NULL != options->writer)
+    {
+        success = print_records(options->min_value, options->max_value,
+                                setup.operation, &setup.row_operation,
+                                setup.title, options->format, options->writer);
+    }
+    else if (options->compact)
+    {
+        success = print_compact_table(options->min_value, options->max_value,
+                                      setup.operation, &setup.row_operation,
+                                      setup.title, options->format);
+    }
+    else if (options->triangle)
+    {
+        success = print_triangle_table(options->min_value, options->max_value,
+                                       setup.operation, &setup.row_operation,
+                                       setup.title, options->format);
+    }
+    else if (NULL != setup.operation)
+    {
+        print_table(options->min_value, options->max_value, setup.operation,
+                    setup.title, options->format);
+    }
+    else
+    {
+        success = print_row_table(options->min_value, options->max_value,
+                                  &setup.row_operation, setup.title, options->format);
+    }
+
+    if (!success)
+    {
+        fprintf(stderr, RED "Error: Failed to %s %s\n" CLR,
+                options->browse ? "browse" : "print", setup.title);
+    }
+
+    plugin_close(&setup.plugin);
+    return success;
+}
+
+/**
+ * @brief Display all selected tables with their rows rendered in parallel
+ *
+ * @param options  Program options
+ * @param stats    Scheduler counters to fill in
+ * @return         bool true on success, false after reporting an error
+ */
+static bool
+show_tables_parallel(const program_options_t *options, scheduler_stats_t *stats)
+{
+    table_setup_t setups[TABLE_ORDER_COUNT];
+    table_job_t jobs[TABLE_ORDER_COUNT];
+    size_t count = 0;
+    bool success = true;
+
+    for (size_t i = 0; i < TABLE_ORDER_COUNT && success; i++)
+    {
+        if (options->tables & TABLE_ORDER[i])
+        {
+            success = setup_table(options, TABLE_ORDER[i], &setups[count]);
+            if (!success)
+            {
+                plugin_close(&setups[count].plugin);
+                break;
+            }
+
+            jobs[count].min_value     = options->min_value;
+            jobs[count].max_value     = options->max_value;
+            jobs[count].title         = setups[count].title;
+            jobs[count].format        = options->format;
+            jobs[count].operation     = setups[count].operation;
+            jobs[count].row_operation = &setups[count].row_operation;
+            count++;
+        }
+    }
+
+    if (success && !print_tables_parallel(jobs, count, options->jobs, stats))
+    {
+        fprintf(stderr, RED "Error: Failed to print the tables\n" CLR);
+        success = false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        plugin_close(&setups[i].plugin);
+    }
+
+    return success;
+}
+
+/**
+ * @brief Open the asynchronous writer on stdout with the configured buffers
+ *
+ * @param writer   Writer to open
+ * @param options  Program options (buffer count and size)
+ * @param backend  Backend to use
+ * @return         bool true on success, false if the backend cannot be set up
+ */
+static bool
+open_async_writer(async_writer_t *writer, const program_options_t *options, async_backend_t backend)
+{
+    return async_writer_open(writer, fileno(stdout), backend,
+                             (size_t)options->async_buffers,
+                             (size_t)options->async_buffer_kib * 1024);
+}
+
+/**
+ * @brief Find the first table selected by the options
+ *
+ * @param options  Program options
+ * @return         table_flag_t First selected table in display order
+ */
+static table_flag_t
+first_table(const program_options_t *options)
+{
+    for (size_t i = 0; i < TABLE_ORDER_COUNT; i++)
+    {
+        if (options->tables & TABLE_ORDER[i])
+        {
+            return TABLE_ORDER[i];
+        }
+    }
+
+    return TABLE_FLAG_MULTIPLICATION;
+}
+
+/**
+ * @brief Find the rows of one shard of a table
+ *
+ * @param options  Program options
+ * @param table    Table being sharded
+ * @param index    Shard number
+ * @return         shard_band_t Rows of the shard
+ */
+static shard_band_t
+table_shard(const program_options_t *options, table_flag_t table, int index)
+{
+    /* Exact power rows get dearer as the row grows; the others cost the same */
+    shard_cost_t cost = (TABLE_FLAG_POWER == table && options->big_power)
+                        ? shard_cost_big_power : shard_cost_uniform;
+
+    return shard_rows(options->min_value, options->max_value, cost, index, options->shard_count);
+}
+
+/**
+ * @brief Count the bytes of one shard's output
+ *
+ * Every row of a table is as long as its cell width makes it, except in
+ * the per-cell power table, whose overflowed cells may be wider than the
+ * cell; only those rows are laid out to measure them.
+ *
+ * @param options  Program options
+ * @param table    Table being sharded
+ * @param setup    Operation of the table
+ * @param band     Rows of the shard
+ * @param length   Set to the number of bytes
+ * @return         bool true on success, false on allocation failure
+ */
+static bool
+measure_shard(const program_options_t *options, table_flag_t table, const table_setup_t *setup,
+              shard_band_t band, long long *length)
+{
+    int count  = options->max_value - options->min_value + 1;
+    int rows   = (band.first_row <= band.last_row) ? band.last_row - band.first_row + 1 : 0;
+    bool exact = TABLE_FLAG_POWER == table && options->big_power;
+    table_layout_t layout;
+    cell_value_t *cells;
+    long long row_length;
+    size_t width;
+
+    table_layout_init(&layout, options->min_value, options->max_value, setup->operation,
+                      &setup->row_operation, setup->title, options->format);
+
+    if (exact)
+        width = big_power_cell_width(options->max_value, options->format);
+    else if (TABLE_FLAG_DIVISION == table && 0 != options->precision)
+        width = fraction_cell_width(options->max_value, options->precision);
+    else
+        width = layout.cell_width;
+
+    if (0 == width)
+    {
+        return false;
+    }
+
+    /* Row label, " |", the cells and the newline; the header row and the
+       separator line beneath it have the same length */
+    row_length = (long long)(count + 1) * (long long)width + 3;
+
+    /* Like output_begin_rows(), the title and header go to the first band */
+    *length = 0;
+    if (band.first_row <= options->min_value)
+    {
+        *length += (long long)strlen(setup->title) + 2 + 2 * row_length;
+    }
+
+    if (TABLE_FLAG_POWER != table || exact)
+    {
+        *length += rows * row_length;
+        return true;
+    }
+
+    cells = malloc((size_t)count * sizeof(*cells));
+    if (NULL == cells)
+    {
+        return false;
+    }
+
+    for (int row = band.first_row; row <= band.last_row; row++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            setup->operation(row, options->min_value + i, &cells[i]);
+        }
+        *length += (long long)table_layout_row(&layout, row, cells, NULL, NULL, 0);
+    }
+
+    free(cells);
+    return true;
+}
+
+/**
+ * @brief Print the rows and byte range of every shard
+ *
+ * Shard i can then be written into its range of one shared file while the
+ * others are generated in parallel.
+ *
+ * @param options  Program options
+ * @return         bool true on success, false after reporting an error
+ */
+static bool
+print_shard_offsets(const program_options_t *options)
+{
+    table_flag_t table = first_table(options);
+    long long offset   = 0;
+    table_setup_t setup;
+    bool success       = setup_table(options, table, &setup);
+
+    for (int i = 0; i < options->shard_count && success; i++)
+    {
+        shard_band_t band = table_shard(options, table, i);
+        long long length;
+
+        if (!measure_shard(options, table, &setup, band, &length))
+        {
+            fprintf(stderr, RED "Error: Cannot measure shard %d/%d\n" CLR, i, options->shard_count);
+            success = false;
+            break;
+        }
+
+        if (band.first_row <= band.last_row)
+        {
+            printf("%d/%d rows %d-%d offset %lld length %lld\n", i, options->shard_count,
+                   band.first_row, band.last_row, offset, length);
+        }
+        else
+        {
+            printf("%d/%d rows none offset %lld length %lld\n", i, options->shard_count,
+                   offset, length);
+        }
+        offset += length;
+    }
+
+    plugin_close(&setup.plugin);
+    return success;
+}
+
+/**
+ * @brief Lookup being printed by print_match()
+ */
+typedef struct
+{
+    uint64_t value;                  /**< Value looked up */
+    const char *symbol;              /**< Operator between row and column */
+    size_t matches;                  /**< Ranges printed so far */
+} find_query_t;
+
+/**
+ * @brief Print a row or column value, or a range of them
+ *
+ * @param first  First value
+ * @param last   Last value
+ */
+static void
+print_find_span(int first, int last)
+{
+    if (first == last)
+    {
+        printf("%d", first);
+    }
+    else
+    {
+        printf("%d..%d", first, last);
+    }
+}
+
+/**
+ * @brief Print one group of matching cells as an equation
+ *
+ * @param context  find_query_t of the lookup
+ * @param range    Matching cells
+ * @return         bool true to continue the lookup
+ */
+static bool
+print_match(void *context, const find_range_t *range)
+{
+    find_query_t *query = context;
+
+    printf("%llu = ", (unsigned long long)query->value);
+    print_find_span(range->first_row, range->last_row);
+    printf(" %s ", query->symbol);
+    print_find_span(range->first_column, range->last_column);
+    printf("\n");
+
+    query->matches++;
+    return true;
+}
+
+/**
+ * @brief Look up one value in every selected table
+ *
+ * @param options  Program options
+ * @param index    Lookup index for the table range
+ * @param value    Value to look up
+ * @return         bool true on success, false after reporting an error
+ */
+static bool
+find_value(const program_options_t *options, const find_index_t *index, uint64_t value)
+{
+    static const struct
+    {
+        table_flag_t table;
+        find_operation_t operation;
+        const char *symbol;
+    } FIND_TABLES[] = {
+        {TABLE_FLAG_MULTIPLICATION, FIND_MULTIPLY, "×"},
+        {TABLE_FLAG_DIVISION,       FIND_DIVIDE,   "÷"},
+        {TABLE_FLAG_POWER,          FIND_POWER,    "^"}
+    };
+
+    for (size_t i = 0; i < sizeof(FIND_TABLES) / sizeof(FIND_TABLES[0]); i++)
+    {
+        find_query_t query = {value, FIND_TABLES[i].symbol, 0};
+
+        if (!(options->tables & FIND_TABLES[i].table))
+        {
+            continue;
+        }
+
+        if (!find_cells(index, FIND_TABLES[i].operation, value, print_match, &query))
+        {
+            fprintf(stderr, RED "Error: Cannot look up %llu\n" CLR, (unsigned long long)value);
+            return false;
+        }
+
+        if (0 == query.matches)
+        {
+            printf("%llu = r %s c: none\n", (unsigned long long)value, query.symbol);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Answer --find and --find-file lookups
+ *
+ * The factor sieve is built once and shared by every value of the file.
+ *
+ * @param options  Program options
+ * @return         bool true on success, false after reporting an error
+ */
+static bool
+run_find(const program_options_t *options)
+{
+    find_index_t index;
+    FILE *file       = NULL;
+    char line[64];
+    unsigned number  = 0;
+    bool success     = true;
+
+    if (!find_index_init(&index, options->min_value, options->max_value))
+    {
+        fprintf(stderr, RED "Error: Cannot allocate the lookup index\n" CLR);
+        return false;
+    }
+
+    if (options->find)
+    {
+        success = find_value(options, &index, options->find_value);
+    }
+
+    if (success && NULL != options->find_path)
+    {
+        file = (0 == strcmp(options->find_path, "-")) ? stdin : fopen(options->find_path, "r");
+        if (NULL == file)
+        {
+            fprintf(stderr, RED "Error: Cannot open %s\n" CLR, options->find_path);
+            success = false;
+        }
+    }
+
+    /* One value per line; blank lines and # comments are skipped */
+    while (success && NULL != file && NULL != fgets(line, sizeof(line), file))
+    {
+        char *text = line + strspn(line, " \t");
+        char *end  = NULL;
+        unsigned long long value;
+
+        number++;
+        text[strcspn(text, " \t\r\n#")] = '\0';
+        if ('\0' == *text)
+        {
+            continue;
+        }
+
+        errno = 0;
+        value = strtoull(text, &end, 10);
+        if ('-' == *text || 0 != errno || '\0' != *end)
+        {
+            fprintf(stderr, RED "Error: Invalid value on line %u of %s: %s\n" CLR,
+                    number, options->find_path, text);
+            success = false;
+            break;
+        }
+
+        success = find_value(options, &index, (uint64_t)value);
+    }
+
+    if (NULL != file && stdin != file)
+    {
+        fclose(file);
+    }
+
+    find_index_free(&index);
+    return success;
+}
+
+/**
+ * @brief Names of the reductions, indexed by agg_kind_t
+ */
+static const char *const AGGREGATE_NAMES[] = {"sum", "min", "max", "hist"};
+
+/**
+ * @brief Print one aggregate result
+ *
+ * @param name    Reduction name
+ * @param label   What was reduced, e.g. "row 3"
+ * @param result  Result to print
+ */
+static void
+print_aggregate(const char *name, const char *label, const agg_result_t *result)
+{
+    char text[AGG_TEXT_SIZE];
+
+    if (0 == result->cells)
+    {
+        printf("%s %s: none\n", name, label);
+    }
+    else if (result->overflow)
+    {
+        printf("%s %s: ≥ 2^127\n", name, label);
+    }
+    else
+    {
+        printf("%s %s: %s\n", name, label, agg_format(result->value, text));
+    }
+}
+
+/**
+ * @brief Print one histogram bucket
+ *
+ * @param context  Unused
+ * @param value    Cell value
+ * @param count    Number of cells holding value
+ * @return         bool true to continue
+ */
+static bool
+print_bucket(void *context, agg_int_t value, uint64_t count)
+{
+    char text[AGG_TEXT_SIZE];
+
+    (void)context;
+    printf("hist %s: %llu\n", agg_format(value, text), (unsigned long long)count);
+    return true;
+}
+
+/**
+ * @brief Print the aggregates of one table
+ *
+ * --range-sum prints one sum; --agg prints the result of every row, every
+ * column and the whole table, or its histogram.
+ *
+ * @param options  Program options
+ * @param table    Table to reduce
+ * @param title    Title of the table
+ * @return         bool true on success, false after reporting an error
+ */
+static bool
+print_table_aggregates(const program_options_t *options, const agg_table_t *table,
+                       const char *title)
+{
+    agg_rect_t rect        = {options->min_value, options->max_value,
+                              options->min_value, options->max_value};
+    size_t count           = (size_t)(options->max_value - options->min_value + 1);
+    agg_result_t *rows     = NULL;
+    agg_result_t *columns  = NULL;
+    agg_result_t total;
+    uint64_t undefined;
+    uint64_t overflow;
+    char label[64];
+    bool success;
+
+    printf("\n%s\n", title);
+
+    if (options->range_sum)
+    {
+        success = agg_reduce(table, AGG_SUM, &options->range, NULL, NULL, &total);
+        if (success)
+        {
+            snprintf(label, sizeof(label), "rows %d..%d, columns %d..%d",
+                     options->range.first_row, options->range.last_row,
+                     options->range.first_column, options->range.last_column);
+            print_aggregate("sum", label, &total);
+        }
+    }
+    else if (AGG_HISTOGRAM == options->aggregate_kind)
+    {
+        success = agg_histogram(table, &rect, print_bucket, NULL, &undefined, &overflow);
+        if (success && undefined > 0)
+        {
+            printf("hist undefined: %llu\n", (unsigned long long)undefined);
+        }
+        if (success && overflow > 0)
+        {
+            printf("hist ≥ 2^127: %llu\n", (unsigned long long)overflow);
+        }
+    }
+    else
+    {
+        const char *name = AGGREGATE_NAMES[options->aggregate_kind];
+
+        rows    = malloc(count * sizeof(*rows));
+        columns = malloc(count * sizeof(*columns));
+        success = NULL != rows && NULL != columns &&
+                  agg_reduce(table, options->aggregate_kind, &rect, rows, columns, &total);
+
+        for (size_t i = 0; success && i < count; i++)
+        {
+            snprintf(label, sizeof(label), "row %d", options->min_value + (int)i);
+            print_aggregate(name, label, &rows[i]);
+        }
+        for (size_t i = 0; success && i < count; i++)
+        {
+            snprintf(label, sizeof(label), "column %d", options->min_value + (int)i);
+            print_aggregate(name, label, &columns[i]);
+        }
+        if (success)
+        {
+            print_aggregate(name, "total", &total);
+        }
+
+        free(columns);
+        free(rows);
+    }
+
+    if (!success)
+    {
+        fprintf(stderr, RED "Error: Cannot aggregate %s\n" CLR, title);
+    }
+
+    return success;
+}
+
+/**
+ * @brief Answer --agg and --range-sum for every selected table
+ *
+ * The multiplication, division and power tables are reduced by their
+ * closed forms with exact values, whatever -b says; the others over their
+ * row kernels.
+ *
+ * @param options  Program options
+ * @return         bool true on success, false after reporting an error
+ */
+static bool
+run_aggregate(const program_options_t *options)
+{
+    bool success = true;
+
+    for (size_t i = 0; i < TABLE_ORDER_COUNT && success; i++)
+    {
+        table_setup_t setup;
+        agg_table_t table;
+
+        if (!(options->tables & TABLE_ORDER[i]))
+        {
+            continue;
+        }
+
+        success = setup_table(options, TABLE_ORDER[i], &setup);
+        if (success)
+        {
+            table.source        = (multiply == setup.operation) ? AGG_TABLE_MULTIPLY
+                                : (divide == setup.operation)   ? AGG_TABLE_DIVIDE
+                                : (power == setup.operation)    ? AGG_TABLE_POWER
+                                : AGG_TABLE_ROWS;
+            table.row_operation = &setup.row_operation;
+            success             = print_table_aggregates(options, &table, setup.title);
+        }
+
+        plugin_close(&setup.plugin);
+    }
+
+    return success;
+}
+
+/**
+ * @brief Add bytes to an FNV-1a hash
+ *
+ * @param hash  Hash so far
+ * @param data  Bytes to add
+ * @param size  Number of bytes
+ * @return      uint64_t Updated hash
+ */
+static uint64_t
+hash_bytes(uint64_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * 1099511628211u;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Hash the options that determine the table output
+ *
+ * A checkpoint is only resumed by a run that would write the same bytes.
+ *
+ * @param options Program options
+ * @return        uint64_t Signature of the output
+ */
+static uint64_t
+output_signature(const program_options_t *options)
+{
+    const char *strings[] = {options->plugin_path, options->plugin_op, options->expression};
+    int values[]          = {options->min_value, options->max_value, (int)options->format,
+                             (int)options->tables, options->big_power, options->triangle,
+                             options->precision, options->compact};
+    uint64_t hash         = 14695981039346656037u;
+
+    hash = hash_bytes(hash, values, sizeof(values));
+    hash = hash_bytes(hash, &options->modulus, sizeof(options->modulus));
+    for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++)
+    {
+        /* The terminator keeps "ab","c" apart from "a","bc"; NULL hashes as nothing */
+        if (NULL != strings[i])
+        {
+            hash = hash_bytes(hash, strings[i], strlen(strings[i]) + 1);
+        }
+        hash = hash_bytes(hash, "", 1);
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Report asynchronous writer statistics on stderr
+ *
+ * @param writer Closed writer
+ */
+static void
+print_async_stats(const async_writer_t *writer)
+{
+    const async_stats_t *stats = &writer->stats;
+    double average_depth       = (stats->writes > 0)
+                                 ? (double)stats->depth_total / (double)stats->writes : 0.0;
+
+    fprintf(stderr, "Async writer: %s, %zu × %zu KiB buffers\n",
+            async_backend_name(writer->backend), writer->buffer_count, writer->buffer_size / 1024);
+    fprintf(stderr, "  writes:      %llu (%llu bytes)\n",
+            (unsigned long long)stats->writes, (unsigned long long)stats->bytes);
+    fprintf(stderr, "  queue depth: avg %.2f, max %u of %zu\n",
+            average_depth, (unsigned)stats->max_depth, writer->max_in_flight);
+    fprintf(stderr, "  stalls:      %llu (renderer waited for a free buffer)\n",
+            (unsigned long long)stats->stalls);
+}
+
+/**
+ * @brief Report pipeline stage waits on stderr
+ *
+ * @param stats Statistics collected over all pipelined tables
+ */
+static void
+print_pipeline_stats(const pipeline_stats_t *stats)
+{
+    fprintf(stderr, "Pipeline: %llu rows\n", (unsigned long long)stats->rows);
+    for (int stage = 0; stage < PIPELINE_STAGE_COUNT; stage++)
+    {
+        fprintf(stderr, "  %-8s waited %10.3f ms for input, %10.3f ms for output\n",
+                pipeline_stage_name((pipeline_stage_t)stage),
+                (double)stats->input_ns[stage] / 1e6, (double)stats->output_ns[stage] / 1e6);
+    }
+}
+
+/**
+ * @brief Close the file streams of the --out outputs
+ *
+ * @param options  Program options
+ * @param count    Number of outputs opened
+ * @return         bool true on success, false after reporting a write error
+ */
+static bool
+close_outputs(const program_options_t *options, int count)
+{
+    bool success = true;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (stdout != output_sinks[i].stream && 0 != fclose(output_sinks[i].stream))
+        {
+            fprintf(stderr, RED "Error: Cannot write output: %s\n" CLR, options->outputs[i].path);
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+/**
+ * @brief Open the streams of the --out outputs
+ *
+ * Files are opened without truncating them, so two outputs reaching the
+ * same file are rejected before either of them has lost its contents.
+ *
+ * @param options  Program options
+ * @return         bool true on success, false after reporting an error
+ */
+static bool
+open_outputs(const program_options_t *options)
+{
+    for (int i = 0; i < options->output_count; i++)
+    {
+        const output_spec_t *spec = &options->outputs[i];
+
+        output_sinks[i].format = spec->format;
+        output_sinks[i].writer = spec->writer;
+        output_sinks[i].stream = (NULL == spec->path) ? stdout : fopen(spec->path, "ab");
+
+        if (NULL == output_sinks[i].stream)
+        {
+            fprintf(stderr, RED "Error: Cannot open output: %s\n" CLR, spec->path);
+            close_outputs(options, i);
+            return false;
+        }
+    }
+
+    if (table_sinks_alias(output_sinks, (size_t)options->output_count))
+    {
+        fprintf(stderr, RED "Error: Two outputs write the same file\n" CLR);
+        close_outputs(options, options->output_count);
+        return false;
+    }
+
+    for (int i = 0; i < options->output_count; i++)
+    {
+        struct stat file;
+
+        /* Appends then start at the beginning of the emptied file */
+        if (stdout != output_sinks[i].stream &&
+            0 == fstat(fileno(output_sinks[i].stream), &file) && S_ISREG(file.st_mode) &&
+            0 != ftruncate(fileno(output_sinks[i].stream), 0))
+        {
+            fprintf(stderr, RED "Error: Cannot open output: %s\n" CLR, options->outputs[i].path);
+            close_outputs(options, options->output_count);
+            return false;
+        }
+    }
+
+    return true;
+}
 
 /**
  * @brief Main program entry point
@@ -28,17 +1037,60 @@
 int main(int argc, char *argv[])
 {
     program_options_t options = {
-        .min_value  = DEFAULT_MIN_VALUE,
-        .max_value  = DEFAULT_MAX_VALUE,
-        .format     = FORMAT_DECIMAL,
-        .tables     = TABLE_FLAG_MULTIPLICATION,
-        .show_help  = false
+        .min_value        = DEFAULT_MIN_VALUE,
+        .max_value        = DEFAULT_MAX_VALUE,
+        .format           = FORMAT_DECIMAL,
+        .tables           = TABLE_FLAG_MULTIPLICATION,
+        .big_power        = false,
+        .modulus          = 0,
+        .plugin_path      = NULL,
+        .plugin_op        = NULL,
+        .expression       = NULL,
+        .browse           = false,
+        .triangle         = false,
+        .writer           = NULL,
+        .async            = false,
+        .async_backend    = ASYNC_BACKEND_AUTO,
+        .async_buffers    = ASYNC_DEFAULT_BUFFERS,
+        .async_buffer_kib = ASYNC_DEFAULT_BUFFER_SIZE / 1024,
+        .async_stats      = false,
+        .no_splice        = false,
+        .stats            = false,
+        .jobs             = 1,
+        .checkpoint_path  = NULL,
+        .resume           = false,
+        .shard_index      = 0,
+        .shard_count      = 1,
+        .shard_offsets    = false,
+        .find             = false,
+        .find_value       = 0,
+        .find_path        = NULL,
+        .aggregate        = false,
+        .aggregate_kind   = AGG_SUM,
+        .range_sum        = false,
+        .range            = {0, 0, 0, 0},
+        .precision        = 0,
+        .output_count     = 0,
+        .compact          = false,
+        .trace_path       = NULL,
+        .show_help        = false
     };
 
     cli_error_t error;
+    checkpoint_t checkpoint;
+    async_writer_t writer;
+    struct stat stdout_info;
+    pipeline_stats_t pipeline_stats;
+    scheduler_stats_t scheduler_stats = {0, 0};
+    bool outputs_open;
+    int status = EXIT_SUCCESS;
+    uint64_t parse_start;
 
     /* Parse command line arguments */
+    parse_start = trace_clock_ns();
+    TRACE_PROBE1(parse_args_begin, argc);
     error = cli_parse_args(argc, argv, &options);
+    TRACE_PROBE1(parse_args_end, argc);
 
     /* Check for errors or help request */
     if (error.code != CLI_SUCCESS)
@@ -54,24 +1106,213 @@ int main(int argc, char *argv[])
         return EXIT_SUCCESS;
     }
 
-    /* Display requested tables */
-    if (options.tables & TABLE_FLAG_MULTIPLICATION)
+    /* The timeline starts with the parsing that just finished */
+    if (NULL != options.trace_path)
+    {
+        trace_error_t trace_error = trace_open(options.trace_path, parse_start);
+
+        if (TRACE_SUCCESS != trace_error.code)
+        {
+            fprintf(stderr, RED "Error: %s: %s\n" CLR, trace_error.message, options.trace_path);
+            return EXIT_FAILURE;
+        }
+        trace_end("parse_args", parse_start, argc);
+    }
+
+    if (options.find || NULL != options.find_path)
+    {
+        status = run_find(&options) ? EXIT_SUCCESS : EXIT_FAILURE;
+        goto exit_function;
+    }
+
+    if (options.aggregate || options.range_sum)
     {
-        print_table(options.min_value, options.max_value, multiply,
-                   MULT_TABLE_TITLE, options.format);
+        status = run_aggregate(&options) ? EXIT_SUCCESS : EXIT_FAILURE;
+        goto exit_function;
     }
 
-    if (options.tables & TABLE_FLAG_DIVISION)
+    if (options.shard_offsets)
     {
-        print_table(options.min_value, options.max_value, divide,
-                   DIV_TABLE_TITLE, options.format);
+        status = print_shard_offsets(&options) ? EXIT_SUCCESS : EXIT_FAILURE;
+        goto exit_function;
+    }
+
+    /* Only this shard's rows are printed, the title and header by shard 0 */
+    if (options.shard_count > 1)
+    {
+        shard_band_t band = table_shard(&options, first_table(&options), options.shard_index);
+
+        output_set_row_band(stdout, band.first_row, band.last_row);
+    }
+
+    /* A resumed run truncates the output, so do it before anything writes */
+    if (NULL != options.checkpoint_path)
+    {
+        checkpoint_error_t checkpoint_error = checkpoint_open(&checkpoint, options.checkpoint_path,
+                                                              fileno(stdout),
+                                                              output_signature(&options),
+                                                              options.resume);
+
+        if (CHECKPOINT_SUCCESS != checkpoint_error.code)
+        {
+            fprintf(stderr, RED "Error: %s: %s\n" CLR, checkpoint_error.message,
+                    options.checkpoint_path);
+            status = EXIT_FAILURE;
+            goto exit_function;
+        }
+        output_set_checkpoint(stdout, &checkpoint);
+    }
+
+    /* Route buffered table output through the asynchronous writer */
+    if (options.async)
+    {
+        bool opened;
+
+        /* --no-splice keeps the automatic choice away from vmsplice */
+        if (options.no_splice && ASYNC_BACKEND_AUTO == options.async_backend)
+        {
+            opened = open_async_writer(&writer, &options, ASYNC_BACKEND_URING) ||
+                     open_async_writer(&writer, &options, ASYNC_BACKEND_THREAD);
+        }
+        else
+        {
+            opened = open_async_writer(&writer, &options, options.async_backend);
+        }
+
+        if (!opened)
+        {
+            fprintf(stderr, RED "Error: Cannot start the %s asynchronous writer\n" CLR,
+                    async_backend_name(options.async_backend));
+            status = EXIT_FAILURE;
+            goto exit_function;
+        }
+        output_set_async_writer(stdout, &writer);
+    }
+    /* Hand pages to a pipe instead of copying them; plain writes if that fails */
+    else if (!options.no_splice && !options.browse &&
+             0 == fstat(fileno(stdout), &stdout_info) && S_ISFIFO(stdout_info.st_mode))
+    {
+        options.async = open_async_writer(&writer, &options, ASYNC_BACKEND_SPLICE);
+        if (options.async)
+        {
+            output_set_async_writer(stdout, &writer);
+        }
+    }
+
+    if (options.stats)
+    {
+        memset(&pipeline_stats, 0, sizeof(pipeline_stats));
+        pipeline_set_stats(&pipeline_stats);
+    }
+
+    outputs_open = open_outputs(&options);
+
+    /* Display requested tables in a fixed order (only the first when browsing) */
+    if (!outputs_open)
+    {
+        status = EXIT_FAILURE;
+    }
+    else if (options.jobs > 1)
+    {
+        if (!show_tables_parallel(&options, &scheduler_stats))
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < TABLE_ORDER_COUNT; i++)
+        {
+            /* Tables before the checkpointed one are complete in the output */
+            if (NULL != options.checkpoint_path && i < checkpoint.resume_table)
+            {
+                continue;
+            }
+
+            if (options.tables & TABLE_ORDER[i])
+            {
+                if (NULL != options.checkpoint_path)
+                {
+                    checkpoint.table = (uint32_t)i;
+                }
+
+                if (!show_table(&options, TABLE_ORDER[i]))
+                {
+                    status = EXIT_FAILURE;
+                    break;
+                }
+
+                if (NULL != options.checkpoint_path)
+                {
+                    checkpoint.table = (uint32_t)(i + 1);
+                    if (!output_checkpoint(stdout, CHECKPOINT_TABLE_START))
+                    {
+                        fprintf(stderr, RED "Error: Cannot write checkpoint: %s\n" CLR,
+                                options.checkpoint_path);
+                        status = EXIT_FAILURE;
+                        break;
+                    }
+                }
+
+                if (options.browse)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (outputs_open && !close_outputs(&options, options.output_count))
+    {
+        status = EXIT_FAILURE;
+    }
+
+    if (options.async)
+    {
+        output_set_async_writer(stdout, NULL);
+        fflush(stdout);
+
+        if (!async_writer_close(&writer))
+        {
+            fprintf(stderr, RED "Error: Asynchronous write failed\n" CLR);
+            status = EXIT_FAILURE;
+        }
+
+        if (options.async_stats)
+        {
+            print_async_stats(&writer);
+        }
+    }
+
+    if (NULL != options.checkpoint_path)
+    {
+        output_set_checkpoint(stdout, NULL);
+        checkpoint_close(&checkpoint);
+    }
+
+    if (options.stats)
+    {
+        pipeline_set_stats(NULL);
+
+        /* Parallel rendering bypasses the pipeline */
+        if (options.jobs > 1)
+        {
+            fprintf(stderr, "Scheduler: %llu tasks on %d workers, %llu stolen\n",
+                    (unsigned long long)scheduler_stats.executed, options.jobs,
+                    (unsigned long long)scheduler_stats.stolen);
+        }
+        else
+        {
+            print_pipeline_stats(&pipeline_stats);
+        }
     }
 
-    if (options.tables & TABLE_FLAG_POWER)
+exit_function:
+    if (!trace_close())
     {
-        print_table(options.min_value, options.max_value, power,
-                   POWER_TABLE_TITLE, options.format);
+        fprintf(stderr, RED "Error: Cannot write trace: %s\n" CLR, options.trace_path);
+        status = EXIT_FAILURE;
     }
 
-    return EXIT_SUCCESS;
+    return status;
 }
\ No newline at end of file
@@ -3,10 +3,12 @@
  * @brief Implementation of table cell operations
  *
  * Contains implementations of the various operations that can be
- * performed on table cells (multiplication, division, power).
+ * performed on table cells (multiplication, division, power) and the row
+ * kernels of the modular, GCD, LCM and remainder tables.
  */
 
 #include <string.h>
+#include <limits.h>
 #include <math.h>
 #include "timestable_operations.h"
 
@@ -15,6 +17,11 @@
  */
 #define UNDEF_STRING "UDF"
 
+/**
+ * @brief String constant for a value too large for the table
+ */
+#define OVERFLOW_STRING "OVF"
+
 /**
  * @brief Multiplication operation (row × column)
  *
@@ -67,4 +74,860 @@ power(int row, int column, cell_value_t *result)
     result->is_numeric      = true;
     result->num_value       = (int)pow(row, column);
     result->str_value[0]    = '\0';
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Check whether a table operation is commutative
+ *
+ * @param operation Operation to check
+ * @return bool true if operation(r, c) == operation(c, r) for all cells
+ */
+bool
+operation_is_symmetric(TableOperation operation)
+{
+    return multiply == operation;
+}
+
+/**
+ * @brief Marker text of a row operation value
+ *
+ * @param operation Row operation that produced the value
+ * @param value Cell value
+ * @return const char* "UDF" or "OVF" for a marker value, otherwise NULL
+ */
+const char *
+row_value_marker(const row_operation_t *operation, uint64_t value)
+{
+    if (!operation->has_markers)
+    {
+        return NULL;
+    }
+
+    switch (value)
+    {
+        case ROW_VALUE_UNDEFINED:
+            return UNDEF_STRING;
+
+        case ROW_VALUE_OVERFLOW:
+            return OVERFLOW_STRING;
+
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Stored power value marking a result too large for an int
+ */
+#define GEN_POWER_OVERFLOW ((uint64_t)INT_MAX + 1)
+
+/**
+ * @brief Multiply a power by the base, saturating at GEN_POWER_OVERFLOW
+ *
+ * @param value Current power (at most GEN_POWER_OVERFLOW)
+ * @param base Base of the power (at most INT_MAX)
+ * @return uint64_t The next power, or GEN_POWER_OVERFLOW if it exceeds INT_MAX
+ */
+static uint64_t
+gen_power_step(uint64_t value, uint64_t base)
+{
+    value *= base; /* Below 2^62, cannot wrap */
+    return (value > INT_MAX) ? GEN_POWER_OVERFLOW : value;
+}
+
+/**
+ * @brief Start generating a row of an operation
+ *
+ * @param generator Generator to initialize
+ * @param operation Operation whose row is generated
+ * @param row Row value
+ * @param col_begin First column value (at least 0)
+ * @return bool true if the operation has an incremental form, false if the
+ *         caller must call the operation for each cell
+ */
+bool
+gen_init(table_generator_t *generator, TableOperation operation, int row, int col_begin)
+{
+    generator->operation = operation;
+
+    if (multiply == operation)
+    {
+        /* Unsigned arithmetic wraps like the int product in multiply() */
+        generator->step  = (uint64_t)(int64_t)row;
+        generator->value = generator->step * (uint64_t)(int64_t)col_begin;
+        return true;
+    }
+
+    if (power == operation && row >= 0 && col_begin >= 0)
+    {
+        generator->step  = (uint64_t)row;
+        generator->value = 1;
+
+        for (int exponent = 0; exponent < col_begin; exponent++)
+        {
+            generator->value = gen_power_step(generator->value, generator->step);
+            if (generator->value <= 1 || GEN_POWER_OVERFLOW == generator->value)
+            {
+                break; /* 0, 1 and overflow are fixed points */
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Produce the next cell of a generated row
+ *
+ * @param generator Generator started with gen_init()
+ * @return int Value of the cell, after which the column advances by one
+ */
+int
+gen_next(table_generator_t *generator)
+{
+    uint64_t value = generator->value;
+
+    if (multiply == generator->operation)
+    {
+        generator->value = value + generator->step;
+        return (int)(uint32_t)value;
+    }
+
+    generator->value = gen_power_step(value, generator->step);
+    return (GEN_POWER_OVERFLOW == value) ? INT_MIN : (int)value;
+}
+
+/**
+ * @brief Produce the next count cells of a generated row
+ *
+ * @param generator Generator started with gen_init()
+ * @param count Number of cells to produce
+ * @param values Array of count entries to store the values in
+ */
+void
+gen_fill(table_generator_t *generator, int count, int *values)
+{
+    int i = 0;
+
+    if (multiply == generator->operation && count >= GEN_LANES)
+    {
+        uint32_t lanes[GEN_LANES];
+        uint32_t stride = (uint32_t)generator->step * GEN_LANES;
+
+        for (int lane = 0; lane < GEN_LANES; lane++)
+        {
+            lanes[lane] = (uint32_t)generator->value + (uint32_t)generator->step * (uint32_t)lane;
+        }
+
+        for (; i + GEN_LANES <= count; i += GEN_LANES)
+        {
+            for (int lane = 0; lane < GEN_LANES; lane++)
+            {
+                values[i + lane] = (int)lanes[lane];
+                lanes[lane] += stride;
+            }
+        }
+
+        generator->value = lanes[0];
+    }
+
+    for (; i < count; i++)
+    {
+        values[i] = gen_next(generator);
+    }
+}
+
+/**
+ * @brief Choose the lane width of a table from the exact bounds of its cells
+ *
+ * @param operation Operation of the table
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return value_width_t Narrowest width whose all-ones value exceeds every
+ *         cell, or VALUE_WIDTH_NONE if there is none
+ */
+value_width_t
+table_value_width(TableOperation operation, int min_value, int max_value)
+{
+    uint64_t largest = 0;
+
+    if (min_value < 0 || max_value < min_value)
+    {
+        return VALUE_WIDTH_NONE;
+    }
+
+    if (multiply == operation)
+    {
+        largest = (uint64_t)max_value * (uint64_t)max_value;
+    }
+    else if (divide == operation)
+    {
+        largest = (uint64_t)max_value;
+    }
+    else if (power == operation)
+    {
+        /* max^max is the largest cell, and 0^0 = 1 */
+        largest = 1;
+        for (int exponent = 0; exponent < max_value && largest <= INT_MAX; exponent++)
+        {
+            largest *= (uint64_t)max_value;
+        }
+    }
+    else
+    {
+        return VALUE_WIDTH_NONE;
+    }
+
+    if (largest < UINT8_MAX)
+    {
+        return VALUE_WIDTH_8;
+    }
+    if (largest < UINT16_MAX)
+    {
+        return VALUE_WIDTH_16;
+    }
+    if (largest <= INT_MAX)
+    {
+        return VALUE_WIDTH_32;
+    }
+
+    return VALUE_WIDTH_NONE;
+}
+
+/**
+ * @brief Define the lane kernel of one width for table_fill_lanes()
+ *
+ * Every cell fits the lane type (see table_value_width()), so the power
+ * recurrence is exact; its product after the last stored cell may wrap,
+ * which unsigned arithmetic allows.
+ */
+#define TABLE_FILL_LANES(name, type)                                        \
+    static void                                                             \
+    name(TableOperation operation, int row, int column, int count,          \
+         type *lanes)                                                       \
+    {                                                                       \
+        if (multiply == operation)                                          \
+        {                                                                   \
+            for (int i = 0; i < count; i++)                                 \
+            {                                                               \
+                lanes[i] = (type)((uint32_t)row * (uint32_t)(column + i));  \
+            }                                                               \
+        }                                                                   \
+        else if (divide == operation)                                       \
+        {                                                                   \
+            for (int i = 0; i < count; i++)                                 \
+            {                                                               \
+                lanes[i] = (0 == column + i) ? LANE_UNDEFINED(type)         \
+                                             : (type)(row / (column + i));  \
+            }                                                               \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+            uint32_t value = 1;                                             \
+                                                                            \
+            for (int exponent = 0; exponent < column; exponent++)           \
+            {                                                               \
+                value *= (uint32_t)row;                                     \
+            }                                                               \
+            for (int i = 0; i < count; i++)                                 \
+            {                                                               \
+                lanes[i] = (type)value;                                     \
+                value   *= (uint32_t)row;                                   \
+            }                                                               \
+        }                                                                   \
+    }
+
+TABLE_FILL_LANES(fill_lanes_8, uint8_t)
+TABLE_FILL_LANES(fill_lanes_16, uint16_t)
+TABLE_FILL_LANES(fill_lanes_32, uint32_t)
+
+/**
+ * @brief Compute a run of cells from one row into lanes of a given width
+ *
+ * @param operation Operation of the table
+ * @param width Width from table_value_width() for the table
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param lanes Array of count lanes of the width to store the values in
+ */
+void
+table_fill_lanes(TableOperation operation, value_width_t width,
+                 int row, int column, int count, void *lanes)
+{
+    switch (width)
+    {
+        case VALUE_WIDTH_8:
+            fill_lanes_8(operation, row, column, count, lanes);
+            break;
+
+        case VALUE_WIDTH_16:
+            fill_lanes_16(operation, row, column, count, lanes);
+            break;
+
+        case VALUE_WIDTH_32:
+            fill_lanes_32(operation, row, column, count, lanes);
+            break;
+
+        case VALUE_WIDTH_NONE:
+            break;
+    }
+}
+
+/**
+ * @brief Multiplication kernel on 64-bit values
+ *
+ * @param context Ignored
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+static void
+multiply_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    (void)context;
+
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = (uint64_t)row * (uint64_t)(column + i);
+    }
+}
+
+/**
+ * @brief Division kernel on 64-bit values, with ROW_VALUE_UNDEFINED for column 0
+ *
+ * @param context Ignored
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+static void
+divide_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    (void)context;
+
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = (0 == column + i) ? ROW_VALUE_UNDEFINED
+                                      : (uint64_t)row / (uint64_t)(column + i);
+    }
+}
+
+/**
+ * @brief Multiply two powers, saturating at ROW_VALUE_OVERFLOW
+ *
+ * @param a First factor (at most ROW_VALUE_OVERFLOW)
+ * @param b Second factor (at most ROW_VALUE_OVERFLOW)
+ * @return uint64_t a × b, or ROW_VALUE_OVERFLOW if it is that large
+ */
+static inline uint64_t
+power_multiply(uint64_t a, uint64_t b)
+{
+    uint64_t product;
+
+    if (0 == a || 0 == b)
+    {
+        return 0;
+    }
+
+    if (ROW_VALUE_OVERFLOW == a || ROW_VALUE_OVERFLOW == b ||
+        __builtin_mul_overflow(a, b, &product) || product >= ROW_VALUE_OVERFLOW)
+    {
+        return ROW_VALUE_OVERFLOW;
+    }
+
+    return product;
+}
+
+/**
+ * @brief Power kernel on 64-bit values, with ROW_VALUE_OVERFLOW past 2^64 - 3
+ *
+ * @param context Ignored
+ * @param row Row value (base)
+ * @param column First column value (exponent)
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+static void
+power_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    uint64_t value  = 1;
+    uint64_t square = (uint64_t)row;
+
+    (void)context;
+
+    /* row^column by squaring, then one multiply per column */
+    for (unsigned exponent = (unsigned)column; 0 != exponent; exponent >>= 1)
+    {
+        if (exponent & 1)
+        {
+            value = power_multiply(value, square);
+        }
+        square = power_multiply(square, square);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = value;
+        value     = power_multiply(value, (uint64_t)row);
+    }
+}
+
+/**
+ * @brief Largest value of the 64-bit multiplication table
+ *
+ * @param context Ignored
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t max_value²
+ */
+static uint64_t
+multiply_row_bound(const void *context, int min_value, int max_value)
+{
+    (void)context;
+    (void)min_value;
+    return (uint64_t)max_value * (uint64_t)max_value;
+}
+
+/**
+ * @brief Largest value of the 64-bit division table
+ *
+ * @param context Ignored
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t max_value
+ */
+static uint64_t
+divide_row_bound(const void *context, int min_value, int max_value)
+{
+    (void)context;
+    (void)min_value;
+    return (uint64_t)max_value;
+}
+
+/**
+ * @brief Largest value of the 64-bit power table
+ *
+ * @param context Ignored
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t max_value^max_value, or ROW_VALUE_OVERFLOW
+ */
+static uint64_t
+power_row_bound(const void *context, int min_value, int max_value)
+{
+    uint64_t largest;
+
+    (void)min_value;
+    power_row(context, max_value, max_value, 1, &largest);
+    return (largest > 1) ? largest : 1; /* 0^0 = 1 */
+}
+
+/**
+ * @brief Describe a per-cell operation as a row operation on 64-bit values
+ *
+ * @param operation multiply, divide or power
+ * @param row_operation Filled with the kernel, bound and attributes
+ * @return bool true on success, false if operation has no 64-bit kernel
+ */
+bool
+table_row_operation(TableOperation operation, row_operation_t *row_operation)
+{
+    row_operation->context      = NULL;
+    row_operation->is_signed    = false;
+    row_operation->is_symmetric = operation_is_symmetric(operation);
+    row_operation->has_markers  = true;
+
+    if (multiply == operation)
+    {
+        row_operation->kernel      = multiply_row;
+        row_operation->value_bound = multiply_row_bound;
+    }
+    else if (divide == operation)
+    {
+        row_operation->kernel      = divide_row;
+        row_operation->value_bound = divide_row_bound;
+    }
+    else if (power == operation)
+    {
+        row_operation->kernel      = power_row;
+        row_operation->value_bound = power_row_bound;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Unsigned 128-bit integer used for modular products
+ */
+__extension__ typedef unsigned __int128 uint128_t;
+
+/**
+ * @brief Add two residues modulo m without overflowing 64 bits
+ *
+ * @param a First residue (< m)
+ * @param b Second residue (< m)
+ * @param m Modulus
+ * @return uint64_t (a + b) mod m
+ */
+static inline uint64_t
+mod_add(uint64_t a, uint64_t b, uint64_t m)
+{
+    return (a >= m - b) ? a - (m - b) : a + b;
+}
+
+/**
+ * @brief Precompute the Shoup constant for multiplying by a fixed residue
+ *
+ * @param factor Fixed multiplier (< m)
+ * @param m Modulus
+ * @return uint64_t floor(factor * 2^64 / m)
+ */
+static inline uint64_t
+mod_shoup_constant(uint64_t factor, uint64_t m)
+{
+    return (uint64_t)(((uint128_t)factor << 64) / m);
+}
+
+/**
+ * @brief Multiply a residue by a fixed factor using its Shoup constant
+ *
+ * The quotient estimate is at most one short, so the remainder lands in
+ * [0, 2m) and a single conditional subtraction finishes the reduction.
+ *
+ * @param value Residue to multiply (< m)
+ * @param factor Fixed multiplier (< m)
+ * @param shoup Constant from mod_shoup_constant()
+ * @param m Modulus
+ * @return uint64_t (value * factor) mod m
+ */
+static inline uint64_t
+mod_mul_shoup(uint64_t value, uint64_t factor, uint64_t shoup, uint64_t m)
+{
+    uint64_t  quotient  = (uint64_t)(((uint128_t)value * shoup) >> 64);
+    uint128_t remainder = (uint128_t)value * factor - (uint128_t)quotient * m;
+
+    return (uint64_t)((remainder >= m) ? remainder - m : remainder);
+}
+
+/**
+ * @brief Modular multiplication kernel ((row × column) mod m)
+ *
+ * @param context Pointer to a modulus_t
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void
+mod_multiply_row(const void *context, int row, int column,
+                 int count, uint64_t *values)
+{
+    uint64_t m     = ((const modulus_t *)context)->modulus;
+    uint64_t step  = (uint64_t)row % m;
+    uint64_t value = (uint64_t)(((uint128_t)(uint64_t)row * (uint64_t)column) % m);
+
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = value;
+        value     = mod_add(value, step, m);
+    }
+}
+
+/**
+ * @brief Modular power kernel ((row ^ column) mod m)
+ *
+ * @param context Pointer to a modulus_t
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void
+mod_power_row(const void *context, int row, int column,
+              int count, uint64_t *values)
+{
+    uint64_t m      = ((const modulus_t *)context)->modulus;
+    uint64_t factor = (uint64_t)row % m;
+    uint64_t shoup  = mod_shoup_constant(factor, m);
+    uint64_t value  = 1 % m;
+
+    /* Bring the running product up to row^column */
+    for (int exponent = 0; exponent < column; exponent++)
+    {
+        value = mod_mul_shoup(value, factor, shoup, m);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = value;
+        value     = mod_mul_shoup(value, factor, shoup, m);
+    }
+}
+
+/**
+ * @brief Largest value of the modular multiplication table
+ *
+ * @param context Pointer to a modulus_t
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t The smaller of m - 1 and max_value²
+ */
+uint64_t
+mod_multiply_bound(const void *context, int min_value, int max_value)
+{
+    uint64_t m       = ((const modulus_t *)context)->modulus;
+    uint64_t product = (uint64_t)max_value * (uint64_t)max_value;
+
+    (void)min_value;
+    return (product < m - 1) ? product : m - 1;
+}
+
+/**
+ * @brief Largest value of the modular power table
+ *
+ * @param context Pointer to a modulus_t
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t m - 1
+ */
+uint64_t
+mod_power_bound(const void *context, int min_value, int max_value)
+{
+    (void)min_value;
+    (void)max_value;
+    return ((const modulus_t *)context)->modulus - 1;
+}
+
+/**
+ * @brief Fill a GCD tile
+ *
+ * @param tile Tile to fill
+ */
+void
+gcd_tile_init(gcd_tile_t *tile)
+{
+    /* Row c of the lower triangle is complete before row r > c needs it */
+    for (int r = 0; r < GCD_TILE_SIDE; r++)
+    {
+        for (int c = 0; c <= r; c++)
+        {
+            tile->gcd[r][c] = (0 == c) ? (uint8_t)r : tile->gcd[c][r % c];
+            tile->gcd[c][r] = tile->gcd[r][c];
+        }
+    }
+}
+
+/**
+ * @brief Binary GCD of an odd value and a nonzero value
+ *
+ * @param odd Odd value
+ * @param value Nonzero value
+ * @return uint64_t gcd(odd, value)
+ */
+static inline uint64_t
+binary_gcd_odd(uint64_t odd, uint64_t value)
+{
+    value >>= __builtin_ctzll(value);
+
+    while (odd != value)
+    {
+        if (odd > value)
+        {
+            uint64_t swap = odd;
+
+            odd   = value;
+            value = swap;
+        }
+        value -= odd;
+        value >>= __builtin_ctzll(value);
+    }
+
+    return odd;
+}
+
+/**
+ * @brief GCD kernel (gcd(row, column), with gcd(0, 0) = 0)
+ *
+ * @param context Pointer to a gcd_tile_t, or NULL
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void
+gcd_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    const gcd_tile_t *tile = context;
+    uint64_t value         = (uint64_t)row;
+    int shift              = (0 == value) ? 0 : __builtin_ctzll(value);
+    uint64_t odd           = value >> shift;
+    int i                  = 0;
+
+    if (NULL != tile && row < GCD_TILE_SIDE)
+    {
+        for (; i < count && column + i < GCD_TILE_SIDE; i++)
+        {
+            values[i] = tile->gcd[row][column + i];
+        }
+    }
+
+    for (; i < count; i++)
+    {
+        uint64_t other = (uint64_t)(column + i);
+        int other_shift;
+
+        if (0 == value || 0 == other)
+        {
+            values[i] = value | other;
+            continue;
+        }
+
+        other_shift = __builtin_ctzll(other);
+        values[i]   = binary_gcd_odd(odd, other) << ((shift < other_shift) ? shift : other_shift);
+    }
+}
+
+/**
+ * @brief LCM kernel (lcm(row, column), with lcm(0, c) = 0)
+ *
+ * @param context Pointer to a gcd_tile_t, or NULL
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void
+lcm_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    uint64_t value = (uint64_t)row;
+
+    gcd_row(context, row, column, count, values);
+
+    for (int i = 0; i < count; i++)
+    {
+        uint64_t other = (uint64_t)(column + i);
+        uint64_t product;
+
+        if (0 == value || 0 == other)
+        {
+            values[i] = 0;
+        }
+        else if (__builtin_mul_overflow(value / values[i], other, &product) ||
+                 product >= ROW_VALUE_OVERFLOW)
+        {
+            values[i] = ROW_VALUE_OVERFLOW;
+        }
+        else
+        {
+            values[i] = product;
+        }
+    }
+}
+
+/**
+ * @brief Precompute the reciprocals of the remainder table columns
+ *
+ * @param divisors Reciprocals to fill
+ */
+void
+remainder_divisors_init(remainder_divisors_t *divisors)
+{
+    divisors->reciprocal[0] = 0;
+    for (uint64_t c = 1; c < REMAINDER_COLUMNS; c++)
+    {
+        divisors->reciprocal[c] = UINT64_MAX / c + 1;
+    }
+}
+
+/**
+ * @brief Remainder kernel (row mod column; column 0 is ROW_VALUE_UNDEFINED)
+ *
+ * @param context Pointer to a remainder_divisors_t
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+void
+remainder_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    const remainder_divisors_t *divisors = context;
+    uint64_t value                       = (uint32_t)row;
+
+    for (int i = 0; i < count; i++)
+    {
+        uint64_t other = (uint64_t)(column + i);
+
+        if (0 == other)
+        {
+            values[i] = ROW_VALUE_UNDEFINED;
+        }
+        else if (other < REMAINDER_COLUMNS)
+        {
+            /* The low bits of value / other, scaled back up by other */
+            uint64_t fraction = divisors->reciprocal[other] * value;
+
+            values[i] = (uint64_t)(((uint128_t)fraction * other) >> 64);
+        }
+        else
+        {
+            values[i] = value % other;
+        }
+    }
+}
+
+/**
+ * @brief Largest value of the GCD table
+ *
+ * @param context Ignored
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t max_value
+ */
+uint64_t
+gcd_bound(const void *context, int min_value, int max_value)
+{
+    (void)context;
+    (void)min_value;
+    return (uint64_t)max_value;
+}
+
+/**
+ * @brief Largest value of the LCM table
+ *
+ * @param context Ignored
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t max_value²
+ */
+uint64_t
+lcm_bound(const void *context, int min_value, int max_value)
+{
+    (void)context;
+    (void)min_value;
+    return (uint64_t)max_value * (uint64_t)max_value;
+}
+
+/**
+ * @brief Largest value of the remainder table
+ *
+ * @param context Ignored
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t max_value
+ */
+uint64_t
+remainder_bound(const void *context, int min_value, int max_value)
+{
+    (void)context;
+    (void)min_value;
+    return (uint64_t)max_value;
+}
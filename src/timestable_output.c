@@ -0,0 +1,391 @@
+/**
+ * @file timestable_output.c
+ * @brief Implementation of buffered table output
+ *
+ * Functions for collecting rendered bytes and writing them in bulk.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "timestable_output.h"
+#include "timestable_trace.h"
+
+static FILE *async_stream          = NULL;
+static async_writer_t *async_route = NULL;
+
+static FILE *checkpoint_stream        = NULL;
+static checkpoint_t *checkpoint_route = NULL;
+
+static FILE *band_stream = NULL;
+static int band_first    = 0;
+static int band_last     = 0;
+
+/**
+ * @brief Route output buffers on a stream through an asynchronous writer
+ *
+ * @param stream  Stream whose buffers use the writer
+ * @param writer  Writer opened on the stream's file descriptor, or NULL to
+ *                go back to synchronous writes
+ */
+void
+output_set_async_writer(FILE *stream, async_writer_t *writer)
+{
+    async_stream = stream;
+    async_route  = writer;
+}
+
+/**
+ * @brief Record checkpoints at row boundaries of output on a stream
+ *
+ * @param stream      Stream the checkpoint positions refer to
+ * @param checkpoint  Open checkpoint, or NULL to stop checkpointing
+ */
+void
+output_set_checkpoint(FILE *stream, checkpoint_t *checkpoint)
+{
+    checkpoint_stream = stream;
+    checkpoint_route  = checkpoint;
+}
+
+/**
+ * @brief Render only a band of rows of the tables written to a stream
+ *
+ * @param stream     Stream whose tables are limited, or NULL for all rows
+ * @param first_row  First row of the band
+ * @param last_row   Last row of the band (first_row - 1 or less if empty)
+ */
+void
+output_set_row_band(FILE *stream, int first_row, int last_row)
+{
+    band_stream = stream;
+    band_first  = first_row;
+    band_last   = last_row;
+}
+
+/**
+ * @brief Find which of a table's rows to render
+ *
+ * @param stream     Stream the table is written to
+ * @param first_row  First row of the table; replaced by the first row to
+ *                   render
+ * @param last_row   Last row of the table; replaced by the last row to
+ *                   render
+ * @return           bool true if the title and header must be written,
+ *                   false if they are already in the output or belong to
+ *                   another band
+ */
+bool
+output_begin_rows(FILE *stream, int *first_row, int *last_row)
+{
+    if (NULL != band_stream && stream == band_stream)
+    {
+        bool first_band = band_first <= *first_row;
+
+        if (band_first > *first_row)
+            *first_row = band_first;
+        if (band_last < *last_row)
+            *last_row = band_last;
+
+        if (!first_band)
+        {
+            return false;
+        }
+    }
+
+    /* The resume position stays pending until the next checkpoint, so a
+       renderer falling back to another one gets the same answer */
+    if (NULL == checkpoint_route || stream != checkpoint_stream || !checkpoint_route->resuming ||
+        checkpoint_route->table != checkpoint_route->resume_table ||
+        CHECKPOINT_TABLE_START == checkpoint_route->resume_row)
+    {
+        return true;
+    }
+
+    *first_row = checkpoint_route->resume_row;
+    return false;
+}
+
+/**
+ * @brief Record a checkpoint at the current end of a stream's output
+ *
+ * @param stream    Stream to checkpoint
+ * @param next_row  First row of the current table not yet written, or
+ *                  CHECKPOINT_TABLE_START
+ * @return          bool true on success, false on a write error
+ */
+bool
+output_checkpoint(FILE *stream, int next_row)
+{
+    off_t offset;
+
+    if (NULL == checkpoint_route || stream != checkpoint_stream)
+    {
+        return true;
+    }
+
+    if (0 != fflush(stream) ||
+        (stream == async_stream && NULL != async_route && !async_writer_drain(async_route)))
+    {
+        return false;
+    }
+
+    offset                     = lseek(fileno(stream), 0, SEEK_CUR);
+    checkpoint_route->resuming = false;
+    return offset >= 0 &&
+           CHECKPOINT_SUCCESS == checkpoint_commit(checkpoint_route, checkpoint_route->table,
+                                                   next_row, offset).code;
+}
+
+/**
+ * @brief Submit bytes to the asynchronous writer and take a fresh buffer
+ *
+ * @param buffer  Buffer whose bytes to submit
+ * @param pending Number of bytes to submit
+ * @return        bool true on success, false on a write error
+ */
+static bool
+output_buffer_submit(output_buffer_t *buffer, size_t pending)
+{
+    /* Anything printed with stdio so far must reach the file first */
+    if (0 != fflush(buffer->stream) ||
+        !async_writer_submit(buffer->async, buffer->data, pending))
+    {
+        buffer->data     = NULL;
+        buffer->capacity = 0;
+        return false;
+    }
+
+    buffer->data = async_writer_acquire(buffer->async);
+    if (NULL == buffer->data)
+    {
+        buffer->capacity = 0;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Hand the buffered bytes on without waiting for them to be written
+ *
+ * @param buffer Buffer to spill
+ * @return       bool true on success, false on a write error
+ */
+static bool
+output_buffer_spill(output_buffer_t *buffer)
+{
+    size_t pending = buffer->length;
+    uint64_t span;
+    bool success;
+
+    if (0 == pending)
+    {
+        return true;
+    }
+
+    buffer->length = 0;
+    span           = trace_begin();
+    TRACE_PROBE1(output_flush_begin, pending);
+
+    success = (NULL == buffer->async)
+            ? fwrite(buffer->data, 1, pending, buffer->stream) == pending
+            : output_buffer_submit(buffer, pending);
+
+    TRACE_PROBE1(output_flush_end, pending);
+    trace_end("output_flush", span, (int64_t)pending);
+    return success;
+}
+
+/**
+ * @brief Initialize an output buffer
+ *
+ * @param buffer    Buffer to initialize
+ * @param stream    Stream to flush the buffered bytes to
+ * @param capacity  Number of bytes to buffer before flushing
+ * @return          bool true on success, false if allocation failed
+ */
+bool
+output_buffer_init(output_buffer_t *buffer, FILE *stream, size_t capacity)
+{
+    buffer->length = 0;
+    buffer->stream = stream;
+    buffer->async  = (stream == async_stream) ? async_route : NULL;
+
+    if (NULL != buffer->async)
+    {
+        buffer->data     = async_writer_acquire(buffer->async);
+        buffer->capacity = buffer->async->buffer_size;
+    }
+    else
+    {
+        buffer->data     = malloc(capacity);
+        buffer->capacity = capacity;
+    }
+
+    return NULL != buffer->data;
+}
+
+/**
+ * @brief Flush and release an output buffer
+ *
+ * @param buffer Buffer to release
+ */
+void
+output_buffer_free(output_buffer_t *buffer)
+{
+    output_buffer_flush(buffer);
+
+    if (NULL != buffer->async && NULL != buffer->data)
+    {
+        async_writer_release(buffer->async, buffer->data);
+    }
+    else
+    {
+        free(buffer->data);
+    }
+
+    buffer->data     = NULL;
+    buffer->length   = 0;
+    buffer->capacity = 0;
+}
+
+/**
+ * @brief Write all buffered bytes to the stream
+ *
+ * @param buffer Buffer to flush
+ * @return       bool true on success, false on a write error
+ */
+bool
+output_buffer_flush(output_buffer_t *buffer)
+{
+    bool success = output_buffer_spill(buffer);
+
+    if (NULL != buffer->async)
+    {
+        success = async_writer_drain(buffer->async) && success;
+    }
+
+    return success;
+}
+
+/**
+ * @brief Append bytes to the buffer, flushing as needed
+ *
+ * Blocks larger than the whole buffer bypass it and are written directly,
+ * unless the buffer belongs to an asynchronous writer.
+ *
+ * @param buffer  Buffer to append to
+ * @param data    Bytes to append
+ * @param length  Number of bytes to append
+ * @return        bool true on success, false on a write error
+ */
+bool
+output_buffer_append(output_buffer_t *buffer, const char *data, size_t length)
+{
+    /* A failed asynchronous writer leaves no buffer to render into */
+    if (NULL == buffer->data)
+    {
+        return false;
+    }
+
+    if (length > buffer->capacity - buffer->length)
+    {
+        if (NULL != buffer->async)
+        {
+            while (length > buffer->capacity - buffer->length)
+            {
+                size_t chunk = buffer->capacity - buffer->length;
+
+                memcpy(buffer->data + buffer->length, data, chunk);
+                buffer->length += chunk;
+                data           += chunk;
+                length         -= chunk;
+
+                if (!output_buffer_spill(buffer))
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            if (!output_buffer_spill(buffer))
+            {
+                return false;
+            }
+
+            if (length > buffer->capacity)
+            {
+                return fwrite(data, 1, length, buffer->stream) == length;
+            }
+        }
+    }
+
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+
+    return true;
+}
+
+/**
+ * @brief Append a run of identical bytes, flushing as needed
+ *
+ * @param buffer  Buffer to append to
+ * @param fill    Byte to repeat
+ * @param count   Number of bytes to append
+ * @return        bool true on success, false on a write error
+ */
+bool
+output_buffer_fill(output_buffer_t *buffer, char fill, size_t count)
+{
+    if (NULL == buffer->data)
+    {
+        return false;
+    }
+
+    while (count > 0)
+    {
+        size_t chunk = buffer->capacity - buffer->length;
+
+        if (0 == chunk)
+        {
+            if (!output_buffer_spill(buffer))
+            {
+                return false;
+            }
+            chunk = buffer->capacity;
+        }
+
+        if (chunk > count)
+        {
+            chunk = count;
+        }
+
+        memset(buffer->data + buffer->length, fill, chunk);
+        buffer->length += chunk;
+        count          -= chunk;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Mark the end of a table row, checkpointing when one is due
+ *
+ * @param buffer  Buffer the row was appended to
+ * @param row     Row that was just completed
+ * @return        bool true on success, false on a write error
+ */
+bool
+output_buffer_end_row(output_buffer_t *buffer, int row)
+{
+    if (NULL == checkpoint_route || buffer->stream != checkpoint_stream ||
+        !checkpoint_due(checkpoint_route))
+    {
+        return true;
+    }
+
+    return output_buffer_flush(buffer) && output_checkpoint(buffer->stream, row + 1);
+}
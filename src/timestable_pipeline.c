@@ -0,0 +1,282 @@
+/**
+ * @file timestable_pipeline.c
+ * @brief Implementation of the single-producer/single-consumer rings
+ *
+ * Indices and flags are shared through GCC atomic builtins: a slot's
+ * contents are published by a release store of tail and taken over by an
+ * acquire load, and likewise for head in the other direction.
+ */
+
+#include <stdlib.h>                 // malloc(), free()
+#include <sched.h>                  // sched_yield()
+#include <time.h>                   // clock_gettime(), CLOCK_MONOTONIC
+
+#include "timestable_pipeline.h"    // spsc_ring_t, pipeline_stats_t
+
+/**
+ * @brief Polls of the other index before yielding the processor
+ */
+#define SPIN_LIMIT 64
+
+static const char *const STAGE_NAMES[PIPELINE_STAGE_COUNT] = {
+    "compute",
+    "format",
+    "write"
+};
+
+/**
+ * @brief Statistics being collected, or NULL
+ */
+static pipeline_stats_t *collected_stats = NULL;
+
+/**
+ * @brief Read the monotonic clock
+ *
+ * @return uint64_t Nanoseconds since an arbitrary point
+ */
+static uint64_t
+now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Back off while waiting for the other side of a ring
+ *
+ * @param spins   Number of polls so far in this wait
+ */
+static void
+back_off(unsigned spins)
+{
+    if (spins >= SPIN_LIMIT)
+    {
+        sched_yield();
+    }
+}
+
+/**
+ * @brief Initialize an empty ring
+ *
+ * @param ring        Ring to initialize
+ * @param slot_count  Number of slots (a power of two)
+ * @param slot_size   Size of each slot in bytes
+ * @return            bool true on success, false if allocation failed
+ */
+bool
+spsc_ring_init(spsc_ring_t *ring, size_t slot_count, size_t slot_size)
+{
+    ring->slots     = malloc(slot_count * slot_size);
+    ring->lengths   = malloc(slot_count * sizeof(*ring->lengths));
+    ring->slot_size = slot_size;
+    ring->mask      = slot_count - 1;
+    ring->closed    = false;
+    ring->aborted   = false;
+    ring->head      = 0;
+    ring->tail      = 0;
+
+    if (NULL == ring->slots || NULL == ring->lengths)
+    {
+        spsc_ring_free(ring);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Release a ring
+ *
+ * @param ring Ring to release
+ */
+void
+spsc_ring_free(spsc_ring_t *ring)
+{
+    free(ring->slots);
+    free(ring->lengths);
+    ring->slots   = NULL;
+    ring->lengths = NULL;
+}
+
+/**
+ * @brief Get the next free slot to fill (producer)
+ *
+ * @param ring     Ring to produce into
+ * @param wait_ns  Incremented by the time spent waiting for a free slot
+ * @return         void* Slot of slot_size bytes, or NULL if the consumer aborted
+ */
+void *
+spsc_ring_reserve(spsc_ring_t *ring, uint64_t *wait_ns)
+{
+    size_t tail    = ring->tail;
+    uint64_t start = 0;
+    unsigned spins = 0;
+
+    /* Full: wait for the consumer to hand a slot back */
+    while (tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) > ring->mask)
+    {
+        if (__atomic_load_n(&ring->aborted, __ATOMIC_ACQUIRE))
+        {
+            return NULL;
+        }
+
+        if (0 == spins)
+        {
+            start = now_ns();
+        }
+        back_off(spins++);
+    }
+
+    if (spins > 0)
+    {
+        *wait_ns += now_ns() - start;
+    }
+
+    return __atomic_load_n(&ring->aborted, __ATOMIC_ACQUIRE)
+           ? NULL : ring->slots + (tail & ring->mask) * ring->slot_size;
+}
+
+/**
+ * @brief Publish the slot returned by spsc_ring_reserve() (producer)
+ *
+ * @param ring    Ring to produce into
+ * @param length  Bytes used in the slot
+ */
+void
+spsc_ring_commit(spsc_ring_t *ring, size_t length)
+{
+    ring->lengths[ring->tail & ring->mask] = length;
+    __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Signal that no more slots will be produced (producer)
+ *
+ * @param ring Ring to close
+ */
+void
+spsc_ring_close(spsc_ring_t *ring)
+{
+    __atomic_store_n(&ring->closed, true, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Get the oldest published slot (consumer)
+ *
+ * @param ring     Ring to consume from
+ * @param length   Set to the bytes used in the slot
+ * @param wait_ns  Incremented by the time spent waiting for a slot
+ * @return         void* Slot, or NULL once the ring is closed and empty
+ */
+void *
+spsc_ring_front(spsc_ring_t *ring, size_t *length, uint64_t *wait_ns)
+{
+    size_t head    = ring->head;
+    uint64_t start = 0;
+    unsigned spins = 0;
+
+    /* Empty: wait for the producer, unless it has finished. closed is
+       read before tail so a final commit is never missed. */
+    for (;;)
+    {
+        bool closed = __atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE);
+
+        if (head != __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE))
+        {
+            break;
+        }
+
+        if (closed)
+        {
+            head = SIZE_MAX;
+            break;
+        }
+
+        if (0 == spins)
+        {
+            start = now_ns();
+        }
+        back_off(spins++);
+    }
+
+    if (spins > 0)
+    {
+        *wait_ns += now_ns() - start;
+    }
+
+    if (SIZE_MAX == head)
+    {
+        return NULL;
+    }
+
+    *length = ring->lengths[head & ring->mask];
+    return ring->slots + (head & ring->mask) * ring->slot_size;
+}
+
+/**
+ * @brief Hand the slot returned by spsc_ring_front() back (consumer)
+ *
+ * @param ring Ring to consume from
+ */
+void
+spsc_ring_pop(spsc_ring_t *ring)
+{
+    __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Stop consuming; later reserves fail so the producer exits (consumer)
+ *
+ * @param ring Ring to abort
+ */
+void
+spsc_ring_abort(spsc_ring_t *ring)
+{
+    __atomic_store_n(&ring->aborted, true, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Collect pipeline statistics for later reporting
+ *
+ * @param stats Statistics to add to, or NULL to stop collecting
+ */
+void
+pipeline_set_stats(pipeline_stats_t *stats)
+{
+    collected_stats = stats;
+}
+
+/**
+ * @brief Add one table's statistics to those being collected
+ *
+ * @param stats Statistics of a finished table
+ */
+void
+pipeline_add_stats(const pipeline_stats_t *stats)
+{
+    if (NULL == collected_stats)
+    {
+        return;
+    }
+
+    collected_stats->rows += stats->rows;
+    for (int stage = 0; stage < PIPELINE_STAGE_COUNT; stage++)
+    {
+        collected_stats->input_ns[stage]  += stats->input_ns[stage];
+        collected_stats->output_ns[stage] += stats->output_ns[stage];
+    }
+}
+
+/**
+ * @brief Name of a stage, for reporting
+ *
+ * @param stage Stage
+ * @return      const char* "compute", "format" or "write"
+ */
+const char *
+pipeline_stage_name(pipeline_stage_t stage)
+{
+    return (stage < PIPELINE_STAGE_COUNT) ? STAGE_NAMES[stage] : "unknown";
+}
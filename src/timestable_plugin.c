@@ -0,0 +1,119 @@
+/**
+ * @file timestable_plugin.c
+ * @brief Implementation of shared object plugin loading
+ *
+ * Functions for loading plugin descriptors with dlopen() and turning their
+ * operations into row operations.
+ */
+
+#include <stddef.h>                 // NULL
+#include <string.h>                 // strcmp()
+#include <dlfcn.h>                  // dlopen(), dlsym(), dlclose()
+
+#include "timestable_plugin.h"      // plugin_t, plugin_error_t, timestable_plugin_t
+
+static const plugin_error_t PLUGIN_ERRORS[] = {
+    {PLUGIN_SUCCESS,            "Success"},
+    {PLUGIN_ERROR_OPEN,         "Cannot open plugin shared object"},
+    {PLUGIN_ERROR_SYMBOL,       "Plugin does not export a " TIMESTABLE_PLUGIN_SYMBOL " descriptor"},
+    {PLUGIN_ERROR_VERSION,      "Plugin was built for a different ABI version"},
+    {PLUGIN_ERROR_OPERATION,    "Plugin does not provide the requested operation"}
+};
+
+static const size_t PLUGIN_ERRORS_COUNT = sizeof(PLUGIN_ERRORS) / sizeof(PLUGIN_ERRORS[0]);
+
+/**
+ * @brief Look up the error structure for a plugin error code
+ *
+ * @param code  Error code
+ * @return      plugin_error_t structure with error code and message
+ */
+static
+plugin_error_t plugin_error(plugin_error_code_t code)
+{
+    for (size_t i = 0; i < PLUGIN_ERRORS_COUNT; i++)
+    {
+        if (code == PLUGIN_ERRORS[i].code)
+        {
+            return PLUGIN_ERRORS[i];
+        }
+    }
+
+    return (plugin_error_t){.code = code, .message = "Unknown error"};
+}
+
+/**
+ * @brief Load a plugin and look up one of its operations
+ *
+ * @param path      Path to the shared object
+ * @param op_name   Name of the operation to use
+ * @param plugin    Pointer to the plugin structure to populate
+ * @return          plugin_error_t structure with error code and message
+ */
+plugin_error_t
+plugin_open(const char *path, const char *op_name, plugin_t *plugin)
+{
+    const timestable_plugin_t *descriptor = NULL;
+    plugin_error_code_t error_code        = PLUGIN_SUCCESS;
+
+    plugin->handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (NULL == plugin->handle)
+    {
+        error_code = PLUGIN_ERROR_OPEN;
+        goto exit_function;
+    }
+
+    descriptor = (const timestable_plugin_t *)dlsym(plugin->handle, TIMESTABLE_PLUGIN_SYMBOL);
+    if (NULL == descriptor)
+    {
+        error_code = PLUGIN_ERROR_SYMBOL;
+        goto exit_function;
+    }
+
+    if (TIMESTABLE_PLUGIN_ABI_VERSION != descriptor->abi_version)
+    {
+        error_code = PLUGIN_ERROR_VERSION;
+        goto exit_function;
+    }
+
+    error_code = PLUGIN_ERROR_OPERATION;
+    for (uint32_t i = 0; i < descriptor->op_count; i++)
+    {
+        const timestable_plugin_op_t *op = &descriptor->ops[i];
+
+        if (0 == strcmp(op->name, op_name) && NULL != op->kernel && NULL != op->value_bound)
+        {
+            plugin->title                 = op->title;
+            plugin->operation.kernel      = op->kernel;
+            plugin->operation.value_bound = op->value_bound;
+            plugin->operation.context     = op->context;
+            plugin->operation.is_signed   = false;
+            error_code                    = PLUGIN_SUCCESS;
+            break;
+        }
+    }
+
+exit_function:
+    if (PLUGIN_SUCCESS != error_code)
+    {
+        plugin_close(plugin);
+    }
+
+    return plugin_error(error_code);
+}
+
+/**
+ * @brief Unload a plugin opened with plugin_open()
+ *
+ * @param plugin Plugin to unload
+ */
+void
+plugin_close(plugin_t *plugin)
+{
+    if (NULL != plugin->handle)
+    {
+        dlclose(plugin->handle);
+    }
+
+    plugin->handle = NULL;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file timestable_scheduler.c
+ * @brief Implementation of the work-stealing scheduler
+ *
+ * Tasks of a batch never create further tasks, so a worker that finds every
+ * deque empty can stop: nothing will be added later.
+ */
+
+#include <stdlib.h>                 // malloc(), free()
+#include <pthread.h>                // pthread_create(), pthread_join(), pthread_mutex_t
+
+#include "timestable_scheduler.h"   // scheduler_task_t, scheduler_stats_t
+
+/**
+ * @brief Deque of task numbers owned by one worker
+ *
+ * The deque holds the range [top, bottom) of task numbers. The owner takes
+ * from the bottom, thieves from the top, both under the deque's lock.
+ */
+typedef struct
+{
+    pthread_mutex_t lock;            /**< Protects top and bottom */
+    size_t top;                      /**< Next task a thief would take */
+    size_t bottom;                   /**< One past the next task the owner takes */
+    scheduler_stats_t stats;         /**< Counters of the owning worker */
+} worker_deque_t;
+
+/**
+ * @brief Batch shared by all workers
+ */
+typedef struct
+{
+    scheduler_task_t task;           /**< Function running one task */
+    void *context;                   /**< Data passed to every task */
+    worker_deque_t *deques;          /**< One deque per worker */
+    int workers;                     /**< Number of workers */
+} batch_t;
+
+/**
+ * @brief Argument of a worker thread
+ */
+typedef struct
+{
+    batch_t *batch;                  /**< Batch being run */
+    int id;                          /**< Index of the worker's deque */
+} worker_t;
+
+/**
+ * @brief Take the next task from the bottom of the worker's own deque
+ *
+ * @param deque  Deque of the calling worker
+ * @param index  Set to the task number
+ * @return       bool true if a task was taken
+ */
+static bool
+pop_bottom(worker_deque_t *deque, size_t *index)
+{
+    bool found;
+
+    pthread_mutex_lock(&deque->lock);
+    found = deque->top < deque->bottom;
+    if (found)
+    {
+        *index = --deque->bottom;
+    }
+    pthread_mutex_unlock(&deque->lock);
+
+    return found;
+}
+
+/**
+ * @brief Take the oldest task from the top of another worker's deque
+ *
+ * @param deque  Deque of the victim
+ * @param index  Set to the task number
+ * @return       bool true if a task was taken
+ */
+static bool
+steal_top(worker_deque_t *deque, size_t *index)
+{
+    bool found;
+
+    pthread_mutex_lock(&deque->lock);
+    found = deque->top < deque->bottom;
+    if (found)
+    {
+        *index = deque->top++;
+    }
+    pthread_mutex_unlock(&deque->lock);
+
+    return found;
+}
+
+/**
+ * @brief Worker loop: drain the own deque, then steal until nothing is left
+ *
+ * @param argument worker_t of this worker
+ * @return void* NULL
+ */
+static void *
+worker_main(void *argument)
+{
+    const worker_t *worker = argument;
+    batch_t *batch         = worker->batch;
+    worker_deque_t *own    = &batch->deques[worker->id];
+    size_t index;
+
+    for (;;)
+    {
+        bool stolen = false;
+
+        if (!pop_bottom(own, &index))
+        {
+            /* Visit the other workers starting with the next one */
+            for (int i = 1; i < batch->workers && !stolen; i++)
+            {
+                stolen = steal_top(&batch->deques[(worker->id + i) % batch->workers], &index);
+            }
+
+            if (!stolen)
+            {
+                break;
+            }
+            own->stats.stolen++;
+        }
+
+        batch->task(batch->context, index);
+        own->stats.executed++;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Run every task of a batch and wait for all of them
+ *
+ * @param task_count  Number of tasks
+ * @param task        Function running one task
+ * @param context     Data passed to every task
+ * @param workers     Number of workers (1 to SCHEDULER_MAX_WORKERS)
+ * @param stats       Counters to fill in, or NULL
+ * @return            bool true on success, false if the pool could not be started
+ */
+bool
+scheduler_run(size_t task_count, scheduler_task_t task, void *context,
+              int workers, scheduler_stats_t *stats)
+{
+    batch_t batch;
+    worker_t *pool;
+    pthread_t *threads;
+    int started  = 1;
+    bool success = false;
+
+    if (workers < 1 || workers > SCHEDULER_MAX_WORKERS)
+    {
+        return false;
+    }
+
+    batch.task    = task;
+    batch.context = context;
+    batch.workers = workers;
+    batch.deques  = malloc((size_t)workers * sizeof(*batch.deques));
+    pool          = malloc((size_t)workers * sizeof(*pool));
+    threads       = malloc((size_t)workers * sizeof(*threads));
+    if (NULL == batch.deques || NULL == pool || NULL == threads)
+    {
+        goto cleanup;
+    }
+
+    /* Deal the tasks out in contiguous shares */
+    for (int i = 0; i < workers; i++)
+    {
+        worker_deque_t *deque = &batch.deques[i];
+
+        pthread_mutex_init(&deque->lock, NULL);
+        deque->top            = task_count * (size_t)i / (size_t)workers;
+        deque->bottom         = task_count * (size_t)(i + 1) / (size_t)workers;
+        deque->stats.executed = 0;
+        deque->stats.stolen   = 0;
+        pool[i].batch         = &batch;
+        pool[i].id            = i;
+    }
+
+    /* Hold every task back until the whole pool is running, so a failed
+       start can still be reported with nothing done */
+    for (int i = 0; i < workers; i++)
+    {
+        pthread_mutex_lock(&batch.deques[i].lock);
+    }
+
+    for (; started < workers; started++)
+    {
+        if (0 != pthread_create(&threads[started], NULL, worker_main, &pool[started]))
+        {
+            break;
+        }
+    }
+
+    if (started < workers)
+    {
+        /* Empty the deques so the threads already running exit at once */
+        for (int i = 0; i < workers; i++)
+        {
+            batch.deques[i].top = batch.deques[i].bottom;
+        }
+    }
+
+    for (int i = 0; i < workers; i++)
+    {
+        pthread_mutex_unlock(&batch.deques[i].lock);
+    }
+
+    if (started == workers)
+    {
+        worker_main(&pool[0]);
+        success = true;
+    }
+
+    for (int i = 1; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    if (NULL != stats)
+    {
+        stats->executed = 0;
+        stats->stolen   = 0;
+        for (int i = 0; i < workers; i++)
+        {
+            stats->executed += batch.deques[i].stats.executed;
+            stats->stolen   += batch.deques[i].stats.stolen;
+        }
+    }
+
+    for (int i = 0; i < workers; i++)
+    {
+        pthread_mutex_destroy(&batch.deques[i].lock);
+    }
+
+cleanup:
+    free(threads);
+    free(pool);
+    free(batch.deques);
+    return success;
+}
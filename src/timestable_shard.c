@@ -0,0 +1,102 @@
+/**
+ * @file timestable_shard.c
+ * @brief Implementation of row bands for sharded generation
+ *
+ * Bands are computed with integer arithmetic only, so every process of a
+ * sharded run agrees on them whatever machine it runs on.
+ */
+
+#include "timestable_shard.h"       // shard_band_t, shard_cost_t
+
+/**
+ * @brief Cost of a row of a table whose rows all take the same work
+ *
+ * @param row Row value
+ * @return    uint64_t 1
+ */
+uint64_t
+shard_cost_uniform(int row)
+{
+    (void)row;
+    return 1;
+}
+
+/**
+ * @brief Cost of a row of the exact power table
+ *
+ * @param row Row value
+ * @return    uint64_t 1 + bit length of row, squared
+ */
+uint64_t
+shard_cost_big_power(int row)
+{
+    uint64_t bits = 0;
+
+    for (unsigned value = (unsigned)row; 0 != value; value >>= 1)
+    {
+        bits++;
+    }
+
+    return 1 + bits * bits;
+}
+
+/**
+ * @brief Find the first row of a shard
+ *
+ * @param min_value  First row of the table
+ * @param max_value  Last row of the table
+ * @param cost       Estimated cost of each row
+ * @param total      Cost of all rows
+ * @param index      Shard number, from 0 to count
+ * @param count      Number of shards
+ * @return           int First row, or max_value + 1 if the shard starts
+ *                   after the last row
+ */
+static int
+band_start(int min_value, int max_value, shard_cost_t cost, uint64_t total,
+           int index, int count)
+{
+    uint64_t before = 0;
+    int row;
+
+    /* before * count >= index * total compares before with index/count of the total */
+    for (row = min_value; row <= max_value; row++)
+    {
+        if (before * (uint64_t)count >= (uint64_t)index * total)
+        {
+            break;
+        }
+        before += cost(row);
+    }
+
+    return row;
+}
+
+/**
+ * @brief Find the band of rows rendered by one shard
+ *
+ * @param min_value  First row of the table
+ * @param max_value  Last row of the table
+ * @param cost       Estimated cost of each row
+ * @param index      Shard number, from 0 to count - 1
+ * @param count      Number of shards
+ * @return           shard_band_t Rows of the shard
+ */
+shard_band_t
+shard_rows(int min_value, int max_value, shard_cost_t cost, int index, int count)
+{
+    shard_band_t band;
+    uint64_t total = 0;
+
+    for (int row = min_value; row <= max_value; row++)
+    {
+        total += cost(row);
+    }
+
+    band.first_row = band_start(min_value, max_value, cost, total, index, count);
+    band.last_row  = (index + 1 < count)
+                     ? band_start(min_value, max_value, cost, total, index + 1, count) - 1
+                     : max_value;
+
+    return band;
+}
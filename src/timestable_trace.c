@@ -0,0 +1,294 @@
+/**
+ * @file timestable_trace.c
+ * @brief Implementation of the render phase timeline
+ *
+ * Each thread appends its spans to a chain of fixed-size blocks that only
+ * it touches; the lock is taken once per thread, to link its buffer into
+ * the list that trace_close() walks. Spans become complete ("X") events.
+ */
+
+#include <stdio.h>                  // FILE, fopen(), fprintf()
+#include <stdlib.h>                 // calloc(), free()
+#include <pthread.h>                // pthread_mutex_t
+#include <time.h>                   // clock_gettime(), CLOCK_MONOTONIC
+#include <unistd.h>                 // getpid(), syscall()
+#include <sys/syscall.h>            // SYS_gettid
+
+#include "timestable_trace.h"       // trace_open(), trace_begin(), trace_end()
+
+static const trace_error_t TRACE_ERRORS[] = {
+    {TRACE_SUCCESS,       "Success"},
+    {TRACE_ERROR_OPEN,    "Cannot create the trace file"},
+    {TRACE_ERROR_ACTIVE,  "A trace is already being recorded"}
+};
+
+/**
+ * @brief One recorded span
+ */
+typedef struct
+{
+    const char *name;                /**< Name of the span */
+    uint64_t start_ns;               /**< Start time */
+    uint64_t end_ns;                 /**< End time */
+    int64_t value;                   /**< Number shown with the span */
+} trace_event_t;
+
+/**
+ * @brief Block of a thread's buffer
+ */
+typedef struct trace_chunk
+{
+    struct trace_chunk *next;        /**< Next block, or NULL */
+    size_t count;                    /**< Events used */
+    trace_event_t events[TRACE_CHUNK_EVENTS]; /**< Recorded spans */
+} trace_chunk_t;
+
+/**
+ * @brief Buffer of the spans of one thread
+ */
+typedef struct trace_thread
+{
+    struct trace_thread *next;       /**< Next thread in traced_threads */
+    long tid;                        /**< Kernel thread id */
+    trace_chunk_t *first;            /**< First block */
+    trace_chunk_t *last;             /**< Block being filled */
+    uint64_t dropped;                /**< Spans lost when a block could not be allocated */
+} trace_thread_t;
+
+/* Set by trace_open() before any traced thread starts, so read without a lock */
+static bool tracing = false;
+static FILE *trace_file = NULL;
+static uint64_t trace_origin_ns = 0;
+
+/* Buffers of every thread that recorded a span, linked under traced_lock */
+static pthread_mutex_t traced_lock = PTHREAD_MUTEX_INITIALIZER;
+static trace_thread_t *traced_threads = NULL;
+
+/* Buffer of the calling thread, or NULL until its first span */
+static __thread trace_thread_t *local_thread = NULL;
+
+/**
+ * @brief Read the clock used for trace timestamps
+ *
+ * @return uint64_t Nanoseconds since an arbitrary point
+ */
+uint64_t
+trace_clock_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Start recording spans
+ *
+ * @param path       File to write the trace to when it is closed
+ * @param origin_ns  Time shown as zero
+ * @return           trace_error_t Error code and message
+ */
+trace_error_t
+trace_open(const char *path, uint64_t origin_ns)
+{
+    if (tracing)
+    {
+        return TRACE_ERRORS[TRACE_ERROR_ACTIVE];
+    }
+
+    trace_file = fopen(path, "w");
+    if (NULL == trace_file)
+    {
+        return TRACE_ERRORS[TRACE_ERROR_OPEN];
+    }
+
+    trace_origin_ns = origin_ns;
+    tracing         = true;
+    return TRACE_ERRORS[TRACE_SUCCESS];
+}
+
+/**
+ * @brief Start a span
+ *
+ * @return uint64_t Start time, or 0 if tracing is off
+ */
+uint64_t
+trace_begin(void)
+{
+    return tracing ? trace_clock_ns() : 0;
+}
+
+/**
+ * @brief Get the buffer of the calling thread, linking a new one on first use
+ *
+ * @return trace_thread_t* The buffer, or NULL if it could not be allocated
+ */
+static trace_thread_t *
+thread_buffer(void)
+{
+    trace_thread_t *thread = local_thread;
+
+    if (NULL != thread)
+    {
+        return thread;
+    }
+
+    thread = calloc(1, sizeof(*thread));
+    if (NULL == thread)
+    {
+        return NULL;
+    }
+
+    thread->tid = (long)syscall(SYS_gettid);
+
+    pthread_mutex_lock(&traced_lock);
+    thread->next   = traced_threads;
+    traced_threads = thread;
+    pthread_mutex_unlock(&traced_lock);
+
+    local_thread = thread;
+    return thread;
+}
+
+/**
+ * @brief Record a span of the calling thread that ends now
+ *
+ * @param name   Name of the span
+ * @param start  Start time; 0 records nothing
+ * @param value  Number shown with the span
+ */
+void
+trace_end(const char *name, uint64_t start, int64_t value)
+{
+    trace_thread_t *thread;
+    trace_event_t *event;
+
+    if (!tracing || 0 == start)
+    {
+        return;
+    }
+
+    thread = thread_buffer();
+    if (NULL == thread)
+    {
+        return;
+    }
+
+    if (NULL == thread->last || TRACE_CHUNK_EVENTS == thread->last->count)
+    {
+        trace_chunk_t *chunk = malloc(sizeof(*chunk));
+
+        if (NULL == chunk)
+        {
+            thread->dropped++;
+            return;
+        }
+
+        chunk->next  = NULL;
+        chunk->count = 0;
+        if (NULL == thread->last)
+        {
+            thread->first = chunk;
+        }
+        else
+        {
+            thread->last->next = chunk;
+        }
+        thread->last = chunk;
+    }
+
+    event           = &thread->last->events[thread->last->count++];
+    event->name     = name;
+    event->start_ns = start;
+    event->end_ns   = trace_clock_ns();
+    event->value    = value;
+}
+
+/**
+ * @brief Write a time in microseconds, as trace-event timestamps are
+ *
+ * @param file  File to write to
+ * @param ns    Nanoseconds
+ */
+static void
+write_microseconds(FILE *file, int64_t ns)
+{
+    uint64_t magnitude = (ns < 0) ? 0 - (uint64_t)ns : (uint64_t)ns;
+
+    fprintf(file, "%s%llu.%03u", (ns < 0) ? "-" : "",
+            (unsigned long long)(magnitude / 1000), (unsigned)(magnitude % 1000));
+}
+
+/**
+ * @brief Stop recording and write the trace file
+ *
+ * @return bool true on success (or if tracing was off), false on a write error
+ */
+bool
+trace_close(void)
+{
+    long pid        = (long)getpid();
+    const char *sep = "";
+    bool success;
+
+    if (!tracing)
+    {
+        return true;
+    }
+    tracing = false;
+
+    fprintf(trace_file, "{\"traceEvents\":[");
+    for (trace_thread_t *thread = traced_threads; NULL != thread; thread = thread->next)
+    {
+        fprintf(trace_file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":%ld,"
+                "\"args\":{\"name\":\"%s\"}}",
+                sep, pid, thread->tid, (thread->tid == pid) ? "main" : "worker");
+        sep = ",";
+
+        for (trace_chunk_t *chunk = thread->first; NULL != chunk; chunk = chunk->next)
+        {
+            for (size_t i = 0; i < chunk->count; i++)
+            {
+                const trace_event_t *event = &chunk->events[i];
+
+                fprintf(trace_file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%ld,\"tid\":%ld,\"ts\":",
+                        event->name, pid, thread->tid);
+                write_microseconds(trace_file, (int64_t)(event->start_ns - trace_origin_ns));
+                fprintf(trace_file, ",\"dur\":");
+                write_microseconds(trace_file, (int64_t)(event->end_ns - event->start_ns));
+                fprintf(trace_file, ",\"args\":{\"value\":%lld}}", (long long)event->value);
+            }
+        }
+
+        if (thread->dropped > 0)
+        {
+            fprintf(trace_file, ",\n{\"name\":\"dropped\",\"ph\":\"i\",\"s\":\"t\",\"pid\":%ld,"
+                    "\"tid\":%ld,\"ts\":0,\"args\":{\"spans\":%llu}}",
+                    pid, thread->tid, (unsigned long long)thread->dropped);
+        }
+    }
+    fprintf(trace_file, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    success    = !ferror(trace_file);
+    success    = (0 == fclose(trace_file)) && success;
+    trace_file = NULL;
+
+    while (NULL != traced_threads)
+    {
+        trace_thread_t *thread = traced_threads;
+
+        traced_threads = thread->next;
+        while (NULL != thread->first)
+        {
+            trace_chunk_t *chunk = thread->first;
+
+            thread->first = chunk->next;
+            free(chunk);
+        }
+        free(thread);
+    }
+
+    /* Only the calling thread's pointer can be reset; traced threads have ended */
+    local_thread = NULL;
+    return success;
+}
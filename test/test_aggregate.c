@@ -0,0 +1,325 @@
+/**
+ * @file test_aggregate.c
+ * @brief Implementation of tests for table aggregates
+ *
+ * Compares the closed forms and the row-kernel reduction with sums,
+ * extremes and histograms computed cell by cell.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_framework.h"
+#include "test_aggregate.h"
+#include "timestable_aggregate.h"
+
+/**
+ * @brief Compute a cell mathematically
+ *
+ * @param source How the cells are computed (not AGG_TABLE_ROWS)
+ * @param row Row value
+ * @param column Column value
+ * @param value Set to the cell value
+ * @return int 0 for a value, 1 for an undefined cell, 2 for an overflow
+ */
+static int cell_value(agg_source_t source, int row, int column, agg_int_t *value)
+{
+    switch (source) {
+        case AGG_TABLE_MULTIPLY:
+            *value = (agg_int_t)row * column;
+            return 0;
+
+        case AGG_TABLE_DIVIDE:
+            *value = (0 == column) ? 0 : row / column;
+            return (0 == column) ? 1 : 0;
+
+        case AGG_TABLE_POWER:
+            *value = 1;
+            for (int i = 0; i < column; i++) {
+                if (__builtin_mul_overflow(*value, row, value)) {
+                    return 2;
+                }
+            }
+            return 0;
+
+        case AGG_TABLE_ROWS:
+            break;
+    }
+    return 1;
+}
+
+/**
+ * @brief Reduce a rectangle cell by cell
+ *
+ * @param source How the cells are computed
+ * @param kind AGG_SUM, AGG_MIN or AGG_MAX
+ * @param rect Cells to reduce
+ * @param result Set to the result
+ */
+static void scan_rect(agg_source_t source, agg_kind_t kind, const agg_rect_t *rect,
+                      agg_result_t *result)
+{
+    bool exact = false;
+
+    memset(result, 0, sizeof(*result));
+    for (int row = rect->first_row; row <= rect->last_row; row++) {
+        for (int column = rect->first_column; column <= rect->last_column; column++) {
+            agg_int_t value;
+            int state = cell_value(source, row, column, &value);
+
+            if (1 == state) {
+                continue;
+            }
+
+            result->cells++;
+            if (2 == state) {
+                /* Every exact value is below an overflowing one */
+                result->overflow = result->overflow || AGG_MIN != kind || !exact;
+                continue;
+            }
+
+            if (AGG_SUM == kind) {
+                result->overflow = result->overflow ||
+                                   __builtin_add_overflow(result->value, value, &result->value);
+            } else if (!exact || (AGG_MIN == kind ? value < result->value : value > result->value)) {
+                result->value = value;
+                if (AGG_MIN == kind) {
+                    result->overflow = false;
+                }
+            }
+            exact = true;
+        }
+    }
+}
+
+/**
+ * @brief Check whether two results agree
+ *
+ * @param a First result
+ * @param b Second result
+ * @return bool true if both have the same cells and value or both overflow
+ */
+static bool same_result(const agg_result_t *a, const agg_result_t *b)
+{
+    return a->cells == b->cells && a->overflow == b->overflow &&
+           (a->overflow || 0 == a->cells || a->value == b->value);
+}
+
+/**
+ * @brief Compare agg_reduce() with a scan for every row, column and the total
+ *
+ * @param source How the cells are computed
+ * @param kind AGG_SUM, AGG_MIN or AGG_MAX
+ * @param rect Cells to reduce
+ * @return bool true if every result matches
+ */
+static bool check_reduce(agg_source_t source, agg_kind_t kind, const agg_rect_t *rect)
+{
+    agg_table_t table = {source, NULL};
+    agg_result_t rows[200];
+    agg_result_t columns[200];
+    agg_result_t total;
+    agg_result_t expected;
+
+    if (!agg_reduce(&table, kind, rect, rows, columns, &total)) {
+        return false;
+    }
+
+    scan_rect(source, kind, rect, &expected);
+    if (!same_result(&total, &expected)) {
+        return false;
+    }
+
+    for (int row = rect->first_row; row <= rect->last_row; row++) {
+        agg_rect_t line = {row, row, rect->first_column, rect->last_column};
+
+        scan_rect(source, kind, &line, &expected);
+        if (!same_result(&rows[row - rect->first_row], &expected)) {
+            return false;
+        }
+    }
+
+    for (int column = rect->first_column; column <= rect->last_column; column++) {
+        agg_rect_t line = {rect->first_row, rect->last_row, column, column};
+
+        scan_rect(source, kind, &line, &expected);
+        if (!same_result(&columns[column - rect->first_column], &expected)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Test the closed forms against a scan, including overflowing powers
+ *
+ * @return int Number of failed tests
+ */
+static int test_aggregate_closed_forms(void)
+{
+    int failures = 0;
+    const agg_rect_t rects[] = {
+        {0, 12, 0, 12}, {1, 10, 1, 10}, {5, 40, 0, 7}, {0, 0, 0, 0},
+        {3, 3, 2, 9}, {2, 150, 120, 130}, {0, 199, 0, 199}
+    };
+
+    for (size_t r = 0; r < sizeof(rects) / sizeof(rects[0]); r++) {
+        for (int kind = AGG_SUM; kind <= AGG_MAX; kind++) {
+            TEST_ASSERT(check_reduce(AGG_TABLE_MULTIPLY, (agg_kind_t)kind, &rects[r]),
+                        "Product aggregates should match a scan", failures);
+            TEST_ASSERT(check_reduce(AGG_TABLE_DIVIDE, (agg_kind_t)kind, &rects[r]),
+                        "Quotient aggregates should match a scan", failures);
+            TEST_ASSERT(check_reduce(AGG_TABLE_POWER, (agg_kind_t)kind, &rects[r]),
+                        "Power aggregates should match a scan", failures);
+        }
+    }
+
+    return failures;
+}
+
+/**
+ * @brief Row kernel of row - column, signed
+ *
+ * @param context Unused
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns to compute
+ * @param values Array of count entries to store the results in
+ */
+static void difference_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    (void)context;
+
+    for (int i = 0; i < count; i++) {
+        values[i] = (uint64_t)((int64_t)row - (int64_t)(column + i));
+    }
+}
+
+/**
+ * @brief Test the row-kernel reduction, with signed values
+ *
+ * @return int Number of failed tests
+ */
+static int test_aggregate_rows(void)
+{
+    int failures = 0;
+    row_operation_t operation = {difference_row, NULL, NULL, true, false, false};
+    agg_table_t table = {AGG_TABLE_ROWS, &operation};
+    agg_rect_t rect = {1, 5, 2, 9};
+    agg_result_t rows[5];
+    agg_result_t columns[8];
+    agg_result_t total;
+
+    TEST_ASSERT(agg_reduce(&table, AGG_SUM, &rect, rows, columns, &total), "Sum should succeed", failures);
+    /* Rows sum to 8r - 44, columns to 15 - 5c */
+    TEST_ASSERT(-36 == rows[0].value && -4 == rows[4].value, "Row sums should be exact", failures);
+    TEST_ASSERT(5 == columns[0].value && -30 == columns[7].value, "Column sums should be exact", failures);
+    TEST_ASSERT(-100 == total.value && 40 == total.cells, "The total should be exact", failures);
+
+    TEST_ASSERT(agg_reduce(&table, AGG_MIN, &rect, NULL, NULL, &total) && -8 == total.value,
+                "The minimum should be signed", failures);
+    TEST_ASSERT(agg_reduce(&table, AGG_MAX, &rect, NULL, NULL, &total) && 3 == total.value,
+                "The maximum should be signed", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Histogram collected by count_bucket()
+ */
+typedef struct {
+    agg_int_t values[64];
+    uint64_t counts[64];
+    size_t buckets;
+} histogram_t;
+
+/**
+ * @brief Store one histogram bucket
+ *
+ * @param context Pointer to the histogram_t
+ * @param value Cell value
+ * @param count Number of cells holding value
+ * @return bool true while there is room
+ */
+static bool count_bucket(void *context, agg_int_t value, uint64_t count)
+{
+    histogram_t *histogram = context;
+
+    if (histogram->buckets == 64) {
+        return false;
+    }
+    histogram->values[histogram->buckets] = value;
+    histogram->counts[histogram->buckets++] = count;
+    return true;
+}
+
+/**
+ * @brief Test histograms, with undefined and overflowing cells
+ *
+ * @return int Number of failed tests
+ */
+static int test_aggregate_histogram(void)
+{
+    int failures = 0;
+    histogram_t histogram = {{0}, {0}, 0};
+    agg_table_t division = {AGG_TABLE_DIVIDE, NULL};
+    agg_table_t powers = {AGG_TABLE_POWER, NULL};
+    agg_rect_t rect = {0, 4, 0, 4};
+    agg_rect_t big = {2, 3, 126, 128};
+    uint64_t undefined;
+    uint64_t overflow;
+
+    TEST_ASSERT(agg_histogram(&division, &rect, count_bucket, &histogram, &undefined, &overflow),
+                "Histogram should succeed", failures);
+    TEST_ASSERT(5 == histogram.buckets && 5 == undefined && 0 == overflow,
+                "Quotients 0-4 and column 0 should be counted", failures);
+    TEST_ASSERT(0 == histogram.values[0] && 10 == histogram.counts[0] &&
+                4 == histogram.values[4] && 1 == histogram.counts[4],
+                "Buckets should be in increasing order with their counts", failures);
+
+    histogram.buckets = 0;
+    TEST_ASSERT(agg_histogram(&powers, &big, count_bucket, &histogram, &undefined, &overflow) &&
+                1 == histogram.buckets && 5 == overflow && 0 == undefined,
+                "Only 2^126 should be below 2^127", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test decimal formatting of 128-bit values
+ *
+ * @return int Number of failed tests
+ */
+static int test_aggregate_format(void)
+{
+    int failures = 0;
+    char text[AGG_TEXT_SIZE];
+    agg_int_t largest = (agg_int_t)(((~(unsigned long long)0) >> 1)) << 64 | ~(unsigned long long)0;
+
+    TEST_ASSERT(0 == strcmp("0", agg_format(0, text)), "Zero should format", failures);
+    TEST_ASSERT(0 == strcmp("-42", agg_format(-42, text)), "Negatives should format", failures);
+    TEST_ASSERT(0 == strcmp("170141183460469231731687303715884105727", agg_format(largest, text)),
+                "2^127 - 1 should format", failures);
+    TEST_ASSERT(0 == strcmp("-170141183460469231731687303715884105728",
+                            agg_format(-largest - 1, text)), "-2^127 should format", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Run all tests for table aggregates
+ *
+ * @return int Number of failed tests
+ */
+int run_aggregate_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_aggregate_closed_forms, failures);
+    RUN_TEST(test_aggregate_rows, failures);
+    RUN_TEST(test_aggregate_histogram, failures);
+    RUN_TEST(test_aggregate_format, failures);
+
+    return failures;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file test_aggregate.h
+ * @brief Tests for table aggregates
+ *
+ * Defines the function prototypes for testing sums, extremes and
+ * histograms against a scan of the table.
+ */
+
+#ifndef TEST_AGGREGATE_H
+#define TEST_AGGREGATE_H
+
+/**
+ * @brief Run all tests for table aggregates
+ *
+ * @return int Number of failed tests
+ */
+int run_aggregate_tests(void);
+
+#endif /* TEST_AGGREGATE_H */
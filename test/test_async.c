@@ -0,0 +1,283 @@
+/**
+ * @file test_async.c
+ * @brief Implementation of tests for the asynchronous writer
+ *
+ * Writes numbered blocks through each backend into a temporary file (or a
+ * pipe for splice) and checks that they arrive complete and in order.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "test_framework.h"
+#include "test_async.h"
+#include "timestable_async.h"
+#include "timestable_output.h"
+
+#define TEST_BLOCKS      64
+#define TEST_BUFFER_SIZE 4096
+
+/**
+ * @brief Write numbered blocks through a backend and read them back
+ *
+ * @param backend Backend to test
+ * @param failures_out Pointer to the failure counter
+ * @return bool false if the backend is not available here
+ */
+static bool check_backend(async_backend_t backend, int *failures_out)
+{
+    int failures = 0;
+    async_writer_t writer;
+    char path[] = "/tmp/timestable_async_XXXXXX";
+    int fd = mkstemp(path);
+    char *expected = malloc(TEST_BLOCKS * TEST_BUFFER_SIZE);
+    char *actual = malloc(TEST_BLOCKS * TEST_BUFFER_SIZE + 1);
+    size_t length = 0;
+    bool available;
+
+    if (fd < 0 || NULL == expected || NULL == actual) {
+        printf("  ERROR: Failed to set up the temporary file\n");
+        free(expected);
+        free(actual);
+        *failures_out += 1;
+        return true;
+    }
+    unlink(path);
+
+    available = async_writer_open(&writer, fd, backend, 3, TEST_BUFFER_SIZE);
+    if (available) {
+        TEST_ASSERT(writer.backend == backend, "Requested backend should be used", failures);
+
+        /* Blocks of varying length, each filled with its own letter */
+        for (int block = 0; block < TEST_BLOCKS; block++) {
+            char *buffer = async_writer_acquire(&writer);
+            size_t size = TEST_BUFFER_SIZE - (size_t)block * 17;
+
+            memset(buffer, 'a' + block % 26, size);
+            memcpy(expected + length, buffer, size);
+            length += size;
+            TEST_ASSERT(async_writer_submit(&writer, buffer, size), "Submit should succeed", failures);
+        }
+
+        TEST_ASSERT(async_writer_close(&writer), "Close should drain without errors", failures);
+        TEST_ASSERT(writer.stats.writes == TEST_BLOCKS && writer.stats.bytes == length,
+                    "Statistics should count every block", failures);
+        TEST_ASSERT(writer.stats.max_depth >= 1 && writer.stats.max_depth <= 3,
+                    "Queue depth should stay within the buffer count", failures);
+
+        TEST_ASSERT(pread(fd, actual, length + 1, 0) == (ssize_t)length &&
+                    0 == memcmp(actual, expected, length),
+                    "Blocks should be written complete and in order", failures);
+        TEST_ASSERT(lseek(fd, 0, SEEK_CUR) == (off_t)length,
+                    "File position should end after the written bytes", failures);
+    }
+
+    close(fd);
+    free(expected);
+    free(actual);
+    *failures_out += failures;
+    return available;
+}
+
+/**
+ * @brief Test ordered writes through the io_uring and thread backends
+ *
+ * @return int Number of failed tests
+ */
+static int test_async_backends(void)
+{
+    int failures = 0;
+
+    TEST_ASSERT(check_backend(ASYNC_BACKEND_THREAD, &failures), "Thread backend should open", failures);
+
+    /* io_uring may be missing or forbidden; only check it when it opens */
+    if (!check_backend(ASYNC_BACKEND_URING, &failures)) {
+        printf("  NOTE: io_uring unavailable, backend not tested\n");
+    }
+
+    return failures;
+}
+
+/**
+ * @brief Pipe reader for the splice test
+ */
+typedef struct
+{
+    int fd;                 /**< Read end of the pipe */
+    char *data;             /**< Destination for everything read */
+    size_t capacity;        /**< Size of data */
+    size_t length;          /**< Bytes read so far */
+} pipe_reader_t;
+
+/**
+ * @brief Read a pipe until end of file, a little at a time
+ *
+ * @param argument pipe_reader_t to fill
+ * @return void* NULL
+ */
+static void *read_pipe(void *argument)
+{
+    pipe_reader_t *reader = argument;
+    ssize_t count;
+
+    while (reader->length < reader->capacity &&
+           (count = read(reader->fd, reader->data + reader->length,
+                         reader->capacity - reader->length < 1000
+                         ? reader->capacity - reader->length : 1000)) > 0) {
+        reader->length += (size_t)count;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Test vmsplice() of rotating buffers into a pipe
+ *
+ * The blocks add up to several times the pipe capacity, so buffers are
+ * reused while earlier pages may still be in the pipe.
+ *
+ * @return int Number of failed tests
+ */
+static int test_async_splice(void)
+{
+    int failures = 0;
+    async_writer_t writer;
+    int fds[2];
+    size_t capacity = 8 * TEST_BLOCKS * TEST_BUFFER_SIZE;
+    char *expected = malloc(capacity);
+    pipe_reader_t reader = {.fd = -1, .data = malloc(capacity + 1), .capacity = capacity + 1, .length = 0};
+    pthread_t thread;
+    size_t length = 0;
+    FILE *file = tmpfile();
+
+    TEST_ASSERT(NULL != file && !async_writer_open(&writer, fileno(file), ASYNC_BACKEND_SPLICE, 3, 4096),
+                "Splice should refuse a regular file", failures);
+    if (NULL != file) {
+        fclose(file);
+    }
+
+    if (NULL == expected || NULL == reader.data || 0 != pipe(fds)) {
+        printf("  ERROR: Failed to set up the pipe\n");
+        free(expected);
+        free(reader.data);
+        return failures + 1;
+    }
+
+    /* Two 8 KiB buffers cannot cover a 64 KiB pipe; two 40 KiB ones can */
+    TEST_ASSERT(!async_writer_open(&writer, fds[1], ASYNC_BACKEND_SPLICE, 3, 5000),
+                "Splice should refuse a pool smaller than the pipe", failures);
+
+    if (!async_writer_open(&writer, fds[1], ASYNC_BACKEND_SPLICE, 3, 40000)) {
+        printf("  NOTE: vmsplice unavailable, backend not tested\n");
+    } else {
+        TEST_ASSERT(writer.backend == ASYNC_BACKEND_SPLICE, "Splice backend should be used", failures);
+        TEST_ASSERT(writer.buffer_size % 4096 == 0 && writer.buffer_size >= 40000,
+                    "Buffer size should be rounded up to whole pages", failures);
+
+        reader.fd = fds[0];
+        pthread_create(&thread, NULL, read_pipe, &reader);
+
+        for (int block = 0; block < 8 * TEST_BLOCKS; block++) {
+            char *buffer = async_writer_acquire(&writer);
+            size_t size = writer.buffer_size - (size_t)block % 97;
+
+            if (NULL == buffer || length + size > capacity) {
+                break;
+            }
+            memset(buffer, 'a' + block % 26, size);
+            memcpy(expected + length, buffer, size);
+            length += size;
+            TEST_ASSERT(async_writer_submit(&writer, buffer, size), "Submit should succeed", failures);
+        }
+
+        TEST_ASSERT(async_writer_close(&writer), "Close should succeed", failures);
+        close(fds[1]);
+        fds[1] = -1;
+        pthread_join(thread, NULL);
+
+        TEST_ASSERT(reader.length == length && 0 == memcmp(reader.data, expected, length),
+                    "Spliced blocks should arrive complete and in order", failures);
+    }
+
+    if (fds[1] >= 0) {
+        close(fds[1]);
+    }
+    close(fds[0]);
+
+    /* A reader that goes away frees the buffers, like a plain write would */
+    if (0 == pipe(fds) && async_writer_open(&writer, fds[1], ASYNC_BACKEND_SPLICE, 3, 40000)) {
+        char *buffer = async_writer_acquire(&writer);
+
+        async_writer_submit(&writer, buffer, writer.buffer_size);
+        for (int i = 0; i < 2; i++) {
+            buffer = async_writer_acquire(&writer);
+            async_writer_submit(&writer, buffer, 100);
+        }
+        close(fds[0]);
+        TEST_ASSERT(NULL != async_writer_acquire(&writer), "Buffers should be free once the reader has gone", failures);
+        TEST_ASSERT(async_writer_close(&writer), "Close should succeed without a reader", failures);
+        close(fds[1]);
+    }
+
+    free(expected);
+    free(reader.data);
+    return failures;
+}
+
+/**
+ * @brief Test output buffers routed through an asynchronous writer
+ *
+ * @return int Number of failed tests
+ */
+static int test_async_output_buffer(void)
+{
+    int failures = 0;
+    async_writer_t writer;
+    output_buffer_t output;
+    FILE *stream = tmpfile();
+    char actual[64];
+
+    if (NULL == stream || !async_writer_open(&writer, fileno(stream), ASYNC_BACKEND_AUTO, 2, 8)) {
+        printf("  ERROR: Failed to set up the writer\n");
+        return 1;
+    }
+
+    /* stdio output before the buffer must stay ahead of it */
+    fputs("title\n", stream);
+    output_set_async_writer(stream, &writer);
+    TEST_ASSERT(output_buffer_init(&output, stream, OUTPUT_BUFFER_DEFAULT_SIZE),
+                "Buffer should take a writer buffer", failures);
+    TEST_ASSERT(output.capacity == 8, "Capacity should be the writer buffer size", failures);
+    output_buffer_append(&output, "0123456789abcdefghij", 20);
+    output_buffer_fill(&output, '.', 3);
+    output_buffer_free(&output);
+    output_set_async_writer(stream, NULL);
+    async_writer_close(&writer);
+
+    rewind(stream);
+    memset(actual, 0, sizeof(actual));
+    TEST_ASSERT(fread(actual, 1, sizeof(actual) - 1, stream) == 29 &&
+                0 == strcmp(actual, "title\n0123456789abcdefghij..."),
+                "Buffered bytes should follow stdio output in order", failures);
+
+    fclose(stream);
+    return failures;
+}
+
+/**
+ * @brief Run all tests for the asynchronous writer
+ *
+ * @return int Number of failed tests
+ */
+int run_async_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_async_backends, failures);
+    RUN_TEST(test_async_splice, failures);
+    RUN_TEST(test_async_output_buffer, failures);
+
+    return failures;
+}
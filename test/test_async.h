@@ -0,0 +1,18 @@
+/**
+ * @file test_async.h
+ * @brief Tests for the asynchronous writer
+ *
+ * Defines the function prototypes for testing the asynchronous writer.
+ */
+
+#ifndef TEST_ASYNC_H
+#define TEST_ASYNC_H
+
+/**
+ * @brief Run all tests for the asynchronous writer
+ *
+ * @return int Number of failed tests
+ */
+int run_async_tests(void);
+
+#endif /* TEST_ASYNC_H */
@@ -0,0 +1,144 @@
+/**
+ * @file test_bigint.c
+ * @brief Implementation of tests for arbitrary-precision integer functions
+ *
+ * Tests for incremental multiplication and decimal/hex conversion.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "test_framework.h"
+#include "test_bigint.h"
+#include "timestable_bigint.h"
+
+/* Buffer size for converted values */
+#define TEXT_SIZE 128
+
+/**
+ * @brief Test multiplication across limb boundaries
+ *
+ * @return int Number of failed tests
+ */
+static int test_bigint_mul(void)
+{
+    int failures = 0;
+    bigint_t value;
+
+    if (!bigint_init(&value, 1)) {
+        printf("  ERROR: Failed to allocate big integer\n");
+        return 1;
+    }
+
+    /* 2^64 needs a third limb */
+    bigint_set_u32(&value, 1);
+    for (int i = 0; i < 64; i++) {
+        bigint_mul_u32(&value, 2);
+    }
+    TEST_ASSERT(value.length == 3, "2^64 should occupy three limbs", failures);
+    TEST_ASSERT(bigint_bit_length(&value) == 65, "2^64 should have 65 bits", failures);
+
+    /* Multiplying by zero collapses to a single zero limb */
+    bigint_mul_u32(&value, 0);
+    TEST_ASSERT(value.length == 1 && value.limbs[0] == 0, "x * 0 should be zero", failures);
+    TEST_ASSERT(bigint_bit_length(&value) == 0, "Zero should have no bits", failures);
+
+    bigint_free(&value);
+    return failures;
+}
+
+/**
+ * @brief Test decimal conversion, including zero-padded inner chunks
+ *
+ * @return int Number of failed tests
+ */
+static int test_bigint_to_decimal(void)
+{
+    int failures = 0;
+    bigint_t value;
+    bigint_t scratch;
+    char text[TEXT_SIZE];
+    size_t length;
+
+    if (!bigint_init(&value, 1) || !bigint_init(&scratch, 1)) {
+        printf("  ERROR: Failed to allocate big integer\n");
+        return 1;
+    }
+
+    bigint_set_u32(&value, 0);
+    length = bigint_to_decimal(&value, &scratch, text, sizeof(text));
+    TEST_ASSERT(length == 1 && text[0] == '0', "Zero should convert to \"0\"", failures);
+
+    /* 10^20 spans three base 10^9 chunks with all-zero low chunks */
+    bigint_set_u32(&value, 1);
+    for (int i = 0; i < 20; i++) {
+        bigint_mul_u32(&value, 10);
+    }
+    length = bigint_to_decimal(&value, &scratch, text, sizeof(text));
+    TEST_ASSERT(length == 21 && 0 == memcmp(text, "100000000000000000000", 21),
+                "10^20 should convert exactly", failures);
+    TEST_ASSERT(bigint_decimal_digits(bigint_bit_length(&value)) >= 21,
+                "Digit bound should cover 10^20", failures);
+
+    /* 3^40 = 12157665459056928801 */
+    bigint_set_u32(&value, 1);
+    for (int i = 0; i < 40; i++) {
+        bigint_mul_u32(&value, 3);
+    }
+    length = bigint_to_decimal(&value, &scratch, text, sizeof(text));
+    TEST_ASSERT(length == 20 && 0 == memcmp(text, "12157665459056928801", 20),
+                "3^40 should convert exactly", failures);
+
+    bigint_free(&scratch);
+    bigint_free(&value);
+    return failures;
+}
+
+/**
+ * @brief Test hexadecimal conversion
+ *
+ * @return int Number of failed tests
+ */
+static int test_bigint_to_hex(void)
+{
+    int failures = 0;
+    bigint_t value;
+    char text[TEXT_SIZE];
+    size_t length;
+
+    if (!bigint_init(&value, 1)) {
+        printf("  ERROR: Failed to allocate big integer\n");
+        return 1;
+    }
+
+    bigint_set_u32(&value, 0);
+    length = bigint_to_hex(&value, text, sizeof(text));
+    TEST_ASSERT(length == 3 && 0 == memcmp(text, "0x0", 3), "Zero should convert to \"0x0\"", failures);
+
+    /* 16^9 = 0x1000000000 crosses a limb boundary */
+    bigint_set_u32(&value, 1);
+    for (int i = 0; i < 9; i++) {
+        bigint_mul_u32(&value, 16);
+    }
+    length = bigint_to_hex(&value, text, sizeof(text));
+    TEST_ASSERT(length == 12 && 0 == memcmp(text, "0x1000000000", 12),
+                "16^9 should convert exactly", failures);
+
+    bigint_free(&value);
+    return failures;
+}
+
+/**
+ * @brief Run all tests for the big integer functions
+ *
+ * @return int Number of failed tests
+ */
+int run_bigint_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_bigint_mul, failures);
+    RUN_TEST(test_bigint_to_decimal, failures);
+    RUN_TEST(test_bigint_to_hex, failures);
+
+    return failures;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file test_bigint.h
+ * @brief Tests for arbitrary-precision integer functions
+ *
+ * Defines the function prototypes for testing the big integer helpers.
+ */
+
+#ifndef TEST_BIGINT_H
+#define TEST_BIGINT_H
+
+/**
+ * @brief Run all tests for the big integer functions
+ *
+ * @return int Number of failed tests
+ */
+int run_bigint_tests(void);
+
+#endif /* TEST_BIGINT_H */
@@ -0,0 +1,146 @@
+/**
+ * @file test_browser.c
+ * @brief Implementation of tests for the viewport browser tile cache
+ *
+ * Tests for tile rendering and least-recently-used eviction. The ncurses
+ * interface itself needs a terminal and is not exercised here.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include "test_framework.h"
+#include "test_browser.h"
+#include "timestable_browser.h"
+
+/**
+ * @brief Test that tiles hold the formatted cells of their region
+ *
+ * @return int Number of failed tests
+ */
+static int test_browser_tiles(void)
+{
+    int failures = 0;
+    browse_cache_t cache;
+    const browse_tile_t *tile;
+    modulus_t modulus = {.modulus = 1000};
+    row_operation_t mod_multiply = {
+        .kernel      = mod_multiply_row,
+        .value_bound = mod_multiply_bound,
+        .context     = &modulus,
+        .is_signed   = false
+    };
+    browse_table_t table = {
+        .min_value     = 1,
+        .max_value     = INT_MAX,
+        .title         = MULT_TABLE_TITLE,
+        .format        = FORMAT_DECIMAL,
+        .operation     = multiply,
+        .row_operation = NULL
+    };
+
+    TEST_ASSERT(browse_cache_init(&cache, &table), "Cache should initialize", failures);
+
+    /* Row 3 column 5 lives in the first tile */
+    tile = browse_cache_get(&cache, 3, 5);
+    TEST_ASSERT(tile->tile_row == 0 && tile->tile_column == 0, "3×5 should be in tile (0, 0)", failures);
+    TEST_ASSERT(tile->length[2][4] == 2 && 0 == memcmp(tile->text[2][4], "15", 2),
+                "Cell 3×5 should read 15", failures);
+
+    /* Cells far into the table are rendered without touching the rest */
+    tile = browse_cache_get(&cache, 40000, 40001);
+    TEST_ASSERT(tile->tile_row == 39999 / BROWSE_TILE_ROWS && tile->tile_column == 40000 / BROWSE_TILE_COLUMNS,
+                "Far cell should select its own tile", failures);
+    TEST_ASSERT(cache.misses == 2 && cache.hits == 0, "Both lookups should miss", failures);
+
+    /* Another cell of the first tile is a hit */
+    browse_cache_get(&cache, 1, 1);
+    TEST_ASSERT(cache.hits == 1, "Lookup within a cached tile should hit", failures);
+
+    /* Products past INT_MAX are exact, not wrapped */
+    tile = browse_cache_get(&cache, 100000, 100000);
+    TEST_ASSERT(0 == memcmp(tile->text[(100000 - 1) % BROWSE_TILE_ROWS][(100000 - 1) % BROWSE_TILE_COLUMNS],
+                            "10000000000", 11),
+                "100000×100000 should read 10000000000", failures);
+    browse_cache_free(&cache);
+
+    /* Powers too large for 64 bits read OVF */
+    table.operation = power;
+    browse_cache_init(&cache, &table);
+    tile = browse_cache_get(&cache, 3, 40);
+    TEST_ASSERT(0 == memcmp(tile->text[2][(40 - 1) % BROWSE_TILE_COLUMNS], "12157665459056928801", 20),
+                "3^40 should be exact", failures);
+    TEST_ASSERT(tile->length[2][(41 - 1) % BROWSE_TILE_COLUMNS] == 3 &&
+                0 == memcmp(tile->text[2][(41 - 1) % BROWSE_TILE_COLUMNS], "OVF", 3),
+                "3^41 should read OVF", failures);
+    browse_cache_free(&cache);
+
+    /* Row operations render through their kernel */
+    table.operation     = NULL;
+    table.row_operation = &mod_multiply;
+    table.format        = FORMAT_HEX;
+    browse_cache_init(&cache, &table);
+    tile = browse_cache_get(&cache, 100, 12);
+    TEST_ASSERT(tile->length[(100 - 1) % BROWSE_TILE_ROWS][11] == 4 &&
+                0 == memcmp(tile->text[(100 - 1) % BROWSE_TILE_ROWS][11], "0xc8", 4),
+                "100×12 mod 1000 should read 0xc8", failures);
+    browse_cache_free(&cache);
+
+    return failures;
+}
+
+/**
+ * @brief Test least-recently-used eviction
+ *
+ * @return int Number of failed tests
+ */
+static int test_browser_eviction(void)
+{
+    int failures = 0;
+    browse_cache_t cache;
+    browse_table_t table = {
+        .min_value     = 0,
+        .max_value     = INT_MAX,
+        .title         = MULT_TABLE_TITLE,
+        .format        = FORMAT_DECIMAL,
+        .operation     = multiply,
+        .row_operation = NULL
+    };
+
+    browse_cache_init(&cache, &table);
+
+    /* Fill the cache, touching tile 0 again so it stays recent */
+    for (int i = 0; i < BROWSE_CACHE_TILES; i++)
+    {
+        browse_cache_get(&cache, 0, (int64_t)i * BROWSE_TILE_COLUMNS);
+    }
+    browse_cache_get(&cache, 0, 0);
+    TEST_ASSERT(cache.misses == BROWSE_CACHE_TILES && cache.hits == 1,
+                "Filling the cache should miss once per tile", failures);
+
+    /* One more tile evicts tile 1, the least recently used */
+    browse_cache_get(&cache, 0, (int64_t)BROWSE_CACHE_TILES * BROWSE_TILE_COLUMNS);
+    browse_cache_get(&cache, 0, 0);
+    TEST_ASSERT(cache.hits == 2, "Recently used tile should survive eviction", failures);
+    browse_cache_get(&cache, 0, BROWSE_TILE_COLUMNS);
+    TEST_ASSERT(cache.misses == BROWSE_CACHE_TILES + 2, "Least recently used tile should be evicted", failures);
+
+    browse_cache_free(&cache);
+
+    return failures;
+}
+
+/**
+ * @brief Run all tests for the browser tile cache
+ *
+ * @return int Number of failed tests
+ */
+int run_browser_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_browser_tiles, failures);
+    RUN_TEST(test_browser_eviction, failures);
+
+    return failures;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file test_browser.h
+ * @brief Tests for the viewport browser tile cache
+ *
+ * Defines the function prototypes for testing the browser tile cache.
+ */
+
+#ifndef TEST_BROWSER_H
+#define TEST_BROWSER_H
+
+/**
+ * @brief Run all tests for the browser tile cache
+ *
+ * @return int Number of failed tests
+ */
+int run_browser_tests(void);
+
+#endif /* TEST_BROWSER_H */
@@ -0,0 +1,283 @@
+/**
+ * @file test_checkpoint.c
+ * @brief Implementation of tests for output checkpoints
+ *
+ * Writes output and records to temporary files, then checks that a resume
+ * truncates the output to the recorded position and that damaged or
+ * foreign records are refused.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "test_framework.h"
+#include "test_helpers.h"
+#include "test_checkpoint.h"
+#include "timestable_checkpoint.h"
+#include "timestable_output.h"
+#include "timestable_formatter.h"
+#include "timestable_operations.h"
+
+#define TEST_SIGNATURE 0x0123456789abcdefu
+
+/* A table well past the default -M limit, and the row a resume starts at */
+#define LARGE_MAX 2000
+#define LARGE_RESUME_ROW 1000
+
+/**
+ * @brief Size of an open file
+ *
+ * @param fd File descriptor
+ * @return off_t Size in bytes, or -1 on error
+ */
+static off_t file_size(int fd)
+{
+    struct stat info;
+
+    return (0 == fstat(fd, &info)) ? info.st_size : -1;
+}
+
+/**
+ * @brief Read a whole file into a new NUL-terminated buffer
+ *
+ * @param file File to read
+ * @param size Set to the number of bytes
+ * @return char* Buffer to free, or NULL on error
+ */
+static char *read_file(FILE *file, size_t *size)
+{
+    off_t length = file_size(fileno(file));
+    char *data = (length < 0) ? NULL : malloc((size_t)length + 1);
+
+    if (NULL == data || 0 != fseek(file, 0, SEEK_SET) ||
+        (size_t)length != fread(data, 1, (size_t)length, file)) {
+        free(data);
+        return NULL;
+    }
+
+    data[length] = '\0';
+    *size = (size_t)length;
+    return data;
+}
+
+/**
+ * @brief Execute the large multiplication table
+ *
+ * For use with capture_stdout_file
+ */
+static void execute_large(void)
+{
+    print_table(0, LARGE_MAX, multiply, MULT_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Test that a large table resumed at a row matches the whole table
+ *
+ * @return int Number of failed tests
+ */
+static int test_checkpoint_large_table(void)
+{
+    int failures = 0;
+    checkpoint_t checkpoint;
+    char path[] = "/tmp/timestable_checkpoint_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *whole = tmpfile();
+    FILE *output = tmpfile();
+    char *expected = NULL;
+    char *resumed = NULL;
+    const char *row;
+    size_t expected_size = 0;
+    size_t resumed_size = 0;
+    size_t offset;
+
+    if (fd < 0 || NULL == whole || NULL == output) {
+        printf("  ERROR: Failed to set up the temporary files\n");
+        return 1;
+    }
+    close(fd);
+
+    expected = capture_stdout_file(execute_large, whole) ? read_file(whole, &expected_size) : NULL;
+    row = (NULL == expected) ? NULL : strstr(expected, "\n    1000 |");
+    if (NULL == row) {
+        printf("  ERROR: Failed to print the large table\n");
+        free(expected);
+        return 1;
+    }
+
+    /* The interrupted run got past the recorded row, then stopped mid-row */
+    offset = (size_t)(row + 1 - expected);
+    TEST_ASSERT(offset + 7 == fwrite(expected, 1, offset + 7, output) && 0 == fflush(output),
+                "Partial output should be written", failures);
+    TEST_ASSERT(CHECKPOINT_SUCCESS == checkpoint_open(&checkpoint, path, fileno(output),
+                                                      TEST_SIGNATURE, false).code &&
+                CHECKPOINT_SUCCESS == checkpoint_commit(&checkpoint, 0, LARGE_RESUME_ROW,
+                                                        (off_t)offset).code,
+                "The row should be recorded", failures);
+    checkpoint_close(&checkpoint);
+
+    TEST_ASSERT(CHECKPOINT_SUCCESS == checkpoint_open(&checkpoint, path, fileno(output),
+                                                      TEST_SIGNATURE, true).code &&
+                LARGE_RESUME_ROW == checkpoint.resume_row,
+                "Checkpoint should reopen at the recorded row", failures);
+
+    checkpoint.table = 0;
+    output_set_checkpoint(stdout, &checkpoint);
+    TEST_ASSERT(capture_stdout_file(execute_large, output), "The table should be resumed", failures);
+    output_set_checkpoint(NULL, NULL);
+    checkpoint_close(&checkpoint);
+
+    resumed = read_file(output, &resumed_size);
+    TEST_ASSERT(NULL != resumed && resumed_size == expected_size &&
+                0 == memcmp(resumed, expected, expected_size),
+                "The resumed output should match the whole table", failures);
+
+    free(resumed);
+    free(expected);
+    fclose(output);
+    fclose(whole);
+    unlink(path);
+    return failures;
+}
+
+/**
+ * @brief Test that a resume truncates the output to the last record
+ *
+ * @return int Number of failed tests
+ */
+static int test_checkpoint_resume(void)
+{
+    int failures = 0;
+    checkpoint_t checkpoint;
+    char path[] = "/tmp/timestable_checkpoint_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *output = tmpfile();
+    int first_row = 1;
+    int last_row = 9;
+
+    if (fd < 0 || NULL == output) {
+        printf("  ERROR: Failed to set up the temporary files\n");
+        return 1;
+    }
+    close(fd);
+
+    /* A fresh run records the current end of the output */
+    TEST_ASSERT(11 == write(fileno(output), "hello world", 11), "Output should be written", failures);
+    TEST_ASSERT(CHECKPOINT_SUCCESS == checkpoint_open(&checkpoint, path, fileno(output),
+                                                      TEST_SIGNATURE, false).code,
+                "Checkpoint should open", failures);
+    TEST_ASSERT(1 == checkpoint.records && !checkpoint.resuming,
+                "Opening should write the first record", failures);
+
+    TEST_ASSERT(6 == write(fileno(output), "abcdef", 6), "Output should be written", failures);
+    TEST_ASSERT(CHECKPOINT_SUCCESS == checkpoint_commit(&checkpoint, 2, 5, 17).code,
+                "Checkpoint should be recorded", failures);
+    TEST_ASSERT(3 == write(fileno(output), "xyz", 3), "Output should be written", failures);
+    checkpoint_close(&checkpoint);
+
+    /* Resuming drops the bytes after the record */
+    TEST_ASSERT(CHECKPOINT_SUCCESS == checkpoint_open(&checkpoint, path, fileno(output),
+                                                      TEST_SIGNATURE, true).code,
+                "Checkpoint should reopen", failures);
+    TEST_ASSERT(checkpoint.resuming && 2 == checkpoint.resume_table && 5 == checkpoint.resume_row,
+                "Resume position should be restored", failures);
+    TEST_ASSERT(17 == file_size(fileno(output)) && 17 == lseek(fileno(output), 0, SEEK_CUR),
+                "Output should be truncated to the recorded offset", failures);
+
+    /* Renderers only skip rows in the table being resumed */
+    output_set_checkpoint(output, &checkpoint);
+    checkpoint.table = 1;
+    TEST_ASSERT(output_begin_rows(output, &first_row, &last_row) && 1 == first_row,
+                "Other tables should start with their title", failures);
+    checkpoint.table = 2;
+    TEST_ASSERT(!output_begin_rows(output, &first_row, &last_row) && 5 == first_row && 9 == last_row,
+                "The resumed table should continue at the recorded row", failures);
+
+    fputs("row5\n", output);
+    TEST_ASSERT(output_checkpoint(output, 6) && !checkpoint.resuming,
+                "A new record should end the resume", failures);
+    output_set_checkpoint(NULL, NULL);
+    checkpoint_close(&checkpoint);
+
+    TEST_ASSERT(CHECKPOINT_SUCCESS == checkpoint_open(&checkpoint, path, fileno(output),
+                                                      TEST_SIGNATURE, true).code &&
+                6 == checkpoint.resume_row && 22 == file_size(fileno(output)),
+                "The record should cover the flushed row", failures);
+    checkpoint_close(&checkpoint);
+
+    fclose(output);
+    unlink(path);
+    return failures;
+}
+
+/**
+ * @brief Test that foreign, damaged and missing records are handled
+ *
+ * @return int Number of failed tests
+ */
+static int test_checkpoint_errors(void)
+{
+    int failures = 0;
+    checkpoint_t checkpoint;
+    char path[] = "/tmp/timestable_checkpoint_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *output = tmpfile();
+    int pipe_fds[2];
+
+    if (fd < 0 || NULL == output || 0 != pipe(pipe_fds)) {
+        printf("  ERROR: Failed to set up the temporary files\n");
+        return 1;
+    }
+
+    /* An empty checkpoint file means nothing was known to be written */
+    TEST_ASSERT(4 == write(fileno(output), "lost", 4), "Output should be written", failures);
+    TEST_ASSERT(CHECKPOINT_SUCCESS == checkpoint_open(&checkpoint, path, fileno(output),
+                                                      TEST_SIGNATURE, true).code,
+                "An empty checkpoint should resume", failures);
+    TEST_ASSERT(0 == checkpoint.resume_table && CHECKPOINT_TABLE_START == checkpoint.resume_row &&
+                0 == file_size(fileno(output)),
+                "An empty checkpoint should restart the output", failures);
+    checkpoint_close(&checkpoint);
+
+    TEST_ASSERT(CHECKPOINT_SUCCESS == checkpoint_open(&checkpoint, path, fileno(output),
+                                                      TEST_SIGNATURE, false).code,
+                "Checkpoint should open", failures);
+    checkpoint_close(&checkpoint);
+
+    TEST_ASSERT(CHECKPOINT_ERROR_MISMATCH == checkpoint_open(&checkpoint, path, fileno(output),
+                                                             TEST_SIGNATURE + 1, true).code,
+                "Other options should be refused", failures);
+
+    TEST_ASSERT(1 == pwrite(fd, "X", 1, 30), "Record should be damaged", failures);
+    TEST_ASSERT(CHECKPOINT_ERROR_CORRUPT == checkpoint_open(&checkpoint, path, fileno(output),
+                                                            TEST_SIGNATURE, true).code,
+                "A damaged record should be refused", failures);
+
+    TEST_ASSERT(CHECKPOINT_ERROR_OUTPUT == checkpoint_open(&checkpoint, path, pipe_fds[1],
+                                                           TEST_SIGNATURE, false).code,
+                "A pipe cannot be checkpointed", failures);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(fd);
+    fclose(output);
+    unlink(path);
+    return failures;
+}
+
+/**
+ * @brief Run all tests for output checkpoints
+ *
+ * @return int Number of failed tests
+ */
+int run_checkpoint_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_checkpoint_resume, failures);
+    RUN_TEST(test_checkpoint_errors, failures);
+    RUN_TEST(test_checkpoint_large_table, failures);
+
+    return failures;
+}
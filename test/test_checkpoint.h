@@ -0,0 +1,19 @@
+/**
+ * @file test_checkpoint.h
+ * @brief Tests for output checkpoints
+ *
+ * Defines the function prototypes for testing checkpoint records and
+ * resuming from them.
+ */
+
+#ifndef TEST_CHECKPOINT_H
+#define TEST_CHECKPOINT_H
+
+/**
+ * @brief Run all tests for output checkpoints
+ *
+ * @return int Number of failed tests
+ */
+int run_checkpoint_tests(void);
+
+#endif /* TEST_CHECKPOINT_H */
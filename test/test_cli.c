@@ -11,51 +11,130 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include "test_framework.h"
 #include "test_cli.h"
 #include "timestable_cli.h"
 
 /**
- * @brief Test initialization of program options
+ * @brief Parse an argument vector into options holding the program defaults
+ *
+ * @param argc Number of arguments, including the program name
+ * @param argv Arguments
+ * @param options Options to fill in
+ * @return cli_error_t Result of cli_parse_args()
+ */
+static cli_error_t parse(int argc, char *argv[], program_options_t *options)
+{
+    memset(options, 0, sizeof(*options));
+    options->min_value = 1;
+    options->max_value = 10;
+    options->format = FORMAT_DECIMAL;
+    options->tables = TABLE_FLAG_MULTIPLICATION;
+    options->jobs = 1;
+    options->shard_count = 1;
+
+    /* Restart getopt() for every vector */
+    optind = 0;
+    return cli_parse_args(argc, argv, options);
+}
+
+/**
+ * @brief Test parsing of the basic options
  *
  * @return int Number of failed tests
  */
-static int test_cli_init_options(void)
+static int test_cli_parse_options(void)
 {
     int failures = 0;
     program_options_t options;
+    char *defaults[] = {"timestable", NULL};
+    char *custom[] = {"timestable", "-m", "2", "-M", "5", "-x", "-t", "d", NULL};
+    cli_error_t error;
 
-    /* Initialize options and check default values */
-    cli_init_options(&options);
-
+    /* No arguments leave the defaults untouched */
+    error = parse(1, defaults, &options);
+    TEST_ASSERT(error.code == CLI_SUCCESS, "No arguments should parse", failures);
     TEST_ASSERT(options.min_value == 1, "Default min_value should be 1", failures);
     TEST_ASSERT(options.max_value == 10, "Default max_value should be 10", failures);
     TEST_ASSERT(options.format == FORMAT_DECIMAL, "Default format should be decimal", failures);
-    TEST_ASSERT(options.tables == TABLE_MULTIPLICATION, "Default table should be multiplication", failures);
+    TEST_ASSERT(options.tables == TABLE_FLAG_MULTIPLICATION, "Default table should be multiplication", failures);
     TEST_ASSERT(options.show_help == false, "Default show_help should be false", failures);
 
+    error = parse(8, custom, &options);
+    TEST_ASSERT(error.code == CLI_SUCCESS, "Basic options should parse", failures);
+    TEST_ASSERT(options.min_value == 2, "-m should set min_value", failures);
+    TEST_ASSERT(options.max_value == 5, "-M should set max_value", failures);
+    TEST_ASSERT(options.format == FORMAT_HEX, "-x should select hexadecimal", failures);
+    TEST_ASSERT(options.tables == TABLE_FLAG_DIVISION, "-t d should select division", failures);
+
     return failures;
 }
 
 /**
- * @brief Test error message functionality
+ * @brief Test error codes and messages of invalid arguments
  *
  * @return int Number of failed tests
  */
 static int test_cli_error_messages(void)
 {
     int failures = 0;
+    program_options_t options;
+    char *bad_table[] = {"timestable", "-t", "z", NULL};
+    char *bad_max[] = {"timestable", "-M", "1000", NULL};
+    char *min_gt_max[] = {"timestable", "-m", "5", "-M", "2", NULL};
+    char *long_checkpoint[] = {"timestable", "-M", "2000", "--checkpoint", "ck", NULL};
+    char *long_shard[] = {"timestable", "-M", "2000", "--shard", "1/4", NULL};
+    char *long_compact[] = {"timestable", "-M", "1000", "--compact", NULL};
+    char *over_long[] = {"timestable", "-M", "46341", "--checkpoint", "ck", NULL};
+    char *plugin_only[] = {"timestable", "--plugin", "bitops.so", "-M", "3", NULL};
+    char *wide_sum[] = {"timestable", "--range-sum", "1:10001,1:10001", "-t", "m", NULL};
+    char *wide_scan[] = {"timestable", "--range-sum", "1:10001,1:10001", "-t", "g", NULL};
+    char *two_files[] = {"timestable", "--out", "dec:/tmp/x", "--out", "hex:/tmp/y",
+                         "--out", "csv:stdout", "--out", "md:-", NULL};
+    cli_error_t error;
+
+    error = parse(3, bad_table, &options);
+    TEST_ASSERT(error.code == CLI_ERROR_INVALID_TABLE_TYPE, "-t z should be an invalid table", failures);
+    TEST_ASSERT(error.message != NULL, "Invalid table type should have a message", failures);
+
+    error = parse(3, bad_max, &options);
+    TEST_ASSERT(error.code == CLI_ERROR_INVALID_MAX, "-M 1000 should be out of range", failures);
+    TEST_ASSERT(error.message != NULL, "Invalid max should have a message", failures);
+
+    error = parse(5, min_gt_max, &options);
+    TEST_ASSERT(error.code == CLI_ERROR_MIN_GT_MAX, "-m 5 -M 2 should be rejected", failures);
+    TEST_ASSERT(error.message != NULL, "Min > max should have a message", failures);
+
+    /* Long-running output may go past the default limit */
+    error = parse(5, long_checkpoint, &options);
+    TEST_ASSERT(error.code == CLI_SUCCESS && options.max_value == 2000,
+                "-M 2000 should be allowed with --checkpoint", failures);
+    error = parse(5, long_shard, &options);
+    TEST_ASSERT(error.code == CLI_SUCCESS && options.max_value == 2000,
+                "-M 2000 should be allowed with --shard", failures);
+    error = parse(4, long_compact, &options);
+    TEST_ASSERT(error.code == CLI_SUCCESS && options.max_value == 1000,
+                "-M 1000 should be allowed with --compact", failures);
+    error = parse(5, over_long, &options);
+    TEST_ASSERT(error.code == CLI_ERROR_INVALID_MAX, "-M 46341 should be out of range", failures);
+
+    /* A plugin without an operation must not fall back to the default table */
+    error = parse(5, plugin_only, &options);
+    TEST_ASSERT(error.code == CLI_ERROR_INVALID_PLUGIN, "--plugin without --op should be rejected",
+                failures);
 
-    /* Test that each error code has a corresponding message */
-    TEST_ASSERT(cli_get_error_message(CLI_SUCCESS) != NULL, "Success should have a message", failures);
-    TEST_ASSERT(cli_get_error_message(CLI_ERROR_INVALID_MIN) != NULL, "Invalid min should have a message", failures);
-    TEST_ASSERT(cli_get_error_message(CLI_ERROR_INVALID_MAX) != NULL, "Invalid max should have a message", failures);
-    TEST_ASSERT(cli_get_error_message(CLI_ERROR_MIN_GT_MAX) != NULL, "Min > max should have a message", failures);
-    TEST_ASSERT(cli_get_error_message(CLI_ERROR_INVALID_TABLE_TYPE) != NULL, "Invalid table type should have a message", failures);
-    TEST_ASSERT(cli_get_error_message(CLI_ERROR_INVALID_OPTION) != NULL, "Invalid option should have a message", failures);
+    /* Closed forms never scan the range, so only scanned tables are capped */
+    error = parse(5, wide_sum, &options);
+    TEST_ASSERT(error.code == CLI_SUCCESS && options.range.last_row == 10001,
+                "--range-sum past 10000 should be allowed for -t m", failures);
+    error = parse(5, wide_scan, &options);
+    TEST_ASSERT(error.code == CLI_ERROR_INVALID_AGGREGATE,
+                "--range-sum past 10000 should be rejected for -t g", failures);
 
-    /* Test that unknown error codes have a default message */
-    TEST_ASSERT(cli_get_error_message(999) != NULL, "Unknown error should have a default message", failures);
+    error = parse(9, two_files, &options);
+    TEST_ASSERT(error.code == CLI_SUCCESS && options.output_count == 4,
+                "Outputs to different files and stdout should parse", failures);
 
     return failures;
 }
@@ -69,7 +148,7 @@ int run_cli_tests(void)
 {
     int failures = 0;
 
-    RUN_TEST(test_cli_init_options, failures);
+    RUN_TEST(test_cli_parse_options, failures);
     RUN_TEST(test_cli_error_messages, failures);
 
     return failures;
@@ -0,0 +1,181 @@
+/**
+ * @file test_decimal.c
+ * @brief Implementation of tests for quotient formatting
+ *
+ * Fixed-point quotients are compared with long division digit by digit,
+ * shortest quotients with the C library reading them back and with the
+ * shortest correctly rounded printf() precision.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_framework.h"
+#include "test_decimal.h"
+#include "timestable_decimal.h"
+
+/**
+ * @brief Render with one of the functions into a NUL-terminated string
+ *
+ * @param text Buffer of DECIMAL_TEXT_SIZE + 1 characters
+ * @param length Characters written before text + DECIMAL_TEXT_SIZE
+ * @return const char* Start of the rendered text
+ */
+static const char *terminate(char *text, size_t length)
+{
+    text[DECIMAL_TEXT_SIZE] = '\0';
+    return text + DECIMAL_TEXT_SIZE - length;
+}
+
+/**
+ * @brief Render numerator ÷ denominator by schoolbook long division
+ *
+ * @param numerator Dividend
+ * @param denominator Divisor
+ * @param digits Fraction digits
+ * @param text Buffer for the result
+ */
+static void long_division(unsigned numerator, unsigned denominator, int digits, char *text)
+{
+    char fraction[DECIMAL_MAX_DIGITS + 2];
+    unsigned long long whole = numerator / denominator;
+    unsigned long long remainder = numerator % denominator;
+    int carry;
+
+    for (int i = 0; i < digits; i++) {
+        remainder *= 10;
+        fraction[i] = (char)('0' + remainder / denominator);
+        remainder %= denominator;
+    }
+
+    /* Round half up, carrying through nines */
+    carry = 2 * remainder >= denominator;
+    for (int i = digits - 1; i >= 0 && carry; i--) {
+        carry = '9' == fraction[i];
+        fraction[i] = carry ? '0' : (char)(fraction[i] + 1);
+    }
+    fraction[digits] = '\0';
+    sprintf(text, "%llu.%s", whole + (unsigned)carry, fraction);
+}
+
+/**
+ * @brief Test fixed-point quotients against long division
+ *
+ * @return int Number of failed tests
+ */
+static int test_decimal_fixed(void)
+{
+    int failures = 0;
+    char text[DECIMAL_TEXT_SIZE + 1];
+    char expected[64];
+    bool all_match = true;
+
+    TEST_ASSERT(0 == strcmp("0.13", terminate(text, decimal_fixed(1, 8, 2, text + DECIMAL_TEXT_SIZE))),
+                "Halves should round up", failures);
+    TEST_ASSERT(0 == strcmp("1.00", terminate(text, decimal_fixed(999, 1000, 2, text + DECIMAL_TEXT_SIZE))),
+                "A rounding carry should reach the whole part", failures);
+    TEST_ASSERT(0 == strcmp("5", terminate(text, decimal_fixed(5, 1, 0, text + DECIMAL_TEXT_SIZE))),
+                "No digits should leave out the point", failures);
+
+    for (int digits = 1; digits <= DECIMAL_MAX_DIGITS; digits++) {
+        const unsigned pairs[][2] = {{1, 3}, {2, 3}, {22, 7}, {1, 97}, {4294967295u, 7},
+                                     {4294967295u, 4294967291u}, {1, 4294967295u}};
+
+        for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+            long_division(pairs[i][0], pairs[i][1], digits, expected);
+            all_match = all_match &&
+                        0 == strcmp(expected, terminate(text, decimal_fixed(pairs[i][0], pairs[i][1], digits,
+                                                                             text + DECIMAL_TEXT_SIZE)));
+        }
+    }
+    TEST_ASSERT(all_match, "Every precision should match long division", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Count the significant digits of a decimal
+ *
+ * @param text Decimal text
+ * @return int Digits from the first to the last nonzero one
+ */
+static int significant_digits(const char *text)
+{
+    int count = 0;
+    int last = 0;
+
+    for (; *text != '\0' && *text != 'e'; text++) {
+        if (*text >= '1' && *text <= '9') {
+            last = ++count;
+        } else if ('0' == *text && count > 0) {
+            count++;
+        }
+    }
+    return last;
+}
+
+/**
+ * @brief Test shortest quotients of a table against the C library
+ *
+ * @return int Number of failed tests
+ */
+static int test_decimal_shortest(void)
+{
+    int failures = 0;
+    char text[DECIMAL_TEXT_SIZE + 1];
+    bool round_trips = true;
+    bool shortest = true;
+
+    TEST_ASSERT(0 == strcmp("0.1", terminate(text, decimal_shortest(0.1, text + DECIMAL_TEXT_SIZE))),
+                "0.1 should be printed as written", failures);
+    TEST_ASSERT(0 == strcmp("0.3333333333333333",
+                            terminate(text, decimal_shortest(1.0 / 3.0, text + DECIMAL_TEXT_SIZE))),
+                "1/3 should have 16 digits", failures);
+    TEST_ASSERT(0 == strcmp("0.14285714285714285",
+                            terminate(text, decimal_shortest(1.0 / 7.0, text + DECIMAL_TEXT_SIZE))),
+                "1/7 should have 17 digits", failures);
+    TEST_ASSERT(0 == strcmp("4294967295000000",
+                            terminate(text, decimal_shortest(4294967295e6, text + DECIMAL_TEXT_SIZE))),
+                "Large integers should be positional", failures);
+    TEST_ASSERT(0 == strcmp("0", terminate(text, decimal_shortest(0.0, text + DECIMAL_TEXT_SIZE))),
+                "Zero should be 0", failures);
+
+    for (int row = 1; row <= 300; row++) {
+        for (int column = 1; column <= 300; column++) {
+            double value = (double)row / (double)column;
+            const char *ours = terminate(text, decimal_shortest(value, text + DECIMAL_TEXT_SIZE));
+            char reference[64];
+            int precision;
+
+            round_trips = round_trips && strtod(ours, NULL) == value;
+
+            /* The correctly rounded decimal of the fewest digits that reads back */
+            for (precision = 1; precision < DECIMAL_SHORTEST_DIGITS; precision++) {
+                snprintf(reference, sizeof(reference), "%.*e", precision - 1, value);
+                if (strtod(reference, NULL) == value) {
+                    break;
+                }
+            }
+            shortest = shortest && significant_digits(ours) <= precision;
+        }
+    }
+    TEST_ASSERT(round_trips, "Every quotient should read back as the same double", failures);
+    TEST_ASSERT(shortest, "No quotient should have more digits than needed", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Run all tests for quotient formatting
+ *
+ * @return int Number of failed tests
+ */
+int run_decimal_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_decimal_fixed, failures);
+    RUN_TEST(test_decimal_shortest, failures);
+
+    return failures;
+}
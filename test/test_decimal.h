@@ -0,0 +1,19 @@
+/**
+ * @file test_decimal.h
+ * @brief Tests for quotient formatting
+ *
+ * Defines the function prototypes for testing fixed-point and shortest
+ * decimal quotients.
+ */
+
+#ifndef TEST_DECIMAL_H
+#define TEST_DECIMAL_H
+
+/**
+ * @brief Run all tests for quotient formatting
+ *
+ * @return int Number of failed tests
+ */
+int run_decimal_tests(void);
+
+#endif /* TEST_DECIMAL_H */
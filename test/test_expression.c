@@ -0,0 +1,164 @@
+/**
+ * @file test_expression.c
+ * @brief Implementation of tests for compiled expression operations
+ *
+ * Tests for parsing, constant folding, loop-invariant hoisting and
+ * row evaluation.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "test_framework.h"
+#include "test_expression.h"
+#include "timestable_expression.h"
+
+/* Shared program, too large to keep on the stack of every test */
+static expr_program_t program;
+
+/* Deeply nested expressions, far past the stack a recursive parser can use */
+#define NESTED_DEPTH 60000
+static char nested[2 * NESTED_DEPTH + 2];
+
+/**
+ * @brief Write "r" inside depth pairs of parentheses, or after depth minus signs
+ *
+ * @param depth Nesting depth
+ * @param parentheses true for parentheses, false for minus signs
+ * @return const char* The expression, in the shared buffer
+ */
+static const char *nest(int depth, bool parentheses)
+{
+    memset(nested, parentheses ? '(' : '-', (size_t)depth);
+    nested[depth] = 'r';
+    memset(nested + depth + 1, ')', parentheses ? (size_t)depth : 0);
+    nested[depth + 1 + (parentheses ? depth : 0)] = '\0';
+    return nested;
+}
+
+/**
+ * @brief Test evaluation of a row against hand-computed values
+ *
+ * @return int Number of failed tests
+ */
+static int test_expression_evaluate(void)
+{
+    int failures = 0;
+    uint64_t values[4];
+    expr_error_t error;
+
+    /* r*c + r for row 3, columns 1..4 */
+    error = expr_compile("r*c + r", &program);
+    TEST_ASSERT(error.code == EXPR_SUCCESS, "r*c + r should compile", failures);
+    expr_row(&program, 3, 1, 4, values);
+    TEST_ASSERT(values[0] == 6 && values[1] == 9 && values[2] == 12 && values[3] == 15,
+                "r*c + r should evaluate across the row", failures);
+
+    /* Negative results are two's complement */
+    error = expr_compile("r*r - c", &program);
+    TEST_ASSERT(error.code == EXPR_SUCCESS, "r*r - c should compile", failures);
+    expr_row(&program, 1, 1, 4, values);
+    TEST_ASSERT((int64_t)values[3] == -3, "1*1 - 4 should equal -3", failures);
+    TEST_ASSERT(!program.has_bound && expr_value_bound(&program, 1, 4) == 15,
+                "Bound should be the largest magnitude", failures);
+    expr_compute_bound(&program, 1, 4);
+    TEST_ASSERT(program.has_bound && program.bound == 15, "Bound should be kept in the program", failures);
+    TEST_ASSERT(expr_value_bound(&program, 1, 4) == 15, "Kept bound should be returned again", failures);
+    TEST_ASSERT(expr_value_bound(&program, 1, 6) == 35 && program.bound == 15,
+                "Another range should be evaluated without changing the kept bound", failures);
+
+    /* Precedence follows C: & binds looser than <<, ^ looser than & */
+    error = expr_compile("(r ^ c) & 0xff | 1 << 8", &program);
+    TEST_ASSERT(error.code == EXPR_SUCCESS, "Bitwise expression should compile", failures);
+    expr_row(&program, 0x1f0, 0x0f, 1, values);
+    TEST_ASSERT(values[0] == 0x1ff, "(0x1f0 ^ 0xf) & 0xff | 1 << 8 should equal 0x1ff", failures);
+
+    /* Division by zero yields 0 */
+    error = expr_compile("r / c + r % c", &program);
+    expr_row(&program, 7, 0, 3, values);
+    TEST_ASSERT(values[0] == 0 && values[1] == 7 && values[2] == 4,
+                "x/0 and x%0 should be 0", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test constant folding and loop-invariant hoisting
+ *
+ * @return int Number of failed tests
+ */
+static int test_expression_optimize(void)
+{
+    int failures = 0;
+    expr_error_t error;
+
+    /* Fully constant: one scalar constant, one broadcast */
+    error = expr_compile("(2 + 3) * 4 - ~0", &program);
+    TEST_ASSERT(error.code == EXPR_SUCCESS, "Constant expression should compile", failures);
+    TEST_ASSERT(program.scalar_count == 1 && program.scalar[0].immediate == 21,
+                "Constant expression should fold to 21", failures);
+    TEST_ASSERT(program.vector_count == 1 && program.vector[0].opcode == EXPR_OP_BROADCAST,
+                "Constant expression should broadcast once per row", failures);
+
+    /* r*r + 1 does not depend on c and moves to the scalar program */
+    error = expr_compile("c + (r*r + 1)", &program);
+    TEST_ASSERT(error.code == EXPR_SUCCESS, "Mixed expression should compile", failures);
+    TEST_ASSERT(program.vector_count == 2, "Only c and the add should run per cell", failures);
+    TEST_ASSERT(program.vector[1].b_scalar, "Invariant operand should be a scalar slot", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test compilation errors
+ *
+ * @return int Number of failed tests
+ */
+static int test_expression_errors(void)
+{
+    int failures = 0;
+    expr_error_t error;
+
+    error = expr_compile("r * ", &program);
+    TEST_ASSERT(error.code == EXPR_ERROR_SYNTAX, "Missing operand should be a syntax error", failures);
+
+    error = expr_compile("(r + c", &program);
+    TEST_ASSERT(error.code == EXPR_ERROR_SYNTAX, "Unbalanced parenthesis should be a syntax error", failures);
+
+    error = expr_compile("row", &program);
+    TEST_ASSERT(error.code == EXPR_ERROR_SYNTAX && error.position == 1,
+                "Unknown identifier should be reported at its position", failures);
+
+    error = expr_compile("99999999999999999999", &program);
+    TEST_ASSERT(error.code == EXPR_ERROR_NUMBER, "Oversized literal should be rejected", failures);
+
+    error = expr_compile("c+(c+(c+(c+(c+(c+(c+(c+(c+c))))))))", &program);
+    TEST_ASSERT(error.code == EXPR_ERROR_TOO_COMPLEX, "Deep nesting should exceed the registers", failures);
+
+    /* Parentheses and unary operators nest before any node is allocated */
+    error = expr_compile(nest(NESTED_DEPTH, true), &program);
+    TEST_ASSERT(error.code == EXPR_ERROR_TOO_COMPLEX, "Deep parentheses should be too complex", failures);
+
+    error = expr_compile(nest(NESTED_DEPTH, false), &program);
+    TEST_ASSERT(error.code == EXPR_ERROR_TOO_COMPLEX, "Long unary chains should be too complex", failures);
+
+    error = expr_compile(nest(EXPR_MAX_DEPTH - 1, true), &program);
+    TEST_ASSERT(error.code == EXPR_SUCCESS, "Nesting within the limit should compile", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Run all tests for the expression compiler
+ *
+ * @return int Number of failed tests
+ */
+int run_expression_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_expression_evaluate, failures);
+    RUN_TEST(test_expression_optimize, failures);
+    RUN_TEST(test_expression_errors, failures);
+
+    return failures;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file test_expression.h
+ * @brief Tests for compiled expression operations
+ *
+ * Defines the function prototypes for testing the expression compiler.
+ */
+
+#ifndef TEST_EXPRESSION_H
+#define TEST_EXPRESSION_H
+
+/**
+ * @brief Run all tests for the expression compiler
+ *
+ * @return int Number of failed tests
+ */
+int run_expression_tests(void);
+
+#endif /* TEST_EXPRESSION_H */
@@ -0,0 +1,201 @@
+/**
+ * @file test_find.c
+ * @brief Implementation of tests for the inverse table lookup
+ *
+ * Marks the cells reported for each value in a grid and compares it with
+ * the cells found by computing the whole table.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_framework.h"
+#include "test_find.h"
+#include "timestable_find.h"
+
+#define GRID_SIZE 40
+
+/**
+ * @brief Cells marked by the lookup, indexed [row][column]
+ */
+static int marked[GRID_SIZE][GRID_SIZE];
+
+/**
+ * @brief Mark every cell of a reported range
+ *
+ * @param context Unused
+ * @param range Matching cells
+ * @return bool true to continue
+ */
+static bool mark_range(void *context, const find_range_t *range)
+{
+    (void)context;
+
+    for (int row = range->first_row; row <= range->last_row; row++) {
+        for (int column = range->first_column; column <= range->last_column; column++) {
+            marked[row][column]++;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Compute a cell mathematically
+ *
+ * @param operation Operation of the table
+ * @param row Row value
+ * @param column Column value
+ * @param value Set to the cell value
+ * @return bool false for an undefined cell
+ */
+static bool cell_value(find_operation_t operation, int row, int column, uint64_t *value)
+{
+    switch (operation) {
+        case FIND_MULTIPLY:
+            *value = (uint64_t)row * (uint64_t)column;
+            return true;
+
+        case FIND_DIVIDE:
+            *value = (0 == column) ? 0 : (uint64_t)(row / column);
+            return 0 != column;
+
+        case FIND_POWER:
+            *value = 1;
+            for (int i = 0; i < column; i++) {
+                if (*value > UINT32_MAX) {
+                    return false;
+                }
+                *value *= (uint64_t)row;
+            }
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Compare the lookup with a scan for one operation and range
+ *
+ * @param index Lookup index of the range
+ * @param operation Operation of the table
+ * @return bool true if every value gave exactly the scanned cells
+ */
+static bool check_operation(const find_index_t *index, find_operation_t operation)
+{
+    const uint64_t values[] = {0, 1, 2, 6, 12, 16, 24, 36, 64, 81, 97, 360, 1024, 1369, 1521};
+
+    for (size_t v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+        memset(marked, 0, sizeof(marked));
+        if (!find_cells(index, operation, values[v], mark_range, NULL)) {
+            return false;
+        }
+
+        for (int row = index->min_value; row <= index->max_value; row++) {
+            for (int column = index->min_value; column <= index->max_value; column++) {
+                uint64_t value;
+                bool match = cell_value(operation, row, column, &value) && value == values[v];
+
+                if (marked[row][column] != (match ? 1 : 0)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Test lookups against a scan of small tables
+ *
+ * @return int Number of failed tests
+ */
+static int test_find_matches_scan(void)
+{
+    int failures = 0;
+    const int ranges[][2] = {{0, 39}, {1, 39}, {5, 20}, {0, 0}, {2, 2}};
+
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+        find_index_t index;
+
+        if (!find_index_init(&index, ranges[r][0], ranges[r][1])) {
+            printf("  ERROR: Failed to build the lookup index\n");
+            return failures + 1;
+        }
+
+        TEST_ASSERT(check_operation(&index, FIND_MULTIPLY), "Products should match a scan", failures);
+        TEST_ASSERT(check_operation(&index, FIND_DIVIDE), "Quotients should match a scan", failures);
+        TEST_ASSERT(check_operation(&index, FIND_POWER), "Powers should match a scan", failures);
+        find_index_free(&index);
+    }
+
+    return failures;
+}
+
+/**
+ * @brief Count the reported cells
+ *
+ * @param context Pointer to the uint64_t count
+ * @param range Matching cells
+ * @return bool true to continue
+ */
+static bool count_cells(void *context, const find_range_t *range)
+{
+    uint64_t *count = context;
+
+    *count += (uint64_t)(range->last_row - range->first_row + 1) *
+              (uint64_t)(range->last_column - range->first_column + 1);
+    return true;
+}
+
+/**
+ * @brief Test lookups in a large table, including factors above the sieve
+ *
+ * @return int Number of failed tests
+ */
+static int test_find_large(void)
+{
+    int failures = 0;
+    find_index_t index;
+    uint64_t count = 0;
+
+    if (!find_index_init(&index, 1, 1000000)) {
+        printf("  ERROR: Failed to build the lookup index\n");
+        return 1;
+    }
+
+    /* 3600 = 2^4 3^2 5^2 has 45 divisors, all within the range */
+    TEST_ASSERT(find_cells(&index, FIND_MULTIPLY, 3600, count_cells, &count) && 45 == count,
+                "Every divisor pair of 3600 should be found", failures);
+
+    /* 999983 is prime, so its square is only p × p; 1 × p^2 is out of range */
+    count = 0;
+    TEST_ASSERT(find_cells(&index, FIND_MULTIPLY, 999983ull * 999983ull, count_cells, &count) &&
+                1 == count, "The square of a large prime should be found once", failures);
+
+    count = 0;
+    /* Column c holds 1000 in c rows, cut to one row at c = 1000 by the range */
+    TEST_ASSERT(find_cells(&index, FIND_DIVIDE, 1000, count_cells, &count) && 499501 == count,
+                "Quotient intervals should cover every matching cell", failures);
+
+    count = 0;
+    TEST_ASSERT(find_cells(&index, FIND_POWER, 1ull << 40, count_cells, &count) && 6 == count,
+                "2^40 should be found as 2^40, 4^20, 16^10, 32^8, 256^5 and 1024^4", failures);
+
+    find_index_free(&index);
+    return failures;
+}
+
+/**
+ * @brief Run all tests for the inverse table lookup
+ *
+ * @return int Number of failed tests
+ */
+int run_find_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_find_matches_scan, failures);
+    RUN_TEST(test_find_large, failures);
+
+    return failures;
+}
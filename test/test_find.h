@@ -0,0 +1,19 @@
+/**
+ * @file test_find.h
+ * @brief Tests for the inverse table lookup
+ *
+ * Defines the function prototypes for testing cell lookups against a
+ * scan of the table.
+ */
+
+#ifndef TEST_FIND_H
+#define TEST_FIND_H
+
+/**
+ * @brief Run all tests for the inverse table lookup
+ *
+ * @return int Number of failed tests
+ */
+int run_find_tests(void);
+
+#endif /* TEST_FIND_H */
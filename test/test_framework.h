@@ -31,16 +31,21 @@
 /**
  * @brief Macro to run a test function and report its status
  *
- * Executes the test function and reports whether it passed or failed.
+ * Executes the test function, reports whether it passed or failed and how
+ * long it took, and records the result for the test runner.
  */
 #define RUN_TEST(test_func, failures) \
     do { \
+        double test_start = test_clock_ms(); \
         int test_failures = test_func(); \
+        double test_elapsed = test_clock_ms() - test_start; \
+        test_record(#test_func, test_failures, test_elapsed); \
         if (test_failures > 0) { \
-            printf("  Test %s FAILED (%d assertions failed)\n", #test_func, test_failures); \
+            printf("  Test %s FAILED (%d assertions failed, %.3f ms)\n", #test_func, \
+                   test_failures, test_elapsed); \
             (failures) += test_failures; \
         } else { \
-            printf("  Test %s PASSED\n", #test_func); \
+            printf("  Test %s PASSED (%.3f ms)\n", #test_func, test_elapsed); \
         } \
     } while (0)
 
@@ -52,4 +57,20 @@ typedef struct {
     int (*run_tests)(void);  /**< Function to run all tests in the suite */
 } TestSuite;
 
+/**
+ * @brief Read a monotonic clock
+ *
+ * @return double Milliseconds since an arbitrary start
+ */
+double test_clock_ms(void);
+
+/**
+ * @brief Record the outcome of one test for the runner
+ *
+ * @param name Test function name, or "" for the suite total
+ * @param failures Failed assertions
+ * @param milliseconds Wall time of the test
+ */
+void test_record(const char *name, int failures, double milliseconds);
+
 #endif /* TEST_FRAMEWORK_H */
\ No newline at end of file
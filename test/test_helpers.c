@@ -28,6 +28,9 @@ bool capture_stdout(void (*func)(void), char *buffer, size_t buffer_size)
     int stdout_backup;
     int pipe_fd[2];
 
+    /* Keep output printed before the call out of the capture */
+    fflush(stdout);
+
     /* Back up the original stdout file descriptor */
     stdout_backup = dup(STDOUT_FILENO);
     if (stdout_backup == -1) {
@@ -82,4 +85,43 @@ bool capture_stdout(void (*func)(void), char *buffer, size_t buffer_size)
     close(stdout_backup);
 
     return true;
-}
\ No newline at end of file
+}
+/**
+ * @brief Captures stdout during function execution into a file
+ *
+ * Redirects stdout to the file's descriptor, at its current offset, so
+ * output larger than a pipe can hold is kept whole.
+ *
+ * @param func Function to execute with captured stdout
+ * @param file File to append the output to
+ * @return bool true on success, false on error
+ */
+bool capture_stdout_file(void (*func)(void), FILE *file)
+{
+    int stdout_backup;
+
+    /* Keep output printed before the call out of the capture */
+    fflush(stdout);
+    fflush(file);
+
+    stdout_backup = dup(STDOUT_FILENO);
+    if (stdout_backup == -1) {
+        return false;
+    }
+
+    if (dup2(fileno(file), STDOUT_FILENO) == -1) {
+        close(stdout_backup);
+        return false;
+    }
+
+    func();
+    fflush(stdout);
+
+    if (dup2(stdout_backup, STDOUT_FILENO) == -1) {
+        close(stdout_backup);
+        return false;
+    }
+
+    close(stdout_backup);
+    return true;
+}
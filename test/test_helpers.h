@@ -28,4 +28,16 @@
  */
 bool capture_stdout(void (*func)(void), char *buffer, size_t buffer_size);
 
+/**
+ * @brief Captures stdout during function execution into a file
+ *
+ * Redirects stdout to the file's descriptor, at its current offset, so
+ * output larger than a pipe can hold is kept whole.
+ *
+ * @param func Function to execute with captured stdout
+ * @param file File to append the output to
+ * @return bool true on success, false on error
+ */
+bool capture_stdout_file(void (*func)(void), FILE *file);
+
 #endif /* TEST_HELPERS_H */
\ No newline at end of file
@@ -0,0 +1,355 @@
+/**
+ * @file test_library.c
+ * @brief Implementation of tests for the embeddable table interface
+ *
+ * Renders tables row by row through the library and compares the text with
+ * the output of the printers, then renders the same tables on several
+ * threads at once.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "test_framework.h"
+#include "test_helpers.h"
+#include "test_library.h"
+#include "timestable.h"
+#include "timestable_formatter.h"
+#include "timestable_operations.h"
+
+#define BUFFER_SIZE 65536
+#define THREAD_COUNT 4
+
+/**
+ * @brief Specification printed by execute_print_spec()
+ */
+static const ts_spec_t *printed_spec;
+
+/**
+ * @brief Print the table of printed_spec with the formatter
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_spec(void)
+{
+    output_format_t format = (TS_FORMAT_HEX == printed_spec->format) ? FORMAT_HEX : FORMAT_DECIMAL;
+    modulus_t modulus = { .modulus = printed_spec->modulus };
+    row_operation_t operation = {
+        .kernel       = mod_multiply_row,
+        .value_bound  = mod_multiply_bound,
+        .context      = &modulus,
+        .is_symmetric = true
+    };
+
+    switch (printed_spec->table) {
+        case TS_TABLE_DIVISION:
+            print_table(printed_spec->min_value, printed_spec->max_value, divide,
+                        DIV_TABLE_TITLE, format);
+            break;
+        case TS_TABLE_POWER:
+            print_table(printed_spec->min_value, printed_spec->max_value, power,
+                        POWER_TABLE_TITLE, format);
+            break;
+        case TS_TABLE_MOD_MULTIPLICATION:
+            print_row_table(printed_spec->min_value, printed_spec->max_value, &operation,
+                            MOD_MULT_TABLE_TITLE, format);
+            break;
+        default:
+            print_table(printed_spec->min_value, printed_spec->max_value, multiply,
+                        MULT_TABLE_TITLE, format);
+            break;
+    }
+}
+
+/**
+ * @brief Render a whole table through the library, as the printers lay it out
+ *
+ * @param spec Table to render
+ * @param buffer Destination
+ * @param size Size of the destination
+ * @return size_t Length of the text, or 0 if the table could not be rendered
+ */
+static size_t render_table(const ts_spec_t *spec, char *buffer, size_t size)
+{
+    ts_table_t *table = ts_table_open(spec, NULL);
+    size_t length;
+    size_t row_length;
+
+    if (NULL == table) {
+        return 0;
+    }
+
+    length = (size_t)snprintf(buffer, size, "\n%s\n", ts_table_title(table));
+    length += ts_table_header(table, buffer + length, size - length);
+    while (length < size &&
+           (row_length = ts_next_row(table, buffer + length, size - length)) > 0) {
+        if (row_length >= size - length) {
+            length = 0;
+            break;
+        }
+        length += row_length;
+    }
+
+    ts_table_close(table);
+    return length;
+}
+
+/**
+ * @brief Test that library rows match the printed tables byte for byte
+ *
+ * @return int Number of failed tests
+ */
+static int test_library_matches_print(void)
+{
+    int failures = 0;
+    static char printed[BUFFER_SIZE];
+    static char rendered[BUFFER_SIZE];
+    ts_spec_t specs[4];
+
+    for (int i = 0; i < 4; i++) {
+        ts_spec_init(&specs[i]);
+    }
+    specs[0].max_value = 12;
+    specs[1].table     = TS_TABLE_DIVISION;
+    specs[1].min_value = 0;
+    specs[1].format    = TS_FORMAT_HEX;
+    specs[2].table     = TS_TABLE_POWER;
+    specs[2].max_value = 6;
+    specs[3].table     = TS_TABLE_MOD_MULTIPLICATION;
+    specs[3].min_value = 0;
+    specs[3].modulus   = 7;
+
+    for (int i = 0; i < 4; i++) {
+        printed_spec = &specs[i];
+        if (!capture_stdout(execute_print_spec, printed, BUFFER_SIZE)) {
+            printf("  ERROR: Failed to capture stdout\n");
+            return failures + 1;
+        }
+
+        TEST_ASSERT(render_table(&specs[i], rendered, BUFFER_SIZE) > 0,
+                    "The table should be rendered through the library", failures);
+        TEST_ASSERT(0 == strcmp(printed, rendered),
+                    "Library rows should match the printed table", failures);
+    }
+
+    return failures;
+}
+
+/**
+ * @brief Test rows that do not fit, skipped rows and raw values
+ *
+ * @return int Number of failed tests
+ */
+static int test_library_row_buffers(void)
+{
+    int failures = 0;
+    ts_spec_t spec;
+    ts_table_t *table;
+    char small[8];
+    char *line;
+    const uint64_t *values;
+    size_t length;
+    int row = 0;
+    int count = 0;
+
+    ts_spec_init(&spec);
+    table = ts_table_open(&spec, NULL);
+    if (NULL == table) {
+        printf("  ERROR: Failed to open the table\n");
+        return 1;
+    }
+
+    line = malloc(ts_row_size(table));
+    TEST_ASSERT(NULL == ts_get_values(table, NULL, NULL),
+                "No values should be available before the first row", failures);
+
+    /* A row that does not fit is kept for the next call */
+    length = ts_next_row(table, small, sizeof(small));
+    TEST_ASSERT(length >= sizeof(small), "A row longer than the buffer should be reported", failures);
+    TEST_ASSERT(length == ts_next_row(table, line, ts_row_size(table)) && length == strlen(line),
+                "The row should be returned again into a larger buffer", failures);
+    TEST_ASSERT(0 == strcmp(line, "    1 |    1    2    3    4    5    6    7    8    9   10\n"),
+                "Row 1 should be rendered in full", failures);
+
+    values = ts_get_values(table, &row, &count);
+    TEST_ASSERT(NULL != values && 1 == row && 10 == count && 7 == values[6],
+                "Raw values of row 1 should be available", failures);
+
+    /* Skipping rows still computes their values */
+    TEST_ASSERT(ts_next_row(table, NULL, 0) > 0, "A row should be skipped with a NULL buffer", failures);
+    values = ts_get_values(table, &row, &count);
+    TEST_ASSERT(2 == row && 20 == values[9], "Raw values of a skipped row should be available", failures);
+
+    for (int i = 3; i <= 10; i++) {
+        ts_next_row(table, line, ts_row_size(table));
+    }
+    TEST_ASSERT(0 == ts_next_row(table, line, ts_row_size(table)) && '\0' == line[0],
+                "The end of the table should return 0", failures);
+
+    free(line);
+    ts_table_close(table);
+    return failures;
+}
+
+/**
+ * @brief Test the options parser and the errors of ts_table_open()
+ *
+ * @return int Number of failed tests
+ */
+static int test_library_spec_parse(void)
+{
+    int failures = 0;
+    ts_spec_t spec;
+    ts_error_t error;
+    ts_table_t *table;
+    const uint64_t *values;
+    char *good[] = {"-m0", "-M", "3", "-x", "--mod=7", "-t", "P"};
+    char *expression[] = {"-m", "0", "-M3", "-e", "r - c"};
+    char *all_tables[] = {"-t", "a"};
+    char *unknown[] = {"-q"};
+    char *missing[] = {"-M"};
+    char *reversed[] = {"-m", "5", "-M", "3"};
+    char *nested;
+
+    ts_spec_init(&spec);
+    error = ts_spec_parse(&spec, 7, good);
+    TEST_ASSERT(TS_SUCCESS == error.code && 0 == spec.min_value && 3 == spec.max_value &&
+                TS_FORMAT_HEX == spec.format && 7 == spec.modulus && TS_TABLE_MOD_POWER == spec.table,
+                "Attached and separate option values should be parsed", failures);
+
+    ts_spec_init(&spec);
+    TEST_ASSERT(TS_ERROR_INVALID_TABLE_TYPE == ts_spec_parse(&spec, 2, all_tables).code,
+                "A handle should hold a single table", failures);
+    TEST_ASSERT(TS_ERROR_INVALID_OPTION == ts_spec_parse(&spec, 1, unknown).code,
+                "Unknown options should be rejected", failures);
+    TEST_ASSERT(TS_ERROR_INVALID_OPTION == ts_spec_parse(&spec, 1, missing).code,
+                "Options without their value should be rejected", failures);
+
+    ts_spec_init(&spec);
+    ts_spec_parse(&spec, 4, reversed);
+    TEST_ASSERT(NULL == ts_table_open(&spec, &error) && TS_ERROR_MIN_GT_MAX == error.code,
+                "A minimum above the maximum should not open", failures);
+
+    ts_spec_init(&spec);
+    spec.table = TS_TABLE_MOD_MULTIPLICATION;
+    TEST_ASSERT(NULL == ts_table_open(&spec, &error) && TS_ERROR_INVALID_MODULUS == error.code,
+                "Modular tables should need a modulus", failures);
+
+    ts_spec_init(&spec);
+    spec.table      = TS_TABLE_EXPRESSION;
+    spec.expression = "r +";
+    TEST_ASSERT(NULL == ts_table_open(&spec, &error) && TS_ERROR_INVALID_EXPRESSION == error.code,
+                "Expressions that do not compile should not open", failures);
+
+    /* Nesting is limited before it can exhaust the stack */
+    nested = malloc(60000 + 2);
+    if (NULL != nested) {
+        memset(nested, '(', 60000);
+        strcpy(nested + 60000, "r");
+        spec.expression = nested;
+        TEST_ASSERT(NULL == ts_table_open(&spec, &error) && TS_ERROR_INVALID_EXPRESSION == error.code,
+                    "Deeply nested expressions should not open", failures);
+        free(nested);
+    }
+
+    ts_spec_init(&spec);
+    TEST_ASSERT(TS_SUCCESS == ts_spec_parse(&spec, 5, expression).code,
+                "An expression should be parsed", failures);
+    table = ts_table_open(&spec, &error);
+    TEST_ASSERT(NULL != table && TS_SUCCESS == error.code, "An expression table should open", failures);
+    if (NULL != table) {
+        ts_next_row(table, NULL, 0);
+        values = ts_get_values(table, NULL, NULL);
+        TEST_ASSERT(0 == values[0] && (uint64_t)-3 == values[3],
+                    "Signed values should be returned in two's complement", failures);
+        TEST_ASSERT(0 == strcmp(ts_table_title(table), "Expression Table (r - c)"),
+                    "The expression should be part of the title", failures);
+        ts_table_close(table);
+    }
+
+    return failures;
+}
+
+/**
+ * @brief Table rendered by one thread of test_library_threads()
+ */
+typedef struct {
+    const ts_spec_t *spec;      /**< Table to render */
+    char *buffer;               /**< Destination of BUFFER_SIZE bytes */
+    size_t length;              /**< Length of the rendered text */
+} rendering_t;
+
+/**
+ * @brief Thread rendering a table through its own handle
+ *
+ * @param argument Pointer to a rendering_t
+ * @return void* NULL
+ */
+static void *render_thread(void *argument)
+{
+    rendering_t *rendering = argument;
+
+    rendering->length = render_table(rendering->spec, rendering->buffer, BUFFER_SIZE);
+    return NULL;
+}
+
+/**
+ * @brief Test independent handles rendering at once on several threads
+ *
+ * @return int Number of failed tests
+ */
+static int test_library_threads(void)
+{
+    int failures = 0;
+    static char expected[2][BUFFER_SIZE];
+    static char buffers[THREAD_COUNT][BUFFER_SIZE];
+    pthread_t threads[THREAD_COUNT];
+    rendering_t renderings[THREAD_COUNT];
+    ts_spec_t specs[2];
+
+    ts_spec_init(&specs[0]);
+    specs[0].table     = TS_TABLE_GCD;
+    specs[0].max_value = 40;
+    ts_spec_init(&specs[1]);
+    specs[1].table      = TS_TABLE_EXPRESSION;
+    specs[1].expression = "r * r - 3 * c";
+    specs[1].max_value  = 40;
+
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT(render_table(&specs[i], expected[i], BUFFER_SIZE) > 0,
+                    "The table should be rendered on one thread", failures);
+    }
+
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        renderings[i].spec   = &specs[i % 2];
+        renderings[i].buffer = buffers[i];
+        renderings[i].length = 0;
+        pthread_create(&threads[i], NULL, render_thread, &renderings[i]);
+    }
+
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        TEST_ASSERT(renderings[i].length > 0 && 0 == strcmp(buffers[i], expected[i % 2]),
+                    "Each thread should render the same table as one thread alone", failures);
+    }
+
+    return failures;
+}
+
+/**
+ * @brief Run all tests for the embeddable table interface
+ *
+ * @return int Number of failed tests
+ */
+int run_library_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_library_matches_print, failures);
+    RUN_TEST(test_library_row_buffers, failures);
+    RUN_TEST(test_library_spec_parse, failures);
+    RUN_TEST(test_library_threads, failures);
+
+    return failures;
+}
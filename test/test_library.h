@@ -0,0 +1,19 @@
+/**
+ * @file test_library.h
+ * @brief Tests for the embeddable table interface
+ *
+ * Defines the function prototypes for testing the row iterator against
+ * the printed tables and across threads.
+ */
+
+#ifndef TEST_LIBRARY_H
+#define TEST_LIBRARY_H
+
+/**
+ * @brief Run all tests for the embeddable table interface
+ *
+ * @return int Number of failed tests
+ */
+int run_library_tests(void);
+
+#endif /* TEST_LIBRARY_H */
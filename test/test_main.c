@@ -4,6 +4,11 @@
  *
  * Orchestrates the execution of all test suites.
  *
+ * Usage: timestable_test [-j jobs] [-n]
+ *   -j jobs  Run up to jobs suites at once, each in its own process
+ *            (default: the number of online CPUs)
+ *   -n       Run the suites one by one in this process, without forking
+ *
  * @author Claude
  * @date March 25, 2025
  */
@@ -12,44 +17,90 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <unistd.h>
 #include "test_framework.h"
+#include "test_runner.h"
 #include "test_table_operations.h"
 #include "test_table_formatter.h"
 #include "test_cli.h"
+#include "test_bigint.h"
+#include "test_plugin.h"
+#include "test_expression.h"
+#include "test_browser.h"
+#include "test_async.h"
+#include "test_pipeline.h"
+#include "test_scheduler.h"
+#include "test_checkpoint.h"
+#include "test_shard.h"
+#include "test_find.h"
+#include "test_aggregate.h"
+#include "test_decimal.h"
+#include "test_library.h"
+#include "test_trace.h"
 
 /**
  * @brief Main entry point for test execution
  *
+ * @param argc Number of arguments
+ * @param argv Arguments: -j jobs and -n
  * @return int EXIT_SUCCESS if all tests pass, EXIT_FAILURE otherwise
  */
-int main(void)
+int main(int argc, char *argv[])
 {
     int failed_tests = 0;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int jobs = (cpus > 0) ? (int)cpus : 1;
+    bool isolate = true;
+    int option;
     TestSuite suites[] = {
         {"Table Operations", run_table_operations_tests},
         {"Table Formatter", run_table_formatter_tests},
-        {"Command Line Interface", run_cli_tests}
+        {"Command Line Interface", run_cli_tests},
+        {"Big Integer", run_bigint_tests},
+        {"Plugin Loader", run_plugin_tests},
+        {"Expression", run_expression_tests},
+        {"Viewport Browser", run_browser_tests},
+        {"Asynchronous Writer", run_async_tests},
+        {"Table Pipeline", run_pipeline_tests},
+        {"Work-Stealing Scheduler", run_scheduler_tests},
+        {"Output Checkpoint", run_checkpoint_tests},
+        {"Sharded Generation", run_shard_tests},
+        {"Inverse Lookup", run_find_tests},
+        {"Table Aggregates", run_aggregate_tests},
+        {"Quotient Formatting", run_decimal_tests},
+        {"Embeddable Library", run_library_tests},
+        {"Render Timeline", run_trace_tests}
     };
     int num_suites = sizeof(suites) / sizeof(suites[0]);
 
-    printf("===== TIMESTABLE TEST SUITE =====\n\n");
-
-    for (int i = 0; i < num_suites; i++)
+    while ((option = getopt(argc, argv, "j:n")) != -1)
     {
-        printf("Running %s tests...\n", suites[i].name);
-        int suite_failures = suites[i].run_tests();
-        if (suite_failures > 0)
-        {
-            printf("  %d tests FAILED in %s suite\n", suite_failures, suites[i].name);
-            failed_tests += suite_failures;
-        }
-        else
+        switch (option)
         {
-            printf("  All tests PASSED in %s suite\n", suites[i].name);
+            case 'j':
+                jobs = atoi(optarg);
+                if (jobs < 1)
+                {
+                    fprintf(stderr, "Invalid job count: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'n':
+                isolate = false;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-j jobs] [-n]\n", argv[0]);
+                return EXIT_FAILURE;
         }
-        printf("\n");
     }
 
+    /* Tests parse their own argument vectors with getopt() */
+    optind = 0;
+
+    printf("===== TIMESTABLE TEST SUITE =====\n\n");
+
+    failed_tests = test_run_suites(suites, num_suites, jobs, isolate);
+
     printf("===== TEST SUMMARY =====\n");
     if (failed_tests > 0)
     {
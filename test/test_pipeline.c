@@ -0,0 +1,209 @@
+/**
+ * @file test_pipeline.c
+ * @brief Implementation of tests for the table pipeline
+ *
+ * Passes numbered items through a small ring from a producer thread, and
+ * checks that pipelined tables match the serial renderer byte for byte.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "test_framework.h"
+#include "test_helpers.h"
+#include "test_pipeline.h"
+#include "timestable_pipeline.h"
+#include "timestable_formatter.h"
+#include "timestable_operations.h"
+
+#define TEST_ITEMS 10000
+#define BUFFER_SIZE 4096
+
+/**
+ * @brief Producer thread: publish TEST_ITEMS numbered slots, then close
+ *
+ * @param argument spsc_ring_t to produce into
+ * @return void* NULL
+ */
+static void *produce_items(void *argument)
+{
+    spsc_ring_t *ring = argument;
+    uint64_t wait_ns = 0;
+
+    for (int item = 0; item < TEST_ITEMS; item++) {
+        int *slot = spsc_ring_reserve(ring, &wait_ns);
+
+        if (NULL == slot) {
+            break;
+        }
+        *slot = item;
+        spsc_ring_commit(ring, sizeof(*slot) + (size_t)item % 3);
+    }
+
+    spsc_ring_close(ring);
+    return NULL;
+}
+
+/**
+ * @brief Test ordered delivery and backpressure through a ring
+ *
+ * @return int Number of failed tests
+ */
+static int test_ring_order(void)
+{
+    int failures = 0;
+    spsc_ring_t ring;
+    pthread_t producer;
+    int expected = 0;
+    bool in_order = true;
+    uint64_t wait_ns = 0;
+    const int *slot;
+    size_t length;
+
+    if (!spsc_ring_init(&ring, 4, sizeof(int))) {
+        printf("  ERROR: Failed to allocate the ring\n");
+        return 1;
+    }
+
+    pthread_create(&producer, NULL, produce_items, &ring);
+    while (NULL != (slot = spsc_ring_front(&ring, &length, &wait_ns))) {
+        if (*slot != expected || length != sizeof(int) + (size_t)expected % 3) {
+            in_order = false;
+        }
+        expected++;
+        spsc_ring_pop(&ring);
+    }
+    pthread_join(producer, NULL);
+
+    TEST_ASSERT(in_order, "Items should arrive in order with their lengths", failures);
+    TEST_ASSERT(expected == TEST_ITEMS, "Every item should arrive before the end", failures);
+
+    spsc_ring_free(&ring);
+    return failures;
+}
+
+/**
+ * @brief Test that aborting a ring stops its producer
+ *
+ * @return int Number of failed tests
+ */
+static int test_ring_abort(void)
+{
+    int failures = 0;
+    spsc_ring_t ring;
+    pthread_t producer;
+    uint64_t wait_ns = 0;
+    size_t length;
+
+    if (!spsc_ring_init(&ring, 2, sizeof(int))) {
+        printf("  ERROR: Failed to allocate the ring\n");
+        return 1;
+    }
+
+    pthread_create(&producer, NULL, produce_items, &ring);
+    TEST_ASSERT(NULL != spsc_ring_front(&ring, &length, &wait_ns), "First item should arrive", failures);
+    spsc_ring_abort(&ring);
+
+    /* The producer is blocked on the full ring; it must exit without more pops */
+    pthread_join(producer, NULL);
+    TEST_ASSERT(NULL == spsc_ring_reserve(&ring, &wait_ns), "Reserve should fail after abort", failures);
+
+    spsc_ring_free(&ring);
+    return failures;
+}
+
+/**
+ * @brief Execute the serial renderer on a division table with zero columns
+ *
+ * For use with capture_stdout
+ */
+static void execute_serial(void)
+{
+    print_table(0, 12, divide, DIV_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute the pipelined renderer on the same table
+ *
+ * For use with capture_stdout
+ */
+static void execute_pipelined(void)
+{
+    print_table_pipelined(0, 12, divide, DIV_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute the pipelined renderer on a hexadecimal power table
+ *
+ * For use with capture_stdout
+ */
+static void execute_pipelined_hex(void)
+{
+    print_table_pipelined(1, 6, power, POWER_TABLE_TITLE, FORMAT_HEX);
+}
+
+/**
+ * @brief Execute the serial renderer on the same hexadecimal table
+ *
+ * For use with capture_stdout
+ */
+static void execute_serial_hex(void)
+{
+    print_table(1, 6, power, POWER_TABLE_TITLE, FORMAT_HEX);
+}
+
+/**
+ * @brief Test that pipelined tables match print_table() and are counted
+ *
+ * @return int Number of failed tests
+ */
+static int test_pipelined_table(void)
+{
+    int failures = 0;
+    char serial[BUFFER_SIZE];
+    char pipelined[BUFFER_SIZE];
+    pipeline_stats_t stats;
+
+    memset(&stats, 0, sizeof(stats));
+    pipeline_set_stats(&stats);
+
+    if (!capture_stdout(execute_serial, serial, BUFFER_SIZE) ||
+        !capture_stdout(execute_pipelined, pipelined, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        pipeline_set_stats(NULL);
+        return 1;
+    }
+    TEST_ASSERT(NULL != strstr(serial, "UDF") && 0 == strcmp(serial, pipelined),
+                "Pipelined division table should match the serial one", failures);
+
+    if (!capture_stdout(execute_serial_hex, serial, BUFFER_SIZE) ||
+        !capture_stdout(execute_pipelined_hex, pipelined, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        pipeline_set_stats(NULL);
+        return failures + 1;
+    }
+    TEST_ASSERT(0 == strcmp(serial, pipelined),
+                "Pipelined hexadecimal table should match the serial one", failures);
+
+    pipeline_set_stats(NULL);
+    TEST_ASSERT(stats.rows == 13 + 6, "Statistics should count every written row", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Run all tests for the table pipeline
+ *
+ * @return int Number of failed tests
+ */
+int run_pipeline_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_ring_order, failures);
+    RUN_TEST(test_ring_abort, failures);
+    RUN_TEST(test_pipelined_table, failures);
+
+    return failures;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file test_pipeline.h
+ * @brief Tests for the pipelined table renderer
+ *
+ * Defines the function prototypes for testing the single-producer/
+ * single-consumer rings and the pipelined print_table().
+ */
+
+#ifndef TEST_PIPELINE_H
+#define TEST_PIPELINE_H
+
+/**
+ * @brief Run all tests for the table pipeline
+ *
+ * @return int Number of failed tests
+ */
+int run_pipeline_tests(void);
+
+#endif /* TEST_PIPELINE_H */
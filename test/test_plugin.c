@@ -0,0 +1,85 @@
+/**
+ * @file test_plugin.c
+ * @brief Implementation of tests for plugin loading
+ *
+ * Uses the example plugin built by "make plugins", which "make test"
+ * builds before running the tests.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "test_framework.h"
+#include "test_plugin.h"
+#include "timestable_plugin.h"
+
+/* Example plugin built by the plugins target */
+#define EXAMPLE_PLUGIN "bin/plugins/timestable_bitops.so"
+
+/**
+ * @brief Test loading an operation from the example plugin
+ *
+ * @return int Number of failed tests
+ */
+static int test_plugin_open(void)
+{
+    int failures = 0;
+    plugin_t plugin;
+    plugin_error_t error;
+    uint64_t values[4];
+
+    error = plugin_open(EXAMPLE_PLUGIN, "xor", &plugin);
+    TEST_ASSERT(error.code == PLUGIN_SUCCESS, "Example plugin should load", failures);
+    if (error.code != PLUGIN_SUCCESS) {
+        return failures;
+    }
+
+    /* 5 ^ (1..4) = 4 7 6 1 */
+    plugin.operation.kernel(plugin.operation.context, 5, 1, 4, values);
+    TEST_ASSERT(values[0] == 4 && values[1] == 7 && values[2] == 6 && values[3] == 1,
+                "Plugin kernel should compute a whole row", failures);
+    TEST_ASSERT(plugin.operation.value_bound(plugin.operation.context, 1, 10) == 15,
+                "Plugin value bound should be available for width calculation", failures);
+    TEST_ASSERT(plugin.title != NULL, "Plugin operation should have a title", failures);
+
+    plugin_close(&plugin);
+    TEST_ASSERT(plugin.handle == NULL, "Closing should clear the handle", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test plugin loading errors
+ *
+ * @return int Number of failed tests
+ */
+static int test_plugin_errors(void)
+{
+    int failures = 0;
+    plugin_t plugin;
+    plugin_error_t error;
+
+    error = plugin_open("bin/plugins/does_not_exist.so", "xor", &plugin);
+    TEST_ASSERT(error.code == PLUGIN_ERROR_OPEN, "Missing file should fail to open", failures);
+    TEST_ASSERT(error.message != NULL, "Errors should have a message", failures);
+
+    error = plugin_open(EXAMPLE_PLUGIN, "no_such_op", &plugin);
+    TEST_ASSERT(error.code == PLUGIN_ERROR_OPERATION, "Unknown operation should be rejected", failures);
+    TEST_ASSERT(plugin.handle == NULL, "Failed loads should not leak the handle", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Run all tests for the plugin loader
+ *
+ * @return int Number of failed tests
+ */
+int run_plugin_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_plugin_open, failures);
+    RUN_TEST(test_plugin_errors, failures);
+
+    return failures;
+}
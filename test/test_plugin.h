@@ -0,0 +1,18 @@
+/**
+ * @file test_plugin.h
+ * @brief Tests for plugin loading
+ *
+ * Defines the function prototypes for testing the plugin loader.
+ */
+
+#ifndef TEST_PLUGIN_H
+#define TEST_PLUGIN_H
+
+/**
+ * @brief Run all tests for the plugin loader
+ *
+ * @return int Number of failed tests
+ */
+int run_plugin_tests(void);
+
+#endif /* TEST_PLUGIN_H */
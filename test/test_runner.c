@@ -0,0 +1,504 @@
+/**
+ * @file test_runner.c
+ * @brief Implementation of the parallel test runner
+ *
+ * Every suite is forked with its stdout and stderr on one pipe and the
+ * RUN_TEST records on another. The parent polls all running suites, so a
+ * chatty suite never blocks on a full pipe while another is being read.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "test_framework.h"
+#include "test_runner.h"
+
+/**
+ * @brief Longest test name kept in a record, including the terminator
+ */
+#define TEST_NAME_SIZE 64
+
+/**
+ * @brief Bytes read from a suite pipe at a time
+ */
+#define READ_CHUNK 4096
+
+/**
+ * @brief Outcome of one test, or of the whole suite if the name is empty
+ */
+typedef struct {
+    char name[TEST_NAME_SIZE];  /**< Test function name */
+    int failures;               /**< Failed assertions */
+    double milliseconds;        /**< Wall time of the test */
+} test_result_t;
+
+/**
+ * @brief Growable byte buffer
+ */
+typedef struct {
+    char *data;                 /**< Bytes collected so far */
+    size_t length;              /**< Number of bytes collected */
+    size_t capacity;            /**< Size of the allocation */
+} byte_buffer_t;
+
+/**
+ * @brief State of one suite being run
+ */
+typedef struct {
+    const TestSuite *suite;     /**< Suite being run */
+    pid_t pid;                  /**< Child running the suite */
+    int output_fd;              /**< Read end of the output pipe, or -1 */
+    int result_fd;              /**< Read end of the result pipe, or -1 */
+    byte_buffer_t output;       /**< Captured stdout and stderr */
+    byte_buffer_t results;      /**< test_result_t records */
+    double start;               /**< Start time in milliseconds */
+    double elapsed;             /**< Wall time in milliseconds */
+    int status;                 /**< Wait status of the child */
+    bool started;               /**< The suite was started */
+    bool done;                  /**< The suite finished and was reaped */
+} suite_run_t;
+
+/**
+ * @brief One entry of the slowest-tests summary
+ */
+typedef struct {
+    const char *suite;          /**< Suite name */
+    const test_result_t *test;  /**< Test record */
+} timed_test_t;
+
+/* Where test_record() sends records: a pipe in a forked suite, else memory */
+static int record_fd = -1;
+static byte_buffer_t *record_buffer = NULL;
+
+/**
+ * @brief Read a monotonic clock
+ *
+ * @return double Milliseconds since an arbitrary start
+ */
+double test_clock_ms(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e3 + (double)now.tv_nsec / 1e6;
+}
+
+/**
+ * @brief Append bytes to a buffer
+ *
+ * @param buffer Buffer to append to
+ * @param data Bytes to append
+ * @param length Number of bytes
+ * @return bool true on success, false if memory ran out
+ */
+static bool append_bytes(byte_buffer_t *buffer, const void *data, size_t length)
+{
+    if (buffer->length + length > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : READ_CHUNK;
+        char *data_new;
+
+        while (capacity < buffer->length + length) {
+            capacity *= 2;
+        }
+        data_new = realloc(buffer->data, capacity);
+        if (data_new == NULL) {
+            return false;
+        }
+        buffer->data = data_new;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    return true;
+}
+
+/**
+ * @brief Write a whole record to a pipe
+ *
+ * @param fd Write end of the pipe
+ * @param data Bytes to write
+ * @param length Number of bytes (at most PIPE_BUF, so the write is atomic)
+ */
+static void write_record(int fd, const void *data, size_t length)
+{
+    ssize_t written;
+
+    do {
+        written = write(fd, data, length);
+    } while (written < 0 && errno == EINTR);
+}
+
+/**
+ * @brief Record the outcome of one test for the runner
+ *
+ * @param name Test function name, or "" for the suite total
+ * @param failures Failed assertions
+ * @param milliseconds Wall time of the test
+ */
+void test_record(const char *name, int failures, double milliseconds)
+{
+    test_result_t result;
+
+    memset(&result, 0, sizeof(result));
+    strncpy(result.name, name, sizeof(result.name) - 1);
+    result.failures = failures;
+    result.milliseconds = milliseconds;
+
+    if (record_fd >= 0) {
+        write_record(record_fd, &result, sizeof(result));
+    } else if (record_buffer != NULL) {
+        append_bytes(record_buffer, &result, sizeof(result));
+    }
+}
+
+/**
+ * @brief Run a suite and record its total
+ *
+ * @param suite Suite to run
+ */
+static void run_suite_body(const TestSuite *suite)
+{
+    double start = test_clock_ms();
+    int failures = suite->run_tests();
+
+    test_record("", failures, test_clock_ms() - start);
+}
+
+/**
+ * @brief Fork a child running one suite
+ *
+ * @param run Suite to start
+ * @return bool true if the child was started
+ */
+static bool start_suite(suite_run_t *run)
+{
+    int output_pipe[2];
+    int result_pipe[2];
+
+    if (pipe(output_pipe) == -1) {
+        return false;
+    }
+    if (pipe(result_pipe) == -1) {
+        close(output_pipe[0]);
+        close(output_pipe[1]);
+        return false;
+    }
+
+    /* Anything still buffered would be written by both processes */
+    fflush(stdout);
+    fflush(stderr);
+
+    run->start = test_clock_ms();
+    run->pid = fork();
+    if (run->pid == -1) {
+        close(output_pipe[0]);
+        close(output_pipe[1]);
+        close(result_pipe[0]);
+        close(result_pipe[1]);
+        return false;
+    }
+
+    if (run->pid == 0) {
+        close(output_pipe[0]);
+        close(result_pipe[0]);
+        dup2(output_pipe[1], STDOUT_FILENO);
+        dup2(output_pipe[1], STDERR_FILENO);
+        close(output_pipe[1]);
+
+        /* Keep report lines out of the buffers of tests that capture stdout */
+        setvbuf(stdout, NULL, _IOLBF, 0);
+        record_fd = result_pipe[1];
+
+        run_suite_body(run->suite);
+        fflush(stdout);
+        _exit(EXIT_SUCCESS);
+    }
+
+    close(output_pipe[1]);
+    close(result_pipe[1]);
+    run->output_fd = output_pipe[0];
+    run->result_fd = result_pipe[0];
+    run->started = true;
+    return true;
+}
+
+/**
+ * @brief Read what is available on one suite pipe
+ *
+ * @param fd Pipe to read; set to -1 at end of file
+ * @param buffer Buffer to append to
+ */
+static void drain_pipe(int *fd, byte_buffer_t *buffer)
+{
+    char chunk[READ_CHUNK];
+    ssize_t length = read(*fd, chunk, sizeof(chunk));
+
+    if (length < 0 && errno == EINTR) {
+        return;
+    }
+
+    if (length <= 0 || !append_bytes(buffer, chunk, (size_t)length)) {
+        close(*fd);
+        *fd = -1;
+    }
+}
+
+/**
+ * @brief Wait until some running suite makes progress, and reap finished ones
+ *
+ * @param runs All suites
+ * @param count Number of suites
+ * @return int Number of suites reaped
+ */
+static int poll_suites(suite_run_t *runs, int count)
+{
+    struct pollfd fds[2 * count];
+    byte_buffer_t *buffers[2 * count];
+    int *descriptors[2 * count];
+    int watched = 0;
+    int reaped = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (runs[i].started && !runs[i].done) {
+            int *pipe_fds[2] = {&runs[i].output_fd, &runs[i].result_fd};
+            byte_buffer_t *pipe_buffers[2] = {&runs[i].output, &runs[i].results};
+
+            for (int p = 0; p < 2; p++) {
+                if (*pipe_fds[p] >= 0) {
+                    fds[watched].fd = *pipe_fds[p];
+                    fds[watched].events = POLLIN;
+                    fds[watched].revents = 0;
+                    buffers[watched] = pipe_buffers[p];
+                    descriptors[watched] = pipe_fds[p];
+                    watched++;
+                }
+            }
+        }
+    }
+
+    if (watched > 0 && poll(fds, (nfds_t)watched, -1) > 0) {
+        for (int i = 0; i < watched; i++) {
+            if (fds[i].revents != 0) {
+                drain_pipe(descriptors[i], buffers[i]);
+            }
+        }
+    }
+
+    /* A suite is over once both of its pipes are closed */
+    for (int i = 0; i < count; i++) {
+        if (runs[i].started && !runs[i].done && runs[i].output_fd < 0 && runs[i].result_fd < 0) {
+            while (waitpid(runs[i].pid, &runs[i].status, 0) == -1 && errno == EINTR) {
+            }
+            runs[i].elapsed = test_clock_ms() - runs[i].start;
+            runs[i].done = true;
+            reaped++;
+        }
+    }
+
+    return reaped;
+}
+
+/**
+ * @brief Print the output and verdict of a finished suite
+ *
+ * @param run Finished suite
+ * @return int Number of failed tests, counting a crash as one
+ */
+static int report_suite(const suite_run_t *run)
+{
+    const test_result_t *results = (const test_result_t *)(const void *)run->results.data;
+    size_t result_count = run->results.length / sizeof(test_result_t);
+    int failures = 0;
+    bool finished = false;
+
+    for (size_t i = 0; i < result_count; i++) {
+        if (results[i].name[0] == '\0') {
+            failures = results[i].failures;
+            finished = true;
+        }
+    }
+
+    printf("Running %s tests...\n", run->suite->name);
+    fwrite(run->output.data ? run->output.data : "", 1, run->output.length, stdout);
+
+    if (!finished) {
+        if (WIFSIGNALED(run->status)) {
+            printf("  Suite %s crashed (signal %d)\n", run->suite->name, WTERMSIG(run->status));
+        } else {
+            printf("  Suite %s did not finish\n", run->suite->name);
+        }
+
+        for (size_t i = 0; i < result_count; i++) {
+            failures += results[i].failures;
+        }
+        if (failures == 0) {
+            failures = 1;
+        }
+    }
+
+    if (failures > 0) {
+        printf("  %d tests FAILED in %s suite (%.3f ms)\n", failures, run->suite->name, run->elapsed);
+    } else {
+        printf("  All tests PASSED in %s suite (%.3f ms)\n", run->suite->name, run->elapsed);
+    }
+    printf("\n");
+
+    return failures;
+}
+
+/**
+ * @brief Order timed tests from slowest to fastest for qsort()
+ *
+ * @param left First test
+ * @param right Second test
+ * @return int Negative if left is slower, positive if faster
+ */
+static int compare_slowest(const void *left, const void *right)
+{
+    double a = ((const timed_test_t *)left)->test->milliseconds;
+    double b = ((const timed_test_t *)right)->test->milliseconds;
+
+    return (a < b) - (a > b);
+}
+
+/**
+ * @brief Print the slowest tests of all suites
+ *
+ * @param runs All suites
+ * @param count Number of suites
+ */
+static void report_slowest(const suite_run_t *runs, int count)
+{
+    size_t total = 0;
+    size_t shown;
+    timed_test_t *tests;
+
+    for (int i = 0; i < count; i++) {
+        total += runs[i].results.length / sizeof(test_result_t);
+    }
+
+    tests = malloc((total ? total : 1) * sizeof(*tests));
+    if (tests == NULL) {
+        return;
+    }
+
+    total = 0;
+    for (int i = 0; i < count; i++) {
+        const test_result_t *results = (const test_result_t *)(const void *)runs[i].results.data;
+        size_t result_count = runs[i].results.length / sizeof(test_result_t);
+
+        for (size_t j = 0; j < result_count; j++) {
+            if (results[j].name[0] != '\0') {
+                tests[total].suite = runs[i].suite->name;
+                tests[total].test = &results[j];
+                total++;
+            }
+        }
+    }
+
+    qsort(tests, total, sizeof(*tests), compare_slowest);
+    shown = (total < TEST_SLOWEST_COUNT) ? total : TEST_SLOWEST_COUNT;
+
+    printf("===== SLOWEST TESTS =====\n");
+    for (size_t i = 0; i < shown; i++) {
+        printf("  %10.3f ms  %s (%s)\n", tests[i].test->milliseconds, tests[i].test->name,
+               tests[i].suite);
+    }
+    printf("\n");
+
+    free(tests);
+}
+
+/**
+ * @brief Run test suites and print their results
+ *
+ * @param suites Suites to run
+ * @param count Number of suites
+ * @param jobs Most suites running at once (at least 1)
+ * @param isolate Fork each suite; false runs them one by one in this process
+ * @return int Number of failed tests, counting a crashed suite as one
+ */
+int test_run_suites(const TestSuite *suites, int count, int jobs, bool isolate)
+{
+    suite_run_t *runs = calloc((size_t)(count ? count : 1), sizeof(*runs));
+    int failures = 0;
+    int next = 0;
+    int running = 0;
+    int reported = 0;
+
+    if (runs == NULL) {
+        printf("ERROR: Out of memory\n");
+        return 1;
+    }
+
+    for (int i = 0; i < count; i++) {
+        runs[i].suite = &suites[i];
+        runs[i].output_fd = -1;
+        runs[i].result_fd = -1;
+    }
+
+    while (reported < count) {
+        /* Suites that cannot be forked run here, after the running ones */
+        while (next < count && (!isolate || running < jobs)) {
+            if (isolate && start_suite(&runs[next])) {
+                running++;
+            } else if (running == 0) {
+                printf("Running %s tests...\n", runs[next].suite->name);
+                record_buffer = &runs[next].results;
+                runs[next].start = test_clock_ms();
+                run_suite_body(runs[next].suite);
+                runs[next].elapsed = test_clock_ms() - runs[next].start;
+                record_buffer = NULL;
+                runs[next].done = true;
+
+                /* Its output is already on stdout; report it before the next one */
+                runs[next].started = false;
+                next++;
+                break;
+            } else {
+                break;
+            }
+            next++;
+        }
+
+        if (running > 0) {
+            running -= poll_suites(runs, count);
+        }
+
+        while (reported < count && runs[reported].done) {
+            if (runs[reported].started) {
+                failures += report_suite(&runs[reported]);
+            } else {
+                const test_result_t *results = (const test_result_t *)(const void *)runs[reported].results.data;
+                size_t result_count = runs[reported].results.length / sizeof(test_result_t);
+                int suite_failures = (result_count > 0) ? results[result_count - 1].failures : 1;
+
+                if (suite_failures > 0) {
+                    printf("  %d tests FAILED in %s suite (%.3f ms)\n", suite_failures,
+                           runs[reported].suite->name, runs[reported].elapsed);
+                } else {
+                    printf("  All tests PASSED in %s suite (%.3f ms)\n",
+                           runs[reported].suite->name, runs[reported].elapsed);
+                }
+                printf("\n");
+                failures += suite_failures;
+            }
+            reported++;
+        }
+    }
+
+    report_slowest(runs, count);
+
+    for (int i = 0; i < count; i++) {
+        free(runs[i].output.data);
+        free(runs[i].results.data);
+    }
+    free(runs);
+    return failures;
+}
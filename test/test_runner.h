@@ -0,0 +1,36 @@
+/**
+ * @file test_runner.h
+ * @brief Parallel test runner with one process per suite
+ *
+ * Defines the entry point that runs the test suites, each in its own
+ * forked process, and reports their output, timings and failures.
+ */
+
+#ifndef TEST_RUNNER_H
+#define TEST_RUNNER_H
+
+#include <stdbool.h>
+#include "test_framework.h"
+
+/**
+ * @brief Number of tests listed in the slowest-tests summary
+ */
+#define TEST_SLOWEST_COUNT 10
+
+/**
+ * @brief Run test suites and print their results
+ *
+ * With isolation each suite runs in a forked child whose output and test
+ * results come back through pipes, up to jobs children at a time. A
+ * suite that crashes counts as failed without stopping the others. The
+ * output of every suite is printed whole and in suite order.
+ *
+ * @param suites Suites to run
+ * @param count Number of suites
+ * @param jobs Most suites running at once (at least 1)
+ * @param isolate Fork each suite; false runs them one by one in this process
+ * @return int Number of failed tests, counting a crashed suite as one
+ */
+int test_run_suites(const TestSuite *suites, int count, int jobs, bool isolate);
+
+#endif /* TEST_RUNNER_H */
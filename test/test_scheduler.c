@@ -0,0 +1,147 @@
+/**
+ * @file test_scheduler.c
+ * @brief Implementation of tests for the work-stealing scheduler
+ *
+ * Runs batches of uneven tasks and checks that each runs exactly once, and
+ * that tables rendered in parallel match the serial output byte for byte.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_framework.h"
+#include "test_helpers.h"
+#include "test_scheduler.h"
+#include "timestable_scheduler.h"
+#include "timestable_formatter.h"
+#include "timestable_operations.h"
+
+#define TEST_TASKS 1000
+#define BUFFER_SIZE 8192
+
+/**
+ * @brief Task counting its runs, with cost growing with the task number
+ *
+ * @param context Array of TEST_TASKS run counters
+ * @param index Task number
+ */
+static void count_task(void *context, size_t index)
+{
+    int *runs = context;
+    volatile uint64_t sink = 0;
+
+    for (size_t i = 0; i < index * 50; i++) {
+        sink += i;
+    }
+    __atomic_fetch_add(&runs[index], 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Test that every task runs exactly once for several pool sizes
+ *
+ * @return int Number of failed tests
+ */
+static int test_scheduler_run(void)
+{
+    int failures = 0;
+    static int runs[TEST_TASKS];
+    const int pool_sizes[] = {1, 2, 7, 32};
+    scheduler_stats_t stats;
+
+    for (size_t p = 0; p < sizeof(pool_sizes) / sizeof(pool_sizes[0]); p++) {
+        bool once = true;
+
+        memset(runs, 0, sizeof(runs));
+        TEST_ASSERT(scheduler_run(TEST_TASKS, count_task, runs, pool_sizes[p], &stats),
+                    "Batch should run", failures);
+
+        for (int i = 0; i < TEST_TASKS; i++) {
+            once = once && 1 == runs[i];
+        }
+        TEST_ASSERT(once, "Every task should run exactly once", failures);
+        TEST_ASSERT(stats.executed == TEST_TASKS, "Statistics should count every task", failures);
+        TEST_ASSERT(pool_sizes[p] > 1 || 0 == stats.stolen, "A single worker has nothing to steal", failures);
+    }
+
+    TEST_ASSERT(scheduler_run(0, count_task, runs, 4, &stats) && 0 == stats.executed,
+                "An empty batch should succeed", failures);
+    TEST_ASSERT(!scheduler_run(1, count_task, runs, 0, NULL),
+                "A pool without workers should be refused", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Modular multiplication table shared by the execute functions
+ */
+static const modulus_t test_modulus = {7};
+static const row_operation_t test_mod_multiply = {
+    mod_multiply_row, mod_multiply_bound, &test_modulus, false, true, false
+};
+
+/**
+ * @brief Execute the serial renderers on three tables
+ *
+ * For use with capture_stdout
+ */
+static void execute_serial(void)
+{
+    print_table(0, 12, divide, DIV_TABLE_TITLE, FORMAT_DECIMAL);
+    print_table(1, 9, power, POWER_TABLE_TITLE, FORMAT_DECIMAL);
+    print_row_table(0, 12, &test_mod_multiply, MOD_MULT_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute the parallel renderer on the same tables
+ *
+ * For use with capture_stdout
+ */
+static void execute_parallel(void)
+{
+    const table_job_t jobs[] = {
+        {0, 12, DIV_TABLE_TITLE, FORMAT_DECIMAL, divide, NULL},
+        {1, 9, POWER_TABLE_TITLE, FORMAT_DECIMAL, power, NULL},
+        {0, 12, MOD_MULT_TABLE_TITLE, FORMAT_DECIMAL, NULL, &test_mod_multiply}
+    };
+
+    print_tables_parallel(jobs, 3, 4, NULL);
+}
+
+/**
+ * @brief Test that parallel tables are stitched back in order
+ *
+ * @return int Number of failed tests
+ */
+static int test_parallel_tables(void)
+{
+    int failures = 0;
+    static char serial[BUFFER_SIZE];
+    static char parallel[BUFFER_SIZE];
+
+    if (!capture_stdout(execute_serial, serial, BUFFER_SIZE) ||
+        !capture_stdout(execute_parallel, parallel, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    TEST_ASSERT(strlen(serial) > 0 && strlen(serial) < BUFFER_SIZE - 1,
+                "Serial tables should fit the capture buffer", failures);
+    TEST_ASSERT(0 == strcmp(serial, parallel), "Parallel tables should match the serial ones", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Run all tests for the work-stealing scheduler
+ *
+ * @return int Number of failed tests
+ */
+int run_scheduler_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_scheduler_run, failures);
+    RUN_TEST(test_parallel_tables, failures);
+
+    return failures;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file test_scheduler.h
+ * @brief Tests for the work-stealing scheduler
+ *
+ * Defines the function prototypes for testing the scheduler and the
+ * parallel table renderer.
+ */
+
+#ifndef TEST_SCHEDULER_H
+#define TEST_SCHEDULER_H
+
+/**
+ * @brief Run all tests for the work-stealing scheduler
+ *
+ * @return int Number of failed tests
+ */
+int run_scheduler_tests(void);
+
+#endif /* TEST_SCHEDULER_H */
@@ -0,0 +1,239 @@
+/**
+ * @file test_shard.c
+ * @brief Implementation of tests for sharded table generation
+ *
+ * Checks that the bands of all shards cover every row exactly once and
+ * that the shards of a table concatenate into the unsharded output.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_framework.h"
+#include "test_helpers.h"
+#include "test_shard.h"
+#include "timestable_shard.h"
+#include "timestable_output.h"
+#include "timestable_formatter.h"
+#include "timestable_operations.h"
+
+#define BUFFER_SIZE 32768
+#define TEST_SHARDS 5
+
+/* A table well past the default -M limit, written through files */
+#define LARGE_MAX 2000
+
+/**
+ * @brief Test that consecutive bands cover the rows without gaps
+ *
+ * @return int Number of failed tests
+ */
+static int test_shard_rows(void)
+{
+    int failures = 0;
+    const int shard_counts[] = {1, 2, 3, 8, 40};
+
+    for (size_t s = 0; s < sizeof(shard_counts) / sizeof(shard_counts[0]); s++) {
+        int next = 1;
+        bool contiguous = true;
+
+        for (int i = 0; i < shard_counts[s]; i++) {
+            shard_band_t band = shard_rows(1, 20, shard_cost_uniform, i, shard_counts[s]);
+
+            if (band.first_row <= band.last_row) {
+                contiguous = contiguous && band.first_row == next;
+                next = band.last_row + 1;
+            }
+            if (0 == i) {
+                TEST_ASSERT(1 == band.first_row && band.last_row >= 1,
+                            "Shard 0 should start with the first row", failures);
+            }
+        }
+        TEST_ASSERT(contiguous && 21 == next, "Bands should cover every row once", failures);
+    }
+
+    return failures;
+}
+
+/**
+ * @brief Test that exact power bands balance cost rather than rows
+ *
+ * @return int Number of failed tests
+ */
+static int test_shard_cost(void)
+{
+    int failures = 0;
+    shard_band_t first = shard_rows(0, 1000, shard_cost_big_power, 0, 4);
+    shard_band_t last = shard_rows(0, 1000, shard_cost_big_power, 3, 4);
+
+    TEST_ASSERT(first.last_row - first.first_row > last.last_row - last.first_row,
+                "Cheap small rows should get a wider band", failures);
+    TEST_ASSERT(1000 == last.last_row, "The last shard should end with the last row", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Shard currently printed by execute_shard
+ */
+static int current_shard = 0;
+
+/**
+ * @brief Execute the division table unsharded
+ *
+ * For use with capture_stdout
+ */
+static void execute_whole(void)
+{
+    print_table(0, 40, divide, DIV_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute one shard of the division table
+ *
+ * For use with capture_stdout
+ */
+static void execute_shard(void)
+{
+    shard_band_t band = shard_rows(0, 40, shard_cost_uniform, current_shard, TEST_SHARDS);
+
+    output_set_row_band(stdout, band.first_row, band.last_row);
+    print_table(0, 40, divide, DIV_TABLE_TITLE, FORMAT_DECIMAL);
+    output_set_row_band(NULL, 0, 0);
+}
+
+/**
+ * @brief Test that the shards concatenate into the whole table
+ *
+ * @return int Number of failed tests
+ */
+static int test_shard_concatenation(void)
+{
+    int failures = 0;
+    static char whole[BUFFER_SIZE];
+    static char joined[BUFFER_SIZE];
+    static char part[BUFFER_SIZE];
+
+    if (!capture_stdout(execute_whole, whole, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    joined[0] = '\0';
+    for (current_shard = 0; current_shard < TEST_SHARDS; current_shard++) {
+        if (!capture_stdout(execute_shard, part, BUFFER_SIZE)) {
+            printf("  ERROR: Failed to capture stdout\n");
+            return 1;
+        }
+        TEST_ASSERT((NULL != strstr(part, DIV_TABLE_TITLE)) == (0 == current_shard),
+                    "Only shard 0 should have the title", failures);
+        strncat(joined, part, BUFFER_SIZE - strlen(joined) - 1);
+    }
+
+    TEST_ASSERT(strlen(whole) < BUFFER_SIZE - 1, "Table should fit the capture buffer", failures);
+    TEST_ASSERT(0 == strcmp(whole, joined), "Shards should concatenate into the whole table", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Execute the large multiplication table unsharded
+ *
+ * For use with capture_stdout_file
+ */
+static void execute_large_whole(void)
+{
+    print_table(0, LARGE_MAX, multiply, MULT_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute one shard of the large multiplication table
+ *
+ * For use with capture_stdout_file
+ */
+static void execute_large_shard(void)
+{
+    shard_band_t band = shard_rows(0, LARGE_MAX, shard_cost_uniform, current_shard, TEST_SHARDS);
+
+    output_set_row_band(stdout, band.first_row, band.last_row);
+    print_table(0, LARGE_MAX, multiply, MULT_TABLE_TITLE, FORMAT_DECIMAL);
+    output_set_row_band(NULL, 0, 0);
+}
+
+/**
+ * @brief Compare the contents of two files from their beginning
+ *
+ * @param first First file
+ * @param second Second file
+ * @return bool true if both hold the same non-empty bytes
+ */
+static bool same_contents(FILE *first, FILE *second)
+{
+    static char first_block[BUFFER_SIZE];
+    static char second_block[BUFFER_SIZE];
+    size_t total = 0;
+    size_t length;
+
+    if (0 != fseek(first, 0, SEEK_SET) || 0 != fseek(second, 0, SEEK_SET)) {
+        return false;
+    }
+
+    do {
+        length = fread(first_block, 1, BUFFER_SIZE, first);
+        if (length != fread(second_block, 1, BUFFER_SIZE, second) ||
+            0 != memcmp(first_block, second_block, length)) {
+            return false;
+        }
+        total += length;
+    } while (BUFFER_SIZE == length);
+
+    return total > 0;
+}
+
+/**
+ * @brief Test that the shards of a table past the default limit concatenate
+ *
+ * The multiplication table mirrors a grid when printed whole, and is
+ * printed row by row one band at a time.
+ *
+ * @return int Number of failed tests
+ */
+static int test_shard_large_concatenation(void)
+{
+    int failures = 0;
+    FILE *whole = tmpfile();
+    FILE *joined = tmpfile();
+
+    if (NULL == whole || NULL == joined) {
+        printf("  ERROR: Failed to create a temporary file\n");
+        return 1;
+    }
+
+    TEST_ASSERT(capture_stdout_file(execute_large_whole, whole), "Whole table should print", failures);
+    for (current_shard = 0; current_shard < TEST_SHARDS; current_shard++) {
+        TEST_ASSERT(capture_stdout_file(execute_large_shard, joined), "Shard should print", failures);
+    }
+
+    TEST_ASSERT(same_contents(whole, joined), "Shards should concatenate into the whole table", failures);
+
+    fclose(joined);
+    fclose(whole);
+    return failures;
+}
+
+/**
+ * @brief Run all tests for sharded table generation
+ *
+ * @return int Number of failed tests
+ */
+int run_shard_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_shard_rows, failures);
+    RUN_TEST(test_shard_cost, failures);
+    RUN_TEST(test_shard_concatenation, failures);
+    RUN_TEST(test_shard_large_concatenation, failures);
+
+    return failures;
+}
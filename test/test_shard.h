@@ -0,0 +1,19 @@
+/**
+ * @file test_shard.h
+ * @brief Tests for sharded table generation
+ *
+ * Defines the function prototypes for testing row bands and the output
+ * of sharded tables.
+ */
+
+#ifndef TEST_SHARD_H
+#define TEST_SHARD_H
+
+/**
+ * @brief Run all tests for sharded table generation
+ *
+ * @return int Number of failed tests
+ */
+int run_shard_tests(void);
+
+#endif /* TEST_SHARD_H */
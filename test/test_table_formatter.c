@@ -38,6 +38,39 @@ static void mock_add(int row, int column, cell_value_t *result)
     result->str_value[0] = '\0';
 }
 
+/**
+ * @brief Mock symmetric row kernel whose cells outgrow its bound
+ *
+ * @param context Unused
+ * @param row Row value
+ * @param column First column value
+ * @param count Number of consecutive columns
+ * @param values Set to row × column × 1000000
+ */
+static void mock_wide_row(const void *context, int row, int column, int count, uint64_t *values)
+{
+    (void)context;
+    for (int i = 0; i < count; i++) {
+        values[i] = (uint64_t)row * (uint64_t)(column + i) * 1000000u;
+    }
+}
+
+/**
+ * @brief Mock bound that understates every cell of mock_wide_row
+ *
+ * @param context Unused
+ * @param min_value Minimum value for rows and columns
+ * @param max_value Maximum value for rows and columns
+ * @return uint64_t Always 0
+ */
+static uint64_t mock_wide_bound(const void *context, int min_value, int max_value)
+{
+    (void)context;
+    (void)min_value;
+    (void)max_value;
+    return 0;
+}
+
 /**
  * @brief Mock operation that returns non-numeric results
  *
@@ -93,6 +126,194 @@ static void execute_print_string_results(void)
     print_table(1, 3, mock_string_result, "Test String Results", FORMAT_DECIMAL);
 }
 
+/**
+ * @brief Execute print_big_power_table with decimal format
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_big_power(void)
+{
+    print_big_power_table(1, 12, POWER_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute print_row_table with the modular multiplication kernel
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_row_table(void)
+{
+    modulus_t modulus = { .modulus = 5 };
+    row_operation_t operation = {
+        .kernel      = mod_multiply_row,
+        .value_bound = mod_multiply_bound,
+        .context     = &modulus
+    };
+
+    print_row_table(1, 4, &operation, MOD_MULT_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute print_table with a symmetric operation spanning two tiles
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_symmetric(void)
+{
+    print_table(1, 20, multiply, MULT_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute print_row_table with cells wider than the bound allows
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_wide_symmetric(void)
+{
+    row_operation_t operation = {
+        .kernel       = mock_wide_row,
+        .value_bound  = mock_wide_bound,
+        .is_symmetric = true
+    };
+
+    print_row_table(1, 4, &operation, "Wide Table", FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute print_triangle_table with the multiplication operation
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_triangle(void)
+{
+    print_triangle_table(1, 4, multiply, NULL, MULT_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute print_records with the CSV writer
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_csv(void)
+{
+    print_records(0, 3, divide, NULL, DIV_TABLE_TITLE, FORMAT_DECIMAL, record_writer_find("csv"));
+}
+
+/**
+ * @brief Execute print_records with the JSON Lines writer
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_jsonl(void)
+{
+    print_records(0, 2, divide, NULL, DIV_TABLE_TITLE, FORMAT_DECIMAL, record_writer_find("jsonl"));
+}
+
+/**
+ * @brief Execute print_records with the Markdown writer and a row operation
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_markdown(void)
+{
+    modulus_t modulus = { .modulus = 5 };
+    row_operation_t operation = {
+        .kernel      = mod_multiply_row,
+        .value_bound = mod_multiply_bound,
+        .context     = &modulus
+    };
+
+    print_records(1, 4, NULL, &operation, MOD_MULT_TABLE_TITLE, FORMAT_HEX, record_writer_find("md"));
+}
+
+/**
+ * @brief Execute print_table with the division operation in decimal
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_division(void)
+{
+    print_table(0, 3, divide, DIV_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute print_table with the division operation in hexadecimal
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_division_hex(void)
+{
+    print_table(0, 3, divide, DIV_TABLE_TITLE, FORMAT_HEX);
+}
+
+/**
+ * @brief Execute print_compact_table with the multiplication and division operations
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_compact(void)
+{
+    print_compact_table(1, 12, multiply, NULL, MULT_TABLE_TITLE, FORMAT_DECIMAL);
+    print_compact_table(0, 3, divide, NULL, DIV_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute print_compact_table past the default -M limit
+ *
+ * For use with capture_stdout_file
+ */
+static void execute_print_compact_large(void)
+{
+    print_compact_table(1, 1000, multiply, NULL, MULT_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Execute print_compact_table with a row operation in hexadecimal
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_compact_row(void)
+{
+    modulus_t modulus = { .modulus = 20 };
+    row_operation_t operation = {
+        .kernel      = mod_multiply_row,
+        .value_bound = mod_multiply_bound,
+        .context     = &modulus
+    };
+
+    print_compact_table(1, 5, NULL, &operation, MOD_MULT_TABLE_TITLE, FORMAT_HEX);
+}
+
+/**
+ * @brief Execute print_table in alternating formats and sizes
+ *
+ * For use with capture_stdout
+ */
+static void execute_print_interned(void)
+{
+    print_table(1, 4, divide, DIV_TABLE_TITLE, FORMAT_DECIMAL);
+    print_table(1, 4, divide, DIV_TABLE_TITLE, FORMAT_HEX);
+    print_table(0, 40, divide, DIV_TABLE_TITLE, FORMAT_DECIMAL);
+}
+
+/**
+ * @brief Read back everything written to a temporary file
+ *
+ * @param file File to read from the start
+ * @param buffer Buffer for the contents, NUL terminated
+ * @param buffer_size Size of the buffer
+ * @return size_t Number of bytes read
+ */
+static size_t read_back(FILE *file, char *buffer, size_t buffer_size)
+{
+    size_t length;
+
+    rewind(file);
+    length = fread(buffer, 1, buffer_size - 1, file);
+    buffer[length] = '\0';
+    return length;
+}
+
 /**
  * @brief Test table printing with decimal format
  *
@@ -149,12 +370,12 @@ static int test_print_table_hex(void)
     TEST_ASSERT(strstr(buffer, "Test Addition Table") != NULL,
                 "Table title should be present in output", failures);
 
-    TEST_ASSERT(strstr(buffer, "[Hexadecimal Format]") != NULL,
-                "Hexadecimal format indicator should be present", failures);
+    /* Column labels, row labels and values are all hexadecimal */
+    TEST_ASSERT(strstr(buffer, "      |  0x1  0x2  0x3\n") != NULL,
+                "Header should hold hexadecimal column labels", failures);
 
-    /* Check for hex-formatted values */
-    TEST_ASSERT(strstr(buffer, "0x") != NULL,
-                "Hexadecimal values should be present (0x prefix)", failures);
+    TEST_ASSERT(strstr(buffer, "  0x3 |  0x4  0x5  0x6\n") != NULL,
+                "Rows should hold hexadecimal labels and values", failures);
 
     return failures;
 }
@@ -188,6 +409,402 @@ static int test_print_table_string_results(void)
     return failures;
 }
 
+/**
+ * @brief Test exact power table printing beyond the range of int
+ *
+ * @return int Number of failed tests
+ */
+static int test_print_big_power_table(void)
+{
+    int failures = 0;
+    char buffer[BUFFER_SIZE];
+    const char *last_row;
+    size_t width;
+
+    if (!capture_stdout(execute_print_big_power, buffer, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    TEST_ASSERT(strstr(buffer, POWER_TABLE_TITLE) != NULL,
+                "Table title should be present in output", failures);
+
+    /* 12^12 overflows int but must be printed exactly */
+    TEST_ASSERT(strstr(buffer, " 8916100448256\n") != NULL,
+                "12^12 should be printed exactly", failures);
+
+    TEST_ASSERT(strstr(buffer, "  743008370688 ") != NULL,
+                "12^11 should be printed exactly", failures);
+
+    /* The last row is the label, " |", twelve cells and the newline */
+    width = big_power_cell_width(12, FORMAT_DECIMAL);
+    last_row = strstr(buffer, "\n             12 |");
+    TEST_ASSERT(width == 15 && last_row != NULL && strlen(last_row + 1) == 13 * width + 3,
+                "Every cell should be as wide as big_power_cell_width()", failures);
+    TEST_ASSERT(big_power_cell_width(12, FORMAT_BINARY) == 0,
+                "Binary output should have no exact power cell width", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test row-at-a-time table printing
+ *
+ * @return int Number of failed tests
+ */
+static int test_print_row_table(void)
+{
+    int failures = 0;
+    char buffer[BUFFER_SIZE];
+
+    if (!capture_stdout(execute_print_row_table, buffer, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    TEST_ASSERT(strstr(buffer, MOD_MULT_TABLE_TITLE) != NULL,
+                "Table title should be present in output", failures);
+
+    /* Same layout as print_table(): 5-character cells */
+    TEST_ASSERT(strstr(buffer, "    3 |    3    1    4    2\n") != NULL,
+                "Row 3 mod 5 should be rendered with padded cells", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test mirrored printing of a symmetric table
+ *
+ * @return int Number of failed tests
+ */
+static int test_print_symmetric_table(void)
+{
+    int failures = 0;
+    char buffer[BUFFER_SIZE];
+    char expected[256];
+    int length = 0;
+
+    if (!capture_stdout(execute_print_symmetric, buffer, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    /* Row 17 lies below the diagonal of the second tile: all mirrored cells */
+    length += snprintf(expected + length, sizeof(expected) - length, "%5d |", 17);
+    for (int column = 1; column <= 20; column++)
+    {
+        length += snprintf(expected + length, sizeof(expected) - length, "%5d", 17 * column);
+    }
+    snprintf(expected + length, sizeof(expected) - length, "\n");
+
+    TEST_ASSERT(strstr(buffer, expected) != NULL,
+                "Mirrored row 17 should match the full product row", failures);
+
+    /* Cells the grid cannot hold are printed whole, row by row */
+    if (!capture_stdout(execute_print_wide_symmetric, buffer, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return failures + 1;
+    }
+    TEST_ASSERT(strstr(buffer, "12000000") != NULL && strstr(buffer, "16000000") != NULL,
+                "Cells wider than the bound should not be truncated", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test upper-triangle printing
+ *
+ * @return int Number of failed tests
+ */
+static int test_print_triangle_table(void)
+{
+    int failures = 0;
+    char buffer[BUFFER_SIZE];
+
+    if (!capture_stdout(execute_print_triangle, buffer, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    /* Header and columns keep the full layout */
+    TEST_ASSERT(strstr(buffer, "      |    1    2    3    4\n") != NULL,
+                "Header row should be unchanged", failures);
+    TEST_ASSERT(strstr(buffer, "    3 |              9   12\n") != NULL,
+                "Row 3 should start at the diagonal, aligned", failures);
+
+    TEST_ASSERT(!print_triangle_table(1, 4, divide, NULL, DIV_TABLE_TITLE, FORMAT_DECIMAL),
+                "Non-symmetric operations should be rejected", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test per-column widths of compact tables
+ *
+ * @return int Number of failed tests
+ */
+static int test_print_compact_table(void)
+{
+    int failures = 0;
+    char buffer[BUFFER_SIZE];
+
+    if (!capture_stdout(execute_print_compact, buffer, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    /* Column c is as wide as 12 × c, plus one space */
+    TEST_ASSERT(strstr(buffer, "   |  1  2  3  4  5  6  7  8   9  10  11  12\n"
+                               "---+----------------------------------------\n") != NULL,
+                "Header and separator should follow the column widths", failures);
+    TEST_ASSERT(strstr(buffer, " 9 |  9 18 27 36 45 54 63 72  81  90  99 108\n") != NULL,
+                "Row 9 should use the widths of the last row", failures);
+
+    /* The undefined column is as wide as its text */
+    TEST_ASSERT(strstr(buffer, "3 | UDF 3 1 1\n") != NULL,
+                "Division columns should be sized by their widest quotient", failures);
+
+    if (!capture_stdout(execute_print_compact_row, buffer, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    /* Column 3 reaches 15 = 0xf, column 4 reaches 16 = 0x10 */
+    TEST_ASSERT(strstr(buffer, "0x5 | 0x5 0xa 0xf  0x0 0x5\n") != NULL,
+                "Row values should be right-aligned in their columns", failures);
+    TEST_ASSERT(strstr(buffer, "0x4 | 0x4 0x8 0xc 0x10 0x0\n") != NULL,
+                "The widest row value should set its column width", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test the compact layout of a 1000 × 1000 table
+ *
+ * @return int Number of failed tests
+ */
+static int test_print_compact_large(void)
+{
+    int failures = 0;
+    size_t size = (size_t)8 << 20;
+    char *buffer = malloc(size);
+    FILE *file = tmpfile();
+    char *line;
+    size_t header_length;
+    size_t length;
+    bool aligned = true;
+
+    if (NULL == buffer || NULL == file || !capture_stdout_file(execute_print_compact_large, file)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        free(buffer);
+        if (NULL != file) {
+            fclose(file);
+        }
+        return 1;
+    }
+    length = read_back(file, buffer, size);
+
+    /* Every line after the title is as long as the header */
+    line = strchr(buffer + 1, '\n') + 1;
+    header_length = (size_t)(strchr(line, '\n') - line);
+    for (; line < buffer + length; line = strchr(line, '\n') + 1) {
+        aligned = aligned && (size_t)(strchr(line, '\n') - line) == header_length;
+    }
+
+    TEST_ASSERT(length < size - 1 && aligned, "Every row should be as long as the header", failures);
+    TEST_ASSERT(length > 16 && 0 == strcmp(buffer + length - 16, " 999000 1000000\n"),
+                "The last row should end with the widest products", failures);
+
+    fclose(file);
+    free(buffer);
+    return failures;
+}
+
+/**
+ * @brief Test that interned cells follow the format and size of each table
+ *
+ * @return int Number of failed tests
+ */
+static int test_print_interned_cells(void)
+{
+    int failures = 0;
+    char buffer[4 * BUFFER_SIZE];
+
+    if (!capture_stdout(execute_print_interned, buffer, sizeof(buffer))) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    TEST_ASSERT(strstr(buffer, "    4 |    4    2    1    1\n") != NULL,
+                "Decimal cells should be rendered in decimal", failures);
+    TEST_ASSERT(strstr(buffer, "  0x4 |  0x4  0x2  0x1  0x1\n") != NULL,
+                "Hexadecimal cells should not reuse decimal text", failures);
+
+    /* The larger pipelined table needs more values than the first one held */
+    TEST_ASSERT(strstr(buffer, "   40 |  UDF   40   20   13   10    8    6    5    5    4") != NULL,
+                "Values beyond the first table should be rendered", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test unpadded record writers
+ *
+ * @return int Number of failed tests
+ */
+static int test_print_records(void)
+{
+    int failures = 0;
+    char buffer[BUFFER_SIZE];
+
+    TEST_ASSERT(record_writer_find("tsv") != NULL, "TSV writer should exist", failures);
+    TEST_ASSERT(record_writer_find("xml") == NULL, "Unknown writers should not be found", failures);
+
+    if (!capture_stdout(execute_print_csv, buffer, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    TEST_ASSERT(0 == strcmp(buffer, "row,0,1,2,3\n0,UDF,0,0,0\n1,UDF,1,0,0\n2,UDF,2,1,0\n3,UDF,3,1,1\n"),
+                "CSV should have a header record and unpadded rows", failures);
+
+    if (!capture_stdout(execute_print_jsonl, buffer, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    TEST_ASSERT(strstr(buffer, "{\"row\":2,\"0\":\"UDF\",\"1\":2,\"2\":1}\n") != NULL,
+                "JSON Lines should emit one object per row with quoted strings", failures);
+
+    if (!capture_stdout(execute_print_markdown, buffer, BUFFER_SIZE)) {
+        printf("  ERROR: Failed to capture stdout\n");
+        return 1;
+    }
+
+    TEST_ASSERT(strstr(buffer, "| row | 0x1 | 0x2 | 0x3 | 0x4 |\n|---:|---:|---:|---:|---:|\n") != NULL,
+                "Markdown should have a header and alignment row", failures);
+    TEST_ASSERT(strstr(buffer, "| 0x3 | 0x3 | 0x1 | 0x4 | 0x2 |\n") != NULL,
+                "Markdown rows should hold hexadecimal cells", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test writing one table to several sinks at once
+ *
+ * Every sink should hold exactly what the single-output function for its
+ * format writes.
+ *
+ * @return int Number of failed tests
+ */
+static int test_print_table_sinks(void)
+{
+    int failures = 0;
+    char buffer[BUFFER_SIZE];
+    char expected[BUFFER_SIZE];
+    table_sink_t sinks[] = {
+        {FORMAT_DECIMAL, NULL, tmpfile()},
+        {FORMAT_HEX, NULL, tmpfile()},
+        {FORMAT_DECIMAL, record_writer_find("csv"), tmpfile()},
+        {FORMAT_BINARY, NULL, tmpfile()}
+    };
+    const uint64_t raw[] = {UINT64_MAX, 0, 0, 0, UINT64_MAX, 1, 0, 0};
+
+    for (size_t i = 0; i < 4; i++) {
+        if (NULL == sinks[i].stream) {
+            printf("  ERROR: Failed to create a temporary file\n");
+            return 1;
+        }
+    }
+
+    TEST_ASSERT(print_table_sinks(0, 3, divide, NULL, DIV_TABLE_TITLE, sinks, 4),
+                "Writing to all sinks should succeed", failures);
+
+    read_back(sinks[0].stream, buffer, BUFFER_SIZE);
+    TEST_ASSERT(capture_stdout(execute_print_division, expected, BUFFER_SIZE) &&
+                0 == strcmp(buffer, expected), "Decimal sink should match print_table()", failures);
+
+    read_back(sinks[1].stream, buffer, BUFFER_SIZE);
+    TEST_ASSERT(capture_stdout(execute_print_division_hex, expected, BUFFER_SIZE) &&
+                0 == strcmp(buffer, expected), "Hexadecimal sink should match print_table()", failures);
+
+    read_back(sinks[2].stream, buffer, BUFFER_SIZE);
+    TEST_ASSERT(capture_stdout(execute_print_csv, expected, BUFFER_SIZE) &&
+                0 == strcmp(buffer, expected), "CSV sink should match print_records()", failures);
+
+    TEST_ASSERT(16 * sizeof(uint64_t) == read_back(sinks[3].stream, buffer, BUFFER_SIZE) &&
+                0 == memcmp(buffer, raw, sizeof(raw)),
+                "Binary sink should hold raw cells with undefined ones set to all ones", failures);
+
+    for (size_t i = 0; i < 4; i++) {
+        fclose(sinks[i].stream);
+    }
+
+    return failures;
+}
+
+/**
+ * @brief Test detection of sinks reaching one file through different paths
+ *
+ * @return int Number of failed tests
+ */
+static int test_sink_aliases(void)
+{
+    int failures = 0;
+    char path[] = "/tmp/timestable_alias_XXXXXX";
+    char alias[sizeof(path) + 2];
+    char link[sizeof(path) + 5];
+    int fd = mkstemp(path);
+    table_sink_t sinks[3];
+
+    if (fd < 0) {
+        printf("  ERROR: Failed to create a temporary file\n");
+        return 1;
+    }
+    close(fd);
+
+    /* "/tmp/./name" and a symbolic link both reach the file */
+    snprintf(alias, sizeof(alias), "/tmp/.%s", path + 4);
+    snprintf(link, sizeof(link), "%s.link", path);
+    TEST_ASSERT(0 == symlink(path, link), "Symbolic link should be created", failures);
+
+    sinks[0] = (table_sink_t){FORMAT_DECIMAL, NULL, fopen(path, "ab")};
+    sinks[1] = (table_sink_t){FORMAT_HEX, NULL, fopen(alias, "ab")};
+    sinks[2] = (table_sink_t){FORMAT_DECIMAL, record_writer_find("csv"), fopen(link, "ab")};
+    if (NULL == sinks[0].stream || NULL == sinks[1].stream || NULL == sinks[2].stream) {
+        printf("  ERROR: Failed to open the temporary file\n");
+        unlink(link);
+        unlink(path);
+        return 1;
+    }
+
+    TEST_ASSERT(table_sinks_alias(sinks, 2), "An aliasing path should reach the same file", failures);
+    TEST_ASSERT(table_sinks_alias(&sinks[1], 2), "A symbolic link should reach the same file", failures);
+    TEST_ASSERT(!table_sinks_alias(sinks, 1), "One sink should not be an alias", failures);
+
+    /* Sinks sharing a stream write in turn */
+    fclose(sinks[1].stream);
+    sinks[1].stream = sinks[0].stream;
+    TEST_ASSERT(!table_sinks_alias(sinks, 2), "Sinks sharing a stream should not be aliases", failures);
+
+    fclose(sinks[0].stream);
+    fclose(sinks[2].stream);
+    sinks[0].stream = tmpfile();
+    sinks[1].stream = tmpfile();
+    TEST_ASSERT(NULL != sinks[0].stream && NULL != sinks[1].stream && !table_sinks_alias(sinks, 2),
+                "Different files should not be aliases", failures);
+
+    for (size_t i = 0; i < 2; i++) {
+        if (NULL != sinks[i].stream) {
+            fclose(sinks[i].stream);
+        }
+    }
+    unlink(link);
+    unlink(path);
+
+    return failures;
+}
+
 /**
  * @brief Run all tests for the table formatter
  *
@@ -200,6 +817,16 @@ int run_table_formatter_tests(void)
     RUN_TEST(test_print_table_decimal, failures);
     RUN_TEST(test_print_table_hex, failures);
     RUN_TEST(test_print_table_string_results, failures);
+    RUN_TEST(test_print_big_power_table, failures);
+    RUN_TEST(test_print_row_table, failures);
+    RUN_TEST(test_print_symmetric_table, failures);
+    RUN_TEST(test_print_triangle_table, failures);
+    RUN_TEST(test_print_compact_table, failures);
+    RUN_TEST(test_print_compact_large, failures);
+    RUN_TEST(test_print_interned_cells, failures);
+    RUN_TEST(test_print_records, failures);
+    RUN_TEST(test_print_table_sinks, failures);
+    RUN_TEST(test_sink_aliases, failures);
 
     return failures;
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <limits.h>
 #include <math.h>
 #include "test_framework.h"
 #include "test_table_operations.h"
@@ -141,6 +142,322 @@ static int test_power(void)
     return failures;
 }
 
+/**
+ * @brief Test the modular multiplication and power kernels
+ *
+ * Checks small moduli against hand-computed rows and a modulus close to
+ * 2^64, where the intermediate products need the full 128-bit path.
+ *
+ * @return int Number of failed tests
+ */
+static int test_modular_rows(void)
+{
+    int failures = 0;
+    uint64_t values[6];
+    modulus_t seven = { .modulus = 7 };
+    modulus_t large = { .modulus = 18446744073709551557u }; /* Largest 64-bit prime */
+    modulus_t one   = { .modulus = 1 };
+
+    /* 3 * (2..7) mod 7 = 6 2 5 1 4 0 */
+    mod_multiply_row(&seven, 3, 2, 6, values);
+    TEST_ASSERT(values[0] == 6 && values[1] == 2 && values[2] == 5 &&
+                values[3] == 1 && values[4] == 4 && values[5] == 0,
+                "3 * c mod 7 should match the running sum", failures);
+
+    /* 3^(0..5) mod 7 = 1 3 2 6 4 5 */
+    mod_power_row(&seven, 3, 0, 6, values);
+    TEST_ASSERT(values[0] == 1 && values[1] == 3 && values[2] == 2 &&
+                values[3] == 6 && values[4] == 4 && values[5] == 5,
+                "3^c mod 7 should match the running product", failures);
+
+    /* 2^64 mod p = 59 and 2^65 mod p = 118 for p = 2^64 - 59 */
+    mod_power_row(&large, 2, 64, 2, values);
+    TEST_ASSERT(values[0] == 59 && values[1] == 118,
+                "2^64 mod (2^64 - 59) should reduce exactly", failures);
+
+    /* Everything is zero modulo one, including 0^0 */
+    mod_power_row(&one, 0, 0, 2, values);
+    TEST_ASSERT(values[0] == 0 && values[1] == 0, "x mod 1 should be zero", failures);
+
+    TEST_ASSERT(mod_multiply_bound(&seven, 1, 10) == 6, "Bound should be capped at m - 1", failures);
+    TEST_ASSERT(mod_multiply_bound(&large, 1, 10) == 100, "Bound should be capped at max²", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Euclid's GCD, the reference for the GCD and LCM kernels
+ *
+ * @param a First value
+ * @param b Second value
+ * @return uint64_t gcd(a, b)
+ */
+static uint64_t euclid(uint64_t a, uint64_t b)
+{
+    while (0 != b) {
+        uint64_t rest = a % b;
+
+        a = b;
+        b = rest;
+    }
+    return a;
+}
+
+/**
+ * @brief Test the GCD, LCM and remainder kernels
+ *
+ * Rows and columns straddle the GCD tile and the reciprocal table, so the
+ * looked-up, binary GCD and plain division paths are all compared with
+ * Euclid's algorithm and the % operator.
+ *
+ * @return int Number of failed tests
+ */
+static int test_number_theory_rows(void)
+{
+    int failures = 0;
+    static gcd_tile_t tile;
+    static remainder_divisors_t divisors;
+    row_operation_t remainder = { .kernel = remainder_row, .has_markers = true };
+    row_operation_t plain = { .kernel = remainder_row };
+    uint64_t values[300];
+    bool gcd_match = true;
+    bool lcm_match = true;
+    bool remainder_match = true;
+    const int rows[] = {0, 1, 2, 12, 96, 127, 128, 255, 4095, 4096, 65536, INT_MAX - 1, INT_MAX};
+    const int columns[] = {0, 100, 4000, 65400, INT_MAX - 299};
+
+    gcd_tile_init(&tile);
+    remainder_divisors_init(&divisors);
+
+    for (size_t i = 0; i < sizeof(rows) / sizeof(rows[0]); i++) {
+        for (size_t j = 0; j < sizeof(columns) / sizeof(columns[0]); j++) {
+            uint64_t row = (uint64_t)rows[i];
+
+            gcd_row(&tile, rows[i], columns[j], 300, values);
+            for (int k = 0; k < 300; k++) {
+                gcd_match = gcd_match && values[k] == euclid(row, (uint64_t)(columns[j] + k));
+            }
+
+            gcd_row(NULL, rows[i], columns[j], 300, values);
+            for (int k = 0; k < 300; k++) {
+                gcd_match = gcd_match && values[k] == euclid(row, (uint64_t)(columns[j] + k));
+            }
+
+            lcm_row(&tile, rows[i], columns[j], 300, values);
+            for (int k = 0; k < 300; k++) {
+                uint64_t column = (uint64_t)(columns[j] + k);
+                uint64_t expected = (0 == row || 0 == column) ? 0 : row / euclid(row, column) * column;
+
+                lcm_match = lcm_match && values[k] == expected;
+            }
+
+            remainder_row(&divisors, rows[i], columns[j], 300, values);
+            for (int k = 0; k < 300; k++) {
+                uint64_t column = (uint64_t)(columns[j] + k);
+
+                remainder_match = remainder_match &&
+                                  values[k] == (0 == column ? ROW_VALUE_UNDEFINED : row % column);
+            }
+        }
+    }
+
+    TEST_ASSERT(gcd_match, "GCD rows should match Euclid's algorithm", failures);
+    TEST_ASSERT(lcm_match, "LCM rows should match row / gcd × column", failures);
+    TEST_ASSERT(remainder_match, "Remainder rows should match the % operator", failures);
+
+    TEST_ASSERT(0 == strcmp("UDF", row_value_marker(&remainder, ROW_VALUE_UNDEFINED)),
+                "Undefined cells should be marked UDF", failures);
+    TEST_ASSERT(0 == strcmp("OVF", row_value_marker(&remainder, ROW_VALUE_OVERFLOW)),
+                "Overflowing cells should be marked OVF", failures);
+    TEST_ASSERT(NULL == row_value_marker(&remainder, 7), "Values should not be markers", failures);
+    TEST_ASSERT(NULL == row_value_marker(&plain, ROW_VALUE_UNDEFINED),
+                "Operations without markers should print every value", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test the symmetry attribute of the per-cell operations
+ *
+ * @return int Number of failed tests
+ */
+static int test_symmetry(void)
+{
+    int failures = 0;
+
+    TEST_ASSERT(operation_is_symmetric(multiply), "Multiplication should be symmetric", failures);
+    TEST_ASSERT(!operation_is_symmetric(divide), "Division should not be symmetric", failures);
+    TEST_ASSERT(!operation_is_symmetric(power), "Power should not be symmetric", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test the incremental generators against the operations they replace
+ *
+ * @return int Number of failed tests
+ */
+static int test_generators(void)
+{
+    int failures = 0;
+    int mismatches = 0;
+    int values[40];
+    table_generator_t generator;
+    cell_value_t expected;
+    static const int starts[] = {0, 1, 7, 30, 31, 1000, 2147483600};
+
+    for (int row = 0; row <= 100; row++)
+    {
+        for (size_t s = 0; s < sizeof(starts) / sizeof(starts[0]); s++)
+        {
+            TEST_ASSERT(gen_init(&generator, multiply, row, starts[s]), "Multiply should generate", failures);
+            gen_fill(&generator, 40, values);
+            for (int i = 0; i < 40; i++)
+            {
+                multiply(row, starts[s] + i, &expected);
+                mismatches += (values[i] != expected.num_value);
+            }
+
+            TEST_ASSERT(gen_init(&generator, power, row, starts[s]), "Power should generate", failures);
+            gen_fill(&generator, 40, values);
+            for (int i = 0; i < 40 && starts[s] <= INT_MAX - i; i++)
+            {
+                power(row, starts[s] + i, &expected);
+                mismatches += (values[i] != expected.num_value);
+            }
+        }
+    }
+
+    TEST_ASSERT(0 == mismatches, "Generated rows should match multiply() and power()", failures);
+    TEST_ASSERT(!gen_init(&generator, divide, 3, 1), "Division has no incremental form", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test the lane widths chosen from the bounds of a table
+ *
+ * @return int Number of failed tests
+ */
+static int test_value_widths(void)
+{
+    int failures = 0;
+
+    TEST_ASSERT(VALUE_WIDTH_8 == table_value_width(multiply, 1, 15), "15 x 15 should fit 8 bits", failures);
+    TEST_ASSERT(VALUE_WIDTH_16 == table_value_width(multiply, 0, 16), "16 x 16 should need 16 bits", failures);
+    TEST_ASSERT(VALUE_WIDTH_16 == table_value_width(multiply, 0, 255), "255 x 255 should fit 16 bits", failures);
+    TEST_ASSERT(VALUE_WIDTH_32 == table_value_width(multiply, 0, 256), "256 x 256 should need 32 bits", failures);
+    TEST_ASSERT(VALUE_WIDTH_32 == table_value_width(multiply, 0, 46340), "46340 x 46340 should fit 32 bits", failures);
+    TEST_ASSERT(VALUE_WIDTH_NONE == table_value_width(multiply, 0, 46341), "Products above INT_MAX should not be narrowed", failures);
+    TEST_ASSERT(VALUE_WIDTH_8 == table_value_width(divide, 0, 254), "Quotients up to 254 should fit 8 bits", failures);
+    TEST_ASSERT(VALUE_WIDTH_16 == table_value_width(divide, 0, 255), "255 is the undefined 8-bit lane", failures);
+    TEST_ASSERT(VALUE_WIDTH_8 == table_value_width(power, 0, 3), "3^3 should fit 8 bits", failures);
+    TEST_ASSERT(VALUE_WIDTH_16 == table_value_width(power, 0, 4), "4^4 should need 16 bits", failures);
+    TEST_ASSERT(VALUE_WIDTH_32 == table_value_width(power, 1, 9), "9^9 should fit 32 bits", failures);
+    TEST_ASSERT(VALUE_WIDTH_NONE == table_value_width(power, 0, 10), "10^10 should not be narrowed", failures);
+    TEST_ASSERT(VALUE_WIDTH_NONE == table_value_width(multiply, -3, 5), "Negative ranges should not be narrowed", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test the lane kernels of every width against the operations
+ *
+ * @return int Number of failed tests
+ */
+static int test_fill_lanes(void)
+{
+    int failures = 0;
+    int mismatches = 0;
+    int narrowed = 0;
+    uint32_t storage[300];
+    cell_value_t expected;
+    static const TableOperation operations[] = {multiply, divide, power};
+    static const int maxima[] = {3, 4, 9, 15, 100, 254, 255, 300};
+
+    for (size_t o = 0; o < sizeof(operations) / sizeof(operations[0]); o++)
+    {
+        for (size_t m = 0; m < sizeof(maxima) / sizeof(maxima[0]); m++)
+        {
+            value_width_t width = table_value_width(operations[o], 0, maxima[m]);
+
+            if (VALUE_WIDTH_NONE == width)
+                continue;
+
+            narrowed |= 1 << width;
+            for (int row = 0; row <= maxima[m]; row++)
+            {
+                table_fill_lanes(operations[o], width, row, 0, maxima[m] + 1, storage);
+                for (int column = 0; column <= maxima[m]; column++)
+                {
+                    uint64_t lane = (VALUE_WIDTH_8 == width)  ? ((uint8_t *)storage)[column]
+                                  : (VALUE_WIDTH_16 == width) ? ((uint16_t *)storage)[column]
+                                                              : storage[column];
+                    uint64_t undefined = (VALUE_WIDTH_8 == width)  ? UINT8_MAX
+                                       : (VALUE_WIDTH_16 == width) ? UINT16_MAX
+                                                                   : UINT32_MAX;
+
+                    operations[o](row, column, &expected);
+                    mismatches += expected.is_numeric ? (lane != (uint64_t)expected.num_value)
+                                                      : (lane != undefined);
+                }
+            }
+        }
+    }
+
+    TEST_ASSERT(0 == mismatches, "Lanes should match multiply(), divide() and power()", failures);
+    TEST_ASSERT(((1 << 1) | (1 << 2) | (1 << 4)) == narrowed, "Every lane width should be exercised", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test the 64-bit row kernels of the per-cell operations
+ *
+ * @return int Number of failed tests
+ */
+static int test_wide_rows(void)
+{
+    int failures = 0;
+    int mismatches = 0;
+    uint64_t values[40];
+    cell_value_t expected;
+    row_operation_t row_operation;
+    static const TableOperation operations[] = {multiply, divide, power};
+
+    /* Within int range the kernels agree with the operations */
+    for (size_t o = 0; o < sizeof(operations) / sizeof(operations[0]); o++)
+    {
+        TEST_ASSERT(table_row_operation(operations[o], &row_operation), "Operation should have a 64-bit kernel", failures);
+        for (int row = 0; row <= 9; row++)
+        {
+            row_operation.kernel(row_operation.context, row, 0, 10, values);
+            for (int column = 0; column <= 9; column++)
+            {
+                operations[o](row, column, &expected);
+                mismatches += expected.is_numeric ? (values[column] != (uint64_t)expected.num_value)
+                                                  : (values[column] != ROW_VALUE_UNDEFINED);
+            }
+        }
+    }
+    TEST_ASSERT(0 == mismatches, "64-bit kernels should match the operations", failures);
+
+    /* Beyond it they are exact or overflow to the marker */
+    table_row_operation(multiply, &row_operation);
+    row_operation.kernel(NULL, INT_MAX, INT_MAX, 1, values);
+    TEST_ASSERT(values[0] == (uint64_t)INT_MAX * INT_MAX, "INT_MAX² should be exact", failures);
+
+    table_row_operation(power, &row_operation);
+    row_operation.kernel(NULL, 2, 62, 4, values);
+    TEST_ASSERT(values[0] == (1ull << 62) && values[1] == (1ull << 63) &&
+                values[2] == ROW_VALUE_OVERFLOW && values[3] == ROW_VALUE_OVERFLOW,
+                "Powers past 64 bits should be ROW_VALUE_OVERFLOW", failures);
+    TEST_ASSERT(ROW_VALUE_OVERFLOW == row_operation.value_bound(NULL, 0, 100), "100^100 should overflow", failures);
+    TEST_ASSERT(!table_row_operation(NULL, &row_operation), "Unknown operations have no kernel", failures);
+
+    return failures;
+}
+
 /**
  * @brief Run all tests for the table operations
  *
@@ -153,6 +470,13 @@ int run_table_operations_tests(void)
     RUN_TEST(test_multiply, failures);
     RUN_TEST(test_divide, failures);
     RUN_TEST(test_power, failures);
+    RUN_TEST(test_modular_rows, failures);
+    RUN_TEST(test_number_theory_rows, failures);
+    RUN_TEST(test_symmetry, failures);
+    RUN_TEST(test_generators, failures);
+    RUN_TEST(test_value_widths, failures);
+    RUN_TEST(test_fill_lanes, failures);
+    RUN_TEST(test_wide_rows, failures);
 
     return failures;
 }
\ No newline at end of file
@@ -0,0 +1,223 @@
+/**
+ * @file test_trace.c
+ * @brief Implementation of tests for the render phase timeline
+ *
+ * Records spans on several threads into a temporary file and checks the
+ * events written for each of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "test_framework.h"
+#include "test_helpers.h"
+#include "test_trace.h"
+#include "timestable_formatter.h"
+#include "timestable_operations.h"
+#include "timestable_trace.h"
+
+#define THREAD_COUNT 3
+#define SPANS_PER_THREAD 5000
+
+/**
+ * @brief Count the occurrences of a string in a text
+ *
+ * @param text Text to search
+ * @param needle String to count
+ * @return int Number of occurrences
+ */
+static int count_occurrences(const char *text, const char *needle)
+{
+    int count = 0;
+
+    for (const char *found = strstr(text, needle); NULL != found;
+         found = strstr(found + 1, needle)) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Read a whole file into a NUL-terminated buffer
+ *
+ * @param path File to read
+ * @return char* Contents to free(), or NULL on error
+ */
+static char *read_file(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char *text = NULL;
+    long size;
+
+    if (NULL == file) {
+        return NULL;
+    }
+
+    if (0 == fseek(file, 0, SEEK_END) && (size = ftell(file)) >= 0 &&
+        0 == fseek(file, 0, SEEK_SET) && NULL != (text = malloc((size_t)size + 1))) {
+        text[fread(text, 1, (size_t)size, file)] = '\0';
+    }
+
+    fclose(file);
+    return text;
+}
+
+/**
+ * @brief Thread recording more spans than one buffer block holds
+ *
+ * @param argument Unused
+ * @return void* NULL
+ */
+static void *record_spans(void *argument)
+{
+    (void)argument;
+
+    for (int i = 0; i < SPANS_PER_THREAD; i++) {
+        trace_end("test_span", trace_begin(), i);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Print a table through each of the traced layouts
+ */
+static void print_layouts(void)
+{
+    print_compact_table(1, 4, multiply, NULL, MULT_TABLE_TITLE, FORMAT_DECIMAL);
+    print_triangle_table(1, 4, multiply, NULL, MULT_TABLE_TITLE, FORMAT_DECIMAL);
+    print_records(1, 4, multiply, NULL, MULT_TABLE_TITLE, FORMAT_DECIMAL, record_writer_find("csv"));
+}
+
+/**
+ * @brief Test that nothing is recorded while tracing is off
+ *
+ * @return int Number of failed tests
+ */
+static int test_trace_off(void)
+{
+    int failures = 0;
+
+    TEST_ASSERT(0 == trace_begin(), "Spans should not start while tracing is off", failures);
+    trace_end("ignored", trace_clock_ns(), 0);
+    TEST_ASSERT(trace_close(), "Closing without a trace should succeed", failures);
+
+    return failures;
+}
+
+/**
+ * @brief Test spans recorded on several threads
+ *
+ * @return int Number of failed tests
+ */
+static int test_trace_threads(void)
+{
+    int failures = 0;
+    char path[] = "/tmp/timestable_trace_XXXXXX";
+    int fd = mkstemp(path);
+    pthread_t threads[THREAD_COUNT];
+    char *text;
+
+    if (fd < 0) {
+        printf("  ERROR: Failed to create a temporary file\n");
+        return 1;
+    }
+    close(fd);
+
+    TEST_ASSERT(TRACE_SUCCESS == trace_open(path, trace_clock_ns()).code,
+                "Tracing should start", failures);
+    TEST_ASSERT(TRACE_ERROR_ACTIVE == trace_open(path, 0).code,
+                "A second trace should be refused", failures);
+    TEST_ASSERT(0 != trace_begin(), "Spans should start while tracing", failures);
+
+    trace_end("main_span", trace_begin(), 42);
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        pthread_create(&threads[i], NULL, record_spans, NULL);
+    }
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    TEST_ASSERT(trace_close(), "The trace should be written", failures);
+    TEST_ASSERT(0 == trace_begin(), "Tracing should stop when closed", failures);
+
+    text = read_file(path);
+    unlink(path);
+    if (NULL == text) {
+        printf("  ERROR: Failed to read the trace\n");
+        return failures + 1;
+    }
+
+    TEST_ASSERT(0 == strncmp(text, "{\"traceEvents\":[", 16) &&
+                NULL != strstr(text, "\n],\"displayTimeUnit\":\"ns\"}\n"),
+                "The trace should be one trace-event object", failures);
+    TEST_ASSERT(1 == count_occurrences(text, "\"name\":\"main_span\"") &&
+                NULL != strstr(text, "\"args\":{\"value\":42}"),
+                "The span of the calling thread should be written", failures);
+    TEST_ASSERT(THREAD_COUNT * SPANS_PER_THREAD == count_occurrences(text, "\"name\":\"test_span\""),
+                "Every span of every thread should be written", failures);
+    TEST_ASSERT(THREAD_COUNT + 1 == count_occurrences(text, "\"ph\":\"M\"") &&
+                1 == count_occurrences(text, "\"name\":\"main\""),
+                "Each thread should be named once", failures);
+
+    free(text);
+    return failures;
+}
+
+/**
+ * @brief Test that every table layout records a span
+ *
+ * @return int Number of failed tests
+ */
+static int test_trace_layouts(void)
+{
+    int failures = 0;
+    char path[] = "/tmp/timestable_trace_XXXXXX";
+    int fd = mkstemp(path);
+    char output[4096];
+    char *text;
+
+    if (fd < 0) {
+        printf("  ERROR: Failed to create a temporary file\n");
+        return 1;
+    }
+    close(fd);
+
+    TEST_ASSERT(TRACE_SUCCESS == trace_open(path, trace_clock_ns()).code,
+                "Tracing should start", failures);
+    TEST_ASSERT(capture_stdout(print_layouts, output, sizeof(output)),
+                "The tables should be printed", failures);
+    TEST_ASSERT(trace_close(), "The trace should be written", failures);
+
+    text = read_file(path);
+    unlink(path);
+    if (NULL == text) {
+        printf("  ERROR: Failed to read the trace\n");
+        return failures + 1;
+    }
+
+    TEST_ASSERT(1 == count_occurrences(text, "\"name\":\"print_compact_table\"") &&
+                1 == count_occurrences(text, "\"name\":\"print_triangle_table\"") &&
+                1 == count_occurrences(text, "\"name\":\"print_records\""),
+                "Each table should be one span", failures);
+
+    free(text);
+    return failures;
+}
+
+/**
+ * @brief Run all tests for the render phase timeline
+ *
+ * @return int Number of failed tests
+ */
+int run_trace_tests(void)
+{
+    int failures = 0;
+
+    RUN_TEST(test_trace_off, failures);
+    RUN_TEST(test_trace_threads, failures);
+    RUN_TEST(test_trace_layouts, failures);
+
+    return failures;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file test_trace.h
+ * @brief Tests for the render phase timeline
+ *
+ * Defines the function prototypes for testing span recording and the
+ * trace-event file.
+ */
+
+#ifndef TEST_TRACE_H
+#define TEST_TRACE_H
+
+/**
+ * @brief Run all tests for the render phase timeline
+ *
+ * @return int Number of failed tests
+ */
+int run_trace_tests(void);
+
+#endif /* TEST_TRACE_H */